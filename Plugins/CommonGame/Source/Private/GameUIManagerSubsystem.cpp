@@ -2,7 +2,10 @@
 
 #include "GameUIManagerSubsystem.h"
 
+#include "CommonLocalPlayer.h"
+#include "Engine/AssetManager.h"
 #include "Engine/GameInstance.h"
+#include "Engine/StreamableManager.h"
 #include "GameUIPolicy.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(GameUIManagerSubsystem)
@@ -16,8 +19,17 @@ void UGameUIManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 	if (!CurrentPolicy && !DefaultUIPolicyClass.IsNull())
 	{
-		TSubclassOf<UGameUIPolicy> PolicyClass = DefaultUIPolicyClass.LoadSynchronous();
-		SwitchToPolicy(NewObject<UGameUIPolicy>(this, PolicyClass));
+		if (DefaultUIPolicyClass.Get())
+		{
+			HandleDefaultPolicyLoaded();
+		}
+		else
+		{
+			// This is on the boot path, so don't block on it; the layout is created once the policy exists
+			FStreamableManager& StreamableManager = UAssetManager::Get().GetStreamableManager();
+			PolicyLoadHandle = StreamableManager.RequestAsyncLoad(DefaultUIPolicyClass.ToSoftObjectPath(),
+				FStreamableDelegate::CreateUObject(this, &ThisClass::HandleDefaultPolicyLoaded), FStreamableManager::AsyncLoadHighPriority);
+		}
 	}
 }
 
@@ -25,9 +37,47 @@ void UGameUIManagerSubsystem::Deinitialize()
 {
 	Super::Deinitialize();
 
+	if (PolicyLoadHandle.IsValid())
+	{
+		PolicyLoadHandle->CancelHandle();
+		PolicyLoadHandle.Reset();
+	}
+	PendingPlayerEvents.Empty();
+
 	SwitchToPolicy(nullptr);
 }
 
+void UGameUIManagerSubsystem::HandleDefaultPolicyLoaded()
+{
+	PolicyLoadHandle.Reset();
+
+	if (!CurrentPolicy)
+	{
+		if (TSubclassOf<UGameUIPolicy> PolicyClass = DefaultUIPolicyClass.Get())
+		{
+			SwitchToPolicy(NewObject<UGameUIPolicy>(this, PolicyClass));
+		}
+	}
+
+	TArray<TPair<TWeakObjectPtr<UCommonLocalPlayer>, EPendingPlayerEvent>> EventsToReplay = MoveTemp(PendingPlayerEvents);
+	PendingPlayerEvents.Reset();
+
+	for (const TPair<TWeakObjectPtr<UCommonLocalPlayer>, EPendingPlayerEvent>& PendingEvent : EventsToReplay)
+	{
+		if (UCommonLocalPlayer* LocalPlayer = PendingEvent.Key.Get())
+		{
+			if (PendingEvent.Value == EPendingPlayerEvent::Added)
+			{
+				NotifyPlayerAdded(LocalPlayer);
+			}
+			else
+			{
+				NotifyPlayerRemoved(LocalPlayer);
+			}
+		}
+	}
+}
+
 bool UGameUIManagerSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 {
 	if (!CastChecked<UGameInstance>(Outer)->IsDedicatedServerInstance())
@@ -48,6 +98,10 @@ void UGameUIManagerSubsystem::NotifyPlayerAdded(UCommonLocalPlayer* LocalPlayer)
 	{
 		CurrentPolicy->NotifyPlayerAdded(LocalPlayer);
 	}
+	else if (LocalPlayer && PolicyLoadHandle.IsValid())
+	{
+		PendingPlayerEvents.Emplace(LocalPlayer, EPendingPlayerEvent::Added);
+	}
 }
 
 void UGameUIManagerSubsystem::NotifyPlayerRemoved(UCommonLocalPlayer* LocalPlayer)
@@ -56,6 +110,10 @@ void UGameUIManagerSubsystem::NotifyPlayerRemoved(UCommonLocalPlayer* LocalPlaye
 	{
 		CurrentPolicy->NotifyPlayerRemoved(LocalPlayer);
 	}
+	else if (LocalPlayer && PolicyLoadHandle.IsValid())
+	{
+		PendingPlayerEvents.Emplace(LocalPlayer, EPendingPlayerEvent::Removed);
+	}
 }
 
 void UGameUIManagerSubsystem::NotifyPlayerDestroyed(UCommonLocalPlayer* LocalPlayer)
@@ -64,6 +122,14 @@ void UGameUIManagerSubsystem::NotifyPlayerDestroyed(UCommonLocalPlayer* LocalPla
 	{
 		CurrentPolicy->NotifyPlayerDestroyed(LocalPlayer);
 	}
+	else if (LocalPlayer)
+	{
+		// The policy never saw this player, so there's nothing to tear down
+		PendingPlayerEvents.RemoveAll([LocalPlayer](const TPair<TWeakObjectPtr<UCommonLocalPlayer>, EPendingPlayerEvent>& PendingEvent)
+		{
+			return PendingEvent.Key == LocalPlayer;
+		});
+	}
 }
 
 void UGameUIManagerSubsystem::SwitchToPolicy(UGameUIPolicy* InPolicy)
@@ -1,7 +1,9 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "GameUIPolicy.h"
+#include "Engine/AssetManager.h"
 #include "Engine/GameInstance.h"
+#include "Engine/StreamableManager.h"
 #include "Framework/Application/SlateApplication.h"
 #include "GameUIManagerSubsystem.h"
 #include "CommonLocalPlayer.h"
@@ -105,6 +107,7 @@ void UGameUIPolicy::NotifyPlayerDestroyed(UCommonLocalPlayer* LocalPlayer)
 {
 	NotifyPlayerRemoved(LocalPlayer);
 	LocalPlayer->OnPlayerControllerSet.RemoveAll(this);
+	PlayersAwaitingLayout.Remove(LocalPlayer);
 	const int32 LayoutInfoIdx = RootViewportLayouts.IndexOfByKey(LocalPlayer);
 	if (LayoutInfoIdx != INDEX_NONE)
 	{
@@ -187,17 +190,50 @@ void UGameUIPolicy::CreateLayoutWidget(UCommonLocalPlayer* LocalPlayer)
 	if (APlayerController* PlayerController = LocalPlayer->GetPlayerController(GetWorld()))
 	{
 		TSubclassOf<UPrimaryGameLayout> LayoutWidgetClass = GetLayoutWidgetClass(LocalPlayer);
+		if (!LayoutWidgetClass && !LayoutClass.IsNull())
+		{
+			// Don't block the join on the layout, create it when the class arrives
+			PlayersAwaitingLayout.AddUnique(LocalPlayer);
+			if (!LayoutLoadHandle.IsValid())
+			{
+				FStreamableManager& StreamableManager = UAssetManager::Get().GetStreamableManager();
+				LayoutLoadHandle = StreamableManager.RequestAsyncLoad(LayoutClass.ToSoftObjectPath(),
+					FStreamableDelegate::CreateUObject(this, &ThisClass::HandleLayoutClassLoaded), FStreamableManager::AsyncLoadHighPriority);
+			}
+			return;
+		}
+
 		if (ensure(LayoutWidgetClass && !LayoutWidgetClass->HasAnyClassFlags(CLASS_Abstract)))
 		{
 			UPrimaryGameLayout* NewLayoutObject = CreateWidget<UPrimaryGameLayout>(PlayerController, LayoutWidgetClass);
 			RootViewportLayouts.Emplace(LocalPlayer, NewLayoutObject, true);
 			
 			AddLayoutToViewport(LocalPlayer, NewLayoutObject);
+
+			LocalPlayer->OnRootLayoutSet.Broadcast(LocalPlayer, NewLayoutObject);
 		}
 	}
 }
 
 TSubclassOf<UPrimaryGameLayout> UGameUIPolicy::GetLayoutWidgetClass(UCommonLocalPlayer* LocalPlayer)
 {
-	return LayoutClass.LoadSynchronous();
+	return LayoutClass.Get();
+}
+
+void UGameUIPolicy::HandleLayoutClassLoaded()
+{
+	// Keep the handle so the class stays loaded for players added later
+	TArray<TWeakObjectPtr<UCommonLocalPlayer>> Players = MoveTemp(PlayersAwaitingLayout);
+	PlayersAwaitingLayout.Reset();
+
+	UE_CLOG(!LayoutClass.Get(), LogCommonGame, Error, TEXT("[%s] failed to load layout class [%s]"), *GetName(), *LayoutClass.ToString());
+
+	for (const TWeakObjectPtr<UCommonLocalPlayer>& WeakLocalPlayer : Players)
+	{
+		UCommonLocalPlayer* LocalPlayer = WeakLocalPlayer.Get();
+		if (LocalPlayer && LayoutClass.Get() && !RootViewportLayouts.FindByKey(LocalPlayer))
+		{
+			CreateLayoutWidget(LocalPlayer);
+		}
+	}
 }
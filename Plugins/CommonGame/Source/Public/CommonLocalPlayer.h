@@ -34,6 +34,10 @@ public:
 	DECLARE_MULTICAST_DELEGATE_TwoParams(FPlayerPawnSetDelegate, UCommonLocalPlayer* LocalPlayer, APawn* Pawn);
 	FPlayerPawnSetDelegate OnPlayerPawnSet;
 
+	/** Called when the UI policy creates the local player's root layout, which can be after the player controller is set while the layout class loads */
+	DECLARE_MULTICAST_DELEGATE_TwoParams(FPlayerRootLayoutSetDelegate, UCommonLocalPlayer* LocalPlayer, UPrimaryGameLayout* RootLayout);
+	FPlayerRootLayoutSetDelegate OnRootLayoutSet;
+
 	FDelegateHandle CallAndRegister_OnPlayerControllerSet(FPlayerControllerSetDelegate::FDelegate Delegate);
 	FDelegateHandle CallAndRegister_OnPlayerStateSet(FPlayerStateSetDelegate::FDelegate Delegate);
 	FDelegateHandle CallAndRegister_OnPlayerPawnSet(FPlayerPawnSetDelegate::FDelegate Delegate);
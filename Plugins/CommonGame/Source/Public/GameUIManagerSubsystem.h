@@ -11,6 +11,7 @@ class FSubsystemCollectionBase;
 class UCommonLocalPlayer;
 class UGameUIPolicy;
 class UObject;
+struct FStreamableHandle;
 
 /**
  * This manager is intended to be replaced by whatever your game needs to
@@ -41,10 +42,22 @@ public:
 protected:
 	void SwitchToPolicy(UGameUIPolicy* InPolicy);
 
+private:
+	void HandleDefaultPolicyLoaded();
+
 private:
 	UPROPERTY(Transient)
 	TObjectPtr<UGameUIPolicy> CurrentPolicy = nullptr;
 
+	// The default policy class is loaded asynchronously, player events that arrive before then are replayed in order once it's created
+	enum class EPendingPlayerEvent : uint8
+	{
+		Added,
+		Removed
+	};
+	TArray<TPair<TWeakObjectPtr<UCommonLocalPlayer>, EPendingPlayerEvent>> PendingPlayerEvents;
+	TSharedPtr<FStreamableHandle> PolicyLoadHandle;
+
 	UPROPERTY(config, EditAnywhere)
 	TSoftClassPtr<UGameUIPolicy> DefaultUIPolicyClass;
 };
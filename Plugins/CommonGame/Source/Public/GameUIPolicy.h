@@ -10,6 +10,7 @@ class UCommonLocalPlayer;
 class UGameUIManagerSubsystem;
 class ULocalPlayer;
 class UPrimaryGameLayout;
+struct FStreamableHandle;
 
 /**
  * 
@@ -82,7 +83,10 @@ protected:
 	virtual void OnRootLayoutRemovedFromViewport(UCommonLocalPlayer* LocalPlayer, UPrimaryGameLayout* Layout);
 	virtual void OnRootLayoutReleased(UCommonLocalPlayer* LocalPlayer, UPrimaryGameLayout* Layout);
 
+	// Creates the player's root layout, or queues it if the layout class is still loading
 	void CreateLayoutWidget(UCommonLocalPlayer* LocalPlayer);
+
+	// Returns the layout class if it is loaded, never blocks
 	TSubclassOf<UPrimaryGameLayout> GetLayoutWidgetClass(UCommonLocalPlayer* LocalPlayer);
 
 private:
@@ -94,6 +98,12 @@ private:
 	UPROPERTY(Transient)
 	TArray<FRootViewportLayoutInfo> RootViewportLayouts;
 
+	// Players waiting on LayoutClass to finish loading before their root layout can be created
+	TArray<TWeakObjectPtr<UCommonLocalPlayer>> PlayersAwaitingLayout;
+	TSharedPtr<FStreamableHandle> LayoutLoadHandle;
+
+	void HandleLayoutClassLoaded();
+
 private:
 	void NotifyPlayerAdded(UCommonLocalPlayer* LocalPlayer);
 	void NotifyPlayerRemoved(UCommonLocalPlayer* LocalPlayer);
@@ -49,13 +49,11 @@ bool ILoadingProcessInterface::ShouldShowLoadingScreen(UObject* TestObject, FStr
 	{
 		if (ILoadingProcessInterface* LoadObserver = Cast<ILoadingProcessInterface>(TestObject))
 		{
-			FString ObserverReason;
-			if (LoadObserver->ShouldShowLoadingScreen(/*out*/ ObserverReason))
+			// Written in place so that polling every frame reuses the caller's string instead of allocating a new one
+			OutReason.Reset();
+			if (LoadObserver->ShouldShowLoadingScreen(/*out*/ OutReason))
 			{
-				if (ensureMsgf(!ObserverReason.IsEmpty(), TEXT("%s failed to set a reason why it wants to show the loading screen"), *GetPathNameSafe(TestObject)))
-				{
-					OutReason = ObserverReason;
-				}
+				ensureMsgf(!OutReason.IsEmpty(), TEXT("%s failed to set a reason why it wants to show the loading screen"), *GetPathNameSafe(TestObject));
 				return true;
 			}
 		}
@@ -182,11 +180,49 @@ UWorld* ULoadingScreenManager::GetTickableGameObjectWorld() const
 void ULoadingScreenManager::RegisterLoadingProcessor(TScriptInterface<ILoadingProcessInterface> Interface)
 {
 	ExternalLoadingProcessors.Add(Interface.GetObject());
+	NotifyLoadingProcessorsChanged();
 }
 
 void ULoadingScreenManager::UnregisterLoadingProcessor(TScriptInterface<ILoadingProcessInterface> Interface)
 {
 	ExternalLoadingProcessors.Remove(Interface.GetObject());
+	NotifyLoadingProcessorsChanged();
+}
+
+uint32 ULoadingScreenManager::AcquireStillLoadingToken(const FString& Reason)
+{
+	const uint32 Token = NextStillLoadingToken++;
+	if (NextStillLoadingToken == 0)
+	{
+		NextStillLoadingToken = 1;
+	}
+
+	ensureMsgf(!Reason.IsEmpty(), TEXT("AcquireStillLoadingToken called without a reason why it wants to show the loading screen"));
+	StillLoadingTokens.Add(Token, Reason);
+
+	UE_LOG(LogLoadingScreen, Verbose, TEXT("Still loading token %u acquired: %s"), Token, *Reason);
+	return Token;
+}
+
+void ULoadingScreenManager::UpdateStillLoadingToken(uint32 Token, const FString& Reason)
+{
+	if (FString* ExistingReason = StillLoadingTokens.Find(Token))
+	{
+		*ExistingReason = Reason;
+	}
+}
+
+void ULoadingScreenManager::ReleaseStillLoadingToken(uint32 Token)
+{
+	if (StillLoadingTokens.Remove(Token) > 0)
+	{
+		UE_LOG(LogLoadingScreen, Verbose, TEXT("Still loading token %u released, %d remaining"), Token, StillLoadingTokens.Num());
+	}
+}
+
+void ULoadingScreenManager::NotifyLoadingProcessorsChanged()
+{
+	bLoadingProcessorsDirty = true;
 }
 
 void ULoadingScreenManager::HandlePreLoadMap(const FWorldContext& WorldContext, const FString& MapName)
@@ -194,6 +230,7 @@ void ULoadingScreenManager::HandlePreLoadMap(const FWorldContext& WorldContext,
 	if (WorldContext.OwningGameInstance == GetGameInstance())
 	{
 		bCurrentlyInLoadMap = true;
+		NotifyLoadingProcessorsChanged();
 
 		// Update the loading screen immediately if the engine is initialized
 		if (GEngine->IsInitialized())
@@ -208,23 +245,28 @@ void ULoadingScreenManager::HandlePostLoadMap(UWorld* World)
 	if ((World != nullptr) && (World->GetGameInstance() == GetGameInstance()))
 	{
 		bCurrentlyInLoadMap = false;
+		NotifyLoadingProcessorsChanged();
 	}
 }
 
 void ULoadingScreenManager::UpdateLoadingScreen()
 {
+	const UCommonLoadingScreenSettings* Settings = GetDefault<UCommonLoadingScreenSettings>();
+
 	bool bLogLoadingScreenStatus = LoadingScreenCVars::LogLoadingScreenReasonEveryFrame;
+	const bool bHeartbeatLogDue = (Settings->LogLoadingScreenHeartbeatInterval > 0.0f) && (TimeUntilNextLogHeartbeatSeconds <= 0.0);
+
+	// Only format detailed reasons when they can end up in the log (every frame logging, the heartbeat, or showing the screen)
+	bBuildDetailedDebugReasons = bLogLoadingScreenStatus || bHeartbeatLogDue || !bCurrentlyShowingLoadingScreen;
 
 	if (ShouldShowLoadingScreen())
 	{
-		const UCommonLoadingScreenSettings* Settings = GetDefault<UCommonLoadingScreenSettings>();
-		
 		// If we don't make it to the specified checkpoint in the given time will trigger the hang detector so we can better determine where progress stalled.
  		FThreadHeartBeat::Get().MonitorCheckpointStart(GetFName(), Settings->LoadingScreenHeartbeatHangDuration);
 
 		ShowLoadingScreen();
 
- 		if ((Settings->LogLoadingScreenHeartbeatInterval > 0.0f) && (TimeUntilNextLogHeartbeatSeconds <= 0.0))
+ 		if (bHeartbeatLogDue)
  		{
 			bLogLoadingScreenStatus = true;
  			TimeUntilNextLogHeartbeatSeconds = Settings->LogLoadingScreenHeartbeatInterval;
@@ -239,20 +281,35 @@ void ULoadingScreenManager::UpdateLoadingScreen()
 
 	if (bLogLoadingScreenStatus)
 	{
-		UE_LOG(LogLoadingScreen, Log, TEXT("Loading screen showing: %d. Reason: %s"), bCurrentlyShowingLoadingScreen ? 1 : 0, *DebugReasonForShowingOrHidingLoadingScreen);
+		UE_LOG(LogLoadingScreen, Log, TEXT("Loading screen showing: %d. Reason: %s"), bCurrentlyShowingLoadingScreen ? 1 : 0, *GetDebugReasonForShowingOrHidingLoadingScreen());
 	}
 }
 
 bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 {
 	// Start out with 'unknown' reason in case someone forgets to put a reason when changing this in the future.
-	DebugReasonForShowingOrHidingLoadingScreen = TEXT("Reason for Showing/Hiding LoadingScreen is unknown!");
+	SetDebugReason(TEXT("Reason for Showing/Hiding LoadingScreen is unknown!"));
 
 	const UGameInstance* LocalGameInstance = GetGameInstance();
 
 	if (LoadingScreenCVars::ForceLoadingScreenVisible)
 	{
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("CommonLoadingScreen.AlwaysShow is true"));
+		SetDebugReason(TEXT("CommonLoadingScreen.AlwaysShow is true"));
+		return true;
+	}
+
+	// Loading work that pushed a token is still going, nothing else needs to be checked until it is released
+	if (StillLoadingTokens.Num() > 0)
+	{
+		if (bBuildDetailedDebugReasons)
+		{
+			DebugReasonForShowingOrHidingLoadingScreen = FString::Printf(TEXT("%s (token %u, %d held)"), *StillLoadingTokens.CreateConstIterator().Value(), StillLoadingTokens.CreateConstIterator().Key(), StillLoadingTokens.Num());
+			SetDebugReason(nullptr);
+		}
+		else
+		{
+			SetDebugReason(TEXT("A still loading token is held"));
+		}
 		return true;
 	}
 
@@ -260,14 +317,14 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 	if (Context == nullptr)
 	{
 		// We don't have a world context right now... better show a loading screen
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("The game instance has a null WorldContext"));
+		SetDebugReason(TEXT("The game instance has a null WorldContext"));
 		return true;
 	}
 
 	UWorld* World = Context->World();
 	if (World == nullptr)
 	{
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("We have no world (FWorldContext's World() is null)"));
+		SetDebugReason(TEXT("We have no world (FWorldContext's World() is null)"));
 		return true;
 	}
 
@@ -275,70 +332,51 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 	if (GameState == nullptr)
 	{
 		// The game state has not yet replicated.
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("GameState hasn't yet replicated (it's null)"));
+		SetDebugReason(TEXT("GameState hasn't yet replicated (it's null)"));
 		return true;
 	}
 
 	if (bCurrentlyInLoadMap)
 	{
 		// Show a loading screen if we are in LoadMap
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("bCurrentlyInLoadMap is true"));
+		SetDebugReason(TEXT("bCurrentlyInLoadMap is true"));
 		return true;
 	}
 
 	if (!Context->TravelURL.IsEmpty())
 	{
 		// Show a loading screen when pending travel
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("We have pending travel (the TravelURL is not empty)"));
+		SetDebugReason(TEXT("We have pending travel (the TravelURL is not empty)"));
 		return true;
 	}
 
 	if (Context->PendingNetGame != nullptr)
 	{
 		// Connecting to another server
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("We are connecting to another server (PendingNetGame != nullptr)"));
+		SetDebugReason(TEXT("We are connecting to another server (PendingNetGame != nullptr)"));
 		return true;
 	}
 
 	if (!World->HasBegunPlay())
 	{
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("World hasn't begun play"));
+		SetDebugReason(TEXT("World hasn't begun play"));
 		return true;
 	}
 
 	if (World->IsInSeamlessTravel())
 	{
 		// Show a loading screen during seamless travel
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("We are in seamless travel"));
+		SetDebugReason(TEXT("We are in seamless travel"));
 		return true;
 	}
 
-	// Ask the game state if it needs a loading screen	
-	if (ILoadingProcessInterface::ShouldShowLoadingScreen(GameState, /*out*/ DebugReasonForShowingOrHidingLoadingScreen))
+	// Ask the game state, the local player controllers, any of their components and any external loading processors
+	// that may have been registered if they need a loading screen
+	if (CheckLoadingProcessors(GameState))
 	{
 		return true;
 	}
 
-	// Ask any game state components if they need a loading screen
-	for (UActorComponent* TestComponent : GameState->GetComponents())
-	{
-		if (ILoadingProcessInterface::ShouldShowLoadingScreen(TestComponent, /*out*/ DebugReasonForShowingOrHidingLoadingScreen))
-		{
-			return true;
-		}
-	}
-
-	// Ask any of the external loading processors that may have been registered.  These might be actors or components
-	// that were registered by game code to tell us to keep the loading screen up while perhaps something finishes
-	// streaming in.
-	for (const TWeakInterfacePtr<ILoadingProcessInterface>& Processor : ExternalLoadingProcessors)
-	{
-		if (ILoadingProcessInterface::ShouldShowLoadingScreen(Processor.GetObject(), /*out*/ DebugReasonForShowingOrHidingLoadingScreen))
-		{
-			return true;
-		}
-	}
-
 	// Check each local player
 	bool bFoundAnyLocalPC = false;
 	bool bMissingAnyLocalPC = false;
@@ -347,24 +385,9 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 	{
 		if (LP != nullptr)
 		{
-			if (APlayerController* PC = LP->PlayerController)
+			if (LP->PlayerController != nullptr)
 			{
 				bFoundAnyLocalPC = true;
-
-				// Ask the PC itself if it needs a loading screen
-				if (ILoadingProcessInterface::ShouldShowLoadingScreen(PC, /*out*/ DebugReasonForShowingOrHidingLoadingScreen))
-				{
-					return true;
-				}
-
-				// Ask any PC components if they need a loading screen
-				for (UActorComponent* TestComponent : PC->GetComponents())
-				{
-					if (ILoadingProcessInterface::ShouldShowLoadingScreen(TestComponent, /*out*/ DebugReasonForShowingOrHidingLoadingScreen))
-					{
-						return true;
-					}
-				}
 			}
 			else
 			{
@@ -379,22 +402,106 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 	// In splitscreen we need all player controllers to be present
 	if (bIsInSplitscreen && bMissingAnyLocalPC)
 	{
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("At least one missing local player controller in splitscreen"));
+		SetDebugReason(TEXT("At least one missing local player controller in splitscreen"));
 		return true;
 	}
 
 	// And in non-splitscreen we need at least one player controller to be present
 	if (!bIsInSplitscreen && !bFoundAnyLocalPC)
 	{
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("Need at least one local player controller"));
+		SetDebugReason(TEXT("Need at least one local player controller"));
 		return true;
 	}
 
 	// Victory! The loading screen can go away now
-	DebugReasonForShowingOrHidingLoadingScreen = TEXT("(nothing wants to show it anymore)");
+	SetDebugReason(TEXT("(nothing wants to show it anymore)"));
+	return false;
+}
+
+bool ULoadingScreenManager::CheckLoadingProcessors(AGameStateBase* GameState)
+{
+	RefreshCachedLoadingProcessors(GameState);
+
+	for (const TWeakObjectPtr<UObject>& Processor : CachedLoadingProcessors)
+	{
+		if (ILoadingProcessInterface::ShouldShowLoadingScreen(Processor.Get(), /*out*/ DebugReasonForShowingOrHidingLoadingScreen))
+		{
+			SetDebugReason(nullptr);
+			return true;
+		}
+	}
+
 	return false;
 }
 
+void ULoadingScreenManager::RefreshCachedLoadingProcessors(AGameStateBase* GameState)
+{
+	const UGameInstance* LocalGameInstance = GetGameInstance();
+
+	// Components are rarely added or removed once loading is underway, so a changed count is enough to notice them
+	int32 ComponentCount = GameState->GetComponents().Num();
+	int32 NumPlayerControllers = 0;
+	bool bPlayerControllersChanged = false;
+	for (ULocalPlayer* LP : LocalGameInstance->GetLocalPlayers())
+	{
+		if (APlayerController* PC = (LP != nullptr) ? LP->PlayerController.Get() : nullptr)
+		{
+			ComponentCount += PC->GetComponents().Num();
+			bPlayerControllersChanged |= !CachedProcessorPlayerControllers.IsValidIndex(NumPlayerControllers) || (CachedProcessorPlayerControllers[NumPlayerControllers].Get() != PC);
+			++NumPlayerControllers;
+		}
+	}
+	bPlayerControllersChanged |= (NumPlayerControllers != CachedProcessorPlayerControllers.Num());
+
+	if (!bLoadingProcessorsDirty && !bPlayerControllersChanged && (CachedProcessorGameState.Get() == GameState) && (ComponentCount == CachedProcessorComponentCount))
+	{
+		return;
+	}
+
+	bLoadingProcessorsDirty = false;
+	CachedProcessorGameState = GameState;
+	CachedProcessorComponentCount = ComponentCount;
+	CachedProcessorPlayerControllers.Reset();
+	CachedLoadingProcessors.Reset();
+
+	auto AddIfLoadingProcessor = [this](UObject* TestObject)
+	{
+		if (Cast<ILoadingProcessInterface>(TestObject) != nullptr)
+		{
+			CachedLoadingProcessors.Add(TestObject);
+		}
+	};
+
+	AddIfLoadingProcessor(GameState);
+	for (UActorComponent* TestComponent : GameState->GetComponents())
+	{
+		AddIfLoadingProcessor(TestComponent);
+	}
+
+	// External loading processors may be actors or components that were registered by game code to tell us to keep
+	// the loading screen up while perhaps something finishes streaming in
+	for (const TWeakInterfacePtr<ILoadingProcessInterface>& Processor : ExternalLoadingProcessors)
+	{
+		AddIfLoadingProcessor(Processor.GetObject());
+	}
+
+	for (ULocalPlayer* LP : LocalGameInstance->GetLocalPlayers())
+	{
+		if (APlayerController* PC = (LP != nullptr) ? LP->PlayerController.Get() : nullptr)
+		{
+			CachedProcessorPlayerControllers.Add(PC);
+
+			AddIfLoadingProcessor(PC);
+			for (UActorComponent* TestComponent : PC->GetComponents())
+			{
+				AddIfLoadingProcessor(TestComponent);
+			}
+		}
+	}
+
+	UE_LOG(LogLoadingScreen, Verbose, TEXT("Found %d loading processor(s)"), CachedLoadingProcessors.Num());
+}
+
 bool ULoadingScreenManager::ShouldShowLoadingScreen()
 {
 	const UCommonLoadingScreenSettings* Settings = GetDefault<UCommonLoadingScreenSettings>();
@@ -404,7 +511,7 @@ bool ULoadingScreenManager::ShouldShowLoadingScreen()
 	static bool bCmdLineNoLoadingScreen = FParse::Param(FCommandLine::Get(), TEXT("NoLoadingScreen"));
 	if (bCmdLineNoLoadingScreen)
 	{
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("CommandLine has 'NoLoadingScreen'"));
+		SetDebugReason(TEXT("CommandLine has 'NoLoadingScreen'"));
 		return false;
 	}
 #endif
@@ -440,7 +547,15 @@ bool ULoadingScreenManager::ShouldShowLoadingScreen()
 			UGameViewportClient* GameViewportClient = GetGameInstance()->GetGameViewportClient();
 			GameViewportClient->bDisableWorldRendering = false;
 
-			DebugReasonForShowingOrHidingLoadingScreen = FString::Printf(TEXT("Keeping loading screen up for an additional %.2f seconds to allow texture streaming"), HoldLoadingScreenAdditionalSecs);
+			if (bBuildDetailedDebugReasons)
+			{
+				DebugReasonForShowingOrHidingLoadingScreen = FString::Printf(TEXT("Keeping loading screen up for an additional %.2f seconds to allow texture streaming"), HoldLoadingScreenAdditionalSecs);
+				SetDebugReason(nullptr);
+			}
+			else
+			{
+				SetDebugReason(TEXT("Keeping loading screen up for additional time to allow texture streaming"));
+			}
 			bWantToForceShowLoadingScreen = true;
 		}
 	}
@@ -478,12 +593,12 @@ void ULoadingScreenManager::ShowLoadingScreen()
 	if (IsShowingInitialLoadingScreen())
 	{
 		UE_LOG(LogLoadingScreen, Log, TEXT("Showing loading screen when 'IsShowingInitialLoadingScreen()' is true."));
-		UE_LOG(LogLoadingScreen, Log, TEXT("%s"), *DebugReasonForShowingOrHidingLoadingScreen);
+		UE_LOG(LogLoadingScreen, Log, TEXT("%s"), *GetDebugReasonForShowingOrHidingLoadingScreen());
 	}
 	else
 	{
 		UE_LOG(LogLoadingScreen, Log, TEXT("Showing loading screen when 'IsShowingInitialLoadingScreen()' is false."));
-		UE_LOG(LogLoadingScreen, Log, TEXT("%s"), *DebugReasonForShowingOrHidingLoadingScreen);
+		UE_LOG(LogLoadingScreen, Log, TEXT("%s"), *GetDebugReasonForShowingOrHidingLoadingScreen());
 
 		UGameInstance* LocalGameInstance = GetGameInstance();
 
@@ -530,12 +645,12 @@ void ULoadingScreenManager::HideLoadingScreen()
 	if (IsShowingInitialLoadingScreen())
 	{
 		UE_LOG(LogLoadingScreen, Log, TEXT("Hiding loading screen when 'IsShowingInitialLoadingScreen()' is true."));
-		UE_LOG(LogLoadingScreen, Log, TEXT("%s"), *DebugReasonForShowingOrHidingLoadingScreen);
+		UE_LOG(LogLoadingScreen, Log, TEXT("%s"), *GetDebugReasonForShowingOrHidingLoadingScreen());
 	}
 	else
 	{
 		UE_LOG(LogLoadingScreen, Log, TEXT("Hiding loading screen when 'IsShowingInitialLoadingScreen()' is false."));
-		UE_LOG(LogLoadingScreen, Log, TEXT("%s"), *DebugReasonForShowingOrHidingLoadingScreen);
+		UE_LOG(LogLoadingScreen, Log, TEXT("%s"), *GetDebugReasonForShowingOrHidingLoadingScreen());
 
 		UE_LOG(LogLoadingScreen, Log, TEXT("Garbage Collecting before dropping load screen"));
 		GEngine->ForceGarbageCollection(true);
@@ -21,7 +21,8 @@
 		ULoadingProcessTask* NewLoadingTask = NewObject<ULoadingProcessTask>(LoadingScreenManager);
 		NewLoadingTask->SetShowLoadingScreenReason(ShowLoadingScreenReason);
 
-		LoadingScreenManager->RegisterLoadingProcessor(NewLoadingTask);
+		// Push the state to the manager rather than registering as a processor that has to be polled
+		NewLoadingTask->StillLoadingToken = LoadingScreenManager->AcquireStillLoadingToken(ShowLoadingScreenReason);
 		
 		return NewLoadingTask;
 	}
@@ -29,15 +30,44 @@
 	return nullptr;
 }
 
+void ULoadingProcessTask::BeginDestroy()
+{
+	// Nothing else references the task once Blueprint lets go of it, so make sure a forgotten task can't hold the loading screen up forever
+	Unregister();
+
+	Super::BeginDestroy();
+}
+
 void ULoadingProcessTask::Unregister()
 {
 	ULoadingScreenManager* LoadingScreenManager = Cast<ULoadingScreenManager>(GetOuter());
+	if (LoadingScreenManager == nullptr)
+	{
+		StillLoadingToken = 0;
+		return;
+	}
+
+	if (StillLoadingToken != 0)
+	{
+		LoadingScreenManager->ReleaseStillLoadingToken(StillLoadingToken);
+		StillLoadingToken = 0;
+	}
+
+	// In case this task was also registered as a processor directly
 	LoadingScreenManager->UnregisterLoadingProcessor(this);
 }
 
 void ULoadingProcessTask::SetShowLoadingScreenReason(const FString& InReason)
 {
 	Reason = InReason;
+
+	if (StillLoadingToken != 0)
+	{
+		if (ULoadingScreenManager* LoadingScreenManager = Cast<ULoadingScreenManager>(GetOuter()))
+		{
+			LoadingScreenManager->UpdateStillLoadingToken(StillLoadingToken, Reason);
+		}
+	}
 }
 
 bool ULoadingProcessTask::ShouldShowLoadingScreen(FString& OutReason) const
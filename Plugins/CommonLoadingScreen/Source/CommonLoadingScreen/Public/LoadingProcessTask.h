@@ -21,6 +21,10 @@ public:
 public:
 	ULoadingProcessTask() { }
 
+	//~UObject interface
+	virtual void BeginDestroy() override;
+	//~End of UObject interface
+
 	UFUNCTION(BlueprintCallable)
 	void Unregister();
 
@@ -30,4 +34,8 @@ public:
 	virtual bool ShouldShowLoadingScreen(FString& OutReason) const override;
 	
 	FString Reason;
+
+private:
+	// Token held with the loading screen manager while this task is registered (0 if not registered)
+	uint32 StillLoadingToken = 0;
 };
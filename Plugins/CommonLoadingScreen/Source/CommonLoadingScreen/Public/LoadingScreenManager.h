@@ -11,6 +11,8 @@
 template <typename InterfaceType> class TScriptInterface;
 
 class FSubsystemCollectionBase;
+class AGameStateBase;
+class APlayerController;
 class IInputProcessor;
 class ILoadingProcessInterface;
 class SWidget;
@@ -45,7 +47,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category=LoadingScreen)
 	FString GetDebugReasonForShowingOrHidingLoadingScreen() const
 	{
-		return DebugReasonForShowingOrHidingLoadingScreen;
+		return (DebugReasonLiteral != nullptr) ? FString(DebugReasonLiteral) : DebugReasonForShowingOrHidingLoadingScreen;
 	}
 
 	/** Returns True when the loading screen is currently being shown */
@@ -60,6 +62,25 @@ public:
 
 	void RegisterLoadingProcessor(TScriptInterface<ILoadingProcessInterface> Interface);
 	void UnregisterLoadingProcessor(TScriptInterface<ILoadingProcessInterface> Interface);
+
+	/**
+	 * Keeps the loading screen up until the returned token is released. This is the preferred way for loading work to
+	 * report its state, as the manager doesn't need to poll anything while a token is held.
+	 * Returns a token that must be passed to ReleaseStillLoadingToken (0 is never a valid token)
+	 */
+	uint32 AcquireStillLoadingToken(const FString& Reason);
+
+	/** Changes the reason reported for a token acquired with AcquireStillLoadingToken */
+	void UpdateStillLoadingToken(uint32 Token, const FString& Reason);
+
+	/** Releases a token acquired with AcquireStillLoadingToken, the loading screen may go away once none are left */
+	void ReleaseStillLoadingToken(uint32 Token);
+
+	/**
+	 * Lets the manager know that the set of loading processors (or components implementing ILoadingProcessInterface on
+	 * the game state or local player controllers) has changed, so it must look for them again
+	 */
+	void NotifyLoadingProcessorsChanged();
 	
 private:
 	void HandlePreLoadMap(const FWorldContext& WorldContext, const FString& MapName);
@@ -71,6 +92,18 @@ private:
 	/** Returns true if we need to be showing the loading screen. */
 	bool CheckForAnyNeedToShowLoadingScreen();
 
+	/** Returns true if any of the objects implementing ILoadingProcessInterface wants the loading screen */
+	bool CheckLoadingProcessors(AGameStateBase* GameState);
+
+	/** Rebuilds CachedLoadingProcessors if the game state, local player controllers or their components have changed */
+	void RefreshCachedLoadingProcessors(AGameStateBase* GameState);
+
+	/** Sets the reason for showing or hiding the loading screen, the literal must have static lifetime */
+	void SetDebugReason(const TCHAR* InReasonLiteral)
+	{
+		DebugReasonLiteral = InReasonLiteral;
+	}
+
 	/** Returns true if we want to be showing the loading screen (if we need to or are artificially forcing it on for other reasons). */
 	bool ShouldShowLoadingScreen();
 
@@ -107,9 +140,28 @@ private:
 	/** External loading processors, components maybe actors that delay the loading. */
 	TArray<TWeakInterfacePtr<ILoadingProcessInterface>> ExternalLoadingProcessors;
 
-	/** The reason why the loading screen is up (or not) */
+	/** Reasons to keep the loading screen up that were pushed via AcquireStillLoadingToken, keyed by token */
+	TMap<uint32, FString> StillLoadingTokens;
+	uint32 NextStillLoadingToken = 1;
+
+	/** Objects that implement ILoadingProcessInterface, in the order they are asked (game state, its components, external processors, then each local player controller and its components) */
+	TArray<TWeakObjectPtr<UObject>> CachedLoadingProcessors;
+
+	/** What CachedLoadingProcessors was built from, used to notice when it needs rebuilding */
+	TWeakObjectPtr<AGameStateBase> CachedProcessorGameState;
+	TArray<TWeakObjectPtr<APlayerController>> CachedProcessorPlayerControllers;
+	int32 CachedProcessorComponentCount = 0;
+	bool bLoadingProcessorsDirty = true;
+
+	/** The reason why the loading screen is up (or not), when it isn't one of the static reasons in DebugReasonLiteral (also reused as the out parameter when polling loading processors) */
 	FString DebugReasonForShowingOrHidingLoadingScreen;
 
+	/** The reason why the loading screen is up (or not), if it's a static string; takes priority over DebugReasonForShowingOrHidingLoadingScreen */
+	const TCHAR* DebugReasonLiteral = nullptr;
+
+	/** True if the current update should build detailed (formatted) reason strings because they will be logged */
+	bool bBuildDetailedDebugReasons = false;
+
 	/** The time when we started showing the loading screen */
 	double TimeLoadingScreenShown = 0.0;
 
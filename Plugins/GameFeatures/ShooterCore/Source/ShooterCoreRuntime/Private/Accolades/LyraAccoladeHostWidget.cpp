@@ -2,7 +2,11 @@
 
 #include "Accolades/LyraAccoladeHostWidget.h"
 
+#include "Algo/AnyOf.h"
+#include "DataRegistry.h"
 #include "DataRegistrySubsystem.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "LyraLogChannels.h"
 #include "Messages/LyraNotificationMessage.h"
 #include "Sound/SoundBase.h"
@@ -22,6 +26,8 @@ void ULyraAccoladeHostWidget::NativeConstruct()
 
 	UGameplayMessageSubsystem& MessageSubsystem = UGameplayMessageSubsystem::Get(this);
 	ListenerHandle = MessageSubsystem.RegisterListener(TAG_Lyra_AddNotification_Message, this, &ThisClass::OnNotificationMessage);
+
+	StartPrefetch();
 }
 
 void ULyraAccoladeHostWidget::NativeDestruct()
@@ -31,9 +37,136 @@ void ULyraAccoladeHostWidget::NativeDestruct()
 
 	CancelAsyncLoading();
 
+	// The prefetch only has to be done again if it was canceled part way through
+	const bool bPrefetchIncomplete = (NumPrefetchRowsPending > 0) || Algo::AnyOf(PrefetchedAccolades, [](const TPair<FName, FPendingAccoladeEntry>& Pair) { return !Pair.Value.bFinishedLoading; });
+	if (bPrefetchIncomplete)
+	{
+		CancelPrefetch();
+	}
+
+	for (UUserWidget* PooledWidget : PooledAccoladeWidgets)
+	{
+		DestroyAccoladeWidget(PooledWidget);
+	}
+	PooledAccoladeWidgets.Reset();
+
 	Super::NativeDestruct();
 }
 
+void ULyraAccoladeHostWidget::StartPrefetch()
+{
+	if (bPrefetchStarted)
+	{
+		return;
+	}
+	bPrefetchStarted = true;
+	++PrefetchGeneration;
+	PrefetchedAccolades.Reset();
+
+	const UDataRegistry* Registry = UDataRegistrySubsystem::Get()->GetRegistryForType(NAME_AccoladeRegistryID);
+	if (Registry == nullptr)
+	{
+		return;
+	}
+
+	TArray<FDataRegistryId> AccoladeIDs;
+	Registry->GetPossibleRegistryIds(/*out*/ AccoladeIDs, /*bSortForDisplay=*/ false);
+
+	// Request every row at once, the callbacks can come back in any order
+	NumPrefetchRowsPending = AccoladeIDs.Num();
+	for (const FDataRegistryId& AccoladeID : AccoladeIDs)
+	{
+		if (!UDataRegistrySubsystem::Get()->AcquireItem(AccoladeID, FDataRegistryItemAcquiredCallback::CreateUObject(this, &ThisClass::OnPrefetchRowAcquired, PrefetchGeneration)))
+		{
+			--NumPrefetchRowsPending;
+		}
+	}
+
+	if (NumPrefetchRowsPending == 0)
+	{
+		LoadPrefetchedAssets();
+	}
+}
+
+void ULyraAccoladeHostWidget::CancelPrefetch()
+{
+	if (PrefetchHandle.IsValid())
+	{
+		PrefetchHandle->CancelHandle();
+		PrefetchHandle.Reset();
+	}
+
+	++PrefetchGeneration;
+	bPrefetchStarted = false;
+	NumPrefetchRowsPending = 0;
+}
+
+void ULyraAccoladeHostWidget::OnPrefetchRowAcquired(const FDataRegistryAcquireResult& AccoladeHandle, int32 Generation)
+{
+	// Rows requested by a canceled prefetch can still come back after a new one has started
+	if ((Generation != PrefetchGeneration) || (NumPrefetchRowsPending <= 0))
+	{
+		return;
+	}
+
+	if (const FLyraAccoladeDefinitionRow* AccoladeRow = AccoladeHandle.GetItem<FLyraAccoladeDefinitionRow>())
+	{
+		FPendingAccoladeEntry& PrefetchedEntry = PrefetchedAccolades.Add(AccoladeHandle.ItemId.ItemName);
+		PrefetchedEntry.Row = *AccoladeRow;
+
+		// Accolades for other locations are dropped by ProcessLoadedAccolade, so there's nothing of theirs to load
+		PrefetchedEntry.bFinishedLoading = (AccoladeRow->LocationTag != LocationName);
+	}
+
+	if (--NumPrefetchRowsPending == 0)
+	{
+		LoadPrefetchedAssets();
+	}
+}
+
+void ULyraAccoladeHostWidget::LoadPrefetchedAssets()
+{
+	TArray<FSoftObjectPath> AssetsToLoad;
+	for (const TPair<FName, FPendingAccoladeEntry>& Pair : PrefetchedAccolades)
+	{
+		if (!Pair.Value.bFinishedLoading)
+		{
+			AssetsToLoad.Add(Pair.Value.Row.Sound.ToSoftObjectPath());
+			AssetsToLoad.Add(Pair.Value.Row.Icon.ToSoftObjectPath());
+		}
+	}
+
+	if (AssetsToLoad.Num() == 0)
+	{
+		return;
+	}
+
+	// One request for everything, the entries hold on to the loaded assets afterwards
+	PrefetchHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetsToLoad,
+		FStreamableDelegate::CreateUObject(this, &ThisClass::OnPrefetchedAssetsLoaded, PrefetchGeneration));
+}
+
+void ULyraAccoladeHostWidget::OnPrefetchedAssetsLoaded(int32 Generation)
+{
+	if (Generation != PrefetchGeneration)
+	{
+		return;
+	}
+
+	for (TPair<FName, FPendingAccoladeEntry>& Pair : PrefetchedAccolades)
+	{
+		FPendingAccoladeEntry& PrefetchedEntry = Pair.Value;
+		if (!PrefetchedEntry.bFinishedLoading)
+		{
+			PrefetchedEntry.Sound = PrefetchedEntry.Row.Sound.Get();
+			PrefetchedEntry.Icon = PrefetchedEntry.Row.Icon.Get();
+			PrefetchedEntry.bFinishedLoading = true;
+		}
+	}
+
+	PrefetchHandle.Reset();
+}
+
 void ULyraAccoladeHostWidget::OnNotificationMessage(FGameplayTag Channel, const FLyraNotificationMessage& Notification)
 {
 	if (Notification.TargetChannel == TAG_Lyra_ShooterGame_Accolade)
@@ -48,10 +181,22 @@ void ULyraAccoladeHostWidget::OnNotificationMessage(FGameplayTag Channel, const
 			}
 		}
 
-		// Load the data registry row for this accolade
 		const int32 NextID = AllocatedSequenceID;
 		++AllocatedSequenceID;
 
+		// Prefetched accolades are ready to go, they still go through the pending list so they display in order
+		if (const FPendingAccoladeEntry* PrefetchedEntry = PrefetchedAccolades.Find(Notification.PayloadTag.GetTagName()))
+		{
+			if (PrefetchedEntry->bFinishedLoading)
+			{
+				FPendingAccoladeEntry& PendingEntry = PendingAccoladeLoads.Add_GetRef(*PrefetchedEntry);
+				PendingEntry.SequenceID = NextID;
+				ConsiderLoadedAccolades();
+				return;
+			}
+		}
+
+		// Load the data registry row for this accolade
 		FDataRegistryId ItemID(NAME_AccoladeRegistryID, Notification.PayloadTag.GetTagName());
 		if (!UDataRegistrySubsystem::Get()->AcquireItem(ItemID, FDataRegistryItemAcquiredCallback::CreateUObject(this, &ThisClass::OnRegistryLoadCompleted, NextID)))
 		{
@@ -119,7 +264,7 @@ void ULyraAccoladeHostWidget::ProcessLoadedAccolade(const FPendingAccoladeEntry&
 			{
 				if (UUserWidget* OldWidget = PendingAccoladeDisplays[Index].AllocatedWidget)
 				{
-					DestroyAccoladeWidget(OldWidget);
+					ReleaseAccoladeWidget(OldWidget);
 					bRecreateWidget = true;
 				}
 				PendingAccoladeDisplays.RemoveAt(Index);
@@ -146,7 +291,7 @@ void ULyraAccoladeHostWidget::DisplayNextAccolade()
 		FPendingAccoladeEntry& Entry = PendingAccoladeDisplays[0];
 
 		GetWorld()->GetTimerManager().SetTimer(NextTimeToReconsiderHandle, this, &ThisClass::PopDisplayedAccolade, Entry.Row.DisplayDuration);
-		Entry.AllocatedWidget = CreateAccoladeWidget(Entry);
+		Entry.AllocatedWidget = AcquireAccoladeWidget(Entry);
 	}
 }
 
@@ -156,7 +301,7 @@ void ULyraAccoladeHostWidget::PopDisplayedAccolade()
 	{
 		if (UUserWidget* OldWidget = PendingAccoladeDisplays[0].AllocatedWidget)
 		{
-			DestroyAccoladeWidget(OldWidget);
+			ReleaseAccoladeWidget(OldWidget);
 		}
 		PendingAccoladeDisplays.RemoveAt(0);
 	}
@@ -164,3 +309,63 @@ void ULyraAccoladeHostWidget::PopDisplayedAccolade()
 	DisplayNextAccolade();
 }
 
+UUserWidget* ULyraAccoladeHostWidget::AcquireAccoladeWidget(const FPendingAccoladeEntry& Entry)
+{
+	while (PooledAccoladeWidgets.Num() > 0)
+	{
+		UUserWidget* PooledWidget = PooledAccoladeWidgets.Pop();
+		if (PooledWidget && ReuseAccoladeWidget(PooledWidget, Entry))
+		{
+			return PooledWidget;
+		}
+
+		if (PooledWidget)
+		{
+			DestroyAccoladeWidget(PooledWidget);
+		}
+	}
+
+	return CreateAccoladeWidget(Entry);
+}
+
+void ULyraAccoladeHostWidget::ReleaseAccoladeWidget(UUserWidget* Widget)
+{
+	if ((PooledAccoladeWidgets.Num() < MaxPooledAccoladeWidgets) && ReleaseAccoladeWidgetToPool(Widget))
+	{
+		PooledAccoladeWidgets.Add(Widget);
+	}
+	else
+	{
+		DestroyAccoladeWidget(Widget);
+	}
+}
+
+bool ULyraAccoladeHostWidget::CanPoolAccoladeWidgets() const
+{
+	// A pooled widget still shows the accolade it was created for until it's set up again
+	return GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(ULyraAccoladeHostWidget, ReinitializeAccoladeWidget));
+}
+
+bool ULyraAccoladeHostWidget::ReuseAccoladeWidget_Implementation(UUserWidget* Widget, const FPendingAccoladeEntry& Entry)
+{
+	if (!CanPoolAccoladeWidgets())
+	{
+		return false;
+	}
+
+	ReinitializeAccoladeWidget(Widget, Entry);
+	Widget->SetVisibility(ESlateVisibility::SelfHitTestInvisible);
+	return true;
+}
+
+bool ULyraAccoladeHostWidget::ReleaseAccoladeWidgetToPool_Implementation(UUserWidget* Widget)
+{
+	if (!CanPoolAccoladeWidgets())
+	{
+		return false;
+	}
+
+	// Stays in its container, just collapsed so it doesn't take up any space
+	Widget->SetVisibility(ESlateVisibility::Collapsed);
+	return true;
+}
@@ -25,6 +25,13 @@ namespace LyraConsoleVariables
 		bDrawDebugViewfinder,
 		TEXT("Should we draw a debug box for the aim assist target viewfinder?"),
 		ECVF_Cheat);
+
+	static bool bAsyncTargetQuery = true;
+	static FAutoConsoleVariableRef CVarAsyncTargetQuery(
+		TEXT("lyra.Weapon.AimAssist.AsyncTargetQuery"),
+		bAsyncTargetQuery,
+		TEXT("Should aim assist targets be gathered from last frame's batched async overlap instead of a blocking overlap per player?"),
+		ECVF_Default);
 }
 
 const FLyraAimAssistTarget* FindTarget(const TArray<FLyraAimAssistTarget>& Targets, const UShapeComponent* TargetComponent)
@@ -118,29 +125,8 @@ void UAimAssistTargetManagerComponent::GetVisibleTargets(const FAimAssistFilter&
 	const FBox2D AssistOuterReticleBounds = OwnerData.ProjectReticleToScreen(Settings.AssistOuterReticleWidth.GetValue(), Settings.AssistOuterReticleHeight.GetValue(), ReticleDepth);
 	const FBox2D TargetingReticleBounds = OwnerData.ProjectReticleToScreen(Settings.TargetingReticleWidth.GetValue(), Settings.TargetingReticleHeight.GetValue(), ReticleDepth);
 
-	static TArray<FOverlapResult> OverlapResults;
-	// Do a world trace on the Aim Assist channel to get any visible targets
-	{
-		UWorld* World = GetWorld();
-		
-		OverlapResults.Reset();
-
-		const FVector PawnLocation = OwnerPawn->GetActorLocation();
-		ECollisionChannel AimAssistChannel = GetAimAssistChannel();
-		FCollisionQueryParams Params(SCENE_QUERY_STAT(AimAssist_QueryTargetsInRange), true);
-		Params.AddIgnoredActor(OwnerPawn);
-
-		// Need to multiply these by 0.5 because MakeBox takes in half extents
-		FCollisionShape BoxShape = FCollisionShape::MakeBox(FVector3f(ReticleDepth * 0.5f, Settings.AssistOuterReticleWidth.GetValue() * 0.5f, Settings.AssistOuterReticleHeight.GetValue() * 0.5f));						
-		World->OverlapMultiByChannel(OUT OverlapResults, PawnLocation, OwnerData.PlayerTransform.GetRotation(), AimAssistChannel, BoxShape, Params);
-
-#if ENABLE_DRAW_DEBUG && !UE_BUILD_SHIPPING
-		if(LyraConsoleVariables::bDrawDebugViewfinder)
-		{
-			DrawDebugBox(World, PawnLocation, BoxShape.GetBox(), OwnerData.PlayerTransform.GetRotation(), FColor::Red);	
-		}
-#endif
-	}
+	TArray<FOverlapResult> OverlapResults;
+	GatherOverlaps(*OwnerPawn, Settings, OwnerData, ReticleDepth, OverlapResults);
 
 	// Gather target options from any visibile hit results that implement the IAimAssistTarget interface
 	TArray<FAimAssistTargetOptions> NewTargetData;
@@ -164,96 +150,112 @@ void UAimAssistTargetManagerComponent::GetVisibleTargets(const FAimAssistFilter&
 			}			
 		}
 	}
-	
-	// Gather targets that are in front of the player
+
+	// Flatten the targets that pass the filter so the view checks below run over contiguous arrays
+	const int32 MaxCandidates = NewTargetData.Num();
+	TArray<const FAimAssistTargetOptions*, TInlineAllocator<32>> CandidateOptions;
+	TArray<FTransform, TInlineAllocator<32>> CandidateTransforms;
+	TArray<FCollisionShape, TInlineAllocator<32>> CandidateShapes;
+	TArray<FVector, TInlineAllocator<32>> CandidateShapeOrigins;
+	TArray<FVector, TInlineAllocator<32>> CandidateViewLocations;
+	CandidateOptions.Reserve(MaxCandidates);
+	CandidateTransforms.Reserve(MaxCandidates);
+	CandidateShapes.Reserve(MaxCandidates);
+	CandidateShapeOrigins.Reserve(MaxCandidates);
+	CandidateViewLocations.Reserve(MaxCandidates);
+
+	for (const FAimAssistTargetOptions& AimAssistTarget : NewTargetData)
 	{
-		const FVector PawnLocation = OwnerPawn->GetActorLocation();		
-		
-		for (FAimAssistTargetOptions& AimAssistTarget : NewTargetData)
+		if (!DoesTargetPassFilter(OwnerData, Filter, AimAssistTarget, TargetRange))
 		{
-			if (!DoesTargetPassFilter(OwnerData, Filter, AimAssistTarget, TargetRange))
-			{
-				continue;
-			}
-			
-			AActor* OwningActor = AimAssistTarget.TargetShapeComponent->GetOwner();
+			continue;
+		}
 
-			FTransform TargetTransform;
-			FCollisionShape TargetShape;
-			FVector TargetShapeOrigin;
+		FTransform TargetTransform;
+		FCollisionShape TargetShape;
+		FVector TargetShapeOrigin;
 
-			if (!GatherTargetInfo(OwningActor, AimAssistTarget.TargetShapeComponent.Get(), TargetTransform, TargetShape, TargetShapeOrigin))
-			{
-				continue;
-			}
-			
-			const FVector TargetViewLocation = TargetTransform.TransformPositionNoScale(TargetShapeOrigin);
-			const FVector TargetViewVector = (TargetViewLocation - ViewLocation);
-
-			FVector TargetViewDirection;
-			float TargetViewDistance;
-			TargetViewVector.ToDirectionAndLength(TargetViewDirection, TargetViewDistance);
-			const float TargetViewDot = FVector::DotProduct(TargetViewDirection, ViewForward);
-			if (TargetViewDot <= 0.0f)
-			{
-				continue;
-			}
-			
-			const FLyraAimAssistTarget* OldTarget = FindTarget(OldTargets, AimAssistTarget.TargetShapeComponent.Get());
+		if (!GatherTargetInfo(AimAssistTarget.TargetShapeComponent->GetOwner(), AimAssistTarget.TargetShapeComponent.Get(), TargetTransform, TargetShape, TargetShapeOrigin))
+		{
+			continue;
+		}
 
-			// Calculate the screen bounds for this target
-			FBox2D TargetScreenBounds(ForceInitToZero);
-			const bool bUpdateTargetProjections = true;
-			if (bUpdateTargetProjections)
-			{
-				TargetScreenBounds = OwnerData.ProjectShapeToScreen(TargetShape, TargetShapeOrigin, TargetTransform);
-			}
-			else
-			{
-				// Target projections are not being updated so use the values from the previous frame if the target existed.
-				if (OldTarget)
-				{
-					TargetScreenBounds = OldTarget->ScreenBounds;
-				}
-			}
+		CandidateOptions.Add(&AimAssistTarget);
+		CandidateViewLocations.Add(TargetTransform.TransformPositionNoScale(TargetShapeOrigin));
+		CandidateTransforms.Add(TargetTransform);
+		CandidateShapes.Add(TargetShape);
+		CandidateShapeOrigins.Add(TargetShapeOrigin);
+	}
 
-			if (!TargetScreenBounds.bIsValid)
-			{
-				continue;
-			}
+	// Branch-free distance and facing for every candidate
+	const int32 NumCandidates = CandidateOptions.Num();
+	TArray<float, TInlineAllocator<32>> CandidateViewDistances;
+	TArray<float, TInlineAllocator<32>> CandidateViewDots;
+	CandidateViewDistances.SetNumUninitialized(NumCandidates);
+	CandidateViewDots.SetNumUninitialized(NumCandidates);
 
-			if (!TargetingReticleBounds.Intersect(TargetScreenBounds))
-			{
-				continue;
-			}
+	for (int32 Index = 0; Index < NumCandidates; ++Index)
+	{
+		const FVector TargetViewVector = (CandidateViewLocations[Index] - ViewLocation);
+		const double TargetViewDistance = TargetViewVector.Size();
+		CandidateViewDistances[Index] = (float)TargetViewDistance;
+		CandidateViewDots[Index] = (float)(FVector::DotProduct(TargetViewVector, ViewForward) / FMath::Max(TargetViewDistance, UE_SMALL_NUMBER));
+	}
 
-			FLyraAimAssistTarget NewTarget;
+	// Project the targets that are in front of the player
+	for (int32 Index = 0; Index < NumCandidates; ++Index)
+	{
+		const float TargetViewDot = CandidateViewDots[Index];
+		if (TargetViewDot <= 0.0f)
+		{
+			continue;
+		}
 
-			NewTarget.TargetShapeComponent = AimAssistTarget.TargetShapeComponent;
-			NewTarget.Location = TargetTransform.GetTranslation();
-			NewTarget.ScreenBounds = TargetScreenBounds;
-			NewTarget.ViewDistance = TargetViewDistance;
-			NewTarget.bUnderAssistInnerReticle = AssistInnerReticleBounds.Intersect(TargetScreenBounds);
-			NewTarget.bUnderAssistOuterReticle = AssistOuterReticleBounds.Intersect(TargetScreenBounds);
-			
-			// Transfer target data from last frame.
-			if (OldTarget)
-			{
-				NewTarget.DeltaMovement = (NewTarget.Location - OldTarget->Location);
-				NewTarget.AssistTime = OldTarget->AssistTime;
-				NewTarget.AssistWeight = OldTarget->AssistWeight;
-				NewTarget.VisibilityTraceHandle = OldTarget->VisibilityTraceHandle;
-			}
+		const FAimAssistTargetOptions& AimAssistTarget = *CandidateOptions[Index];
+		const FTransform& TargetTransform = CandidateTransforms[Index];
+		const float TargetViewDistance = CandidateViewDistances[Index];
+
+		const FLyraAimAssistTarget* OldTarget = FindTarget(OldTargets, AimAssistTarget.TargetShapeComponent.Get());
 
-			// Calculate a score used for sorting based on previous weight, distance from target, and distance from reticle.
-			const float AssistWeightScore = (NewTarget.AssistWeight * Settings.TargetScore_AssistWeight);
-			const float ViewDotScore = ((TargetViewDot * Settings.TargetScore_ViewDot) - Settings.TargetScore_ViewDotOffset);
-			const float ViewDistanceScore = ((1.0f - (TargetViewDistance / TargetRange)) * Settings.TargetScore_ViewDistance);
+		// Calculate the screen bounds for this target
+		const FBox2D TargetScreenBounds = OwnerData.ProjectShapeToScreen(CandidateShapes[Index], CandidateShapeOrigins[Index], TargetTransform);
 
-			NewTarget.SortScore = (AssistWeightScore + ViewDotScore + ViewDistanceScore);
+		if (!TargetScreenBounds.bIsValid)
+		{
+			continue;
+		}
 
-			OutNewTargets.Add(NewTarget);
+		if (!TargetingReticleBounds.Intersect(TargetScreenBounds))
+		{
+			continue;
 		}
+
+		FLyraAimAssistTarget NewTarget;
+
+		NewTarget.TargetShapeComponent = AimAssistTarget.TargetShapeComponent;
+		NewTarget.Location = TargetTransform.GetTranslation();
+		NewTarget.ScreenBounds = TargetScreenBounds;
+		NewTarget.ViewDistance = TargetViewDistance;
+		NewTarget.bUnderAssistInnerReticle = AssistInnerReticleBounds.Intersect(TargetScreenBounds);
+		NewTarget.bUnderAssistOuterReticle = AssistOuterReticleBounds.Intersect(TargetScreenBounds);
+		
+		// Transfer target data from last frame.
+		if (OldTarget)
+		{
+			NewTarget.DeltaMovement = (NewTarget.Location - OldTarget->Location);
+			NewTarget.AssistTime = OldTarget->AssistTime;
+			NewTarget.AssistWeight = OldTarget->AssistWeight;
+			NewTarget.VisibilityTraceHandle = OldTarget->VisibilityTraceHandle;
+		}
+
+		// Calculate a score used for sorting based on previous weight, distance from target, and distance from reticle.
+		const float AssistWeightScore = (NewTarget.AssistWeight * Settings.TargetScore_AssistWeight);
+		const float ViewDotScore = ((TargetViewDot * Settings.TargetScore_ViewDot) - Settings.TargetScore_ViewDotOffset);
+		const float ViewDistanceScore = ((1.0f - (TargetViewDistance / TargetRange)) * Settings.TargetScore_ViewDistance);
+
+		NewTarget.SortScore = (AssistWeightScore + ViewDotScore + ViewDistanceScore);
+
+		OutNewTargets.Add(NewTarget);
 	}
 
 	// Sort the targets by their score so if there are too many so we can limit the amount of visibility traces performed.
@@ -276,6 +278,64 @@ void UAimAssistTargetManagerComponent::GetVisibleTargets(const FAimAssistFilter&
 	}
 }
 
+void UAimAssistTargetManagerComponent::GatherOverlaps(const APawn& OwnerPawn, const FAimAssistSettings& Settings, const FAimAssistOwnerViewData& OwnerData, float ReticleDepth, TArray<FOverlapResult>& OutOverlaps)
+{
+	UWorld* World = GetWorld();
+	check(World);
+
+	const FVector PawnLocation = OwnerPawn.GetActorLocation();
+	const FQuat PawnRotation = OwnerData.PlayerTransform.GetRotation();
+	const ECollisionChannel AimAssistChannel = GetAimAssistChannel();
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(AimAssist_QueryTargetsInRange), true);
+	Params.AddIgnoredActor(&OwnerPawn);
+
+	// Need to multiply these by 0.5 because MakeBox takes in half extents
+	const FCollisionShape BoxShape = FCollisionShape::MakeBox(FVector3f(ReticleDepth * 0.5f, Settings.AssistOuterReticleWidth.GetValue() * 0.5f, Settings.AssistOuterReticleHeight.GetValue() * 0.5f));
+
+	bool bHasOverlaps = false;
+
+	if (LyraConsoleVariables::bAsyncTargetQuery)
+	{
+		for (auto It = PendingOverlapQueries.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		FTraceHandle& PendingQuery = PendingOverlapQueries.FindOrAdd(OwnerData.PlayerController);
+
+		// Targets are re-projected from their current transforms below, so a frame old overlap is fine for picking candidates
+		FOverlapDatum OverlapDatum;
+		if (PendingQuery.IsValid() && World->QueryOverlapData(PendingQuery, OverlapDatum))
+		{
+			OutOverlaps = MoveTemp(OverlapDatum.OutOverlaps);
+			bHasOverlaps = true;
+		}
+
+		// Async queries from every local player are run together as one batch at the end of the frame
+		PendingQuery = World->AsyncOverlapByChannel(PawnLocation, PawnRotation, AimAssistChannel, BoxShape, Params);
+	}
+	else
+	{
+		PendingOverlapQueries.Remove(OwnerData.PlayerController);
+	}
+
+	if (!bHasOverlaps)
+	{
+		// First update for this player, or async queries are disabled
+		World->OverlapMultiByChannel(OUT OutOverlaps, PawnLocation, PawnRotation, AimAssistChannel, BoxShape, Params);
+	}
+
+#if ENABLE_DRAW_DEBUG && !UE_BUILD_SHIPPING
+	if (LyraConsoleVariables::bDrawDebugViewfinder)
+	{
+		DrawDebugBox(World, PawnLocation, BoxShape.GetBox(), PawnRotation, FColor::Red);	
+	}
+#endif
+}
+
 bool UAimAssistTargetManagerComponent::DoesTargetPassFilter(const FAimAssistOwnerViewData& OwnerData, const FAimAssistFilter& Filter, const FAimAssistTargetOptions& Target, const float AcceptableRange) const
 {
 	const APawn* OwnerPawn = OwnerData.PlayerController ? OwnerData.PlayerController->GetPawn() : nullptr;
@@ -10,6 +10,10 @@ struct FInteractionQuery;
 
 ALyraWorldCollectable::ALyraWorldCollectable()
 {
+	PrimaryActorTick.bCanEverTick = false;
+
+	// The pickup contents never change after spawning, so there's nothing to replicate until it's collected
+	NetDormancy = DORM_Initial;
 }
 
 void ALyraWorldCollectable::GatherInteractionOptions(const FInteractionQuery& InteractQuery, FInteractionOptionBuilder& InteractionBuilder)
@@ -13,6 +13,13 @@ UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Lyra_Elimination_Message, "Lyra.Elimination.Me
 UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Lyra_Damage_Message, "Lyra.Damage.Message");
 UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Lyra_Assist_Message, "Lyra.Assist.Message");
 
+namespace AssistProcessor
+{
+	// Longest burst of hits from one player that is merged into a single damage event when there is an assist window.
+	// Merged damage counts as dealt at the last hit, so this is also how far past the window an assist can reach
+	static const double MaxMergeSeconds = 1.0;
+}
+
 void UAssistProcessor::StartListening()
 {
 	UGameplayMessageSubsystem& MessageSubsystem = UGameplayMessageSubsystem::Get(this);
@@ -20,6 +27,111 @@ void UAssistProcessor::StartListening()
 	AddListenerHandle(MessageSubsystem.RegisterListener(TAG_Lyra_Damage_Message, this, &ThisClass::OnDamageMessage));
 }
 
+//////////////////////////////////////////////////////////////////////
+// FPlayerAssistDamageTracking
+
+void FPlayerAssistDamageTracking::AddDamage(APlayerState* Instigator, float Damage, double Time, int32 Capacity, double MergeSeconds)
+{
+	if (RecentDamage.IsEmpty())
+	{
+		RecentDamage.SetNum(FMath::Max(Capacity, 1));
+	}
+	const int32 NumSlots = RecentDamage.Num();
+
+	if (Count > 0)
+	{
+		FPlayerAssistDamageEvent& Newest = RecentDamage[(Head + Count - 1) % NumSlots];
+		if ((Newest.Instigator == Instigator) && ((Time - Newest.Time) <= MergeSeconds))
+		{
+			Newest.Damage += Damage;
+			Newest.Time = Time;
+			return;
+		}
+	}
+
+	FPlayerAssistDamageEvent* NewEvent = nullptr;
+	if (Count < NumSlots)
+	{
+		NewEvent = &RecentDamage[(Head + Count) % NumSlots];
+		++Count;
+	}
+	else
+	{
+		// Full, so the oldest event makes room
+		NewEvent = &RecentDamage[Head];
+		Head = (Head + 1) % NumSlots;
+	}
+
+	NewEvent->Instigator = Instigator;
+	NewEvent->Damage = Damage;
+	NewEvent->Time = Time;
+}
+
+void FPlayerAssistDamageTracking::AccumulateDamageSince(double MinTime, TArray<TPair<APlayerState*, float>, TInlineAllocator<8>>& OutDamageByPlayer) const
+{
+	OutDamageByPlayer.Reset();
+
+	for (int32 Offset = 0; Offset < Count; ++Offset)
+	{
+		const FPlayerAssistDamageEvent& Event = RecentDamage[(Head + Offset) % RecentDamage.Num()];
+		if ((Event.Time < MinTime) || (Event.Instigator == nullptr))
+		{
+			continue;
+		}
+
+		// Only a handful of players damage any one target, so a linear search beats a map here
+		TPair<APlayerState*, float>* Entry = OutDamageByPlayer.FindByPredicate([&Event](const TPair<APlayerState*, float>& Existing) { return Existing.Key == Event.Instigator; });
+		if (Entry == nullptr)
+		{
+			Entry = &OutDamageByPlayer.Emplace_GetRef(Event.Instigator, 0.0f);
+		}
+		Entry->Value += Event.Damage;
+	}
+}
+
+void FPlayerAssistDamageTracking::Reset()
+{
+	// Don't hold on to the instigators of the events that are left in the buffer
+	for (int32 Offset = 0; Offset < Count; ++Offset)
+	{
+		RecentDamage[(Head + Offset) % RecentDamage.Num()].Instigator = nullptr;
+	}
+
+	Head = 0;
+	Count = 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// UAssistProcessor
+
+void UAssistProcessor::RecordDamage(APlayerState* Target, APlayerState* Instigator, float Damage, double Time)
+{
+	FPlayerAssistDamageTracking* DamageOnTarget = DamageHistory.Find(Target);
+	if (DamageOnTarget == nullptr)
+	{
+		DamageOnTarget = &DamageHistory.Add(Target);
+		Target->OnDestroyed.AddUniqueDynamic(this, &ThisClass::OnPlayerStateDestroyed);
+	}
+
+	// Without a window all damage since the last elimination counts, so any run of hits from one player can share an event
+	const double MergeSeconds = (AssistWindowSeconds > 0.0f) ? FMath::Min<double>(AssistWindowSeconds, AssistProcessor::MaxMergeSeconds) : UE_DOUBLE_BIG_NUMBER;
+	DamageOnTarget->AddDamage(Instigator, Damage, Time, MaxDamageEventsPerPlayer, MergeSeconds);
+}
+
+void UAssistProcessor::GatherAssists(APlayerState* Target, const UObject* Eliminator, double Time, TArray<TPair<APlayerState*, float>, TInlineAllocator<8>>& OutAssists) const
+{
+	OutAssists.Reset();
+
+	if (const FPlayerAssistDamageTracking* DamageOnTarget = DamageHistory.Find(Target))
+	{
+		const double MinTime = (AssistWindowSeconds > 0.0f) ? (Time - AssistWindowSeconds) : -UE_DOUBLE_BIG_NUMBER;
+		DamageOnTarget->AccumulateDamageSince(MinTime, OutAssists);
+
+		// The eliminator gets the elimination, not an assist
+		OutAssists.RemoveAll([Eliminator](const TPair<APlayerState*, float>& Assist) { return Assist.Key == Eliminator; });
+	}
+}
+
 void UAssistProcessor::OnDamageMessage(FGameplayTag Channel, const FLyraVerbMessage& Payload)
 {
 	if (Payload.Instigator != Payload.Target)
@@ -28,9 +140,7 @@ void UAssistProcessor::OnDamageMessage(FGameplayTag Channel, const FLyraVerbMess
 		{
 			if (APlayerState* TargetPS = ULyraVerbMessageHelpers::GetPlayerStateFromObject(Payload.Target))
 			{
-				FPlayerAssistDamageTracking& Damage = DamageHistory.FindOrAdd(TargetPS);
-				float& DamageTotalFromTarget = Damage.AccumulatedDamageByPlayer.FindOrAdd(InstigatorPS);
-				DamageTotalFromTarget += Payload.Magnitude;
+				RecordDamage(TargetPS, InstigatorPS, Payload.Magnitude, GetServerTime());
 			}
 		}
 	}
@@ -42,33 +152,35 @@ void UAssistProcessor::OnEliminationMessage(FGameplayTag Channel, const FLyraVer
 	if (APlayerState* TargetPS = Cast<APlayerState>(Payload.Target))
 	{
 		// Grant an assist to each player who damaged the target but wasn't the instigator
-		if (FPlayerAssistDamageTracking* DamageOnTarget = DamageHistory.Find(TargetPS))
+		TArray<TPair<APlayerState*, float>, TInlineAllocator<8>> Assists;
+		GatherAssists(TargetPS, Payload.Instigator, GetServerTime(), Assists);
+
+		for (const TPair<APlayerState*, float>& Assist : Assists)
 		{
-			for (const auto& KVP : DamageOnTarget->AccumulatedDamageByPlayer)
-			{
-				if (APlayerState* AssistPS = KVP.Key)
-				{
-					if (AssistPS != Payload.Instigator)
-					{
-						FLyraVerbMessage AssistMessage;
-						AssistMessage.Verb = TAG_Lyra_Assist_Message;
-						AssistMessage.Instigator = AssistPS;
-						//@TODO: Get default tags from a player state or save off most recent tags during assist damage?
-						//AssistMessage.InstigatorTags = ;
-						AssistMessage.Target = TargetPS;
-						AssistMessage.TargetTags = Payload.TargetTags;
-						AssistMessage.ContextTags = Payload.ContextTags;
-						AssistMessage.Magnitude = KVP.Value;
-
-						UGameplayMessageSubsystem& MessageSubsystem = UGameplayMessageSubsystem::Get(this);
-						MessageSubsystem.BroadcastMessage(AssistMessage.Verb, AssistMessage);
-					}
-				}
-			}
+			FLyraVerbMessage AssistMessage;
+			AssistMessage.Verb = TAG_Lyra_Assist_Message;
+			AssistMessage.Instigator = Assist.Key;
+			//@TODO: Get default tags from a player state or save off most recent tags during assist damage?
+			//AssistMessage.InstigatorTags = ;
+			AssistMessage.Target = TargetPS;
+			AssistMessage.TargetTags = Payload.TargetTags;
+			AssistMessage.ContextTags = Payload.ContextTags;
+			AssistMessage.Magnitude = Assist.Value;
 
-			// Clear the damage log for the eliminated player
-			DamageHistory.Remove(TargetPS);
+			UGameplayMessageSubsystem& MessageSubsystem = UGameplayMessageSubsystem::Get(this);
+			MessageSubsystem.BroadcastMessage(AssistMessage.Verb, AssistMessage);
+		}
+
+		// Their next life starts with a clean slate, reusing the buffer
+		if (FPlayerAssistDamageTracking* DamageOnTarget = DamageHistory.Find(TargetPS))
+		{
+			DamageOnTarget->Reset();
 		}
 	}
 }
 
+void UAssistProcessor::OnPlayerStateDestroyed(AActor* DestroyedActor)
+{
+	// Players who leave don't linger in the map
+	DamageHistory.Remove(Cast<APlayerState>(DestroyedActor));
+}
@@ -0,0 +1,201 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MessageProcessors/AssistProcessor.h"
+
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/GameplayMessageSubsystem.h"
+#include "GameFramework/PlayerState.h"
+#include "Messages/LyraVerbMessage.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace AssistProcessorTest
+{
+	using FAssistList = TArray<TPair<APlayerState*, float>, TInlineAllocator<8>>;
+
+	/** A standalone game instance (so the message subsystem exists) with an assist processor listening in its world */
+	struct FTestMatch
+	{
+		FTestMatch()
+		{
+			GameInstance = NewObject<UGameInstance>(GEngine);
+			GameInstance->AddToRoot();
+			GameInstance->InitializeStandalone();
+			World = GameInstance->GetWorld();
+
+			AActor* ProcessorOwner = World->SpawnActor<AActor>();
+			Processor = NewObject<UAssistProcessor>(ProcessorOwner);
+			Processor->RegisterComponent();
+			Processor->StartListening();
+
+			UGameplayMessageSubsystem::Get(World).RegisterListener<FLyraVerbMessage>(
+				FGameplayTag::RequestGameplayTag(TEXT("Lyra.Assist.Message")),
+				[this](FGameplayTag Channel, const FLyraVerbMessage& Message)
+				{
+					AssistMessages.Emplace(Cast<APlayerState>(Message.Instigator), (float)Message.Magnitude);
+				});
+		}
+
+		~FTestMatch()
+		{
+			GameInstance->Shutdown();
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+			GameInstance->RemoveFromRoot();
+		}
+
+		APlayerState* AddPlayer()
+		{
+			return World->SpawnActor<APlayerState>();
+		}
+
+		void Damage(APlayerState* Instigator, APlayerState* Target, float Damage)
+		{
+			FLyraVerbMessage Message;
+			Message.Verb = FGameplayTag::RequestGameplayTag(TEXT("Lyra.Damage.Message"));
+			Message.Instigator = Instigator;
+			Message.Target = Target;
+			Message.Magnitude = Damage;
+			UGameplayMessageSubsystem::Get(World).BroadcastMessage(Message.Verb, Message);
+		}
+
+		// Returns the assists that were broadcast for the elimination
+		FAssistList Eliminate(APlayerState* Instigator, APlayerState* Target)
+		{
+			AssistMessages.Reset();
+
+			FLyraVerbMessage Message;
+			Message.Verb = FGameplayTag::RequestGameplayTag(TEXT("Lyra.Elimination.Message"));
+			Message.Instigator = Instigator;
+			Message.Target = Target;
+			UGameplayMessageSubsystem::Get(World).BroadcastMessage(Message.Verb, Message);
+
+			return AssistMessages;
+		}
+
+		UGameInstance* GameInstance = nullptr;
+		UWorld* World = nullptr;
+		UAssistProcessor* Processor = nullptr;
+		FAssistList AssistMessages;
+	};
+
+	static bool TestAssists(FAutomationTestBase& Test, const TCHAR* What, const FAssistList& Actual, std::initializer_list<TPair<APlayerState*, float>> Expected)
+	{
+		bool bMatches = Test.TestEqual(FString::Printf(TEXT("%s: number of assists"), What), Actual.Num(), (int32)Expected.size());
+		int32 Index = 0;
+		for (const TPair<APlayerState*, float>& ExpectedAssist : Expected)
+		{
+			if (Actual.IsValidIndex(Index))
+			{
+				bMatches &= Test.TestTrue(FString::Printf(TEXT("%s: assist %d goes to the right player"), What, Index), Actual[Index].Key == ExpectedAssist.Key);
+				bMatches &= Test.TestEqual(FString::Printf(TEXT("%s: assist %d damage"), What, Index), Actual[Index].Value, ExpectedAssist.Value);
+			}
+			++Index;
+		}
+		return bMatches;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssistProcessorAttributionTest, "Lyra.ShooterCore.Assists.Attribution", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FAssistProcessorAttributionTest::RunTest(const FString& Parameters)
+{
+	using namespace AssistProcessorTest;
+
+	FTestMatch Match;
+	APlayerState* Victim = Match.AddPlayer();
+	APlayerState* A = Match.AddPlayer();
+	APlayerState* B = Match.AddPlayer();
+	APlayerState* C = Match.AddPlayer();
+
+	// Damage is summed per player and the eliminator doesn't get an assist
+	Match.Damage(A, Victim, 10.0f);
+	Match.Damage(B, Victim, 20.0f);
+	Match.Damage(A, Victim, 5.0f);
+	Match.Damage(C, Victim, 40.0f);
+	TestAssists(*this, TEXT("Summed per player"), Match.Eliminate(C, Victim), { MakeTuple(A, 15.0f), MakeTuple(B, 20.0f) });
+
+	// Self damage never counts
+	Match.Damage(Victim, Victim, 30.0f);
+	TestAssists(*this, TEXT("Self damage"), Match.Eliminate(A, Victim), {});
+
+	// An early attacker keeps their assist no matter how many hits come in after them
+	Match.Damage(A, Victim, 50.0f);
+	for (int32 HitIndex = 0; HitIndex < 100; ++HitIndex)
+	{
+		Match.Damage(B, Victim, 1.0f);
+	}
+	TestAssists(*this, TEXT("Early attacker"), Match.Eliminate(C, Victim), { MakeTuple(A, 50.0f), MakeTuple(B, 100.0f) });
+
+	// The elimination cleared the history, so the next life starts without assists
+	TestAssists(*this, TEXT("Next life"), Match.Eliminate(C, Victim), {});
+	TestTrue(TEXT("Eliminated players keep their history entry"), Match.Processor->DamageHistory.Contains(Victim));
+
+	// Damage to one player doesn't leak into another player's assists
+	Match.Damage(A, Victim, 10.0f);
+	Match.Damage(B, C, 10.0f);
+	TestAssists(*this, TEXT("Per target"), Match.Eliminate(A, C), { MakeTuple(B, 10.0f) });
+	TestAssists(*this, TEXT("Per target"), Match.Eliminate(B, Victim), { MakeTuple(A, 10.0f) });
+
+	// Players who leave are dropped from the history
+	Match.Damage(A, B, 10.0f);
+	B->Destroy();
+	TestFalse(TEXT("Destroyed player states are dropped"), Match.Processor->DamageHistory.Contains(B));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssistProcessorWindowTest, "Lyra.ShooterCore.Assists.Window", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FAssistProcessorWindowTest::RunTest(const FString& Parameters)
+{
+	using namespace AssistProcessorTest;
+
+	FTestMatch Match;
+	APlayerState* A = Match.AddPlayer();
+	APlayerState* B = Match.AddPlayer();
+
+	const float WindowSeconds = 5.0f;
+	const int32 Capacity = 4;
+	const double MergeSeconds = 1.0;
+	FPlayerAssistDamageTracking Tracking;
+	FAssistList DamageByPlayer;
+
+	// Only damage inside the window counts
+	Tracking.AddDamage(A, 10.0f, 0.0, Capacity, MergeSeconds);
+	Tracking.AddDamage(B, 20.0f, 3.0, Capacity, MergeSeconds);
+	Tracking.AddDamage(A, 5.0f, 6.0, Capacity, MergeSeconds);
+	Tracking.AccumulateDamageSince(6.0 - WindowSeconds, DamageByPlayer);
+	TestAssists(*this, TEXT("Window"), DamageByPlayer, { MakeTuple(B, 20.0f), MakeTuple(A, 5.0f) });
+
+	// A burst of hits from one player shares an event, so it doesn't push out another player's
+	Tracking.Reset();
+	Tracking.AddDamage(A, 50.0f, 10.0, Capacity, MergeSeconds);
+	for (int32 HitIndex = 0; HitIndex < 100; ++HitIndex)
+	{
+		Tracking.AddDamage(B, 1.0f, 10.0 + HitIndex * 0.01, Capacity, MergeSeconds);
+	}
+	Tracking.AccumulateDamageSince(11.0 - WindowSeconds, DamageByPlayer);
+	TestAssists(*this, TEXT("Busy window"), DamageByPlayer, { MakeTuple(A, 50.0f), MakeTuple(B, 100.0f) });
+
+	// Hits further apart than the merge time are separate events, and once the buffer is full the oldest is overwritten
+	Tracking.Reset();
+	for (int32 HitIndex = 0; HitIndex < 6; ++HitIndex)
+	{
+		Tracking.AddDamage((HitIndex % 2) ? B : A, (float)(HitIndex + 1), 20.0 + HitIndex * 2.0, Capacity, MergeSeconds);
+	}
+	Tracking.AccumulateDamageSince(-UE_DOUBLE_BIG_NUMBER, DamageByPlayer);
+	TestAssists(*this, TEXT("Wrap around"), DamageByPlayer, { MakeTuple(A, 3.0f + 5.0f), MakeTuple(B, 4.0f + 6.0f) });
+
+	// Reset clears everything
+	Tracking.Reset();
+	Tracking.AccumulateDamageSince(-UE_DOUBLE_BIG_NUMBER, DamageByPlayer);
+	TestAssists(*this, TEXT("Reset"), DamageByPlayer, {});
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -13,6 +13,7 @@ class UObject;
 class USoundBase;
 class UUserWidget;
 struct FDataRegistryAcquireResult;
+struct FStreamableHandle;
 struct FLyraNotificationMessage;
 
 USTRUCT(BlueprintType)
@@ -62,6 +63,26 @@ public:
 
 	UFUNCTION(BlueprintImplementableEvent)
 	UUserWidget* CreateAccoladeWidget(const FPendingAccoladeEntry& Entry);
+
+	// Sets up a pooled widget (previously returned by CreateAccoladeWidget) to show a new entry, e.g., new text, icon and intro animation.
+	// Widgets are only pooled when this is implemented, otherwise every accolade creates and destroys its own widget
+	UFUNCTION(BlueprintImplementableEvent)
+	void ReinitializeAccoladeWidget(UUserWidget* Widget, const FPendingAccoladeEntry& Entry);
+
+	// Shows a pooled widget for a new entry. By default calls ReinitializeAccoladeWidget and makes the widget visible again.
+	// Return false if it can't be reused, and a new widget will be created instead
+	UFUNCTION(BlueprintNativeEvent)
+	bool ReuseAccoladeWidget(UUserWidget* Widget, const FPendingAccoladeEntry& Entry);
+
+	// Hides a widget that's done displaying so it can be reused. By default collapses it, if ReinitializeAccoladeWidget is implemented.
+	// Return false to have it destroyed with DestroyAccoladeWidget instead
+	UFUNCTION(BlueprintNativeEvent)
+	bool ReleaseAccoladeWidgetToPool(UUserWidget* Widget);
+
+	// The most hidden accolade widgets kept around for reuse
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta=(ClampMin=0))
+	int32 MaxPooledAccoladeWidgets = 4;
+
 private:
 	FGameplayMessageListenerHandle ListenerHandle;
 
@@ -78,6 +99,33 @@ private:
 	UPROPERTY(Transient)
 	TArray<FPendingAccoladeEntry> PendingAccoladeDisplays;
 
+	// Every accolade row in the registry keyed by tag, fetched (along with the icons and sounds for this location) when the widget is first constructed
+	UPROPERTY(Transient)
+	TMap<FName, FPendingAccoladeEntry> PrefetchedAccolades;
+
+	// Hidden widgets ready to be reused by DisplayNextAccolade
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UUserWidget>> PooledAccoladeWidgets;
+
+	bool bPrefetchStarted = false;
+	int32 NumPrefetchRowsPending = 0;
+
+	// Bumped whenever a prefetch starts or is canceled, so callbacks from an older prefetch are ignored
+	int32 PrefetchGeneration = 0;
+
+	// Kept apart from the FAsyncMixin queue, so on-demand accolade loads don't wait behind the prefetch
+	TSharedPtr<FStreamableHandle> PrefetchHandle;
+
+	void StartPrefetch();
+	void CancelPrefetch();
+	void OnPrefetchRowAcquired(const FDataRegistryAcquireResult& AccoladeHandle, int32 Generation);
+	void LoadPrefetchedAssets();
+	void OnPrefetchedAssetsLoaded(int32 Generation);
+
+	bool CanPoolAccoladeWidgets() const;
+
+	UUserWidget* AcquireAccoladeWidget(const FPendingAccoladeEntry& Entry);
+	void ReleaseAccoladeWidget(UUserWidget* Widget);
 
 	void OnNotificationMessage(FGameplayTag Channel, const FLyraNotificationMessage& Notification);
 	void OnRegistryLoadCompleted(const FDataRegistryAcquireResult& AccoladeHandle, int32 SequenceID);
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Components/GameStateComponent.h"
+#include "WorldCollision.h"
 
 #include "AimAssistTargetManagerComponent.generated.h"
 
@@ -16,11 +17,16 @@ struct FAimAssistSettings;
 struct FAimAssistTargetOptions;
 struct FCollisionQueryParams;
 struct FLyraAimAssistTarget;
+struct FOverlapResult;
 
 /**
  * The Aim Assist Target Manager Component is used to gather all aim assist targets that are within
  * a given player's view. Targets must implement the IAimAssistTargetInterface and be on the
  * collision channel that is set in the ShooterCoreRuntimeSettings. 
+ *
+ * There is one of these per world, shared by every local player. Each player's target overlap is queued
+ * as an async query and read back on their next update, so all players' queries run together as one batch
+ * at the end of the frame instead of as separate blocking overlaps.
  */
 UCLASS(Blueprintable)
 class SHOOTERCORERUNTIME_API UAimAssistTargetManagerComponent : public UGameStateComponent
@@ -51,4 +57,14 @@ protected:
 	
 	/** Setup CollisionQueryParams to ignore a set of actors based on filter settings. Such as Ignoring Requester or Instigator. */
 	void InitTargetSelectionCollisionParams(FCollisionQueryParams& OutParams, const AActor& RequestedBy, const FAimAssistFilter& Filter) const;
+
+	/**
+	 * Gets the overlaps from the async query queued for this player last frame (or a blocking overlap if there isn't one),
+	 * and queues the query for next frame.
+	 */
+	void GatherOverlaps(const APawn& OwnerPawn, const FAimAssistSettings& Settings, const FAimAssistOwnerViewData& OwnerData, float ReticleDepth, TArray<FOverlapResult>& OutOverlaps);
+
+private:
+	/** Target overlap queued for each local player, read back on their next call to GetVisibleTargets */
+	TMap<TWeakObjectPtr<const APlayerController>, FTraceHandle> PendingOverlapQueries;
 };
@@ -6,21 +6,54 @@
 
 #include "AssistProcessor.generated.h"
 
+class AActor;
 class APlayerState;
 class UObject;
 struct FGameplayTag;
 struct FLyraVerbMessage;
 template <typename T> struct TObjectPtr;
 
-// Tracks the damage done to a player by other players
+// Damage done to a player by another player
+USTRUCT()
+struct FPlayerAssistDamageEvent
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TObjectPtr<APlayerState> Instigator;
+
+	float Damage = 0.0f;
+
+	// Server time the damage was dealt (the most recent hit when several are merged into one event)
+	double Time = 0.0;
+};
+
+// Tracks the most recent damage done to a player by other players since they were last eliminated, in a fixed size ring buffer
 USTRUCT()
 struct FPlayerAssistDamageTracking
 {
 	GENERATED_BODY()
 
-	// Map of damager to damage dealt
+	// Records damage, overwriting the oldest event once Capacity events are stored. A hit from the same instigator as the
+	// newest event, within MergeSeconds of it, is added to that event instead, so a burst of fire from one player takes one slot
+	void AddDamage(APlayerState* Instigator, float Damage, double Time, int32 Capacity, double MergeSeconds);
+
+	// Sums the damage dealt at or after MinTime per instigator, in the order each instigator first appears
+	void AccumulateDamageSince(double MinTime, TArray<TPair<APlayerState*, float>, TInlineAllocator<8>>& OutDamageByPlayer) const;
+
+	// Forgets all damage while keeping the buffer allocated
+	void Reset();
+
+private:
+	// Ring buffer of damage events, allocated to capacity on first use
 	UPROPERTY(Transient)
-	TMap<TObjectPtr<APlayerState>, float> AccumulatedDamageByPlayer;
+	TArray<FPlayerAssistDamageEvent> RecentDamage;
+
+	// Slot of the oldest event
+	int32 Head = 0;
+
+	// Number of events stored
+	int32 Count = 0;
 };
 
 // Tracks assists (dealing damage to another player without finishing them)
@@ -32,12 +65,34 @@ class UAssistProcessor : public UGameplayMessageProcessor
 public:
 	virtual void StartListening() override;
 
+	// Records damage done to Target by Instigator at the given server time
+	void RecordDamage(APlayerState* Target, APlayerState* Instigator, float Damage, double Time);
+
+	// Gets the damage per player that counts towards an assist on Target if they are eliminated at the given time, excluding the eliminator
+	void GatherAssists(APlayerState* Target, const UObject* Eliminator, double Time, TArray<TPair<APlayerState*, float>, TInlineAllocator<8>>& OutAssists) const;
+
+protected:
+	// Only damage dealt within this many seconds of the elimination counts towards an assist (0 counts all damage since the player was last eliminated)
+	UPROPERTY(EditDefaultsOnly, Category=Assists, meta=(ClampMin=0, Units=s))
+	float AssistWindowSeconds = 0.0f;
+
+	// How many damage events are kept per player, once full new damage overwrites the oldest
+	UPROPERTY(EditDefaultsOnly, Category=Assists, meta=(ClampMin=1))
+	int32 MaxDamageEventsPerPlayer = 32;
+
 private:
 	void OnDamageMessage(FGameplayTag Channel, const FLyraVerbMessage& Payload);
 	void OnEliminationMessage(FGameplayTag Channel, const FLyraVerbMessage& Payload);
 
+	UFUNCTION()
+	void OnPlayerStateDestroyed(AActor* DestroyedActor);
+
 private:
-	// Map of player to damage dealt to them
+	// Map of player to damage dealt to them. Entries are reset when the player is eliminated and removed when their player state goes away
 	UPROPERTY(Transient)
 	TMap<TObjectPtr<APlayerState>, FPlayerAssistDamageTracking> DamageHistory;
+
+#if WITH_DEV_AUTOMATION_TESTS
+	friend class FAssistProcessorAttributionTest;
+#endif
 };
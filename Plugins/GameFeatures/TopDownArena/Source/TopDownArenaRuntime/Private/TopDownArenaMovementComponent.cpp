@@ -2,7 +2,9 @@
 
 #include "TopDownArenaMovementComponent.h"
 
+#include "AbilitySystemComponent.h"
 #include "AbilitySystemGlobals.h"
+#include "Character/LyraPawnExtensionComponent.h"
 #include "TopDownArenaAttributeSet.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(TopDownArenaMovementComponent)
@@ -10,10 +12,117 @@
 UTopDownArenaMovementComponent::UTopDownArenaMovementComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	bWantsInitializeComponent = true;
+}
+
+void UTopDownArenaMovementComponent::InitializeComponent()
+{
+	Super::InitializeComponent();
+
+	if (ULyraPawnExtensionComponent* PawnExtComponent = ULyraPawnExtensionComponent::FindPawnExtensionComponent(GetOwner()))
+	{
+		PawnExtComponent->OnAbilitySystemInitialized_RegisterAndCall(FSimpleMulticastDelegate::FDelegate::CreateUObject(this, &ThisClass::HandleAbilitySystemInitialized));
+		PawnExtComponent->OnAbilitySystemUninitialized_Register(FSimpleMulticastDelegate::FDelegate::CreateUObject(this, &ThisClass::HandleAbilitySystemUninitialized));
+	}
+}
+
+void UTopDownArenaMovementComponent::UninitializeComponent()
+{
+	UnbindFromAbilitySystem();
+
+	Super::UninitializeComponent();
+}
+
+void UTopDownArenaMovementComponent::HandleAbilitySystemInitialized()
+{
+	BindToAbilitySystem(UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(GetOwner()));
+}
+
+void UTopDownArenaMovementComponent::HandleAbilitySystemUninitialized()
+{
+	UnbindFromAbilitySystem();
+}
+
+void UTopDownArenaMovementComponent::BindToAbilitySystem(UAbilitySystemComponent* ASC)
+{
+	UnbindFromAbilitySystem();
+
+	if (ASC == nullptr)
+	{
+		return;
+	}
+
+	BoundAbilitySystem = ASC;
+
+	MovementSpeedChangedHandle = ASC->GetGameplayAttributeValueChangeDelegate(UTopDownArenaAttributeSet::GetMovementSpeedAttribute()).AddUObject(this, &ThisClass::HandleMovementSpeedChanged);
+
+	// Parent tag counts include child tags, so this matches HasMatchingGameplayTag
+	MovementStoppedTagHandle = ASC->RegisterGameplayTagEvent(TAG_Gameplay_MovementStopped, EGameplayTagEventType::NewOrRemoved).AddUObject(this, &ThisClass::HandleMovementStoppedTagChanged);
+	bMovementStopped = ASC->HasMatchingGameplayTag(TAG_Gameplay_MovementStopped);
+}
+
+void UTopDownArenaMovementComponent::UnbindFromAbilitySystem()
+{
+	if (UAbilitySystemComponent* ASC = BoundAbilitySystem.Get())
+	{
+		ASC->GetGameplayAttributeValueChangeDelegate(UTopDownArenaAttributeSet::GetMovementSpeedAttribute()).Remove(MovementSpeedChangedHandle);
+		ASC->RegisterGameplayTagEvent(TAG_Gameplay_MovementStopped, EGameplayTagEventType::NewOrRemoved).Remove(MovementStoppedTagHandle);
+	}
+
+	BoundAbilitySystem.Reset();
+	MovementSpeedChangedHandle.Reset();
+	MovementStoppedTagHandle.Reset();
+	bMovementStopped = false;
+	bHasMovementSpeed = false;
+	CachedMovementSpeed = 0.0f;
+}
+
+void UTopDownArenaMovementComponent::HandleMovementSpeedChanged(const FOnAttributeChangeData& ChangeData)
+{
+	// Fires for predicted changes and their rollbacks as well, so this always matches the current value
+	CachedMovementSpeed = ChangeData.NewValue;
+	bHasMovementSpeed = true;
+}
+
+void UTopDownArenaMovementComponent::HandleMovementStoppedTagChanged(const FGameplayTag Tag, int32 NewCount)
+{
+	bMovementStopped = (NewCount > 0);
 }
 
 float UTopDownArenaMovementComponent::GetMaxSpeed() const
 {
+	if (const UAbilitySystemComponent* ASC = BoundAbilitySystem.Get())
+	{
+		if (bMovementStopped)
+		{
+			return 0;
+		}
+
+		if (MovementMode == MOVE_Walking)
+		{
+			// Removing the attribute set (e.g., when a game feature deactivates) doesn't fire a change event, so drop the
+			// cached value once it's gone and read it again if the set is added back
+			if (!ASC->HasAttributeSetForAttribute(UTopDownArenaAttributeSet::GetMovementSpeedAttribute()))
+			{
+				bHasMovementSpeed = false;
+			}
+			else if (!bHasMovementSpeed)
+			{
+				CachedMovementSpeed = ASC->GetNumericAttribute(UTopDownArenaAttributeSet::GetMovementSpeedAttribute());
+				bHasMovementSpeed = true;
+			}
+
+			if (bHasMovementSpeed && (CachedMovementSpeed > 0.0f))
+			{
+				return CachedMovementSpeed;
+			}
+		}
+
+		// ULyraCharacterMovementComponent::GetMaxSpeed only adds the stopped tag check (handled above), skip its lookup
+		return UCharacterMovementComponent::GetMaxSpeed();
+	}
+
+	// Not bound to an ability system yet, look everything up like before
 	if (UAbilitySystemComponent* ASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(GetOwner()))
 	{
 		if (MovementMode == MOVE_Walking)
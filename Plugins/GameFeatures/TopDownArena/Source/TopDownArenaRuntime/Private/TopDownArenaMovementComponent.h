@@ -6,7 +6,10 @@
 
 #include "TopDownArenaMovementComponent.generated.h"
 
+class UAbilitySystemComponent;
 class UObject;
+struct FGameplayTag;
+struct FOnAttributeChangeData;
 
 UCLASS()
 class UTopDownArenaMovementComponent : public ULyraCharacterMovementComponent
@@ -21,4 +24,35 @@ public:
 	virtual float GetMaxSpeed() const override;
 	//~End of UMovementComponent interface
 
+protected:
+
+	//~UActorComponent interface
+	virtual void InitializeComponent() override;
+	virtual void UninitializeComponent() override;
+	//~End of UActorComponent interface
+
+private:
+
+	void HandleAbilitySystemInitialized();
+	void HandleAbilitySystemUninitialized();
+	void BindToAbilitySystem(UAbilitySystemComponent* ASC);
+	void UnbindFromAbilitySystem();
+
+	void HandleMovementSpeedChanged(const FOnAttributeChangeData& ChangeData);
+	void HandleMovementStoppedTagChanged(const FGameplayTag Tag, int32 NewCount);
+
+private:
+
+	// GetMaxSpeed runs several times per move (and again for every replayed move), so the movement speed attribute and
+	// the stopped tag are cached here and kept up to date by the ability system's change events
+	TWeakObjectPtr<UAbilitySystemComponent> BoundAbilitySystem;
+	FDelegateHandle MovementSpeedChangedHandle;
+	FDelegateHandle MovementStoppedTagHandle;
+
+	bool bMovementStopped = false;
+
+	// The attribute set may be granted after the ability system is initialized or removed again, so the cached value is
+	// only used while the set exists and is read again whenever it comes back
+	mutable bool bHasMovementSpeed = false;
+	mutable float CachedMovementSpeed = 0.0f;
 };
@@ -3,18 +3,85 @@
 #include "DataSource/GameSettingDataSourceDynamic.h"
 
 #include "Engine/LocalPlayer.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/UnrealType.h"
 
 //--------------------------------------
 // FGameSettingDataSourceDynamic
 //--------------------------------------
 
 FGameSettingDataSourceDynamic::FGameSettingDataSourceDynamic(const TArray<FString>& InDynamicPath)
-	: DynamicPath(InDynamicPath)
+	: DynamicPathSegments(InDynamicPath)
+	, DynamicPath(InDynamicPath)
 {
 }
 
+template<typename ReadFunc>
+bool FGameSettingDataSourceDynamic::ReadValue(const FTypedAccessor& Accessor, ULocalPlayer* InLocalPlayer, ReadFunc&& Read) const
+{
+	UObject* Container = GetLeafContainer(Accessor, InLocalPlayer);
+	if (Container == nullptr)
+	{
+		return false;
+	}
+
+	if (UFunction* Function = Accessor.Leaf.Function)
+	{
+		if (Function->GetReturnProperty() != Accessor.ValueProperty)
+		{
+			// This is a setter
+			return false;
+		}
+
+		uint8* Params = (uint8*)FMemory_Alloca_Aligned(Function->ParmsSize, Function->GetMinAlignment());
+		Function->InitializeStruct(Params);
+		Container->ProcessEvent(Function, Params);
+		Read(Accessor.ValueProperty->ContainerPtrToValuePtr<void>(Params));
+		Function->DestroyStruct(Params);
+	}
+	else
+	{
+		Read(Accessor.ValueProperty->ContainerPtrToValuePtr<void>(Container));
+	}
+
+	return true;
+}
+
+template<typename WriteFunc>
+bool FGameSettingDataSourceDynamic::WriteValue(const FTypedAccessor& Accessor, ULocalPlayer* InLocalPlayer, WriteFunc&& Write) const
+{
+	UObject* Container = GetLeafContainer(Accessor, InLocalPlayer);
+	if (Container == nullptr)
+	{
+		return false;
+	}
+
+	if (UFunction* Function = Accessor.Leaf.Function)
+	{
+		if (Function->GetReturnProperty() == Accessor.ValueProperty)
+		{
+			// This is a getter
+			return false;
+		}
+
+		uint8* Params = (uint8*)FMemory_Alloca_Aligned(Function->ParmsSize, Function->GetMinAlignment());
+		Function->InitializeStruct(Params);
+		const bool bWritten = Write(Accessor.ValueProperty->ContainerPtrToValuePtr<void>(Params));
+		if (bWritten)
+		{
+			Container->ProcessEvent(Function, Params);
+		}
+		Function->DestroyStruct(Params);
+		return bWritten;
+	}
+
+	return Write(Accessor.ValueProperty->ContainerPtrToValuePtr<void>(Container));
+}
+
 bool FGameSettingDataSourceDynamic::Resolve(ULocalPlayer* InLocalPlayer)
 {
+	GetTypedAccessor(InLocalPlayer);
+
 	return DynamicPath.Resolve(InLocalPlayer);
 }
 
@@ -22,6 +89,20 @@ FString FGameSettingDataSourceDynamic::GetValueAsString(ULocalPlayer* InLocalPla
 {
 	FString OutStringValue;
 
+	if (const FTypedAccessor* Accessor = GetTypedAccessor(InLocalPlayer))
+	{
+		// Same formatting as PropertyPathHelpers, just without walking the path
+		const bool bRead = ReadValue(*Accessor, InLocalPlayer, [&](const void* ValuePtr)
+		{
+			Accessor->ValueProperty->ExportTextItem_Direct(OutStringValue, ValuePtr, nullptr, nullptr, PPF_None);
+		});
+
+		if (bRead)
+		{
+			return OutStringValue;
+		}
+	}
+
 	const bool bSuccess = PropertyPathHelpers::GetPropertyValueAsString(InLocalPlayer, DynamicPath, OutStringValue);
 	ensure(bSuccess);
 
@@ -30,11 +111,228 @@ FString FGameSettingDataSourceDynamic::GetValueAsString(ULocalPlayer* InLocalPla
 
 void FGameSettingDataSourceDynamic::SetValue(ULocalPlayer* InLocalPlayer, const FString& InStringValue)
 {
+	if (const FTypedAccessor* Accessor = GetTypedAccessor(InLocalPlayer))
+	{
+		const bool bWritten = WriteValue(*Accessor, InLocalPlayer, [&](void* ValuePtr)
+		{
+			return Accessor->ValueProperty->ImportText_Direct(*InStringValue, ValuePtr, nullptr, PPF_None) != nullptr;
+		});
+
+		if (bWritten)
+		{
+			return;
+		}
+	}
+
 	const bool bSuccess = PropertyPathHelpers::SetPropertyValueFromString(InLocalPlayer, DynamicPath, InStringValue);
 	ensure(bSuccess);
 }
 
+bool FGameSettingDataSourceDynamic::GetValueAsDouble(ULocalPlayer* InLocalPlayer, double& OutValue) const
+{
+	const FTypedAccessor* Accessor = GetTypedAccessor(InLocalPlayer);
+	if ((Accessor == nullptr) || ((Accessor->Type != EAccessorType::Numeric) && (Accessor->Type != EAccessorType::Bool)))
+	{
+		return false;
+	}
+
+	return ReadValue(*Accessor, InLocalPlayer, [&](const void* ValuePtr)
+	{
+		if (Accessor->Type == EAccessorType::Bool)
+		{
+			OutValue = CastFieldChecked<FBoolProperty>(Accessor->ValueProperty)->GetPropertyValue(ValuePtr) ? 1.0 : 0.0;
+		}
+		else
+		{
+			const FNumericProperty* NumericProperty = CastFieldChecked<FNumericProperty>(Accessor->ValueProperty);
+			OutValue = NumericProperty->IsFloatingPoint() ? NumericProperty->GetFloatingPointPropertyValue(ValuePtr) : (double)NumericProperty->GetSignedIntPropertyValue(ValuePtr);
+		}
+	});
+}
+
+bool FGameSettingDataSourceDynamic::SetValueFromDouble(ULocalPlayer* InLocalPlayer, double Value)
+{
+	const FTypedAccessor* Accessor = GetTypedAccessor(InLocalPlayer);
+	if ((Accessor == nullptr) || ((Accessor->Type != EAccessorType::Numeric) && (Accessor->Type != EAccessorType::Bool)))
+	{
+		return false;
+	}
+
+	return WriteValue(*Accessor, InLocalPlayer, [&](void* ValuePtr)
+	{
+		if (Accessor->Type == EAccessorType::Bool)
+		{
+			CastFieldChecked<FBoolProperty>(Accessor->ValueProperty)->SetPropertyValue(ValuePtr, Value != 0.0);
+		}
+		else
+		{
+			const FNumericProperty* NumericProperty = CastFieldChecked<FNumericProperty>(Accessor->ValueProperty);
+			if (NumericProperty->IsFloatingPoint())
+			{
+				NumericProperty->SetFloatingPointPropertyValue(ValuePtr, Value);
+			}
+			else
+			{
+				// Match LexFromString on the string path, which truncates
+				NumericProperty->SetIntPropertyValue(ValuePtr, (int64)Value);
+			}
+		}
+		return true;
+	});
+}
+
 FString FGameSettingDataSourceDynamic::ToString() const
 {
 	return DynamicPath.ToString();
 }
+
+const FGameSettingDataSourceDynamic::FTypedAccessor* FGameSettingDataSourceDynamic::GetTypedAccessor(ULocalPlayer* InLocalPlayer) const
+{
+	if (!bTypedAccessorBuilt && (InLocalPlayer != nullptr))
+	{
+		BuildTypedAccessor(InLocalPlayer);
+	}
+
+	return TypedAccessor.GetPtrOrNull();
+}
+
+void FGameSettingDataSourceDynamic::BuildTypedAccessor(ULocalPlayer* InLocalPlayer) const
+{
+	bTypedAccessorBuilt = true;
+	TypedAccessor.Reset();
+
+	if (DynamicPathSegments.Num() == 0)
+	{
+		return;
+	}
+
+	FTypedAccessor Accessor;
+	UClass* CurrentClass = InLocalPlayer->GetClass();
+
+	for (int32 SegmentIndex = 0; SegmentIndex < DynamicPathSegments.Num(); ++SegmentIndex)
+	{
+		const FString& SegmentName = DynamicPathSegments[SegmentIndex];
+		const bool bIsLeaf = (SegmentIndex == DynamicPathSegments.Num() - 1);
+
+		// Array indices, struct members and anything else fancy stay on the string path
+		if ((CurrentClass == nullptr) || SegmentName.Contains(TEXT("[")))
+		{
+			return;
+		}
+
+		FAccessorSegment Segment;
+		Segment.OwnerClass = CurrentClass;
+
+		FProperty* SegmentValueProperty = nullptr;
+		if (UFunction* Function = CurrentClass->FindFunctionByName(*SegmentName))
+		{
+			FProperty* ReturnProperty = Function->GetReturnProperty();
+			if ((Function->NumParms == 1) && (ReturnProperty != nullptr))
+			{
+				// Getter
+				SegmentValueProperty = ReturnProperty;
+			}
+			else if (bIsLeaf && (Function->NumParms == 1) && (ReturnProperty == nullptr))
+			{
+				// Setter, only valid at the end of the path
+				for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+				{
+					SegmentValueProperty = *It;
+				}
+			}
+
+			Segment.Function = Function;
+		}
+		else if (FProperty* Property = CurrentClass->FindPropertyByName(*SegmentName))
+		{
+			if (Property->ArrayDim != 1)
+			{
+				return;
+			}
+
+			SegmentValueProperty = Property;
+			Segment.Property = Property;
+		}
+
+		if (SegmentValueProperty == nullptr)
+		{
+			return;
+		}
+
+		if (bIsLeaf)
+		{
+			Accessor.Leaf = Segment;
+			Accessor.ValueProperty = SegmentValueProperty;
+		}
+		else
+		{
+			const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(SegmentValueProperty);
+			if (ObjectProperty == nullptr)
+			{
+				return;
+			}
+
+			Accessor.ObjectSegments.Add(Segment);
+			CurrentClass = ObjectProperty->PropertyClass;
+		}
+	}
+
+	if (Accessor.ValueProperty->IsA<FBoolProperty>())
+	{
+		Accessor.Type = EAccessorType::Bool;
+	}
+	else if (Accessor.ValueProperty->IsA<FEnumProperty>() || (CastField<FByteProperty>(Accessor.ValueProperty) && CastField<FByteProperty>(Accessor.ValueProperty)->Enum))
+	{
+		Accessor.Type = EAccessorType::Enum;
+	}
+	else if (Accessor.ValueProperty->IsA<FNumericProperty>())
+	{
+		Accessor.Type = EAccessorType::Numeric;
+	}
+	else if (Accessor.ValueProperty->IsA<FStrProperty>())
+	{
+		Accessor.Type = EAccessorType::String;
+	}
+	else
+	{
+		// Structs (e.g., colors) and other types keep using PropertyPathHelpers
+		return;
+	}
+
+	TypedAccessor = MoveTemp(Accessor);
+}
+
+UObject* FGameSettingDataSourceDynamic::GetLeafContainer(const FTypedAccessor& Accessor, ULocalPlayer* InLocalPlayer) const
+{
+	UObject* CurrentObject = InLocalPlayer;
+
+	for (const FAccessorSegment& Segment : Accessor.ObjectSegments)
+	{
+		if ((CurrentObject == nullptr) || !CurrentObject->IsA(Segment.OwnerClass))
+		{
+			return nullptr;
+		}
+
+		if (Segment.Function)
+		{
+			const FObjectPropertyBase* ReturnProperty = CastFieldChecked<FObjectPropertyBase>(Segment.Function->GetReturnProperty());
+
+			uint8* Params = (uint8*)FMemory_Alloca_Aligned(Segment.Function->ParmsSize, Segment.Function->GetMinAlignment());
+			Segment.Function->InitializeStruct(Params);
+			CurrentObject->ProcessEvent(Segment.Function, Params);
+			CurrentObject = ReturnProperty->GetObjectPropertyValue(ReturnProperty->ContainerPtrToValuePtr<void>(Params));
+			Segment.Function->DestroyStruct(Params);
+		}
+		else
+		{
+			CurrentObject = CastFieldChecked<FObjectPropertyBase>(Segment.Property)->GetObjectPropertyValue_InContainer(CurrentObject);
+		}
+	}
+
+	if ((CurrentObject == nullptr) || !CurrentObject->IsA(Accessor.Leaf.OwnerClass))
+	{
+		return nullptr;
+	}
+
+	return CurrentObject;
+}
@@ -27,5 +27,12 @@ public:
 
 	virtual void SetValue(ULocalPlayer* InContext, const FString& Value) = 0;
 
+	/**
+	 * Numeric access that skips the string round trip. Returns false if this source can't provide it, in which
+	 * case callers should fall back to GetValueAsString / SetValue.
+	 */
+	virtual bool GetValueAsDouble(ULocalPlayer* InContext, double& OutValue) const { return false; }
+	virtual bool SetValueFromDouble(ULocalPlayer* InContext, double Value) { return false; }
+
 	virtual FString ToString() const = 0;
 };
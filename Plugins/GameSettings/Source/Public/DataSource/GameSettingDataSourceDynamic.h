@@ -5,7 +5,9 @@
 #include "GameSettingDataSource.h"
 #include "PropertyPathHelpers.h"
 
+class FProperty;
 class ULocalPlayer;
+class UFunction;
 
 //--------------------------------------
 // FGameSettingDataSourceDynamic
@@ -22,8 +24,57 @@ public:
 
 	virtual void SetValue(ULocalPlayer* InLocalPlayer, const FString& Value) override;
 
+	virtual bool GetValueAsDouble(ULocalPlayer* InLocalPlayer, double& OutValue) const override;
+	virtual bool SetValueFromDouble(ULocalPlayer* InLocalPlayer, double Value) override;
+
 	virtual FString ToString() const override;
 
 private:
+	/** The kind of value at the end of the path that the typed accessor knows how to read and write directly */
+	enum class EAccessorType : uint8
+	{
+		Bool,
+		Numeric,
+		Enum,
+		String
+	};
+
+	/** One object hop along the path, either a getter function returning an object or an object property */
+	struct FAccessorSegment
+	{
+		UClass* OwnerClass = nullptr;
+		UFunction* Function = nullptr;
+		FProperty* Property = nullptr;
+	};
+
+	/**
+	 * The dynamic path resolved once against the local player's class, so values can be read and written
+	 * without walking the path by name or going through strings every time.
+	 */
+	struct FTypedAccessor
+	{
+		TArray<FAccessorSegment, TInlineAllocator<2>> ObjectSegments;
+		FAccessorSegment Leaf;
+
+		// The property holding the value; the return value or only parameter if Leaf is a function
+		FProperty* ValueProperty = nullptr;
+		EAccessorType Type = EAccessorType::String;
+	};
+
+	const FTypedAccessor* GetTypedAccessor(ULocalPlayer* InLocalPlayer) const;
+	void BuildTypedAccessor(ULocalPlayer* InLocalPlayer) const;
+	UObject* GetLeafContainer(const FTypedAccessor& Accessor, ULocalPlayer* InLocalPlayer) const;
+
+	template<typename ReadFunc>
+	bool ReadValue(const FTypedAccessor& Accessor, ULocalPlayer* InLocalPlayer, ReadFunc&& Read) const;
+
+	template<typename WriteFunc>
+	bool WriteValue(const FTypedAccessor& Accessor, ULocalPlayer* InLocalPlayer, WriteFunc&& Write) const;
+
+private:
+	TArray<FString> DynamicPathSegments;
 	FCachedPropertyPath DynamicPath;
+
+	mutable TOptional<FTypedAccessor> TypedAccessor;
+	mutable bool bTypedAccessorBuilt = false;
 };
@@ -4,6 +4,7 @@
 #include "Engine/Engine.h"
 #include "Engine/GameInstance.h"
 #include "Engine/World.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 #include "UObject/ScriptMacros.h"
 #include "UObject/Stack.h"
 
@@ -11,6 +12,8 @@
 
 DEFINE_LOG_CATEGORY(LogGameplayMessageSubsystem);
 
+CSV_DEFINE_CATEGORY(GameplayMessages, true);
+
 namespace UE
 {
 	namespace GameplayMessageSubsystem
@@ -64,6 +67,8 @@ void UGameplayMessageSubsystem::Deinitialize()
 
 void UGameplayMessageSubsystem::BroadcastMessageInternal(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes)
 {
+	CSV_SCOPED_TIMING_STAT(GameplayMessages, BroadcastMessage);
+
 	// Log the message if enabled
 	if (UE::GameplayMessageSubsystem::ShouldLogMessages != 0)
 	{
@@ -38,6 +38,7 @@ public class LyraExtTool : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"UnrealEd",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
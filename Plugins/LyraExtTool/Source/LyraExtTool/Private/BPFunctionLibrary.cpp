@@ -3,24 +3,89 @@
 #include "BPFunctionLibrary.h"
 
 #include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+#include "Misc/ScopedSlowTask.h"
+#include "ScopedTransaction.h"
+#include "StaticMeshResources.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BPFunctionLibrary)
 
-class UMaterialInterface;
+#define LOCTEXT_NAMESPACE "LyraExtTool"
+
+DEFINE_LOG_CATEGORY_STATIC(LogLyraExtTool, Log, All);
 
 bool UBPFunctionLibrary::ChangeMeshMaterials(TArray<UStaticMesh*> Mesh, UMaterialInterface* Material)
 {
+	ChangeMeshMaterialsBatched(Mesh, Material);
+	return true;
+}
 
-	for (int i = 0; i < Mesh.Num(); i++)
+TArray<UStaticMesh*> UBPFunctionLibrary::ChangeMeshMaterialsBatched(const TArray<UStaticMesh*>& Meshes, UMaterialInterface* Material)
+{
+	TArray<UStaticMesh*> MeshesToChange;
+	MeshesToChange.Reserve(Meshes.Num());
+
+	TSet<UStaticMesh*> SeenMeshes;
+	SeenMeshes.Reserve(Meshes.Num());
+
+	for (UStaticMesh* StaticMesh : Meshes)
 	{
-		Mesh[i]->Modify();
-		TArray<FStaticMaterial>& Mats = Mesh[i]->GetStaticMaterials();
-		for (int j = 0; j < Mats.Num(); j++)
+		bool bAlreadySeen = false;
+		SeenMeshes.Add(StaticMesh, &bAlreadySeen);
+		if (StaticMesh == nullptr || bAlreadySeen)
+		{
+			continue;
+		}
+
+		const bool bAlreadyMatches = !StaticMesh->GetStaticMaterials().ContainsByPredicate([Material](const FStaticMaterial& StaticMaterial)
 		{
-			Mats[j].MaterialInterface = Material;
+			return StaticMaterial.MaterialInterface != Material;
+		});
 
+		if (!bAlreadyMatches)
+		{
+			MeshesToChange.Add(StaticMesh);
 		}
-		Mesh[i]->PostEditChange();
 	}
-	return true;
+
+	if (MeshesToChange.Num() == 0)
+	{
+		UE_LOG(LogLyraExtTool, Log, TEXT("ChangeMeshMaterials: all %d mesh(es) already use %s"), Meshes.Num(), *GetNameSafe(Material));
+		return MeshesToChange;
+	}
+
+	FScopedTransaction Transaction(FText::Format(LOCTEXT("ChangeMeshMaterials", "Change Materials on {0} Static Mesh(es)"), MeshesToChange.Num()));
+	FScopedSlowTask SlowTask((float)MeshesToChange.Num(), LOCTEXT("ChangeMeshMaterialsProgress", "Changing static mesh materials..."));
+	SlowTask.MakeDialogDelayed(1.0f);
+
+	{
+		// Only components using the changed meshes recreate their render state, once for the whole batch
+		FStaticMeshComponentRecreateRenderStateContext RecreateRenderStateContext(MeshesToChange);
+
+		// Only the material slots changed, so let the mesh handle that instead of going through a full PostEditChange
+		FProperty* StaticMaterialsProperty = FindFProperty<FProperty>(UStaticMesh::StaticClass(), UStaticMesh::GetStaticMaterialsName());
+
+		for (UStaticMesh* StaticMesh : MeshesToChange)
+		{
+			SlowTask.EnterProgressFrame(1.0f);
+
+			StaticMesh->Modify();
+			for (FStaticMaterial& StaticMaterial : StaticMesh->GetStaticMaterials())
+			{
+				StaticMaterial.MaterialInterface = Material;
+			}
+			FPropertyChangedEvent PropertyChangedEvent(StaticMaterialsProperty, EPropertyChangeType::ValueSet);
+			StaticMesh->PostEditChangeProperty(PropertyChangedEvent);
+		}
+	}
+
+	UE_LOG(LogLyraExtTool, Log, TEXT("ChangeMeshMaterials: changed %d of %d mesh(es) to %s"), MeshesToChange.Num(), Meshes.Num(), *GetNameSafe(Material));
+	for (const UStaticMesh* StaticMesh : MeshesToChange)
+	{
+		UE_LOG(LogLyraExtTool, Verbose, TEXT("  %s"), *StaticMesh->GetPathName());
+	}
+
+	return MeshesToChange;
 }
+
+#undef LOCTEXT_NAMESPACE
@@ -22,4 +22,12 @@ class UBPFunctionLibrary : public UBlueprintFunctionLibrary
 
     UFUNCTION(BlueprintCallable, Category="LyraExt")
     static bool ChangeMeshMaterials(TArray<UStaticMesh*> Mesh, UMaterialInterface* Material);
+
+    /**
+     * Sets every material slot of the given meshes to Material as a single undoable transaction.
+     * Meshes whose slots already all use Material are skipped, and only components using the changed meshes recreate their render state, once for the whole batch.
+     * Returns the meshes that were changed.
+     */
+    UFUNCTION(BlueprintCallable, Category="LyraExt")
+    static TArray<UStaticMesh*> ChangeMeshMaterialsBatched(const TArray<UStaticMesh*>& Meshes, UMaterialInterface* Material);
 };
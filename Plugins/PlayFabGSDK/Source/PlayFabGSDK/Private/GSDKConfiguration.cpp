@@ -5,13 +5,80 @@
 #include "GSDKInternalUtils.h"
 #include "PlayFabGSDK.h"
 #include "Logging/LogMacros.h"
+#include "Logging/LogVerbosity.h"
 #include "Misc/FileHelper.h"
 
+namespace
+{
+	// ParseLogVerbosityFromString turns anything it doesn't know into NoLogging, which would silently turn the log off
+	ELogVerbosity::Type GetLogVerbosityFromEnvironment(const TCHAR* EnvVarName, ELogVerbosity::Type DefaultVerbosity)
+	{
+		FString VerbosityString = UGSDKInternalUtils::GetEnvironmentVariable(EnvVarName);
+		VerbosityString.TrimStartAndEndInline();
+		if (VerbosityString.IsEmpty())
+		{
+			return DefaultVerbosity;
+		}
+
+		const ELogVerbosity::Type Verbosity = ParseLogVerbosityFromString(VerbosityString);
+		if ((Verbosity == ELogVerbosity::NoLogging) && (VerbosityString != TEXT("NoLogging")))
+		{
+			UE_LOG(LogPlayFabGSDK, Warning, TEXT("Unrecognized verbosity '%s' in %s, using %s"), *VerbosityString, EnvVarName, ToString(DefaultVerbosity));
+			return DefaultVerbosity;
+		}
+
+		return Verbosity;
+	}
+}
+
 FConfigurationBase::FConfigurationBase()
 {
 	TitleId = UGSDKInternalUtils::GetEnvironmentVariable(TITLE_ID_ENV_VAR);
 	BuildId = UGSDKInternalUtils::GetEnvironmentVariable(BUILD_ID_ENV_VAR);
 	Region = UGSDKInternalUtils::GetEnvironmentVariable(REGION_ENV_VAR);
+
+	// Only a handful of categories go to the GSDK log by default, everything else only when it's a warning or an error
+	FString Categories = UGSDKInternalUtils::GetEnvironmentVariable(LOG_CATEGORIES_ENV_VAR);
+	if (Categories.IsEmpty())
+	{
+		Categories = TEXT("LogPlayFabGSDK,LogNet,LogOnline,LogGameMode,LogLyra,LogLyraExperience");
+	}
+
+	TArray<FString> CategoryNames;
+	Categories.ParseIntoArray(CategoryNames, TEXT(","));
+	for (FString& CategoryName : CategoryNames)
+	{
+		CategoryName.TrimStartAndEndInline();
+		if (CategoryName == TEXT("*"))
+		{
+			LogSettings.bAllCategories = true;
+		}
+		else if (!CategoryName.IsEmpty())
+		{
+			LogSettings.Categories.Add(FName(*CategoryName));
+		}
+	}
+
+	LogSettings.Verbosity = GetLogVerbosityFromEnvironment(LOG_VERBOSITY_ENV_VAR, LogSettings.Verbosity);
+	LogSettings.OtherVerbosity = GetLogVerbosityFromEnvironment(LOG_OTHER_VERBOSITY_ENV_VAR, LogSettings.OtherVerbosity);
+
+	const FString MaxFileSizeMB = UGSDKInternalUtils::GetEnvironmentVariable(LOG_MAX_FILE_SIZE_MB_ENV_VAR);
+	if (MaxFileSizeMB.IsNumeric())
+	{
+		LogSettings.MaxFileSizeBytes = FMath::Max<int64>(FCString::Atoi64(*MaxFileSizeMB), 1) * 1024 * 1024;
+	}
+
+	const FString MaxFiles = UGSDKInternalUtils::GetEnvironmentVariable(LOG_MAX_FILES_ENV_VAR);
+	if (MaxFiles.IsNumeric())
+	{
+		LogSettings.MaxFiles = FMath::Max(FCString::Atoi(*MaxFiles), 1);
+	}
+
+	const FString QueueSize = UGSDKInternalUtils::GetEnvironmentVariable(LOG_QUEUE_SIZE_ENV_VAR);
+	if (QueueSize.IsNumeric())
+	{
+		LogSettings.MaxQueuedLines = FMath::Max(FCString::Atoi(*QueueSize), 1);
+	}
 }
 
 const FString& FConfigurationBase::GetTitleId()
@@ -34,6 +101,11 @@ bool FConfigurationBase::ShouldLog()
 	return true;
 }
 
+const FGSDKLogSettings& FConfigurationBase::GetLogSettings()
+{
+	return LogSettings;
+}
+
 bool FConfigurationBase::ShouldHeartbeat()
 {
 	return true;
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 
 #include "GameServerConnectionInfo.h"
+#include "GSDKOutputDevice.h"
 
 class FConfiguration
 {
@@ -25,6 +26,7 @@ public:
 	virtual const FString& GetFullyQualifiedDomainName() = 0;
 	virtual const FGameServerConnectionInfo& GetGameServerConnectionInfo() = 0;
 	virtual bool ShouldLog() = 0;
+	virtual const FGSDKLogSettings& GetLogSettings() = 0;
 	virtual bool ShouldHeartbeat() = 0;
 	virtual int32 GetMinimumHeartbeatInterval() = 0;
 	virtual int32 GetMaximumAllowedUnexpectedOperationsCount() = 0;
@@ -37,6 +39,12 @@ protected:
 	static constexpr const TCHAR* BUILD_ID_ENV_VAR = TEXT("PF_BUILD_ID");
 	static constexpr const TCHAR* REGION_ENV_VAR = TEXT("PF_REGION");
 	static constexpr const TCHAR* SHARED_CONTENT_FOLDER_ENV_VAR = TEXT("SHARED_CONTENT_FOLDER");
+	static constexpr const TCHAR* LOG_CATEGORIES_ENV_VAR = TEXT("GSDK_LOG_CATEGORIES");
+	static constexpr const TCHAR* LOG_VERBOSITY_ENV_VAR = TEXT("GSDK_LOG_VERBOSITY");
+	static constexpr const TCHAR* LOG_OTHER_VERBOSITY_ENV_VAR = TEXT("GSDK_LOG_OTHER_VERBOSITY");
+	static constexpr const TCHAR* LOG_MAX_FILE_SIZE_MB_ENV_VAR = TEXT("GSDK_LOG_MAX_FILE_SIZE_MB");
+	static constexpr const TCHAR* LOG_MAX_FILES_ENV_VAR = TEXT("GSDK_LOG_MAX_FILES");
+	static constexpr const TCHAR* LOG_QUEUE_SIZE_ENV_VAR = TEXT("GSDK_LOG_QUEUE_SIZE");
 };
 
 class FConfigurationBase : public FConfiguration
@@ -48,6 +56,7 @@ public:
 	virtual const FString& GetBuildId() override;
 	virtual const FString& GetRegion() override;
 	virtual bool ShouldLog() override;
+	virtual const FGSDKLogSettings& GetLogSettings() override;
 	virtual bool ShouldHeartbeat() override;
 	virtual int32 GetMinimumHeartbeatInterval() override;
 	virtual int32 GetMaximumAllowedUnexpectedOperationsCount() override;
@@ -57,6 +66,7 @@ private:
 	FString TitleId;
 	FString BuildId;
 	FString Region;
+	FGSDKLogSettings LogSettings;
 };
 
 class FEnvironmentVariableConfiguration : public FConfigurationBase
@@ -4,6 +4,7 @@
 
 #include "GSDKConfiguration.h"
 #include "GSDKInternalUtils.h"
+#include "GSDKOutputDevice.h"
 #include "HttpModule.h"
 #include "Async/Async.h"
 #include "Json.h"
@@ -69,7 +70,7 @@ FGSDKInternal::FGSDKInternal()
 
 	if (ConfigPtr->ShouldLog())
 	{
-		StartLog();
+		StartLog(ConfigPtr->GetLogSettings());
 	}
 
 	// Use highest frequency permitted heartbeat interval until VMAgent tells an updated one.
@@ -111,9 +112,8 @@ FGSDKInternal::~FGSDKInternal()
 
 	if (OutputDevice)
 	{
-		GLog->RemoveOutputDevice(OutputDevice);
-		delete OutputDevice;
-		OutputDevice = nullptr;
+		GLog->RemoveOutputDevice(OutputDevice.Get());
+		OutputDevice.Reset();
 	}
 }
 
@@ -134,24 +134,22 @@ void FGSDKInternal::HeartbeatAsyncTaskFunction()
 	}
 }
 
-void FGSDKInternal::StartLog()
+void FGSDKInternal::StartLog(const FGSDKLogSettings& LogSettings)
 {
 	FScopeLock ScopeLock(&ConfigMutex);
 
-	const FString LogFileName = FString::Printf(TEXT("GSDK_output_%lld.txt"), FDateTime::Now().GetTicks());
 	FString LogFolder = ConfigSettings[FPlayFabGSDKModule::LOG_FOLDER_KEY];
 
 	IPlatformFile& FileManager = FPlatformFileManager::Get().GetPlatformFile();
 
-	if (!FileManager.CreateDirectoryTree(*LogFolder))
+	if (LogFolder.IsEmpty() || !FileManager.CreateDirectoryTree(*LogFolder))
 	{
-		LogFolder = TEXT("");
+		LogFolder = FPaths::ProjectLogDir();
 	}
 
-	const FString GSDKLogPath = FString::Printf(TEXT("%s/%s"), *LogFolder, *LogFileName);
-
-	OutputDevice = new FOutputDeviceFile(*GSDKLogPath);
-	GLog->AddOutputDevice(OutputDevice);
+	// Filtered by category and verbosity and written from a background thread, with size based rotation
+	OutputDevice = MakeUnique<FGSDKOutputDevice>(LogFolder, LogSettings);
+	GLog->AddOutputDevice(OutputDevice.Get());
 }
 
 void FGSDKInternal::SendHeartbeat()
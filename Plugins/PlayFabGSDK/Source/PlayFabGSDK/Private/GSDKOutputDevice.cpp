@@ -0,0 +1,212 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "GSDKOutputDevice.h"
+
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/OutputDeviceHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace GSDKOutputDevice
+{
+	// How often the writer wakes up on its own to write whatever is queued
+	static constexpr uint32 WriteIntervalMs = 200;
+}
+
+FGSDKOutputDevice::FGSDKOutputDevice(const FString& InLogFolder, const FGSDKLogSettings& InSettings)
+	: Settings(InSettings)
+	, LogFolder(InLogFolder)
+{
+	BaseFileName = FString::Printf(TEXT("GSDK_output_%lld"), FDateTime::Now().GetTicks());
+	QueuedLines.Reserve(FMath::Min(Settings.MaxQueuedLines, 1024));
+
+	OpenNextFile();
+
+	if (FPlatformProcess::SupportsMultithreading())
+	{
+		WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+		WriterThread = FRunnableThread::Create(this, TEXT("GSDKLogWriter"), 0, TPri_BelowNormal);
+	}
+}
+
+FGSDKOutputDevice::~FGSDKOutputDevice()
+{
+	TearDown();
+}
+
+bool FGSDKOutputDevice::PassesFilter(ELogVerbosity::Type Verbosity, const FName& Category) const
+{
+	const ELogVerbosity::Type VerbosityLevel = (ELogVerbosity::Type)(Verbosity & ELogVerbosity::VerbosityMask);
+	if (VerbosityLevel <= Settings.OtherVerbosity)
+	{
+		return true;
+	}
+
+	return (VerbosityLevel <= Settings.Verbosity) && (Settings.bAllCategories || Settings.Categories.Contains(Category));
+}
+
+void FGSDKOutputDevice::Serialize(const TCHAR* Data, ELogVerbosity::Type Verbosity, const FName& Category)
+{
+	Serialize(Data, Verbosity, Category, -1.0);
+}
+
+void FGSDKOutputDevice::Serialize(const TCHAR* Data, ELogVerbosity::Type Verbosity, const FName& Category, const double Time)
+{
+	if (!PassesFilter(Verbosity, Category))
+	{
+		return;
+	}
+
+	FString Line = FOutputDeviceHelper::FormatLogLine(Verbosity, Category, Data, GPrintLogTimes, Time);
+
+	if (WriterThread == nullptr)
+	{
+		// No threads on this platform, write straight away
+		FScopeLock WriterLock(&WriterMutex);
+		WriteLine(Line);
+		return;
+	}
+
+	int32 NumQueued = 0;
+	{
+		FScopeLock QueueLock(&QueueMutex);
+		if (QueuedLines.Num() >= Settings.MaxQueuedLines)
+		{
+			++DroppedLines;
+			return;
+		}
+		NumQueued = QueuedLines.Add(MoveTemp(Line)) + 1;
+	}
+
+	// Errors are written as soon as possible, everything else waits for the next write interval unless the queue is filling up
+	if (((Verbosity & ELogVerbosity::VerbosityMask) <= ELogVerbosity::Error) || (NumQueued >= Settings.MaxQueuedLines / 2))
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+void FGSDKOutputDevice::Flush()
+{
+	// Write everything that's queued on the calling thread, the file is only ever touched with the writer lock held
+	FScopeLock WriterLock(&WriterMutex);
+	WritePendingLines();
+	if (File)
+	{
+		File->Flush();
+	}
+}
+
+void FGSDKOutputDevice::TearDown()
+{
+	if (WriterThread)
+	{
+		Stop();
+		WriterThread->WaitForCompletion();
+		delete WriterThread;
+		WriterThread = nullptr;
+	}
+
+	if (WakeEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+		WakeEvent = nullptr;
+	}
+
+	FScopeLock WriterLock(&WriterMutex);
+	WritePendingLines();
+	File.Reset();
+}
+
+uint32 FGSDKOutputDevice::Run()
+{
+	while (!bStopping)
+	{
+		WakeEvent->Wait(GSDKOutputDevice::WriteIntervalMs);
+
+		FScopeLock WriterLock(&WriterMutex);
+		WritePendingLines();
+		if (File)
+		{
+			File->Flush();
+		}
+	}
+
+	return 0;
+}
+
+void FGSDKOutputDevice::Stop()
+{
+	bStopping = true;
+	if (WakeEvent)
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+void FGSDKOutputDevice::WritePendingLines()
+{
+	TArray<FString> LinesToWrite;
+	int32 NumDropped = 0;
+	{
+		FScopeLock QueueLock(&QueueMutex);
+		Swap(LinesToWrite, QueuedLines);
+		NumDropped = DroppedLines;
+		DroppedLines = 0;
+	}
+
+	for (const FString& Line : LinesToWrite)
+	{
+		WriteLine(Line);
+	}
+
+	if (NumDropped > 0)
+	{
+		WriteLine(FString::Printf(TEXT("GSDK log queue was full, dropped %d line(s)"), NumDropped));
+	}
+}
+
+void FGSDKOutputDevice::WriteLine(const FString& Line)
+{
+	FTCHARToUTF8 Converted(*Line);
+	const int64 LineSize = Converted.Length() + UE_ARRAY_COUNT(LINE_TERMINATOR_ANSI) - 1;
+
+	if (File && (CurrentFileSize > 0) && (CurrentFileSize + LineSize > Settings.MaxFileSizeBytes))
+	{
+		OpenNextFile();
+	}
+
+	if (File)
+	{
+		File->Serialize((void*)Converted.Get(), Converted.Length());
+		File->Serialize((void*)LINE_TERMINATOR_ANSI, UE_ARRAY_COUNT(LINE_TERMINATOR_ANSI) - 1);
+		CurrentFileSize += LineSize;
+	}
+}
+
+void FGSDKOutputDevice::OpenNextFile()
+{
+	File.Reset();
+
+	const FString FileName = (FileIndex == 0)
+		? FString::Printf(TEXT("%s.txt"), *BaseFileName)
+		: FString::Printf(TEXT("%s_%d.txt"), *BaseFileName, FileIndex);
+	const FString FilePath = FPaths::Combine(LogFolder, FileName);
+	++FileIndex;
+
+	File.Reset(IFileManager::Get().CreateFileWriter(*FilePath, FILEWRITE_AllowRead));
+	CurrentFileSize = 0;
+
+	if (File)
+	{
+		WrittenFiles.Add(FilePath);
+	}
+
+	// Only ever delete files this device wrote
+	while (WrittenFiles.Num() > FMath::Max(Settings.MaxFiles, 1))
+	{
+		IFileManager::Get().Delete(*WrittenFiles[0], /*RequireExists=*/ false, /*EvenReadOnly=*/ true, /*Quiet=*/ true);
+		WrittenFiles.RemoveAt(0);
+	}
+}
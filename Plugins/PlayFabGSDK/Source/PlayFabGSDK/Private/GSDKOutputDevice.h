@@ -0,0 +1,84 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "HAL/CriticalSection.h"
+#include "HAL/Runnable.h"
+#include "Misc/OutputDevice.h"
+
+class FArchive;
+class FEvent;
+class FRunnableThread;
+
+struct FGSDKLogSettings
+{
+public:
+	// Categories written up to Verbosity, "*" means every category
+	TSet<FName> Categories;
+	bool bAllCategories = false;
+	ELogVerbosity::Type Verbosity = ELogVerbosity::Log;
+
+	// Every other category is only written up to this verbosity
+	ELogVerbosity::Type OtherVerbosity = ELogVerbosity::Warning;
+
+	// A new file is started once the current one reaches this size, and only the newest MaxFiles are kept
+	int64 MaxFileSizeBytes = 50 * 1024 * 1024;
+	int32 MaxFiles = 10;
+
+	// Lines waiting for the writer thread beyond this are dropped (and counted) instead of blocking the game
+	int32 MaxQueuedLines = 10000;
+};
+
+/**
+ * Output device for the GSDK log folder that filters by category and verbosity and does its file I/O on a
+ * background thread, so the game thread only pays for formatting the lines that pass the filter.
+ */
+class FGSDKOutputDevice : public FOutputDevice, public FRunnable
+{
+public:
+	FGSDKOutputDevice(const FString& InLogFolder, const FGSDKLogSettings& InSettings);
+	virtual ~FGSDKOutputDevice();
+
+	//~FOutputDevice interface
+	virtual void Serialize(const TCHAR* Data, ELogVerbosity::Type Verbosity, const FName& Category) override;
+	virtual void Serialize(const TCHAR* Data, ELogVerbosity::Type Verbosity, const FName& Category, const double Time) override;
+	virtual void Flush() override;
+	virtual void TearDown() override;
+	virtual bool CanBeUsedOnAnyThread() const override { return true; }
+	virtual bool CanBeUsedOnMultipleThreads() const override { return true; }
+	//~End of FOutputDevice interface
+
+	//~FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~End of FRunnable interface
+
+private:
+	bool PassesFilter(ELogVerbosity::Type Verbosity, const FName& Category) const;
+
+	// Writer side, only called with WriterMutex held
+	void WritePendingLines();
+	void WriteLine(const FString& Line);
+	void OpenNextFile();
+
+private:
+	const FGSDKLogSettings Settings;
+	FString LogFolder;
+	FString BaseFileName;
+
+	FCriticalSection QueueMutex;
+	TArray<FString> QueuedLines;
+	int32 DroppedLines = 0;
+
+	FCriticalSection WriterMutex;
+	TUniquePtr<FArchive> File;
+	int64 CurrentFileSize = 0;
+	int32 FileIndex = 0;
+	TArray<FString> WrittenFiles;
+
+	FEvent* WakeEvent = nullptr;
+	FRunnableThread* WriterThread = nullptr;
+	TAtomic<bool> bStopping { false };
+};
@@ -9,7 +9,9 @@
 #include "HAL/Event.h"
 #include "HAL/CriticalSection.h"
 #include "Interfaces/IHttpRequest.h"
-#include "Misc/OutputDeviceFile.h"
+
+class FGSDKOutputDevice;
+struct FGSDKLogSettings;
 
 #define MAKE_ENUM(VAR) VAR,
 #define MAKE_STRINGS(VAR) TEXT(#VAR),
@@ -178,7 +180,7 @@ private:
 	int32 MinimumHeartbeatInterval;
 	FString HeartbeatUrl;
 	TFuture<void> HeartbeatThread;
-	FOutputDeviceFile* OutputDevice;
+	TUniquePtr<FGSDKOutputDevice> OutputDevice;
 
 
 	FGameServerConnectionInfo ConnectionInfo;
@@ -205,7 +207,7 @@ private:
 	FCriticalSection HeartbeatMutex;
 	TArray<TSharedRef<IHttpRequest, ESPMode::ThreadSafe>> Heartbeats;
 
-	void StartLog();
+	void StartLog(const FGSDKLogSettings& LogSettings);
 	void SendHeartbeat();
 	void ReceiveHeartbeat();
 
@@ -6,6 +6,9 @@
 #include "Runtime/Engine/Classes/Engine/WorldComposition.h"
 #include "Components/PrimitiveComponent.h"
 #include "Runtime/Launch/Resources/Version.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+CSV_DEFINE_CATEGORY(SmoothSync, true);
 
 // Sets default values for this component's properties
 USmoothSync::USmoothSync()
@@ -57,10 +60,9 @@ void USmoothSync::BeginPlay()
 {
 	Super::BeginPlay();
 
-#ifdef TimeSync
-	UE_LOG(LogTemp, Warning, TEXT("TimeSync support detected."));
-	timeSync = GetWorld()->GetGameState()->FindComponentByClass<UTimeSyncGameStateComponentBase>();
-	if (timeSync == nullptr && enableLagCompensation)
+#if WITH_SMOOTHSYNC_TIMESYNC
+	// If the GameState hasn't replicated yet, the component is looked up again once it has
+	if (enableLagCompensation && findTimeSync() == nullptr && GetWorld()->GetGameState() != nullptr)
 	{
 		enableLagCompensation = false;
 		UE_LOG(LogTemp, 
@@ -68,8 +70,7 @@ void USmoothSync::BeginPlay()
 			TEXT(
 				"Lag compensation is enabled but Time Sync is not properly configured so it won't work.\n"
 				"Falling back to built in time syncing.\n"
-				"Make sure your GameState has a TimeSyncGameStateComponent and that your are calling "
-				"SpawnTimerForPlayer from the OnPostLogin event in your GameController."
+				"Make sure your GameState has a TimeSyncGameStateComponent."
 			)
 		);
 	}
@@ -732,7 +733,7 @@ void USmoothSync::checkIfOwnerHasChanged(SmoothState* newState)
 	{
 		previousReceivedOwnerInt = ownerChangeIndicator;
 		clearBuffer();
-		ownerTimeOffsets.Empty();
+		clearOwnerTimeOffsets();
 	}
 }
 
@@ -741,6 +742,8 @@ void USmoothSync::TickComponent(float DeltaTime, ELevelTick TickType, FActorComp
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	CSV_SCOPED_TIMING_STAT(SmoothSync, TickComponent);
+
 	if (!isBeingUsed || realObjectToSync == nullptr || targetTempState == nullptr) return;
 
 	IsTicking = true;
@@ -2652,18 +2655,16 @@ float USmoothSync::GetNetworkSendInterval()
 void USmoothSync::adjustOwnerTime()
 {
 	if (stateBuffer[0] == nullptr) return;
-#ifdef TimeSync
-	if (enableLagCompensation)
+#if WITH_SMOOTHSYNC_TIMESYNC
+	float timeOffset = 0;
+	if (enableLagCompensation &&
+		(GetOwner()->GetWorld()->IsServer() || (findTimeSync() != nullptr && timeSync->GetServerTimeOffset(timeOffset))))
 	{
-		float timeOffset = 0;
-		if (!GetOwner()->GetWorld()->IsServer())
-		{
-			timeSync->GetServerTimeOffset(timeOffset);
-		}
 		ownerTime = UGameplayStatics::GetRealTimeSeconds(GetOwner()->GetWorld()) + timeOffset;
 	}
 	else
 	{
+		// Until the connection's time has been synced, fall back to the per-actor estimate
 		ownerTime = UGameplayStatics::GetRealTimeSeconds(GetOwner()->GetWorld()) + averageOwnerTimeOffset;
 	}
 #else
@@ -2681,21 +2682,52 @@ void USmoothSync::adjustOwnerTime()
 void USmoothSync::AddOwnerTimeOffset(float newOwnerTime)
 {
 	int numValuesToStore = FMath::Max(1.0f, sendRate * timeSmoothing);
-	if (ownerTimeOffsets.Num() == numValuesToStore)
+	if (ownerTimeOffsets.Num() != numValuesToStore)
 	{
-		// Remove oldest value
-		ownerTimeOffsets.RemoveAt(0, 1, false);
+		// The send rate or smoothing changed, start over with the new size
+		ownerTimeOffsets.SetNumUninitialized(numValuesToStore);
+		clearOwnerTimeOffsets();
 	}
 
 	// Calculate latest difference between local and owner time
 	float newTimeOffset = newOwnerTime - UGameplayStatics::GetRealTimeSeconds(GetOwner()->GetWorld());
-	// Add the new value
-	ownerTimeOffsets.Add(newTimeOffset);
+
+	if (ownerTimeOffsetsCount == numValuesToStore)
+	{
+		// Overwrite the oldest value
+		ownerTimeOffsetsSum -= ownerTimeOffsets[ownerTimeOffsetsStart];
+		ownerTimeOffsets[ownerTimeOffsetsStart] = newTimeOffset;
+		ownerTimeOffsetsStart = (ownerTimeOffsetsStart + 1) % numValuesToStore;
+
+		// Once per lap, rebuild the sum so rounding errors can't accumulate
+		if (ownerTimeOffsetsStart == 0)
+		{
+			ownerTimeOffsetsSum = 0;
+			for (float val : ownerTimeOffsets) ownerTimeOffsetsSum += val;
+		}
+		else
+		{
+			ownerTimeOffsetsSum += newTimeOffset;
+		}
+	}
+	else
+	{
+		ownerTimeOffsets[(ownerTimeOffsetsStart + ownerTimeOffsetsCount) % numValuesToStore] = newTimeOffset;
+		ownerTimeOffsetsCount++;
+		ownerTimeOffsetsSum += newTimeOffset;
+	}
 
 	// Update the average, since it will have changed
 	averageOwnerTimeOffset = GetAverageOwnerTimeOffset();
 }
 
+void USmoothSync::clearOwnerTimeOffsets()
+{
+	ownerTimeOffsetsStart = 0;
+	ownerTimeOffsetsCount = 0;
+	ownerTimeOffsetsSum = 0;
+}
+
 /// <summary>Get the average difference between owner and local time</summary>
 /// <remarks>
 /// Even with 0 latency, the difference from owner time is expected to vary by one owner deltaTime.
@@ -2706,11 +2738,24 @@ void USmoothSync::AddOwnerTimeOffset(float newOwnerTime)
 /// </remarks>
 float USmoothSync::GetAverageOwnerTimeOffset()
 {
-	float total = 0;
-	for (float val : ownerTimeOffsets) total += val;
-	return total / ownerTimeOffsets.Num();
+	if (ownerTimeOffsetsCount == 0) return 0;
+	return (float)(ownerTimeOffsetsSum / ownerTimeOffsetsCount);
 }
 
+#if WITH_SMOOTHSYNC_TIMESYNC
+UTimeSyncGameStateComponentBase* USmoothSync::findTimeSync()
+{
+	if (timeSync == nullptr)
+	{
+		if (AGameStateBase* gameState = GetWorld()->GetGameState())
+		{
+			timeSync = gameState->FindComponentByClass<UTimeSyncGameStateComponentBase>();
+		}
+	}
+	return timeSync;
+}
+#endif
+
 bool USmoothSync::ReplicateSubobjects(class UActorChannel * Channel, class FOutBunch * Bunch, FReplicationFlags * RepFlags)
 {
 	if (RepFlags->bNetInitial)
@@ -2729,7 +2774,7 @@ bool USmoothSync::ReplicateSubobjects(class UActorChannel * Channel, class FOutB
 //	// Can we edit flower color?
 //	if (InProperty->GetFName() == GET_MEMBER_NAME_CHECKED(USmoothSync, enableLagCompensation))
 //	{
-//#ifdef TimeSync
+//#if WITH_SMOOTHSYNC_TIMESYNC
 //		return true;
 //#else
 //		return false;
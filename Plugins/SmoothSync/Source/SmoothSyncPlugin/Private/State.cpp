@@ -3,7 +3,7 @@
 #include "State.h"
 #include "SmoothSync.h"
 #include "Engine/World.h"
-#ifdef TimeSync
+#if WITH_SMOOTHSYNC_TIMESYNC
 #include "GameFramework/GameStateBase.h"
 #include "TimeSyncGameStateComponentBase.h"
 #endif
@@ -54,7 +54,7 @@ void SmoothState::defaultTheVariables()
 
 void SmoothState::copyFromSmoothSync(USmoothSync *smoothSyncScript)
 {
-#ifdef TimeSync
+#if WITH_SMOOTHSYNC_TIMESYNC
 	if (smoothSyncScript->enableLagCompensation)
 	{
 		if (smoothSyncScript->GetOwner()->GetWorld()->IsServer())
@@ -63,8 +63,12 @@ void SmoothState::copyFromSmoothSync(USmoothSync *smoothSyncScript)
 		}
 		else
 		{
+			// Stays at 0 until this connection's time has been synced
 			float timeOffset = 0;
-			smoothSyncScript->timeSync->GetServerTimeOffset(timeOffset);
+			if (UTimeSyncGameStateComponentBase* timeSync = smoothSyncScript->findTimeSync())
+			{
+				timeSync->GetServerTimeOffset(timeOffset);
+			}
 
 			ownerTimestamp = UGameplayStatics::GetRealTimeSeconds(smoothSyncScript->GetOwner()->GetWorld()) + timeOffset;
 		}
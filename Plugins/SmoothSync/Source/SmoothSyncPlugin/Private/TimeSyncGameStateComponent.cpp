@@ -0,0 +1,165 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TimeSyncGameStateComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "TimerManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(TimeSyncGameStateComponent)
+
+//#region UTimeSyncGameStateComponent
+
+void UTimeSyncGameStateComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (autoSpawnTimers && GetOwner()->HasAuthority())
+	{
+		postLoginHandle = FGameModeEvents::GameModePostLoginEvent.AddUObject(this, &UTimeSyncGameStateComponent::HandlePostLogin);
+
+		// Players that logged in before the GameState began play
+		for (FConstPlayerControllerIterator it = GetWorld()->GetPlayerControllerIterator(); it; ++it)
+		{
+			SpawnTimerForPlayer(it->Get());
+		}
+	}
+}
+
+void UTimeSyncGameStateComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	FGameModeEvents::GameModePostLoginEvent.Remove(postLoginHandle);
+	postLoginHandle.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UTimeSyncGameStateComponent::HandlePostLogin(AGameModeBase* gameMode, APlayerController* newPlayer)
+{
+	if (gameMode && gameMode->GetWorld() == GetWorld())
+	{
+		SpawnTimerForPlayer(newPlayer);
+	}
+}
+
+void UTimeSyncGameStateComponent::SpawnTimerForPlayer(APlayerController* playerController)
+{
+	// Local players already share the server's clock
+	if (playerController == nullptr || !playerController->HasAuthority() || playerController->IsLocalController())
+	{
+		return;
+	}
+
+	if (playerController->FindComponentByClass<UTimeSyncPlayerComponent>() != nullptr)
+	{
+		return;
+	}
+
+	UTimeSyncPlayerComponent* timer = NewObject<UTimeSyncPlayerComponent>(playerController, TEXT("TimeSyncPlayerComponent"));
+	timer->RegisterComponent();
+}
+
+//#endregion UTimeSyncGameStateComponent
+
+//#region UTimeSyncPlayerComponent
+
+UTimeSyncPlayerComponent::UTimeSyncPlayerComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+}
+
+void UTimeSyncPlayerComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Only the owning client measures, the server just answers
+	APlayerController* playerController = Cast<APlayerController>(GetOwner());
+	if (playerController && playerController->IsLocalController() && !playerController->HasAuthority())
+	{
+		SendRequest();
+	}
+}
+
+void UTimeSyncPlayerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWorld* world = GetWorld())
+	{
+		world->GetTimerManager().ClearTimer(requestTimerHandle);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+UTimeSyncGameStateComponent* UTimeSyncPlayerComponent::FindGameStateComponent() const
+{
+	AGameStateBase* gameState = GetWorld()->GetGameState();
+	return gameState ? gameState->FindComponentByClass<UTimeSyncGameStateComponent>() : nullptr;
+}
+
+void UTimeSyncPlayerComponent::SendRequest()
+{
+	const UTimeSyncGameStateComponent* settings = FindGameStateComponent();
+	const int initialSyncCount = settings ? settings->initialSyncCount : 5;
+	const float initialSyncInterval = settings ? settings->initialSyncInterval : .2f;
+	const float syncInterval = settings ? settings->syncInterval : 5;
+
+	ServerRequestTime(UGameplayStatics::GetRealTimeSeconds(GetWorld()));
+	requestsSent++;
+
+	// Unreliable, so a lost request or response just means one less sample
+	const float nextRequestDelay = (requestsSent < initialSyncCount) ? initialSyncInterval : syncInterval;
+	GetWorld()->GetTimerManager().SetTimer(requestTimerHandle, this, &UTimeSyncPlayerComponent::SendRequest, nextRequestDelay, false);
+}
+
+void UTimeSyncPlayerComponent::ServerRequestTime_Implementation(double clientSendTime)
+{
+	ClientReceiveTime(clientSendTime, UGameplayStatics::GetRealTimeSeconds(GetWorld()));
+}
+
+void UTimeSyncPlayerComponent::ClientReceiveTime_Implementation(double clientSendTime, double serverTime)
+{
+	UTimeSyncGameStateComponent* gameStateComponent = FindGameStateComponent();
+	const int samplesToKeep = gameStateComponent ? gameStateComponent->samplesToKeep : 8;
+
+	const double now = UGameplayStatics::GetRealTimeSeconds(GetWorld());
+
+	// Assume the response took half of the round trip to get here
+	FTimeSyncSample sample;
+	sample.roundTripTime = now - clientSendTime;
+	sample.timeOffset = serverTime + sample.roundTripTime * 0.5 - now;
+
+	if (samples.Num() > samplesToKeep)
+	{
+		samples.Reset();
+		nextSampleIndex = 0;
+	}
+
+	if (samples.Num() < samplesToKeep)
+	{
+		samples.Add(sample);
+	}
+	else
+	{
+		samples[nextSampleIndex] = sample;
+		nextSampleIndex = (nextSampleIndex + 1) % samplesToKeep;
+	}
+
+	const FTimeSyncSample* bestSample = &samples[0];
+	for (const FTimeSyncSample& candidate : samples)
+	{
+		if (candidate.roundTripTime < bestSample->roundTripTime)
+		{
+			bestSample = &candidate;
+		}
+	}
+
+	if (gameStateComponent)
+	{
+		gameStateComponent->SetServerTimeOffset((float)bestSample->timeOffset);
+	}
+}
+
+//#endregion UTimeSyncPlayerComponent
@@ -0,0 +1,21 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TimeSyncGameStateComponentBase.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(TimeSyncGameStateComponentBase)
+
+bool UTimeSyncGameStateComponentBase::GetServerTimeOffset(float& timeOffset) const
+{
+	timeOffset = serverTimeOffset;
+	return hasServerTimeOffset;
+}
+
+void UTimeSyncGameStateComponentBase::SpawnTimerForPlayer(APlayerController* playerController)
+{
+}
+
+void UTimeSyncGameStateComponentBase::SetServerTimeOffset(float newTimeOffset)
+{
+	serverTimeOffset = newTimeOffset;
+	hasServerTimeOffset = true;
+}
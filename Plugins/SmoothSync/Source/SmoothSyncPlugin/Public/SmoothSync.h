@@ -7,7 +7,7 @@
 #include "Runtime/Engine/Classes/GameFramework/Character.h"
 #include "Runtime/Engine/Classes/GameFramework/CharacterMovementComponent.h"
 
-#ifdef TimeSync
+#if WITH_SMOOTHSYNC_TIMESYNC
 #include "GameFramework/GameStateBase.h"
 #include "TimeSyncGameStateComponentBase.h"
 #endif
@@ -53,7 +53,15 @@ private:
 	TArray<uint8> readingCharArray;
 	int readingCharArraySize = 0;
 
+	/// <summary>Ring buffer of the latest differences between owner and local time.</summary>
+	/// <remarks>
+	/// Sized to sendRate * timeSmoothing. The sum is kept up to date as values are added and removed
+	/// so the average doesn't need to walk the whole buffer for every received State.
+	/// </remarks>
 	TArray<float> ownerTimeOffsets;
+	int ownerTimeOffsetsStart = 0;
+	int ownerTimeOffsetsCount = 0;
+	double ownerTimeOffsetsSum = 0;
 	float averageOwnerTimeOffset = 0;
 	
 	int samePositionSentCount = 0;
@@ -95,10 +103,10 @@ public:
 	///
 	/// With lag compensation and an interpolation back time of 0 all objects will be at their present position
 	/// with no delay. This will cause constant extrapolation though, which is less accurate than interpolation.
-	/// This option requires the Time Sync plugin to sync time and measure latency.
+	/// This option requires a TimeSyncGameStateComponent on the GameState to sync time and measure latency.
 	/// </remarks>
-	//UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Important)
-	//	bool enableLagCompensation = false;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Important)
+		bool enableLagCompensation = false;
 
 	/// <summary>The amount of extrapolation used.</summary>
 	/// <remarks>
@@ -580,8 +588,12 @@ public:
 	/// <summary> Used to know when the owner has changed. Not an identifier. Only sent from Server. </summary>
 	uint8 ownerChangeIndicator = 1;
 
-#ifdef TimeSync
+#if WITH_SMOOTHSYNC_TIMESYNC
 	UTimeSyncGameStateComponentBase* timeSync = nullptr;
+
+	/// <summary>Returns the GameState's time sync component, looking it up the first time it is available.</summary>
+	/// <remarks>On clients the GameState may not have replicated yet when this actor begins play.</remarks>
+	UTimeSyncGameStateComponentBase* findTimeSync();
 #endif
 
 	/// <summary>
@@ -765,6 +777,9 @@ public:
 	/// </remarks>
 	void AddOwnerTimeOffset(float newOwnerTime);
 
+	/// <summary>Forget all of the stored owner time offsets, keeping the buffer allocated.</summary>
+	void clearOwnerTimeOffsets();
+
 	virtual bool ReplicateSubobjects(class UActorChannel * Channel, class FOutBunch * Bunch, FReplicationFlags * RepFlags) override;
 	
 protected:
@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "TimeSyncGameStateComponentBase.h"
+
+#include "TimeSyncGameStateComponent.generated.h"
+
+class AGameModeBase;
+class APlayerController;
+
+/// <summary>Built in time sync. Add this to your GameState to use lag compensation in Smooth Sync.</summary>
+/// <remarks>
+/// On the server a UTimeSyncPlayerComponent is added to every remote PlayerController as it logs in.
+/// That component measures the round trip to the server a few times when the player joins and then every
+/// syncInterval seconds, and keeps the offset from the sample with the lowest round trip time, since that
+/// sample has the least uncertainty in it.
+/// </remarks>
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class SMOOTHSYNCPLUGIN_API UTimeSyncGameStateComponent : public UTimeSyncGameStateComponentBase
+{
+	GENERATED_BODY()
+
+public:
+
+	/// <summary>Add a UTimeSyncPlayerComponent to every PlayerController automatically when it logs in.</summary>
+	/// <remarks>Turn this off if you'd rather call SpawnTimerForPlayer yourself.</remarks>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = TimeSync)
+		bool autoSpawnTimers = true;
+
+	/// <summary>How many round trips to measure right after joining, to get a good estimate quickly.</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = TimeSync, meta = (ClampMin = "1"))
+		int initialSyncCount = 5;
+
+	/// <summary>Time between round trips while doing the initial sync, in seconds.</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = TimeSync, meta = (ClampMin = "0.01"))
+		float initialSyncInterval = .2f;
+
+	/// <summary>Time between round trips after the initial sync, in seconds.</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = TimeSync, meta = (ClampMin = "0.1"))
+		float syncInterval = 5;
+
+	/// <summary>How many of the latest round trips to pick the best one from.</summary>
+	/// <remarks>Larger values ride out latency spikes better but take longer to react to a real change in latency.</remarks>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = TimeSync, meta = (ClampMin = "1", ClampMax = "32"))
+		int samplesToKeep = 8;
+
+	virtual void SpawnTimerForPlayer(APlayerController* playerController) override;
+
+protected:
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	void HandlePostLogin(AGameModeBase* gameMode, APlayerController* newPlayer);
+
+	FDelegateHandle postLoginHandle;
+};
+
+/// <summary>Measures the round trip between one client and the server. Added to the PlayerController by UTimeSyncGameStateComponent.</summary>
+UCLASS()
+class SMOOTHSYNCPLUGIN_API UTimeSyncPlayerComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	UTimeSyncPlayerComponent();
+
+protected:
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UFUNCTION(Server, Unreliable)
+		void ServerRequestTime(double clientSendTime);
+
+	UFUNCTION(Client, Unreliable)
+		void ClientReceiveTime(double clientSendTime, double serverTime);
+
+	void SendRequest();
+	UTimeSyncGameStateComponent* FindGameStateComponent() const;
+
+	struct FTimeSyncSample
+	{
+		double roundTripTime = 0;
+		double timeOffset = 0;
+	};
+
+	/// <summary>Ring buffer of the latest samples.</summary>
+	TArray<FTimeSyncSample> samples;
+	int nextSampleIndex = 0;
+	int requestsSent = 0;
+
+	FTimerHandle requestTimerHandle;
+};
@@ -0,0 +1,40 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Components/ActorComponent.h"
+
+#include "TimeSyncGameStateComponentBase.generated.h"
+
+class APlayerController;
+
+/// <summary>GameState component that provides the offset between local time and server time for lag compensation.</summary>
+/// <remarks>
+/// Smooth Sync looks this up on the GameState when enableLagCompensation is set. Time is synced once per connection
+/// here instead of being estimated separately by every synced actor.
+/// See UTimeSyncGameStateComponent for the built in implementation.
+/// </remarks>
+UCLASS(Abstract)
+class SMOOTHSYNCPLUGIN_API UTimeSyncGameStateComponentBase : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	/// <summary>Gets how far ahead server time is of local real time, in seconds.</summary>
+	/// <returns>False if the time has not been synced yet, in which case timeOffset is 0.</returns>
+	UFUNCTION(BlueprintCallable, Category = TimeSync)
+		virtual bool GetServerTimeOffset(float& timeOffset) const;
+
+	/// <summary>Start syncing time with the given player's connection. Only does something on the server.</summary>
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = TimeSync)
+		virtual void SpawnTimerForPlayer(APlayerController* playerController);
+
+	/// <summary>Called on clients with the latest estimate of the server time offset.</summary>
+	void SetServerTimeOffset(float newTimeOffset);
+
+protected:
+
+	float serverTimeOffset = 0;
+	bool hasServerTimeOffset = false;
+};
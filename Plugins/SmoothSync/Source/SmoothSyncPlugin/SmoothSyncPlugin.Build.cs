@@ -8,6 +8,10 @@ public class SmoothSyncPlugin : ModuleRules
 	{
 		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
 
+		// Time sync for lag compensation is built in (see UTimeSyncGameStateComponent). Public because SmoothSync.h checks it
+		// too, so it needs a name that can't clash with identifiers in the modules that include it
+		PublicDefinitions.Add("WITH_SMOOTHSYNC_TIMESYNC=1");
+
         PublicIncludePaths.AddRange(
 			new string[] {
 				// ... add public include paths required here ...
@@ -3,6 +3,7 @@
 #include "UIExtensionSystem.h"
 
 #include "Blueprint/UserWidget.h"
+#include "HAL/IConsoleManager.h"
 #include "LogUIExtension.h"
 #include "UObject/Stack.h"
 
@@ -10,6 +11,23 @@
 
 class FSubsystemCollectionBase;
 
+namespace UIExtensionCVars
+{
+	static int32 DeferAdditions = 1;
+	static FAutoConsoleVariableRef CVarDeferAdditions(
+		TEXT("UIExtension.DeferAdditions"),
+		DeferAdditions,
+		TEXT("Should extension points that allow it receive their Added notifications spread over several frames?"),
+		ECVF_Default);
+
+	static float DeferredAddBudgetMS = 2.0f;
+	static FAutoConsoleVariableRef CVarDeferredAddBudgetMS(
+		TEXT("UIExtension.DeferredAddBudgetMS"),
+		DeferredAddBudgetMS,
+		TEXT("Time in milliseconds that can be spent each frame delivering deferred extension additions (at least one is always delivered)"),
+		ECVF_Default);
+}
+
 //=========================================================
 
 void FUIExtensionPointHandle::Unregister()
@@ -89,15 +107,24 @@ void UUIExtensionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 void UUIExtensionSubsystem::Deinitialize()
 {
+	if (DeferredAddTickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(DeferredAddTickHandle);
+		DeferredAddTickHandle.Reset();
+	}
+	DeferredAdds.Reset();
+	NumDeferredAddsDelivered = 0;
+	TagAndParentsCache.Reset();
+
 	Super::Deinitialize();
 }
 
-FUIExtensionPointHandle UUIExtensionSubsystem::RegisterExtensionPoint(const FGameplayTag& ExtensionPointTag, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FExtendExtensionPointDelegate ExtensionCallback)
+FUIExtensionPointHandle UUIExtensionSubsystem::RegisterExtensionPoint(const FGameplayTag& ExtensionPointTag, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FExtendExtensionPointDelegate ExtensionCallback, bool bDeferAdditions)
 {
-	return RegisterExtensionPointForContext(ExtensionPointTag, nullptr, ExtensionPointTagMatchType, AllowedDataClasses, ExtensionCallback);
+	return RegisterExtensionPointForContext(ExtensionPointTag, nullptr, ExtensionPointTagMatchType, AllowedDataClasses, ExtensionCallback, bDeferAdditions);
 }
 
-FUIExtensionPointHandle UUIExtensionSubsystem::RegisterExtensionPointForContext(const FGameplayTag& ExtensionPointTag, UObject* ContextObject, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FExtendExtensionPointDelegate ExtensionCallback)
+FUIExtensionPointHandle UUIExtensionSubsystem::RegisterExtensionPointForContext(const FGameplayTag& ExtensionPointTag, UObject* ContextObject, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FExtendExtensionPointDelegate ExtensionCallback, bool bDeferAdditions)
 {
 	if (!ExtensionPointTag.IsValid())
 	{
@@ -125,6 +152,7 @@ FUIExtensionPointHandle UUIExtensionSubsystem::RegisterExtensionPointForContext(
 	Entry->ExtensionPointTagMatchType = ExtensionPointTagMatchType;
 	Entry->AllowedDataClasses = AllowedDataClasses;
 	Entry->Callback = MoveTemp(ExtensionCallback);
+	Entry->bDeferAdditions = bDeferAdditions;
 
 	UE_LOG(LogUIExtension, Verbose, TEXT("Extension Point [%s] Registered"), *ExtensionPointTag.ToString());
 
@@ -181,7 +209,9 @@ FUIExtensionHandle UUIExtensionSubsystem::RegisterExtensionAsData(const FGamepla
 
 void UUIExtensionSubsystem::NotifyExtensionPointOfExtensions(TSharedPtr<FUIExtensionPoint>& ExtensionPoint)
 {
-	for (FGameplayTag Tag = ExtensionPoint->ExtensionPointTag; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+	// Copy in case a callback registers a new tag and the cache grows
+	const TArray<FGameplayTag> TagAndParents = GetTagAndParents(ExtensionPoint->ExtensionPointTag);
+	for (const FGameplayTag& Tag : TagAndParents)
 	{
 		if (const FExtensionList* ListPtr = ExtensionMap.Find(Tag))
 		{
@@ -192,8 +222,7 @@ void UUIExtensionSubsystem::NotifyExtensionPointOfExtensions(TSharedPtr<FUIExten
 			{
 				if (ExtensionPoint->DoesExtensionPassContract(Extension.Get()))
 				{
-					FUIExtensionRequest Request = CreateExtensionRequest(Extension);
-					ExtensionPoint->Callback.ExecuteIfBound(EUIExtensionAction::Added, Request);
+					NotifyExtensionPoint(EUIExtensionAction::Added, ExtensionPoint, Extension);
 				}
 			}
 		}
@@ -208,7 +237,8 @@ void UUIExtensionSubsystem::NotifyExtensionPointOfExtensions(TSharedPtr<FUIExten
 void UUIExtensionSubsystem::NotifyExtensionPointsOfExtension(EUIExtensionAction Action, TSharedPtr<FUIExtension>& Extension)
 {
 	bool bOnInitialTag = true;
-	for (FGameplayTag Tag = Extension->ExtensionPointTag; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+	const TArray<FGameplayTag> TagAndParents = GetTagAndParents(Extension->ExtensionPointTag);
+	for (const FGameplayTag& Tag : TagAndParents)
 	{
 		if (const FExtensionPointList* ListPtr = ExtensionPointMap.Find(Tag))
 		{
@@ -221,8 +251,7 @@ void UUIExtensionSubsystem::NotifyExtensionPointsOfExtension(EUIExtensionAction
 				{
 					if (ExtensionPoint->DoesExtensionPassContract(Extension.Get()))
 					{
-						FUIExtensionRequest Request = CreateExtensionRequest(Extension);
-						ExtensionPoint->Callback.ExecuteIfBound(Action, Request);
+						NotifyExtensionPoint(Action, ExtensionPoint, Extension);
 					}
 				}
 			}
@@ -232,6 +261,105 @@ void UUIExtensionSubsystem::NotifyExtensionPointsOfExtension(EUIExtensionAction
 	}
 }
 
+void UUIExtensionSubsystem::NotifyExtensionPoint(EUIExtensionAction Action, const TSharedPtr<FUIExtensionPoint>& ExtensionPoint, const TSharedPtr<FUIExtension>& Extension)
+{
+	if (Action == EUIExtensionAction::Added)
+	{
+		if (ExtensionPoint->bDeferAdditions && (UIExtensionCVars::DeferAdditions != 0))
+		{
+			QueueDeferredAdd(ExtensionPoint, Extension);
+			return;
+		}
+	}
+	else if (CancelDeferredAdd(ExtensionPoint.Get(), Extension.Get()))
+	{
+		// The extension point never heard about this extension, so there's nothing to remove
+		return;
+	}
+
+	FUIExtensionRequest Request = CreateExtensionRequest(Extension);
+	ExtensionPoint->Callback.ExecuteIfBound(Action, Request);
+}
+
+const TArray<FGameplayTag>& UUIExtensionSubsystem::GetTagAndParents(const FGameplayTag& Tag)
+{
+	if (const TArray<FGameplayTag>* ExistingChain = TagAndParentsCache.Find(Tag))
+	{
+		return *ExistingChain;
+	}
+
+	TArray<FGameplayTag>& NewChain = TagAndParentsCache.Add(Tag);
+	for (FGameplayTag ParentTag = Tag; ParentTag.IsValid(); ParentTag = ParentTag.RequestDirectParent())
+	{
+		NewChain.Add(ParentTag);
+	}
+	return NewChain;
+}
+
+void UUIExtensionSubsystem::QueueDeferredAdd(const TSharedPtr<FUIExtensionPoint>& ExtensionPoint, const TSharedPtr<FUIExtension>& Extension)
+{
+	// Keep the queue ordered by priority, first come first served within the same priority (and never in front of what's already been delivered)
+	int32 InsertIndex = DeferredAdds.Num();
+	while ((InsertIndex > NumDeferredAddsDelivered) && (DeferredAdds[InsertIndex - 1].Extension->Priority < Extension->Priority))
+	{
+		--InsertIndex;
+	}
+	DeferredAdds.Insert(FDeferredExtensionAdd{ ExtensionPoint, Extension }, InsertIndex);
+
+	if (!DeferredAddTickHandle.IsValid())
+	{
+		DeferredAddTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::ProcessDeferredAdds), 0.0f);
+	}
+}
+
+bool UUIExtensionSubsystem::CancelDeferredAdd(const FUIExtensionPoint* ExtensionPoint, const FUIExtension* Extension)
+{
+	const int32 NumRemoved = DeferredAdds.RemoveAll([ExtensionPoint, Extension](const FDeferredExtensionAdd& Pending)
+	{
+		// Delivered entries are cleared, so they never match
+		return Pending.Extension.IsValid() && (Pending.Extension.Get() == Extension) && ((ExtensionPoint == nullptr) || (Pending.ExtensionPoint.Get() == ExtensionPoint));
+	});
+	return NumRemoved > 0;
+}
+
+bool UUIExtensionSubsystem::ProcessDeferredAdds(float DeltaTime)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const double BudgetSeconds = UIExtensionCVars::DeferredAddBudgetMS * 0.001;
+
+	// Delivered entries are cleared in place and only removed from the front once at the end, instead of shifting the
+	// whole queue for every delivery. The callbacks may queue or cancel other additions, but only after the delivered ones
+	NumDeferredAddsDelivered = 0;
+	while (NumDeferredAddsDelivered < DeferredAdds.Num())
+	{
+		if ((NumDeferredAddsDelivered > 0) && ((FPlatformTime::Seconds() - StartTime) >= BudgetSeconds))
+		{
+			break;
+		}
+
+		// Take it out before calling out, the callback may grow the queue
+		const FDeferredExtensionAdd Pending = MoveTemp(DeferredAdds[NumDeferredAddsDelivered]);
+		++NumDeferredAddsDelivered;
+
+		FUIExtensionRequest Request = CreateExtensionRequest(Pending.Extension);
+		Pending.ExtensionPoint->Callback.ExecuteIfBound(EUIExtensionAction::Added, Request);
+	}
+
+	const int32 NumDelivered = NumDeferredAddsDelivered;
+	DeferredAdds.RemoveAt(0, NumDelivered, /*bAllowShrinking=*/ false);
+	NumDeferredAddsDelivered = 0;
+
+	UE_LOG(LogUIExtension, VeryVerbose, TEXT("Delivered %d deferred extension(s), %d still queued"), NumDelivered, DeferredAdds.Num());
+
+	if (DeferredAdds.Num() == 0)
+	{
+		DeferredAddTickHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
 void UUIExtensionSubsystem::UnregisterExtension(const FUIExtensionHandle& ExtensionHandle)
 {
 	if (ExtensionHandle.IsValid())
@@ -252,6 +380,9 @@ void UUIExtensionSubsystem::UnregisterExtension(const FUIExtensionHandle& Extens
 
 			NotifyExtensionPointsOfExtension(EUIExtensionAction::Removed, Extension);
 
+			// Extension points that no longer match (e.g., their context went away) may still have it queued
+			CancelDeferredAdd(nullptr, Extension.Get());
+
 			ListPtr->RemoveSwap(Extension);
 			
 			if (ListPtr->Num() == 0)
@@ -277,6 +408,8 @@ void UUIExtensionSubsystem::UnregisterExtensionPoint(const FUIExtensionPointHand
 		{
 			UE_LOG(LogUIExtension, Verbose, TEXT("Extension Point [%s] Unregistered"), *ExtensionPoint->ExtensionPointTag.ToString());
 
+			DeferredAdds.RemoveAll([&ExtensionPoint](const FDeferredExtensionAdd& Pending) { return Pending.ExtensionPoint == ExtensionPoint; });
+
 			ListPtr->RemoveSwap(ExtensionPoint);
 			if (ListPtr->Num() == 0)
 			{
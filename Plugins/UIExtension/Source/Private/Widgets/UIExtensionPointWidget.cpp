@@ -89,12 +89,14 @@ void UUIExtensionPointWidget::RegisterExtensionPoint()
 
 		ExtensionPointHandles.Add(ExtensionSubsystem->RegisterExtensionPoint(
 			ExtensionPointTag, ExtensionPointTagMatch, AllowedDataClasses,
-			FExtendExtensionPointDelegate::CreateUObject(this, &ThisClass::OnAddOrRemoveExtension)
+			FExtendExtensionPointDelegate::CreateUObject(this, &ThisClass::OnAddOrRemoveExtension),
+			/*bDeferAdditions=*/ true
 		));
 
 		ExtensionPointHandles.Add(ExtensionSubsystem->RegisterExtensionPointForContext(
 			ExtensionPointTag, GetOwningLocalPlayer(), ExtensionPointTagMatch, AllowedDataClasses,
-			FExtendExtensionPointDelegate::CreateUObject(this, &ThisClass::OnAddOrRemoveExtension)
+			FExtendExtensionPointDelegate::CreateUObject(this, &ThisClass::OnAddOrRemoveExtension),
+			/*bDeferAdditions=*/ true
 		));
 	}
 }
@@ -109,7 +111,8 @@ void UUIExtensionPointWidget::RegisterExtensionPointForPlayerState(UCommonLocalP
 
 		ExtensionPointHandles.Add(ExtensionSubsystem->RegisterExtensionPointForContext(
 			ExtensionPointTag, PlayerState, ExtensionPointTagMatch, AllowedDataClasses,
-			FExtendExtensionPointDelegate::CreateUObject(this, &ThisClass::OnAddOrRemoveExtension)
+			FExtendExtensionPointDelegate::CreateUObject(this, &ThisClass::OnAddOrRemoveExtension),
+			/*bDeferAdditions=*/ true
 		));
 	}
 }
@@ -123,6 +126,8 @@ void UUIExtensionPointWidget::OnAddOrRemoveExtension(EUIExtensionAction Action,
 		TSubclassOf<UUserWidget> WidgetClass(Cast<UClass>(Data));
 		if (WidgetClass)
 		{
+			// Entries come from (and are released back to) the entry box's widget pool, so a retired widget of the
+			// same class is reused here rather than constructed again
 			UUserWidget* Widget = CreateEntryInternal(WidgetClass);
 			ExtensionMapping.Add(Request.ExtensionHandle, Widget);
 		}
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "Containers/Ticker.h"
 #include "GameplayTagContainer.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Subsystems/WorldSubsystem.h"
@@ -65,6 +66,9 @@ public:
 	TArray<TObjectPtr<UClass>> AllowedDataClasses;
 	FExtendExtensionPointDelegate Callback;
 
+	// If set, Added notifications are queued and delivered over several frames (highest priority first) instead of immediately
+	bool bDeferAdditions = false;
+
 	// Tests if the extension and the extension point match up, if they do then this extension point should learn
 	// about this extension.
 	bool DoesExtensionPassContract(const FUIExtension* Extension) const;
@@ -192,8 +196,13 @@ class UIEXTENSION_API UUIExtensionSubsystem : public UWorldSubsystem
 	GENERATED_BODY()
 
 public:
-	FUIExtensionPointHandle RegisterExtensionPoint(const FGameplayTag& ExtensionPointTag, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FExtendExtensionPointDelegate ExtensionCallback);
-	FUIExtensionPointHandle RegisterExtensionPointForContext(const FGameplayTag& ExtensionPointTag, UObject* ContextObject, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FExtendExtensionPointDelegate ExtensionCallback);
+	/**
+	 * Registers an extension point. If bDeferAdditions is set, Added callbacks are queued and delivered within a per-frame
+	 * budget (see UIExtension.DeferredAddBudgetMS), which is useful when each addition creates a widget.
+	 * Removed callbacks are always immediate, and are skipped for extensions whose Added callback was still queued.
+	 */
+	FUIExtensionPointHandle RegisterExtensionPoint(const FGameplayTag& ExtensionPointTag, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FExtendExtensionPointDelegate ExtensionCallback, bool bDeferAdditions = false);
+	FUIExtensionPointHandle RegisterExtensionPointForContext(const FGameplayTag& ExtensionPointTag, UObject* ContextObject, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FExtendExtensionPointDelegate ExtensionCallback, bool bDeferAdditions = false);
 
 	FUIExtensionHandle RegisterExtensionAsWidget(const FGameplayTag& ExtensionPointTag, TSubclassOf<UUserWidget> WidgetClass, int32 Priority);
 	FUIExtensionHandle RegisterExtensionAsWidgetForContext(const FGameplayTag& ExtensionPointTag, UObject* ContextObject, TSubclassOf<UUserWidget> WidgetClass, int32 Priority);
@@ -241,12 +250,39 @@ protected:
 
 	FUIExtensionRequest CreateExtensionRequest(const TSharedPtr<FUIExtension>& Extension);
 
+private:
+	// Delivers (or queues, for deferred extension points) a single notification
+	void NotifyExtensionPoint(EUIExtensionAction Action, const TSharedPtr<FUIExtensionPoint>& ExtensionPoint, const TSharedPtr<FUIExtension>& Extension);
+
+	// Returns the tag followed by each of its parents, cached so registrations don't keep walking the tag tree
+	const TArray<FGameplayTag>& GetTagAndParents(const FGameplayTag& Tag);
+
+	void QueueDeferredAdd(const TSharedPtr<FUIExtensionPoint>& ExtensionPoint, const TSharedPtr<FUIExtension>& Extension);
+	bool CancelDeferredAdd(const FUIExtensionPoint* ExtensionPoint, const FUIExtension* Extension);
+	bool ProcessDeferredAdds(float DeltaTime);
+
 private:
 	typedef TArray<TSharedPtr<FUIExtensionPoint>> FExtensionPointList;
 	TMap<FGameplayTag, FExtensionPointList> ExtensionPointMap;
 
 	typedef TArray<TSharedPtr<FUIExtension>> FExtensionList;
 	TMap<FGameplayTag, FExtensionList> ExtensionMap;
+
+	TMap<FGameplayTag, TArray<FGameplayTag>> TagAndParentsCache;
+
+	struct FDeferredExtensionAdd
+	{
+		TSharedPtr<FUIExtensionPoint> ExtensionPoint;
+		TSharedPtr<FUIExtension> Extension;
+	};
+
+	// Added notifications waiting for deferred extension points, sorted by descending extension priority
+	TArray<FDeferredExtensionAdd> DeferredAdds;
+
+	// Number of entries at the front of DeferredAdds already delivered this tick, they're cleared and removed in one go at the end
+	int32 NumDeferredAddsDelivered = 0;
+
+	FTSTicker::FDelegateHandle DeferredAddTickHandle;
 };
 
 
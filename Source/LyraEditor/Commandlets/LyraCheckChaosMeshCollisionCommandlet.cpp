@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraCheckChaosMeshCollisionCommandlet.h"
+
+#include "AssetRegistry/ARFilter.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/StaticMesh.h"
+#include "Utilities/CheckChaosMeshCollision.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraCheckChaosMeshCollisionCommandlet)
+
+DEFINE_LOG_CATEGORY_STATIC(LogLyraCheckChaosMeshCollision, Log, Log);
+
+ULyraCheckChaosMeshCollisionCommandlet::ULyraCheckChaosMeshCollisionCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+int32 ULyraCheckChaosMeshCollisionCommandlet::Main(const FString& FullCommandLine)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> Params;
+	ParseCommandLine(*FullCommandLine, Tokens, Switches, Params);
+
+	const FString* PathParam = Params.Find(TEXT("Path"));
+	const FString* ReportParam = Params.Find(TEXT("Report"));
+	const bool bUseCache = !Switches.Contains(TEXT("NoCache"));
+
+	int32 BatchSize = 256;
+	if (const FString* BatchSizeParam = Params.Find(TEXT("BatchSize")))
+	{
+		LexFromString(BatchSize, **BatchSizeParam);
+		BatchSize = FMath::Max(BatchSize, 1);
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UStaticMesh::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	if (PathParam)
+	{
+		Filter.PackagePaths.Add(FName(**PathParam));
+		Filter.bRecursivePaths = true;
+	}
+
+	TArray<FAssetData> MeshAssets;
+	AssetRegistry.GetAssets(Filter, MeshAssets);
+	UE_LOG(LogLyraCheckChaosMeshCollision, Display, TEXT("Checking collision of %d static mesh(es) in batches of %d"), MeshAssets.Num(), BatchSize);
+
+	LyraEditorUtilities::FChaosMeshCollisionAudit Audit(bUseCache);
+
+	// Meshes whose packages haven't changed since the last run come straight from the cache, only the rest are loaded
+	TArray<const FAssetData*> MeshesToLoad;
+	MeshesToLoad.Reserve(MeshAssets.Num());
+	for (const FAssetData& MeshAssetData : MeshAssets)
+	{
+		if (!Audit.AddCachedResult(MeshAssetData))
+		{
+			MeshesToLoad.Add(&MeshAssetData);
+		}
+	}
+	UE_LOG(LogLyraCheckChaosMeshCollision, Display, TEXT("%d static mesh(es) are unchanged since the last run, loading the other %d"), MeshAssets.Num() - MeshesToLoad.Num(), MeshesToLoad.Num());
+
+	TArray<UStaticMesh*> Batch;
+	Batch.Reserve(BatchSize);
+	for (int32 BatchStart = 0; BatchStart < MeshesToLoad.Num(); BatchStart += BatchSize)
+	{
+		Batch.Reset();
+
+		const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, MeshesToLoad.Num());
+		for (int32 AssetIndex = BatchStart; AssetIndex < BatchEnd; ++AssetIndex)
+		{
+			if (UStaticMesh* MeshAsset = Cast<UStaticMesh>(MeshesToLoad[AssetIndex]->GetAsset()))
+			{
+				Batch.Add(MeshAsset);
+			}
+			else
+			{
+				UE_LOG(LogLyraCheckChaosMeshCollision, Warning, TEXT("Failed to load %s"), *MeshesToLoad[AssetIndex]->GetObjectPathString());
+			}
+		}
+
+		Audit.CheckMeshes(Batch, *GLog);
+
+		// Drop this batch before loading the next one
+		Batch.Reset();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	if (!Audit.Finish(ReportParam ? ReportParam->TrimQuotes() : FString(), *GLog))
+	{
+		return 1;
+	}
+
+	return (Audit.GetNumMeshesWithProblems() > 0) ? 1 : 0;
+}
@@ -0,0 +1,25 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "LyraCheckChaosMeshCollisionCommandlet.generated.h"
+
+/**
+ * Checks the Chaos collision data of every static mesh in the project for degenerate triangles and writes a JSON report.
+ *
+ * Meshes unchanged since the last run (by the saved package hashes in the asset registry) come from the cache without
+ * being loaded, the rest are loaded and checked in batches so memory stays bounded. Returns 1 if any mesh has a problem, for use in nightly content checks. Usage:
+ *   UnrealEditor-Cmd LyraGame.uproject -run=LyraCheckChaosMeshCollision [-Path=/Game] [-Report=...] [-BatchSize=256] [-NoCache]
+ */
+UCLASS()
+class ULyraCheckChaosMeshCollisionCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	// Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	// End UCommandlet Interface
+};
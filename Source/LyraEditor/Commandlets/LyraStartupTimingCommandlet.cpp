@@ -0,0 +1,96 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraStartupTimingCommandlet.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraStartupTimingCommandlet)
+
+DEFINE_LOG_CATEGORY_STATIC(LogLyraStartupTiming, Log, Log);
+
+ULyraStartupTimingCommandlet::ULyraStartupTimingCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+int32 ULyraStartupTimingCommandlet::Main(const FString& FullCommandLine)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> Params;
+	ParseCommandLine(*FullCommandLine, Tokens, Switches, Params);
+
+	int32 NumRuns = 3;
+	if (const FString* RunsParam = Params.Find(TEXT("Runs")))
+	{
+		LexFromString(NumRuns, **RunsParam);
+		NumRuns = FMath::Max(NumRuns, 1);
+	}
+
+	const FString* ExtraArgsParam = Params.Find(TEXT("ExtraArgs"));
+	const FString ExtraArgs = ExtraArgsParam ? ExtraArgsParam->TrimQuotes() : FString();
+
+	// Alternate the modes so disk cache warmup affects both equally
+	double BestSerial = TNumericLimits<double>::Max();
+	double BestParallel = TNumericLimits<double>::Max();
+	for (int32 RunIndex = 0; RunIndex < NumRuns; ++RunIndex)
+	{
+		for (const bool bSerial : { true, false })
+		{
+			const double Seconds = RunStartupJobs(bSerial, ExtraArgs, RunIndex);
+			if (Seconds < 0.0)
+			{
+				UE_LOG(LogLyraStartupTiming, Error, TEXT("Run %d (%s) failed to report startup job timing"), RunIndex, bSerial ? TEXT("serial") : TEXT("parallel"));
+				return 1;
+			}
+
+			UE_LOG(LogLyraStartupTiming, Display, TEXT("Run %d (%s): %.3f seconds"), RunIndex, bSerial ? TEXT("serial") : TEXT("parallel"), Seconds);
+
+			double& Best = bSerial ? BestSerial : BestParallel;
+			Best = FMath::Min(Best, Seconds);
+		}
+	}
+
+	UE_LOG(LogLyraStartupTiming, Display, TEXT("Startup jobs (best of %d): serial %.3f seconds, parallel %.3f seconds, %.1f%% faster"),
+		NumRuns, BestSerial, BestParallel, (BestSerial > 0.0) ? (100.0 * (BestSerial - BestParallel) / BestSerial) : 0.0);
+
+	return 0;
+}
+
+double ULyraStartupTimingCommandlet::RunStartupJobs(bool bSerial, const FString& ExtraArgs, int32 RunIndex) const
+{
+	const FString ReportFile = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("StartupTiming") / FString::Printf(TEXT("Run%d_%s.txt"), RunIndex, bSerial ? TEXT("Serial") : TEXT("Parallel")));
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(ReportFile), /*Tree=*/ true);
+	IFileManager::Get().Delete(*ReportFile);
+
+	const FString Args = FString::Printf(TEXT("\"%s\" -game -nullrhi -nosound -unattended -nosplash %s -LyraStartupJobs.ReportFile=\"%s\" -LyraStartupJobs.ExitWhenDone %s"),
+		*FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath()),
+		bSerial ? TEXT("-LyraSerialStartupJobs") : TEXT(""),
+		*ReportFile,
+		*ExtraArgs);
+
+	FProcHandle ProcHandle = FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *Args, /*bLaunchDetached=*/ false, /*bLaunchHidden=*/ true, /*bLaunchReallyHidden=*/ true, nullptr, 0, nullptr, nullptr);
+	if (!ProcHandle.IsValid())
+	{
+		return -1.0;
+	}
+
+	FPlatformProcess::WaitForProc(ProcHandle);
+	FPlatformProcess::CloseProc(ProcHandle);
+
+	// The child writes "<mode>,<seconds>"
+	FString Report;
+	FString Mode;
+	FString SecondsString;
+	if (!FFileHelper::LoadFileToString(Report, *ReportFile) || !Report.Split(TEXT(","), &Mode, &SecondsString))
+	{
+		return -1.0;
+	}
+
+	double Seconds = -1.0;
+	LexFromString(Seconds, *SecondsString);
+	return Seconds;
+}
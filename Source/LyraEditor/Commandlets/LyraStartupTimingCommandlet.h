@@ -0,0 +1,29 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "LyraStartupTimingCommandlet.generated.h"
+
+/**
+ * Measures ULyraAssetManager startup job time with serial and with overlapped (parallel) job execution.
+ *
+ * Each run is a fresh -game -nullrhi process so caches from the previous run don't skew the result, and the
+ * process exits as soon as the startup jobs are done. Usage:
+ *   UnrealEditor-Cmd LyraGame.uproject -run=LyraStartupTiming [-Runs=3] [-ExtraArgs="..."]
+ */
+UCLASS()
+class ULyraStartupTimingCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	// Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	// End UCommandlet Interface
+
+private:
+	/** Launches a child process and returns the wall clock time of its startup jobs, or a negative value on failure */
+	double RunStartupJobs(bool bSerial, const FString& ExtraArgs, int32 RunIndex) const;
+};
@@ -48,7 +48,8 @@ public class LyraEditor : ModuleRules
 				"DeveloperToolSettings",
 				"CollectionManager",
 				"SourceControl",
-				"Chaos"
+				"Chaos",
+				"Json"
 			}
         );
 
@@ -1,11 +1,25 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
+#include "Utilities/CheckChaosMeshCollision.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
 #include "Chaos/TriangleMeshImplicitObject.h"
+#include "Dom/JsonObject.h"
 #include "Engine/StaticMesh.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 #include "PhysicsEngine/BodySetup.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "StaticMeshCompiler.h"
 #include "UObject/UObjectIterator.h"
 
-class FOutputDevice;
 class UWorld;
 
 namespace LyraEditorUtilities
@@ -13,14 +27,23 @@ namespace LyraEditorUtilities
 
 //////////////////////////////////////////////////////////////////////////
 
-// returns true if the mesh has one or more degenerate triangles
-bool CheckMeshDataForProblem(const Chaos::FTriangleMeshImplicitObject::ParticlesType& Particles, const Chaos::FTrimeshIndexBuffer& Elements)
+// Bump this when the check itself changes so old cached results are thrown away
+static const int32 ChaosMeshCollisionCacheVersion = 2;
+
+static FString GetChaosMeshCollisionCachePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ChaosMeshCollision") / TEXT("Cache.json");
+}
+
+// returns the number of degenerate triangles in the mesh
+int32 CountDegenerateTriangles(const Chaos::FTriangleMeshImplicitObject::ParticlesType& Particles, const Chaos::FTrimeshIndexBuffer& Elements)
 {
 	// Internal helper because the index buffer type is templated
-	auto CheckTris = [&](const auto& Elements, int32 NumTriangles)
+	auto CountTris = [&](const auto& Elements, int32 NumTriangles)
 	{
 		using VecType = Chaos::FTriangleMeshImplicitObject::ParticleVecType;
 
+		int32 NumDegenerate = 0;
 		for (int32 FaceIdx = 0; FaceIdx < NumTriangles; ++FaceIdx)
 		{
 			const VecType& A = Particles.X(Elements[FaceIdx][0]);
@@ -33,54 +56,370 @@ bool CheckMeshDataForProblem(const Chaos::FTriangleMeshImplicitObject::Particles
 
 			if (Normal.SafeNormalize() < SMALL_NUMBER)
 			{
-				return true;
+				++NumDegenerate;
 			}
 		}
 
-		return false;
+		return NumDegenerate;
 	};
 
 	const int32 NumTriangles = Elements.GetNumTriangles();
 	if (Elements.RequiresLargeIndices())
 	{
-		return CheckTris(Elements.GetLargeIndexBuffer(), NumTriangles);
+		return CountTris(Elements.GetLargeIndexBuffer(), NumTriangles);
 	}
 	else
 	{
-		return CheckTris(Elements.GetSmallIndexBuffer(), NumTriangles);
+		return CountTris(Elements.GetSmallIndexBuffer(), NumTriangles);
 	}
 }
 
-void CheckChaosMeshCollision(FOutputDevice& Ar)
+// Unsaved changes aren't in the saved hash, so meshes in (or using) a dirty package are always checked
+static bool IsPackageDirty(const UObject* Object)
 {
-	for (UStaticMesh* MeshAsset : TObjectRange<UStaticMesh>())
+	const UPackage* Package = Object ? Object->GetPackage() : nullptr;
+	return Package && Package->IsDirty();
+}
+
+FChaosMeshCollisionAudit::FChaosMeshCollisionAudit(bool bInUseCache)
+	: AssetRegistry(FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get())
+	, bUseCache(bInUseCache)
+{
+	if (bUseCache)
+	{
+		LoadCache();
+	}
+}
+
+// The collision is cooked from the mesh package and, when it has one, the package of its ComplexCollisionMesh
+FString FChaosMeshCollisionAudit::GetCollisionCacheKey(FName MeshPackage, FName ComplexCollisionPackage) const
+{
+	auto GetSavedHash = [this](FName PackageName, FString& OutHash)
+	{
+		const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+		if (!PackageData.IsSet() || PackageData->GetPackageSavedHash().IsZero())
+		{
+			return false;
+		}
+
+		OutHash = LexToString(PackageData->GetPackageSavedHash());
+		return true;
+	};
+
+	FString MeshHash;
+	if (!GetSavedHash(MeshPackage, MeshHash))
+	{
+		return FString();
+	}
+
+	FString ComplexCollisionHash = TEXT("None");
+	if (!ComplexCollisionPackage.IsNone() && (ComplexCollisionPackage != MeshPackage) && !GetSavedHash(ComplexCollisionPackage, ComplexCollisionHash))
+	{
+		return FString();
+	}
+
+	return FString::Printf(TEXT("%d_%s_%s"), ChaosMeshCollisionCacheVersion, *MeshHash, *ComplexCollisionHash);
+}
+
+bool FChaosMeshCollisionAudit::AddCachedResult(const FAssetData& MeshAssetData)
+{
+	if (!bUseCache)
+	{
+		return false;
+	}
+
+	const FString MeshPath = MeshAssetData.GetObjectPathString();
+	const FCachedResult* CachedResult = Cache.Find(MeshPath);
+	if (CachedResult == nullptr)
+	{
+		return false;
+	}
+
+	// A changed ComplexCollisionMesh reference changes the mesh package too, so the one from the cache is still current if the key matches
+	const FString CacheKey = GetCollisionCacheKey(MeshAssetData.PackageName, CachedResult->ComplexCollisionPackage);
+	if (CacheKey.IsEmpty() || (CacheKey != CachedResult->CacheKey) || IsPackageDirty(MeshAssetData.FastGetAsset()))
+	{
+		return false;
+	}
+
+	FMeshResult& Result = Results.AddDefaulted_GetRef();
+	Result.MeshPath = MeshPath;
+	Result.CacheKey = CacheKey;
+	Result.NumDegenerateTriangles = CachedResult->NumDegenerateTriangles;
+	Result.bFromCache = true;
+	return true;
+}
+
+void FChaosMeshCollisionAudit::CheckMeshes(TConstArrayView<UStaticMesh*> Meshes, FOutputDevice& Ar)
+{
+	struct FCheckJob
+	{
+		int32 ResultIndex = INDEX_NONE;
+		UStaticMesh* MeshAsset = nullptr;
+		FName ComplexCollisionPackage;
+		decltype(UBodySetup::ChaosTriMeshes) TriMeshes;
+	};
+	TArray<FCheckJob> Jobs;
+	int32 NumFromCache = 0;
+
+	for (UStaticMesh* MeshAsset : Meshes)
+	{
+		if ((MeshAsset == nullptr) || (MeshAsset->GetBodySetup() == nullptr))
+		{
+			continue;
+		}
+
+		const UStaticMesh* ComplexCollisionMesh = MeshAsset->ComplexCollisionMesh;
+		const FName ComplexCollisionPackage = ComplexCollisionMesh ? ComplexCollisionMesh->GetPackage()->GetFName() : NAME_None;
+
+		FMeshResult& Result = Results.AddDefaulted_GetRef();
+		Result.MeshPath = MeshAsset->GetPathName();
+		if (!IsPackageDirty(MeshAsset) && !IsPackageDirty(ComplexCollisionMesh))
+		{
+			Result.CacheKey = GetCollisionCacheKey(MeshAsset->GetPackage()->GetFName(), ComplexCollisionPackage);
+		}
+
+		if (bUseCache && !Result.CacheKey.IsEmpty())
+		{
+			const FCachedResult* CachedResult = Cache.Find(Result.MeshPath);
+			if (CachedResult && (CachedResult->CacheKey == Result.CacheKey))
+			{
+				Result.NumDegenerateTriangles = CachedResult->NumDegenerateTriangles;
+				Result.bFromCache = true;
+				++NumFromCache;
+				continue;
+			}
+		}
+
+		FCheckJob& Job = Jobs.AddDefaulted_GetRef();
+		Job.ResultIndex = Results.Num() - 1;
+		Job.MeshAsset = MeshAsset;
+		Job.ComplexCollisionPackage = ComplexCollisionPackage;
+	}
+
+	// The collision isn't there until the mesh has finished compiling
+	TArray<UStaticMesh*> CompilingMeshes;
+	for (const FCheckJob& Job : Jobs)
+	{
+		if (Job.MeshAsset->IsCompiling())
+		{
+			CompilingMeshes.Add(Job.MeshAsset);
+		}
+	}
+	if (CompilingMeshes.Num() > 0)
+	{
+		FStaticMeshCompilingManager::Get().FinishCompilation(CompilingMeshes);
+	}
+
+	// Snapshot the collision of every mesh that needs checking, the shared pointers keep it alive while the workers read it
+	for (FCheckJob& Job : Jobs)
+	{
+		UBodySetup* BodySetup = Job.MeshAsset->GetBodySetup();
+		if (!BodySetup->bCreatedPhysicsMeshes)
+		{
+			BodySetup->CreatePhysicsMeshes();
+		}
+		Job.TriMeshes = BodySetup->ChaosTriMeshes;
+	}
+
+	ParallelFor(Jobs.Num(), [this, &Jobs](int32 JobIndex)
 	{
-		if (UBodySetup* BodySetup = MeshAsset->GetBodySetup())
+		const FCheckJob& Job = Jobs[JobIndex];
+
+		int32 NumDegenerate = 0;
+		for (const auto& TriMesh : Job.TriMeshes)
 		{
-			for (const TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>& TriMesh : BodySetup->ChaosTriMeshes)
+			if (const Chaos::FTriangleMeshImplicitObject* TriMeshData = TriMesh.Get())
 			{
-				if (Chaos::FTriangleMeshImplicitObject* TriMeshData = TriMesh.Get())
+				NumDegenerate += CountDegenerateTriangles(TriMeshData->Particles(), TriMeshData->Elements());
+			}
+		}
+
+		// Each job owns its own result
+		Results[Job.ResultIndex].NumDegenerateTriangles = NumDegenerate;
+	});
+
+	for (const FCheckJob& Job : Jobs)
+	{
+		const FMeshResult& Result = Results[Job.ResultIndex];
+		if (Result.NumDegenerateTriangles > 0)
+		{
+			UE_LOG(LogConsoleResponse, Warning, TEXT("Mesh asset %s has %d degenerate triangle(s) in collision data"), *Result.MeshPath, Result.NumDegenerateTriangles);
+		}
+
+		if (!Result.CacheKey.IsEmpty())
+		{
+			Cache.Add(Result.MeshPath, { Result.CacheKey, Job.ComplexCollisionPackage, Result.NumDegenerateTriangles });
+		}
+	}
+
+	Ar.Logf(TEXT("Checked collision of %d mesh(es), %d were unchanged since the last run"), Jobs.Num(), NumFromCache);
+}
+
+int32 FChaosMeshCollisionAudit::GetNumMeshesWithProblems() const
+{
+	int32 NumWithProblems = 0;
+	for (const FMeshResult& Result : Results)
+	{
+		NumWithProblems += (Result.NumDegenerateTriangles > 0) ? 1 : 0;
+	}
+	return NumWithProblems;
+}
+
+FString FChaosMeshCollisionAudit::GetDefaultReportPath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ChaosMeshCollision") / TEXT("Report.json");
+}
+
+bool FChaosMeshCollisionAudit::Finish(const FString& ReportPath, FOutputDevice& Ar)
+{
+	if (bUseCache)
+	{
+		SaveCache();
+	}
+
+	int32 NumFromCache = 0;
+	TArray<TSharedPtr<FJsonValue>> ProblemMeshes;
+	for (const FMeshResult& Result : Results)
+	{
+		NumFromCache += Result.bFromCache ? 1 : 0;
+
+		// Cached problems are reported again, they're still in the content
+		if (Result.NumDegenerateTriangles > 0)
+		{
+			TSharedRef<FJsonObject> MeshObject = MakeShared<FJsonObject>();
+			MeshObject->SetStringField(TEXT("mesh"), Result.MeshPath);
+			MeshObject->SetNumberField(TEXT("degenerateTriangles"), Result.NumDegenerateTriangles);
+			MeshObject->SetBoolField(TEXT("cached"), Result.bFromCache);
+			ProblemMeshes.Add(MakeShared<FJsonValueObject>(MeshObject));
+		}
+	}
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetNumberField(TEXT("meshesChecked"), Results.Num());
+	Report->SetNumberField(TEXT("meshesFromCache"), NumFromCache);
+	Report->SetNumberField(TEXT("meshesWithProblems"), ProblemMeshes.Num());
+	Report->SetArrayField(TEXT("problems"), ProblemMeshes);
+
+	FString ReportText;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ReportText);
+	FJsonSerializer::Serialize(Report, Writer);
+
+	const FString FullReportPath = FPaths::ConvertRelativePathToFull(ReportPath.IsEmpty() ? GetDefaultReportPath() : ReportPath);
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(FullReportPath), /*Tree=*/ true);
+	if (!FFileHelper::SaveStringToFile(ReportText, *FullReportPath))
+	{
+		Ar.Logf(ELogVerbosity::Error, TEXT("Failed to write Chaos mesh collision report to %s"), *FullReportPath);
+		return false;
+	}
+
+	Ar.Logf(TEXT("%d of %d mesh(es) have degenerate collision triangles (%d results from cache). Report written to %s"),
+		ProblemMeshes.Num(), Results.Num(), NumFromCache, *FullReportPath);
+	return true;
+}
+
+void FChaosMeshCollisionAudit::LoadCache()
+{
+	FString CacheText;
+	if (!FFileHelper::LoadFileToString(CacheText, *GetChaosMeshCollisionCachePath()))
+	{
+		return;
+	}
+
+	TSharedPtr<FJsonObject> CacheObject;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(CacheText), CacheObject) || !CacheObject.IsValid())
+	{
+		return;
+	}
+
+	if (CacheObject->GetIntegerField(TEXT("version")) != ChaosMeshCollisionCacheVersion)
+	{
+		return;
+	}
+
+	const TSharedPtr<FJsonObject>* MeshesObject = nullptr;
+	if (CacheObject->TryGetObjectField(TEXT("meshes"), MeshesObject))
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*MeshesObject)->Values)
+		{
+			const TSharedPtr<FJsonObject>* EntryObject = nullptr;
+			if (Pair.Value.IsValid() && Pair.Value->TryGetObject(EntryObject))
+			{
+				FCachedResult& CachedResult = Cache.Add(Pair.Key);
+				CachedResult.CacheKey = (*EntryObject)->GetStringField(TEXT("key"));
+				FString ComplexCollisionPackage;
+				if ((*EntryObject)->TryGetStringField(TEXT("complexCollisionPackage"), ComplexCollisionPackage))
 				{
-					if (CheckMeshDataForProblem(TriMeshData->Particles(), TriMeshData->Elements()))
-					{
-						UE_LOG(LogConsoleResponse, Warning, TEXT("Mesh asset %s has one or more degenerate triangles in collision data"), *GetPathNameSafe(MeshAsset));
-					}
+					CachedResult.ComplexCollisionPackage = FName(*ComplexCollisionPackage);
 				}
+				CachedResult.NumDegenerateTriangles = (*EntryObject)->GetIntegerField(TEXT("degenerateTriangles"));
 			}
 		}
 	}
 }
 
+void FChaosMeshCollisionAudit::SaveCache() const
+{
+	TSharedRef<FJsonObject> MeshesObject = MakeShared<FJsonObject>();
+	for (const TPair<FString, FCachedResult>& Pair : Cache)
+	{
+		TSharedRef<FJsonObject> EntryObject = MakeShared<FJsonObject>();
+		EntryObject->SetStringField(TEXT("key"), Pair.Value.CacheKey);
+		if (!Pair.Value.ComplexCollisionPackage.IsNone())
+		{
+			EntryObject->SetStringField(TEXT("complexCollisionPackage"), Pair.Value.ComplexCollisionPackage.ToString());
+		}
+		EntryObject->SetNumberField(TEXT("degenerateTriangles"), Pair.Value.NumDegenerateTriangles);
+		MeshesObject->SetObjectField(Pair.Key, EntryObject);
+	}
+
+	TSharedRef<FJsonObject> CacheObject = MakeShared<FJsonObject>();
+	CacheObject->SetNumberField(TEXT("version"), ChaosMeshCollisionCacheVersion);
+	CacheObject->SetObjectField(TEXT("meshes"), MeshesObject);
+
+	FString CacheText;
+	FJsonSerializer::Serialize(CacheObject, TJsonWriterFactory<>::Create(&CacheText));
+
+	const FString CachePath = GetChaosMeshCollisionCachePath();
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(CachePath), /*Tree=*/ true);
+	FFileHelper::SaveStringToFile(CacheText, *CachePath);
+}
+
 FAutoConsoleCommandWithWorldArgsAndOutputDevice GCheckChaosMeshCollisionCmd(
 	TEXT("Lyra.CheckChaosMeshCollision"),
 	TEXT("Usage:\n")
-	TEXT("  Lyra.CheckChaosMeshCollision\n")
+	TEXT("  Lyra.CheckChaosMeshCollision [ReportPath] [-NoCache]\n")
 	TEXT("\n")
-	TEXT("It will check Chaos collision data for all *loaded* static mesh assets for any degenerate triangles"),
+	TEXT("It will check Chaos collision data for all *loaded* static mesh assets for any degenerate triangles,\n")
+	TEXT("and write a JSON report (Saved/ChaosMeshCollision/Report.json by default).\n")
+	TEXT("Meshes that are unchanged since the last run are skipped unless -NoCache is passed.\n")
+	TEXT("Use the LyraCheckChaosMeshCollision commandlet to check every static mesh in the project."),
 	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(
 		[](const TArray<FString>& Params, UWorld* World, FOutputDevice& Ar)
 {
-	CheckChaosMeshCollision(Ar);
+	FString ReportPath;
+	bool bUseCache = true;
+	for (const FString& Param : Params)
+	{
+		if (Param.Equals(TEXT("-NoCache"), ESearchCase::IgnoreCase))
+		{
+			bUseCache = false;
+		}
+		else
+		{
+			ReportPath = Param;
+		}
+	}
+
+	TArray<UStaticMesh*> Meshes;
+	for (UStaticMesh* MeshAsset : TObjectRange<UStaticMesh>())
+	{
+		Meshes.Add(MeshAsset);
+	}
+
+	FChaosMeshCollisionAudit Audit(bUseCache);
+	Audit.CheckMeshes(Meshes, Ar);
+	Audit.Finish(ReportPath, Ar);
 }));
 
 
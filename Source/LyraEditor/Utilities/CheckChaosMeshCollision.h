@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+#include "Containers/Map.h"
+#include "Containers/UnrealString.h"
+
+class FOutputDevice;
+class IAssetRegistry;
+class UStaticMesh;
+struct FAssetData;
+
+namespace LyraEditorUtilities
+{
+
+/**
+ * Looks for degenerate triangles in the Chaos collision data of static meshes.
+ *
+ * The triangle checks run on worker threads over a snapshot of each mesh's collision data. Results are cached on disk,
+ * keyed on the saved hash of the mesh's package and of its ComplexCollisionMesh's package from the asset registry, so
+ * meshes that haven't changed since the last run aren't loaded or checked again.
+ * Used by the Lyra.CheckChaosMeshCollision console command and ULyraCheckChaosMeshCollisionCommandlet.
+ */
+class FChaosMeshCollisionAudit
+{
+public:
+	explicit FChaosMeshCollisionAudit(bool bInUseCache = true);
+
+	/** Adds the cached result for the mesh to the report if its packages haven't changed since it was checked, without loading it */
+	bool AddCachedResult(const FAssetData& MeshAssetData);
+
+	/** Checks the given meshes and adds them to the report, can be called several times (e.g., once per batch of loaded assets) */
+	void CheckMeshes(TConstArrayView<UStaticMesh*> Meshes, FOutputDevice& Ar);
+
+	/** Writes the JSON report and saves the cache, returns false if the report couldn't be written */
+	bool Finish(const FString& ReportPath, FOutputDevice& Ar);
+
+	int32 GetNumMeshesChecked() const { return Results.Num(); }
+	int32 GetNumMeshesWithProblems() const;
+
+	static FString GetDefaultReportPath();
+
+private:
+	struct FMeshResult
+	{
+		FString MeshPath;
+		FString CacheKey;
+		int32 NumDegenerateTriangles = 0;
+		bool bFromCache = false;
+	};
+
+	struct FCachedResult
+	{
+		FString CacheKey;
+		FName ComplexCollisionPackage;
+		int32 NumDegenerateTriangles = 0;
+	};
+
+	FString GetCollisionCacheKey(FName MeshPackage, FName ComplexCollisionPackage) const;
+
+	void LoadCache();
+	void SaveCache() const;
+
+	TArray<FMeshResult> Results;
+	TMap<FString, FCachedResult> Cache;
+	IAssetRegistry& AssetRegistry;
+	bool bUseCache = true;
+};
+
+}; // End of namespace
@@ -9,6 +9,7 @@
 #include "GameFramework/Pawn.h"
 #include "LyraGlobalAbilitySystem.h"
 #include "LyraLogChannels.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 #include "System/LyraAssetManager.h"
 #include "System/LyraGameData.h"
 
@@ -16,6 +17,8 @@
 
 UE_DEFINE_GAMEPLAY_TAG(TAG_Gameplay_AbilityInputBlocked, "Gameplay.AbilityInputBlocked");
 
+CSV_DEFINE_CATEGORY(LyraAbilities, true);
+
 ULyraAbilitySystemComponent::ULyraAbilitySystemComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -212,6 +215,8 @@ void ULyraAbilitySystemComponent::AbilityInputTagReleased(const FGameplayTag& In
 
 void ULyraAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGamePaused)
 {
+	CSV_SCOPED_TIMING_STAT(LyraAbilities, ProcessAbilityInput);
+
 	if (HasMatchingGameplayTag(TAG_Gameplay_AbilityInputBlocked))
 	{
 		ClearAbilityInput();
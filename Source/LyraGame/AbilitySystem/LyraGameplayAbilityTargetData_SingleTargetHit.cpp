@@ -2,7 +2,9 @@
 
 #include "LyraGameplayAbilityTargetData_SingleTargetHit.h"
 
+#include "Engine/NetSerialization.h"
 #include "LyraGameplayEffectContext.h"
+#include "UObject/CoreNet.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraGameplayAbilityTargetData_SingleTargetHit)
 
@@ -10,6 +12,165 @@ struct FGameplayEffectContextHandle;
 
 //////////////////////////////////////////////////////////////////////
 
+namespace LyraTargetDataSerialization
+{
+	// Bits per axis for the octahedral normal encoding (~0.05 degrees worst case)
+	static constexpr int32 NormalBitsPerAxis = 12;
+	static constexpr uint32 NormalAxisMax = (1u << NormalBitsPerAxis) - 1;
+
+	enum EHitFlags : uint16
+	{
+		HitFlag_BlockingHit				= 1 << 0,
+		HitFlag_ImpactPointIsLocation	= 1 << 1,
+		HitFlag_ImpactNormalIsNormal	= 1 << 2,
+		HitFlag_HasNormal				= 1 << 3,
+		HitFlag_HasHitObject			= 1 << 4,
+		HitFlag_HasComponent			= 1 << 5,
+		HitFlag_HasPhysMaterial			= 1 << 6,
+		HitFlag_HasBoneName				= 1 << 7,
+		HitFlag_HasImpactNormal			= 1 << 8,
+	};
+	static constexpr uint32 NumHitFlags = 9;
+
+	static double NonZeroSign(double Value)
+	{
+		return (Value >= 0.0) ? 1.0 : -1.0;
+	}
+
+	static void EncodeNormal(const FVector& Normal, uint32& OutU, uint32& OutV)
+	{
+		const FVector N = Normal.GetSafeNormal(UE_SMALL_NUMBER, FVector::UpVector);
+		const double L1 = FMath::Abs(N.X) + FMath::Abs(N.Y) + FMath::Abs(N.Z);
+		double U = N.X / L1;
+		double V = N.Y / L1;
+		if (N.Z < 0.0)
+		{
+			const double OldU = U;
+			U = (1.0 - FMath::Abs(V)) * NonZeroSign(OldU);
+			V = (1.0 - FMath::Abs(OldU)) * NonZeroSign(V);
+		}
+
+		OutU = (uint32)FMath::Clamp(FMath::RoundToInt32((U * 0.5 + 0.5) * NormalAxisMax), 0, (int32)NormalAxisMax);
+		OutV = (uint32)FMath::Clamp(FMath::RoundToInt32((V * 0.5 + 0.5) * NormalAxisMax), 0, (int32)NormalAxisMax);
+	}
+
+	static FVector DecodeNormal(uint32 InU, uint32 InV)
+	{
+		const double U = ((double)InU / NormalAxisMax) * 2.0 - 1.0;
+		const double V = ((double)InV / NormalAxisMax) * 2.0 - 1.0;
+		FVector N(U, V, 1.0 - FMath::Abs(U) - FMath::Abs(V));
+		if (N.Z < 0.0)
+		{
+			const double OldX = N.X;
+			N.X = (1.0 - FMath::Abs(N.Y)) * NonZeroSign(OldX);
+			N.Y = (1.0 - FMath::Abs(OldX)) * NonZeroSign(N.Y);
+		}
+		return N.GetSafeNormal();
+	}
+
+	static void SerializeNormal(FArchive& Ar, FVector& Normal)
+	{
+		uint32 U = 0;
+		uint32 V = 0;
+		if (Ar.IsSaving())
+		{
+			EncodeNormal(Normal, U, V);
+		}
+
+		Ar.SerializeInt(U, NormalAxisMax + 1);
+		Ar.SerializeInt(V, NormalAxisMax + 1);
+
+		if (Ar.IsLoading())
+		{
+			Normal = DecodeNormal(U, V);
+		}
+	}
+
+	static bool SerializeHitResult(FArchive& Ar, UPackageMap* Map, FHitResult& Hit)
+	{
+		uint16 Flags = 0;
+		if (Ar.IsSaving())
+		{
+			// Each normal has its own bit since a zero normal can't be encoded (it would come back as a unit vector)
+			const bool bImpactNormalIsNormal = (Hit.ImpactNormal == Hit.Normal);
+			Flags |= Hit.bBlockingHit ? HitFlag_BlockingHit : 0;
+			Flags |= (Hit.ImpactPoint == Hit.Location) ? HitFlag_ImpactPointIsLocation : 0;
+			Flags |= bImpactNormalIsNormal ? HitFlag_ImpactNormalIsNormal : 0;
+			Flags |= !Hit.Normal.IsNearlyZero() ? HitFlag_HasNormal : 0;
+			Flags |= (!bImpactNormalIsNormal && !Hit.ImpactNormal.IsNearlyZero()) ? HitFlag_HasImpactNormal : 0;
+			Flags |= Hit.HitObjectHandle.IsValid() ? HitFlag_HasHitObject : 0;
+			Flags |= Hit.Component.IsValid() ? HitFlag_HasComponent : 0;
+			Flags |= Hit.PhysMaterial.IsValid() ? HitFlag_HasPhysMaterial : 0;
+			Flags |= (Hit.BoneName != NAME_None) ? HitFlag_HasBoneName : 0;
+		}
+		else
+		{
+			// Start clean so the fields we don't send keep their defaults
+			Hit = FHitResult();
+		}
+
+		uint32 SerializedFlags = Flags;
+		Ar.SerializeInt(SerializedFlags, 1u << NumHitFlags);
+		Flags = (uint16)SerializedFlags;
+
+		bool bSuccess = true;
+
+		bSuccess &= SerializePackedVector<1, 24>(Hit.TraceStart, Ar);
+		bSuccess &= SerializePackedVector<1, 24>(Hit.TraceEnd, Ar);
+		bSuccess &= SerializePackedVector<1, 24>(Hit.Location, Ar);
+		if ((Flags & HitFlag_ImpactPointIsLocation) == 0)
+		{
+			bSuccess &= SerializePackedVector<1, 24>(Hit.ImpactPoint, Ar);
+		}
+
+		if (Flags & HitFlag_HasNormal)
+		{
+			SerializeNormal(Ar, Hit.Normal);
+		}
+		if (Flags & HitFlag_HasImpactNormal)
+		{
+			SerializeNormal(Ar, Hit.ImpactNormal);
+		}
+
+		if (Flags & HitFlag_HasHitObject)
+		{
+			Ar << Hit.HitObjectHandle;
+		}
+		if (Flags & HitFlag_HasComponent)
+		{
+			Ar << Hit.Component;
+		}
+		if (Flags & HitFlag_HasPhysMaterial)
+		{
+			Ar << Hit.PhysMaterial;
+		}
+		if (Flags & HitFlag_HasBoneName)
+		{
+			Ar << Hit.BoneName;
+		}
+
+		if (Ar.IsLoading())
+		{
+			Hit.bBlockingHit = (Flags & HitFlag_BlockingHit) != 0;
+			if (Flags & HitFlag_ImpactPointIsLocation)
+			{
+				Hit.ImpactPoint = Hit.Location;
+			}
+			if (Flags & HitFlag_ImpactNormalIsNormal)
+			{
+				Hit.ImpactNormal = Hit.Normal;
+			}
+
+			// Re-derived instead of sent
+			const double TraceLength = FVector::Dist(Hit.TraceStart, Hit.TraceEnd);
+			Hit.Distance = (float)FVector::Dist(Hit.TraceStart, Hit.Location);
+			Hit.Time = (TraceLength > UE_KINDA_SMALL_NUMBER) ? (float)FMath::Clamp(Hit.Distance / TraceLength, 0.0, 1.0) : 1.0f;
+		}
+
+		return bSuccess;
+	}
+}
+
 void FLyraGameplayAbilityTargetData_SingleTargetHit::AddTargetDataToContext(FGameplayEffectContextHandle& Context, bool bIncludeActorArray) const
 {
 	FGameplayAbilityTargetData_SingleTargetHit::AddTargetDataToContext(Context, bIncludeActorArray);
@@ -23,10 +184,16 @@ void FLyraGameplayAbilityTargetData_SingleTargetHit::AddTargetDataToContext(FGam
 
 bool FLyraGameplayAbilityTargetData_SingleTargetHit::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
 {
-	FGameplayAbilityTargetData_SingleTargetHit::NetSerialize(Ar, Map, bOutSuccess);
+	bOutSuccess = LyraTargetDataSerialization::SerializeHitResult(Ar, Map, HitResult);
 
-	Ar << CartridgeID;
+	// Cartridge IDs count up per shot from the ranged weapon ability (with -1 meaning none), so they usually pack into a byte or two.
+	// Any value round trips unchanged, larger ones just cost more bytes
+	uint32 PackedCartridgeID = (uint32)CartridgeID + 1u;
+	Ar.SerializeIntPacked(PackedCartridgeID);
+	if (Ar.IsLoading())
+	{
+		CartridgeID = (int32)(PackedCartridgeID - 1u);
+	}
 
 	return true;
 }
-
@@ -22,10 +22,22 @@ struct FLyraGameplayAbilityTargetData_SingleTargetHit : public FGameplayAbilityT
 
 	virtual void AddTargetDataToContext(FGameplayEffectContextHandle& Context, bool bIncludeActorArray) const override;
 
-	/** ID to allow the identification of multiple bullets that were part of the same cartridge */
+	/**
+	 * ID to allow the identification of multiple bullets that were part of the same cartridge.
+	 * Only unique among the shots of one ranged weapon ability instance (it counts up per shot), not across players.
+	 */
 	UPROPERTY()
 	int32 CartridgeID;
 
+	/**
+	 * Compact replacement for FHitResult::NetSerialize, sent from the shooting client to the server.
+	 * Positions are quantized to 1cm, normals are octahedral-encoded, and fields the server either re-derives
+	 * (Distance, Time) or never reads (face/item/element indices, penetration) are not sent.
+	 * Only the legacy path is hand-written. Under Iris the struct has no NetSerializer of its own: it is listed in
+	 * SupportsStructNetSerializerList (DefaultEngine.ini), so the generic last-resort serializer wraps the bits this writes,
+	 * without Iris quantization or delta compression of its own.
+	 * The round trip is covered by the Lyra.Net.TargetDataSerialization automation tests.
+	 */
 	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
 
 	virtual UScriptStruct* GetScriptStruct() const override
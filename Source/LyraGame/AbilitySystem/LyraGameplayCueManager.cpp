@@ -1,7 +1,12 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "LyraGameplayCueManager.h"
+#include "AbilitySystemComponent.h"
 #include "Engine/AssetManager.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
 #include "LyraLogChannels.h"
 #include "GameplayCueSet.h"
 #include "AbilitySystemGlobals.h"
@@ -35,6 +40,13 @@ namespace LyraGameplayCueManagerCvars
 		FConsoleCommandWithArgsDelegate::CreateStatic(ULyraGameplayCueManager::DumpGameplayCues));
 
 	static ELyraEditorLoadMode LoadMode = ELyraEditorLoadMode::LoadUpfront;
+
+	static int32 MaxPreloadsPerFrame = 8;
+	static FAutoConsoleVariableRef CVarMaxPreloadsPerFrame(
+		TEXT("Lyra.GameplayCues.MaxPreloadsPerFrame"),
+		MaxPreloadsPerFrame,
+		TEXT("How many gameplay cue preloads can be started per frame. Cues used by local players' abilities go first. 0 starts them all immediately."),
+		ECVF_Default);
 }
 
 const bool bPreloadEvenInEditor = true;
@@ -175,6 +187,7 @@ void ULyraGameplayCueManager::DumpGameplayCues(const TArray<FString>& Args)
 	UE_LOG(LogLyra, Log, TEXT("  ... %d cues in preloaded list"), GCM->PreloadedCues.Num());
 	UE_LOG(LogLyra, Log, TEXT("  ... %d cues loaded on demand"), NumMissingCuesLoaded);
 	UE_LOG(LogLyra, Log, TEXT("  ... %d cues in total"), GCM->AlwaysLoadedCues.Num() + GCM->PreloadedCues.Num() + NumMissingCuesLoaded);
+	UE_LOG(LogLyra, Log, TEXT("  ... %d cue preloads pending (%d queued, %d loading)"), GCM->GetNumPendingCuePreloads(), GCM->QueuedCuePreloads.Num(), GCM->InFlightCuePreloads.Num());
 }
 
 void ULyraGameplayCueManager::OnGameplayTagLoaded(const FGameplayTag& Tag)
@@ -209,6 +222,10 @@ void ULyraGameplayCueManager::OnGameplayTagLoaded(const FGameplayTag& Tag)
 
 void ULyraGameplayCueManager::HandlePostGarbageCollect()
 {
+	// Don't spend the budget on preloads whose referencers were just collected
+	PruneStaleCuePreloads();
+
+	// Tags that arrived during GC go through the same queue, so a cue that is already queued or loading is not requested again
 	if (bProcessLoadedTagsAfterGC)
 	{
 		ProcessLoadedTags();
@@ -281,20 +298,191 @@ void ULyraGameplayCueManager::ProcessTagToPreload(const FGameplayTag& Tag, UObje
 		}
 		else
 		{
-			bool bAlwaysLoadedCue = OwningObject == nullptr;
-			TWeakObjectPtr<UObject> WeakOwner = OwningObject;
-			StreamableManager.RequestAsyncLoad(CueData.GameplayCueNotifyObj, FStreamableDelegate::CreateUObject(this, &ThisClass::OnPreloadCueComplete, CueData.GameplayCueNotifyObj, WeakOwner, bAlwaysLoadedCue), FStreamableManager::DefaultAsyncLoadPriority, false, false, TEXT("GameplayCueManager"));
+			QueueCuePreload(CueData.GameplayCueNotifyObj, OwningObject);
 		}
 	}
 }
 
-void ULyraGameplayCueManager::OnPreloadCueComplete(FSoftObjectPath Path, TWeakObjectPtr<UObject> OwningObject, bool bAlwaysLoadedCue)
+void ULyraGameplayCueManager::QueueCuePreload(const FSoftObjectPath& Path, UObject* OwningObject)
+{
+	// Merge with a request that is already loading or queued instead of loading the cue twice
+	FPendingCuePreload* Existing = InFlightCuePreloads.Find(Path);
+	if (!Existing && QueuedCuePreloadPaths.Contains(Path))
+	{
+		Existing = QueuedCuePreloads.FindByPredicate([&Path](const FPendingCuePreload& Pending) { return Pending.Path == Path; });
+	}
+
+	if (!Existing)
+	{
+		Existing = &QueuedCuePreloads.AddDefaulted_GetRef();
+		Existing->Path = Path;
+		QueuedCuePreloadPaths.Add(Path);
+	}
+
+	if (OwningObject == nullptr)
+	{
+		Existing->bAlwaysLoadedCue = true;
+	}
+	else
+	{
+		Existing->Owners.AddUnique(OwningObject);
+	}
+
+	if (!QueuedCuePreloads.IsEmpty() && !CuePreloadTickHandle.IsValid())
+	{
+		CuePreloadTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::TickCuePreloads), 0.0f);
+	}
+}
+
+bool ULyraGameplayCueManager::TickCuePreloads(float DeltaTime)
 {
-	if (bAlwaysLoadedCue || OwningObject.IsValid())
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_LyraGameplayCueManager_TickCuePreloads);
+
+	const int32 Budget = (LyraGameplayCueManagerCvars::MaxPreloadsPerFrame > 0) ? LyraGameplayCueManagerCvars::MaxPreloadsPerFrame : MAX_int32;
+
+	// Only worth working out what the local players need if we can't start everything this frame
+	TSet<FName> PriorityPackageNames;
+	if (QueuedCuePreloads.Num() > Budget)
+	{
+		GatherPriorityCueOwnerPackages(PriorityPackageNames);
+	}
+
+	int32 NumStarted = 0;
+	for (int32 Pass = 0; (Pass < 2) && (NumStarted < Budget); ++Pass)
 	{
-		if (UClass* LoadedGameplayCueClass = Cast<UClass>(Path.ResolveObject()))
+		const bool bPriorityPass = (Pass == 0);
+		if (bPriorityPass && (PriorityPackageNames.Num() == 0))
+		{
+			continue;
+		}
+
+		for (int32 QueueIndex = 0; (QueueIndex < QueuedCuePreloads.Num()) && (NumStarted < Budget); ++QueueIndex)
 		{
-			RegisterPreloadedCue(LoadedGameplayCueClass, OwningObject.Get());
+			if (QueuedCuePreloads[QueueIndex].bStarted)
+			{
+				continue;
+			}
+
+			if (bPriorityPass)
+			{
+				const bool bIsPriority = QueuedCuePreloads[QueueIndex].Owners.ContainsByPredicate([&PriorityPackageNames](const TWeakObjectPtr<UObject>& Owner)
+				{
+					return Owner.IsValid() && PriorityPackageNames.Contains(Owner->GetPackage()->GetFName());
+				});
+
+				if (!bIsPriority)
+				{
+					continue;
+				}
+			}
+
+			// Left in place and compacted once below, removing each one would shift the rest of the queue every time
+			FPendingCuePreload Preload = MoveTemp(QueuedCuePreloads[QueueIndex]);
+			QueuedCuePreloads[QueueIndex].bStarted = true;
+			QueuedCuePreloadPaths.Remove(Preload.Path);
+			++NumStarted;
+
+			// Registered before the request, since it completes immediately if the cue got loaded in the meantime
+			const FSoftObjectPath Path = Preload.Path;
+			InFlightCuePreloads.Add(Path, MoveTemp(Preload));
+			StreamableManager.RequestAsyncLoad(Path, FStreamableDelegate::CreateUObject(this, &ThisClass::OnPreloadCueComplete, Path), FStreamableManager::DefaultAsyncLoadPriority, false, false, TEXT("GameplayCueManager"));
+		}
+	}
+
+	if (NumStarted > 0)
+	{
+		QueuedCuePreloads.RemoveAll([](const FPendingCuePreload& Preload) { return Preload.bStarted; });
+	}
+
+	if (QueuedCuePreloads.IsEmpty())
+	{
+		UE_LOG(LogLyra, Verbose, TEXT("ULyraGameplayCueManager: all cue preloads started, %d still loading"), InFlightCuePreloads.Num());
+		CuePreloadTickHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void ULyraGameplayCueManager::GatherPriorityCueOwnerPackages(TSet<FName>& OutPackageNames) const
+{
+	if (!GEngine)
+	{
+		return;
+	}
+
+	// Cues referenced by the abilities granted to locally controlled pawns are the ones most likely to fire first
+	for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+	{
+		UWorld* World = WorldContext.World();
+		if (!World || !World->IsGameWorld())
+		{
+			continue;
+		}
+
+		for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+		{
+			const APlayerController* PC = It->Get();
+			const APawn* Pawn = (PC && PC->IsLocalController()) ? PC->GetPawn() : nullptr;
+			if (!Pawn)
+			{
+				continue;
+			}
+
+			OutPackageNames.Add(Pawn->GetClass()->GetPackage()->GetFName());
+
+			if (const UAbilitySystemComponent* ASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Pawn))
+			{
+				for (const FGameplayAbilitySpec& Spec : ASC->GetActivatableAbilities())
+				{
+					if (Spec.Ability)
+					{
+						OutPackageNames.Add(Spec.Ability->GetClass()->GetPackage()->GetFName());
+					}
+				}
+			}
+		}
+	}
+}
+
+void ULyraGameplayCueManager::PruneStaleCuePreloads()
+{
+	for (FPendingCuePreload& Preload : QueuedCuePreloads)
+	{
+		Preload.Owners.RemoveAll([](const TWeakObjectPtr<UObject>& Owner) { return !Owner.IsValid(); });
+		if (!Preload.bAlwaysLoadedCue && Preload.Owners.IsEmpty())
+		{
+			QueuedCuePreloadPaths.Remove(Preload.Path);
+		}
+	}
+
+	// A single stable pass, so the queue keeps its request order
+	QueuedCuePreloads.RemoveAll([](const FPendingCuePreload& Preload) { return !Preload.bAlwaysLoadedCue && Preload.Owners.IsEmpty(); });
+}
+
+void ULyraGameplayCueManager::OnPreloadCueComplete(FSoftObjectPath Path)
+{
+	FPendingCuePreload Preload;
+	if (!InFlightCuePreloads.RemoveAndCopyValue(Path, Preload))
+	{
+		return;
+	}
+
+	if (UClass* LoadedGameplayCueClass = Cast<UClass>(Path.ResolveObject()))
+	{
+		if (Preload.bAlwaysLoadedCue)
+		{
+			RegisterPreloadedCue(LoadedGameplayCueClass, nullptr);
+		}
+		else
+		{
+			for (const TWeakObjectPtr<UObject>& Owner : Preload.Owners)
+			{
+				if (UObject* OwningObject = Owner.Get())
+				{
+					RegisterPreloadedCue(LoadedGameplayCueClass, OwningObject);
+				}
+			}
 		}
 	}
 }
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "Containers/Ticker.h"
 #include "GameplayCueManager.h"
 
 #include "LyraGameplayCueManager.generated.h"
@@ -42,12 +43,19 @@ public:
 	// Updates the bundles for the singular gameplay cue primary asset
 	void RefreshGameplayCuePrimaryAsset();
 
+	// Returns how many cue preloads are waiting for their turn or still loading
+	int32 GetNumPendingCuePreloads() const { return QueuedCuePreloads.Num() + InFlightCuePreloads.Num(); }
+
 private:
 	void OnGameplayTagLoaded(const FGameplayTag& Tag);
 	void HandlePostGarbageCollect();
 	void ProcessLoadedTags();
 	void ProcessTagToPreload(const FGameplayTag& Tag, UObject* OwningObject);
-	void OnPreloadCueComplete(FSoftObjectPath Path, TWeakObjectPtr<UObject> OwningObject, bool bAlwaysLoadedCue);
+	void QueueCuePreload(const FSoftObjectPath& Path, UObject* OwningObject);
+	bool TickCuePreloads(float DeltaTime);
+	void GatherPriorityCueOwnerPackages(TSet<FName>& OutPackageNames) const;
+	void PruneStaleCuePreloads();
+	void OnPreloadCueComplete(FSoftObjectPath Path);
 	void RegisterPreloadedCue(UClass* LoadedGameplayCueClass, UObject* OwningObject);
 	void HandlePostLoadMap(UWorld* NewWorld);
 	void UpdateDelayLoadDelegateListeners();
@@ -63,6 +71,16 @@ private:
 		FLoadedGameplayTagToProcessData(const FGameplayTag& InTag, const TWeakObjectPtr<UObject>& InWeakOwner) : Tag(InTag), WeakOwner(InWeakOwner) {}
 	};
 
+	struct FPendingCuePreload
+	{
+		FSoftObjectPath Path;
+		TArray<TWeakObjectPtr<UObject>> Owners;
+		bool bAlwaysLoadedCue = false;
+
+		// Set once the request has been handed to the streamable manager, the entry is removed from the queue at the end of the tick
+		bool bStarted = false;
+	};
+
 private:
 	// Cues that were preloaded on the client due to being referenced by content
 	UPROPERTY(transient)
@@ -76,4 +94,17 @@ private:
 	TArray<FLoadedGameplayTagToProcessData> LoadedGameplayTagsToProcess;
 	FCriticalSection LoadedGameplayTagsToProcessCS;
 	bool bProcessLoadedTagsAfterGC = false;
+
+	// Cue preloads waiting for the per-frame budget, in request order (see Lyra.GameplayCues.MaxPreloadsPerFrame)
+	TArray<FPendingCuePreload> QueuedCuePreloads;
+	TSet<FSoftObjectPath> QueuedCuePreloadPaths;
+
+	// Cue preloads that have been requested from the streamable manager and haven't completed yet
+	TMap<FSoftObjectPath, FPendingCuePreload> InFlightCuePreloads;
+
+	FTSTicker::FDelegateHandle CuePreloadTickHandle;
+
+#if WITH_DEV_AUTOMATION_TESTS
+	friend class FLyraGameplayCuePreloadBudgetTest;
+#endif
 };
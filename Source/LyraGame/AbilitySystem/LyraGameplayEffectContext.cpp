@@ -33,6 +33,11 @@ bool FLyraGameplayEffectContext::NetSerialize(FArchive& Ar, class UPackageMap* M
 	// Not serialized for post-activation use:
 	// CartridgeID
 
+	// The base fields are left on the engine's encoding on both paths: Iris forwards to FGameplayEffectContextNetSerializer
+	// below, so compacting them here would need a hand-written Iris serializer (UE_NET_IMPLEMENT_SERIALIZER) for the context
+	// to keep both paths in step, and there isn't one yet. Only the target data's legacy path is compacted
+	// (see FLyraGameplayAbilityTargetData_SingleTargetHit::NetSerialize)
+
 	return true;
 }
 
@@ -20,6 +20,8 @@
 #include "Components/GameFrameworkComponentManager.h"
 #include "PlayerMappableInputConfig.h"
 #include "Camera/LyraCameraMode.h"
+#include "Equipment/LyraEquipmentManagerComponent.h"
+#include "Weapons/LyraRangedWeaponInstance.h"
 #include "UserSettings/EnhancedInputUserSettings.h"
 #include "InputMappingContext.h"
 
@@ -33,6 +35,18 @@ namespace LyraHero
 {
 	static const float LookYawRate = 300.0f;
 	static const float LookPitchRate = 165.0f;
+
+	// Ranged weapon spread depends on the camera mode (e.g., aiming), so a dormant weapon needs to re-evaluate it
+	static void WakeRangedWeapon(APawn* Pawn)
+	{
+		if (ULyraEquipmentManagerComponent* EquipmentManager = Pawn ? Pawn->FindComponentByClass<ULyraEquipmentManagerComponent>() : nullptr)
+		{
+			if (ULyraRangedWeaponInstance* RangedWeapon = EquipmentManager->GetFirstInstanceOfType<ULyraRangedWeaponInstance>())
+			{
+				RangedWeapon->WakeFromDormancy();
+			}
+		}
+	}
 };
 
 const FName ULyraHeroComponent::NAME_BindInputsNow("BindInputsNow");
@@ -499,6 +513,8 @@ void ULyraHeroComponent::SetAbilityCameraMode(TSubclassOf<ULyraCameraMode> Camer
 	{
 		AbilityCameraMode = CameraMode;
 		AbilityCameraModeOwningSpecHandle = OwningSpecHandle;
+
+		LyraHero::WakeRangedWeapon(GetPawn<APawn>());
 	}
 }
 
@@ -508,6 +524,8 @@ void ULyraHeroComponent::ClearAbilityCameraMode(const FGameplayAbilitySpecHandle
 	{
 		AbilityCameraMode = nullptr;
 		AbilityCameraModeOwningSpecHandle = FGameplayAbilitySpecHandle();
+
+		LyraHero::WakeRangedWeapon(GetPawn<APawn>());
 	}
 }
 
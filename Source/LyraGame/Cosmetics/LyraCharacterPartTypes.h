@@ -69,6 +69,12 @@ struct FLyraCharacterPart
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	ECharacterCustomizationCollisionMode CollisionMode = ECharacterCustomizationCollisionMode::NoCollision;
 
+	// If the part class is a plain mesh holder (a single static or skeletal mesh component and no other components),
+	// add a copy of that mesh directly to the pawn instead of spawning a child actor for it.
+	// Only enable this for parts that don't rely on actor logic; merged parts are not returned by GetCharacterPartActors
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bAllowMergedMesh = false;
+
 	// Compares against another part, ignoring the collision mode
 	static bool AreEquivalentParts(const FLyraCharacterPart& A, const FLyraCharacterPart& B)
 	{
@@ -3,9 +3,13 @@
 #include "Cosmetics/LyraPawnComponent_CharacterParts.h"
 
 #include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
 #include "Cosmetics/LyraCharacterPartTypes.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "GameFramework/Character.h"
 #include "GameplayTagAssetInterface.h"
+#include "HAL/IConsoleManager.h"
 #include "Net/UnrealNetwork.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraPawnComponent_CharacterParts)
@@ -15,11 +19,53 @@ class UPhysicsAsset;
 class USkeletalMesh;
 class UWorld;
 
+namespace LyraCharacterParts
+{
+	static int32 DeferSpawning = 1;
+	static FAutoConsoleVariableRef CVarDeferSpawning(
+		TEXT("Lyra.CharacterParts.DeferSpawning"),
+		DeferSpawning,
+		TEXT("Should character parts be preloaded and spawned over several frames (1) or immediately when added (0)?"),
+		ECVF_Default);
+
+	static float SpawnBudgetMS = 2.0f;
+	static FAutoConsoleVariableRef CVarSpawnBudgetMS(
+		TEXT("Lyra.CharacterParts.SpawnBudgetMS"),
+		SpawnBudgetMS,
+		TEXT("Time in milliseconds that all pawns together may spend spawning deferred character parts each frame (at least one part is always spawned)"),
+		ECVF_Default);
+
+	// Shared by every character parts component so that a burst of pawns spawning at once is spread out
+	static uint64 BudgetFrameNumber = 0;
+	static double BudgetSpentSeconds = 0.0;
+	static bool bSpawnedPartThisFrame = false;
+
+	// Returns the mesh component to copy if the part class only consists of a single static or skeletal mesh component
+	static const UMeshComponent* FindMergeableMeshTemplate(TSubclassOf<AActor> PartClass)
+	{
+		const UMeshComponent* Result = nullptr;
+		int32 NumComponents = 0;
+
+		AActor::ForEachComponentOfActorClassDefault<UActorComponent>(PartClass, [&](const UActorComponent* TemplateComponent)
+		{
+			++NumComponents;
+			if (TemplateComponent->IsA<UStaticMeshComponent>() || TemplateComponent->IsA<USkeletalMeshComponent>())
+			{
+				Result = CastChecked<UMeshComponent>(TemplateComponent);
+			}
+			return true;
+		});
+
+		return (NumComponents == 1) ? Result : nullptr;
+	}
+}
+
 //////////////////////////////////////////////////////////////////////
 
 FString FLyraAppliedCharacterPartEntry::GetDebugString() const
 {
-	return FString::Printf(TEXT("(PartClass: %s, Socket: %s, Instance: %s)"), *GetPathNameSafe(Part.PartClass), *Part.SocketName.ToString(), *GetPathNameSafe(SpawnedComponent));
+	const UObject* Instance = (MergedComponent != nullptr) ? (UObject*)MergedComponent : (UObject*)SpawnedComponent;
+	return FString::Printf(TEXT("(PartClass: %s, Socket: %s, Instance: %s%s)"), *GetPathNameSafe(Part.PartClass), *Part.SocketName.ToString(), *GetPathNameSafe(Instance), bSpawnPending ? TEXT(" [Pending]") : TEXT(""));
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -35,22 +81,17 @@ void FLyraCharacterPartList::PreReplicatedRemove(const TArrayView<int32> Removed
 
 	if (bDestroyedAnyActors && ensure(OwnerComponent))
 	{
-		OwnerComponent->BroadcastChanged();
+		OwnerComponent->MarkPartsChanged();
 	}
 }
 
 void FLyraCharacterPartList::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
 {
-	bool bCreatedAnyActors = false;
+	// The change is broadcast once the queued parts have actually been spawned
 	for (int32 Index : AddedIndices)
 	{
 		FLyraAppliedCharacterPartEntry& Entry = Entries[Index];
-		bCreatedAnyActors |= SpawnActorForEntry(Entry);
-	}
-
-	if (bCreatedAnyActors && ensure(OwnerComponent))
-	{
-		OwnerComponent->BroadcastChanged();
+		QueueSpawnForEntry(Entry);
 	}
 }
 
@@ -64,12 +105,12 @@ void FLyraCharacterPartList::PostReplicatedChange(const TArrayView<int32> Change
 		FLyraAppliedCharacterPartEntry& Entry = Entries[Index];
 
 		bChangedAnyActors |= DestroyActorForEntry(Entry);
-		bChangedAnyActors |= SpawnActorForEntry(Entry);
+		QueueSpawnForEntry(Entry);
 	}
 
 	if (bChangedAnyActors && ensure(OwnerComponent))
 	{
-		OwnerComponent->BroadcastChanged();
+		OwnerComponent->MarkPartsChanged();
 	}
 }
 
@@ -83,13 +124,11 @@ FLyraCharacterPartHandle FLyraCharacterPartList::AddEntry(FLyraCharacterPart New
 		FLyraAppliedCharacterPartEntry& NewEntry = Entries.AddDefaulted_GetRef();
 		NewEntry.Part = NewPart;
 		NewEntry.PartHandle = Result.PartHandle;
-	
-		if (SpawnActorForEntry(NewEntry))
-		{
-			OwnerComponent->BroadcastChanged();
-		}
 
 		MarkItemDirty(NewEntry);
+
+		// On clients and listen servers the part is spawned (and the change broadcast) once its turn comes up
+		QueueSpawnForEntry(NewEntry);
 	}
 
 	return Result;
@@ -108,7 +147,7 @@ void FLyraCharacterPartList::RemoveEntry(FLyraCharacterPartHandle Handle)
 
 			if (bDestroyedActor && ensure(OwnerComponent))
 			{
-				OwnerComponent->BroadcastChanged();
+				OwnerComponent->MarkPartsChanged();
 			}
 
 			break;
@@ -128,7 +167,7 @@ void FLyraCharacterPartList::ClearAllEntries(bool bBroadcastChangeDelegate)
 
 	if (bDestroyedAnyActors && bBroadcastChangeDelegate && ensure(OwnerComponent))
 	{
-		OwnerComponent->BroadcastChanged();
+		OwnerComponent->MarkPartsChanged();
 	}
 }
 
@@ -145,14 +184,35 @@ FGameplayTagContainer FLyraCharacterPartList::CollectCombinedTags() const
 				TagInterface->GetOwnedGameplayTags(/*inout*/ Result);
 			}
 		}
+		else if ((Entry.MergedComponent != nullptr) && (Entry.Part.PartClass != nullptr))
+		{
+			// Merged parts have no actor instance, so use the tags from the class defaults
+			if (const IGameplayTagAssetInterface* TagInterface = Cast<IGameplayTagAssetInterface>(Entry.Part.PartClass->GetDefaultObject()))
+			{
+				TagInterface->GetOwnedGameplayTags(/*inout*/ Result);
+			}
+		}
 	}
 
 	return Result;
 }
 
+bool FLyraCharacterPartList::QueueSpawnForEntry(FLyraAppliedCharacterPartEntry& Entry)
+{
+	if (ensure(OwnerComponent) && !OwnerComponent->IsNetMode(NM_DedicatedServer) && (Entry.Part.PartClass != nullptr))
+	{
+		Entry.bSpawnPending = true;
+		OwnerComponent->QueuePendingParts();
+		return true;
+	}
+
+	return false;
+}
+
 bool FLyraCharacterPartList::SpawnActorForEntry(FLyraAppliedCharacterPartEntry& Entry)
 {
 	bool bCreatedAnyActors = false;
+	Entry.bSpawnPending = false;
 
 	if (ensure(OwnerComponent) && !OwnerComponent->IsNetMode(NM_DedicatedServer))
 	{
@@ -162,6 +222,11 @@ bool FLyraCharacterPartList::SpawnActorForEntry(FLyraAppliedCharacterPartEntry&
 
 			if (USceneComponent* ComponentToAttachTo = OwnerComponent->GetSceneComponentToAttachTo())
 			{
+				if (Entry.Part.bAllowMergedMesh && SpawnMergedMeshForEntry(Entry, ComponentToAttachTo))
+				{
+					return true;
+				}
+
 				const FTransform SpawnTransform = ComponentToAttachTo->GetSocketTransform(Entry.Part.SocketName);
 
 				UChildActorComponent* PartComponent = NewObject<UChildActorComponent>(OwnerComponent->GetOwner());
@@ -199,9 +264,49 @@ bool FLyraCharacterPartList::SpawnActorForEntry(FLyraAppliedCharacterPartEntry&
 	return bCreatedAnyActors;
 }
 
+bool FLyraCharacterPartList::SpawnMergedMeshForEntry(FLyraAppliedCharacterPartEntry& Entry, USceneComponent* ComponentToAttachTo)
+{
+	const UMeshComponent* MeshTemplate = LyraCharacterParts::FindMergeableMeshTemplate(Entry.Part.PartClass);
+	if (MeshTemplate == nullptr)
+	{
+		return false;
+	}
+
+	// Copy the mesh straight onto the pawn, skipping the child actor and its extra components entirely
+	UMeshComponent* MeshComponent = NewObject<UMeshComponent>(OwnerComponent->GetOwner(), MeshTemplate->GetClass(), NAME_None, RF_Transient, const_cast<UMeshComponent*>(MeshTemplate));
+	MeshComponent->SetupAttachment(ComponentToAttachTo, Entry.Part.SocketName);
+
+	switch (Entry.Part.CollisionMode)
+	{
+	case ECharacterCustomizationCollisionMode::UseCollisionFromCharacterPart:
+		// Do nothing
+		break;
+
+	case ECharacterCustomizationCollisionMode::NoCollision:
+		MeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		break;
+	}
+
+	MeshComponent->RegisterComponent();
+	MeshComponent->AddTickPrerequisiteComponent(ComponentToAttachTo);
+
+	// Skeletal parts follow the body instead of evaluating their own animation
+	if (USkeletalMeshComponent* SkeletalMeshComponent = Cast<USkeletalMeshComponent>(MeshComponent))
+	{
+		if (USkeletalMeshComponent* ParentMeshComponent = Cast<USkeletalMeshComponent>(ComponentToAttachTo))
+		{
+			SkeletalMeshComponent->SetLeaderPoseComponent(ParentMeshComponent);
+		}
+	}
+
+	Entry.MergedComponent = MeshComponent;
+	return true;
+}
+
 bool FLyraCharacterPartList::DestroyActorForEntry(FLyraAppliedCharacterPartEntry& Entry)
 {
 	bool bDestroyedAnyActors = false;
+	Entry.bSpawnPending = false;
 
 	if (Entry.SpawnedComponent != nullptr)
 	{
@@ -210,6 +315,13 @@ bool FLyraCharacterPartList::DestroyActorForEntry(FLyraAppliedCharacterPartEntry
 		bDestroyedAnyActors = true;
 	}
 
+	if (Entry.MergedComponent != nullptr)
+	{
+		Entry.MergedComponent->DestroyComponent();
+		Entry.MergedComponent = nullptr;
+		bDestroyedAnyActors = true;
+	}
+
 	return bDestroyedAnyActors;
 }
 
@@ -219,6 +331,10 @@ ULyraPawnComponent_CharacterParts::ULyraPawnComponent_CharacterParts(const FObje
 	: Super(ObjectInitializer)
 {
 	SetIsReplicatedByDefault(true);
+
+	// Only ticks while there are parts waiting to be spawned or a change waiting to be broadcast
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 }
 
 void ULyraPawnComponent_CharacterParts::GetLifetimeReplicatedProps(TArray< FLifetimeProperty >& OutLifetimeProps) const
@@ -252,6 +368,10 @@ void ULyraPawnComponent_CharacterParts::EndPlay(const EEndPlayReason::Type EndPl
 {
 	CharacterPartList.ClearAllEntries(/*bBroadcastChangeDelegate=*/ false);
 
+	PreloadHandle.Reset();
+	bHasPendingParts = false;
+	bPartsChanged = false;
+
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -265,6 +385,110 @@ void ULyraPawnComponent_CharacterParts::OnRegister()
 	}
 }
 
+void ULyraPawnComponent_CharacterParts::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (bHasPendingParts && !(PreloadHandle.IsValid() && PreloadHandle->IsLoadingInProgress()))
+	{
+		if (SpawnPendingParts(/*bIgnoreBudget=*/ false))
+		{
+			bPartsChanged = true;
+		}
+	}
+
+	if (bPartsChanged)
+	{
+		bPartsChanged = false;
+		BroadcastChanged();
+	}
+
+	if (!bHasPendingParts && !bPartsChanged)
+	{
+		PreloadHandle.Reset();
+		SetComponentTickEnabled(false);
+	}
+}
+
+void ULyraPawnComponent_CharacterParts::MarkPartsChanged()
+{
+	bPartsChanged = true;
+	SetComponentTickEnabled(true);
+}
+
+void ULyraPawnComponent_CharacterParts::QueuePendingParts()
+{
+	bHasPendingParts = true;
+
+	if (LyraCharacterParts::DeferSpawning == 0)
+	{
+		if (SpawnPendingParts(/*bIgnoreBudget=*/ true))
+		{
+			MarkPartsChanged();
+		}
+		return;
+	}
+
+	StartPreloadForPendingParts();
+	SetComponentTickEnabled(true);
+}
+
+void ULyraPawnComponent_CharacterParts::StartPreloadForPendingParts()
+{
+	TArray<FSoftObjectPath> ClassesToLoad;
+	for (const FLyraAppliedCharacterPartEntry& Entry : CharacterPartList.Entries)
+	{
+		if (Entry.bSpawnPending && (Entry.Part.PartClass != nullptr))
+		{
+			ClassesToLoad.AddUnique(FSoftObjectPath(Entry.Part.PartClass));
+		}
+	}
+
+	if (ClassesToLoad.Num() > 0)
+	{
+		// Replaces any earlier request, the new one covers every part that is still pending
+		PreloadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(ClassesToLoad, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+	}
+}
+
+bool ULyraPawnComponent_CharacterParts::SpawnPendingParts(bool bIgnoreBudget)
+{
+	using namespace LyraCharacterParts;
+
+	if (BudgetFrameNumber != GFrameCounter)
+	{
+		BudgetFrameNumber = GFrameCounter;
+		BudgetSpentSeconds = 0.0;
+		bSpawnedPartThisFrame = false;
+	}
+
+	const double BudgetSeconds = SpawnBudgetMS * 0.001;
+
+	bool bSpawnedAnyParts = false;
+	bool bStillPending = false;
+	for (FLyraAppliedCharacterPartEntry& Entry : CharacterPartList.Entries)
+	{
+		if (!Entry.bSpawnPending)
+		{
+			continue;
+		}
+
+		if (!bIgnoreBudget && bSpawnedPartThisFrame && (BudgetSpentSeconds >= BudgetSeconds))
+		{
+			bStillPending = true;
+			break;
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		bSpawnedAnyParts |= CharacterPartList.SpawnActorForEntry(Entry);
+		BudgetSpentSeconds += FPlatformTime::Seconds() - StartTime;
+		bSpawnedPartThisFrame = true;
+	}
+
+	bHasPendingParts = bStillPending;
+	return bSpawnedAnyParts;
+}
+
 TArray<AActor*> ULyraPawnComponent_CharacterParts::GetCharacterPartActors() const
 {
 	TArray<AActor*> Result;
@@ -284,6 +508,21 @@ TArray<AActor*> ULyraPawnComponent_CharacterParts::GetCharacterPartActors() cons
 	return Result;
 }
 
+TArray<UMeshComponent*> ULyraPawnComponent_CharacterParts::GetMergedCharacterPartMeshes() const
+{
+	TArray<UMeshComponent*> Result;
+
+	for (const FLyraAppliedCharacterPartEntry& Entry : CharacterPartList.Entries)
+	{
+		if (UMeshComponent* MeshComponent = Entry.MergedComponent)
+		{
+			Result.Add(MeshComponent);
+		}
+	}
+
+	return Result;
+}
+
 USkeletalMeshComponent* ULyraPawnComponent_CharacterParts::GetParentMeshComponent() const
 {
 	if (AActor* OwnerActor = GetOwner())
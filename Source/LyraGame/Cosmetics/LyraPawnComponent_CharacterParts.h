@@ -16,11 +16,13 @@ struct FLyraCharacterPartList;
 
 class AActor;
 class UChildActorComponent;
+class UMeshComponent;
 class UObject;
 class USceneComponent;
 class USkeletalMeshComponent;
 struct FFrame;
 struct FNetDeltaSerializeInfo;
+struct FStreamableHandle;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FLyraSpawnedCharacterPartsChanged, ULyraPawnComponent_CharacterParts*, ComponentWithChangedParts);
 
@@ -53,6 +55,13 @@ private:
 	// The spawned actor instance (client only)
 	UPROPERTY(NotReplicated)
 	TObjectPtr<UChildActorComponent> SpawnedComponent = nullptr;
+
+	// The mesh added directly to the owner when using the merged mesh path (client only)
+	UPROPERTY(NotReplicated)
+	TObjectPtr<UMeshComponent> MergedComponent = nullptr;
+
+	// Is this part waiting for its turn to be spawned? (client only)
+	bool bSpawnPending = false;
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -94,7 +103,10 @@ public:
 private:
 	friend ULyraPawnComponent_CharacterParts;
 
+	// Marks the entry to be spawned by the owner component, returns true if there is anything to spawn
+	bool QueueSpawnForEntry(FLyraAppliedCharacterPartEntry& Entry);
 	bool SpawnActorForEntry(FLyraAppliedCharacterPartEntry& Entry);
+	bool SpawnMergedMeshForEntry(FLyraAppliedCharacterPartEntry& Entry, USceneComponent* ComponentToAttachTo);
 	bool DestroyActorForEntry(FLyraAppliedCharacterPartEntry& Entry);
 
 private:
@@ -131,6 +143,7 @@ public:
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void OnRegister() override;
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	//~End of UActorComponent interface
 
 	// Adds a character part to the actor that owns this customization component, should be called on the authority only
@@ -149,6 +162,10 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure=false, BlueprintCosmetic, Category=Cosmetics)
 	TArray<AActor*> GetCharacterPartActors() const;
 
+	// Gets the meshes added directly to the owner for parts that use the merged mesh path (see FLyraCharacterPart::bAllowMergedMesh)
+	UFUNCTION(BlueprintCallable, BlueprintPure=false, BlueprintCosmetic, Category=Cosmetics)
+	TArray<UMeshComponent*> GetMergedCharacterPartMeshes() const;
+
 	// If the parent actor is derived from ACharacter, returns the Mesh component, otherwise nullptr
 	USkeletalMeshComponent* GetParentMeshComponent() const;
 
@@ -162,6 +179,21 @@ public:
 
 	void BroadcastChanged();
 
+	// Requests a BroadcastChanged; all requests made before this component next ticks result in a single broadcast
+	void MarkPartsChanged();
+
+	// Schedules pending parts to be preloaded and spawned over the next frames
+	void QueuePendingParts();
+
+	// Returns true if any parts are still waiting to be spawned
+	bool HasPendingParts() const { return bHasPendingParts; }
+
+private:
+	// Spawns pending parts until the per-frame budget runs out, returns true if any were spawned
+	bool SpawnPendingParts(bool bIgnoreBudget);
+
+	void StartPreloadForPendingParts();
+
 public:
 	// Delegate that will be called when the list of spawned character parts has changed
 	UPROPERTY(BlueprintAssignable, Category=Cosmetics, BlueprintCallable)
@@ -175,4 +207,10 @@ private:
 	// Rules for how to pick a body style mesh for animation to play on, based on character part cosmetics tags
 	UPROPERTY(EditAnywhere, Category=Cosmetics)
 	FLyraAnimBodyStyleSelectionSet BodyMeshes;
+
+	// Keeps the classes of pending parts (and everything they reference) loaded until they are spawned
+	TSharedPtr<FStreamableHandle> PreloadHandle;
+
+	bool bHasPendingParts = false;
+	bool bPartsChanged = false;
 };
@@ -1,9 +1,12 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "GameFeatureAction_AddAbilities.h"
+#include "Engine/AssetManager.h"
 #include "Engine/GameInstance.h"
 #include "Components/GameFrameworkComponentManager.h"
 #include "AbilitySystem/LyraAbilitySystemComponent.h"
+#include "Engine/DataTable.h"
+#include "Engine/StreamableManager.h"
 #include "Engine/World.h"
 #include "Player/LyraPlayerState.h" //@TODO: For the fname
 #include "GameFeatures/GameFeatureAction_WorldActionBase.h"
@@ -16,9 +19,33 @@
 
 #define LOCTEXT_NAMESPACE "GameFeatures"
 
+namespace LyraAddAbilities
+{
+	static int32 NumSynchronousGrantLoads = 0;
+
+	// Everything should have been loaded by the preload, this only catches assets that were unloaded or changed since
+	template<typename SoftPtrType>
+	static auto GetLoadedAsset(const SoftPtrType& SoftPtr)
+	{
+		auto* Asset = SoftPtr.Get();
+		if ((Asset == nullptr) && !SoftPtr.IsNull())
+		{
+			++NumSynchronousGrantLoads;
+			UE_LOG(LogGameFeatures, Warning, TEXT("AddAbilities: %s was not preloaded, loading it synchronously"), *SoftPtr.ToString());
+			Asset = SoftPtr.LoadSynchronous();
+		}
+		return Asset;
+	}
+}
+
 //////////////////////////////////////////////////////////////////////
 // UGameFeatureAction_AddAbilities
 
+int32 UGameFeatureAction_AddAbilities::GetNumSynchronousGrantLoads()
+{
+	return LyraAddAbilities::NumSynchronousGrantLoads;
+}
+
 void UGameFeatureAction_AddAbilities::OnGameFeatureActivating(FGameFeatureActivatingContext& Context)
 {
 	FPerContextData& ActiveData = ContextData.FindOrAdd(Context);
@@ -28,6 +55,7 @@ void UGameFeatureAction_AddAbilities::OnGameFeatureActivating(FGameFeatureActiva
 	{
 		Reset(ActiveData);
 	}
+
 	Super::OnGameFeatureActivating(Context);
 }
 
@@ -111,6 +139,13 @@ void UGameFeatureAction_AddAbilities::AddToWorld(const FWorldContext& WorldConte
 
 	if ((GameInstance != nullptr) && (World != nullptr) && World->IsGameWorld())
 	{
+		// Only authority grants anything (see AddActorAbilities), so clients don't load the assets at all.
+		// Start before the extension handlers are added, which immediately fire for every existing actor
+		if ((World->GetNetMode() != NM_Client) && !ActiveData.bAssetsLoaded && !ActiveData.PreloadHandle.IsValid())
+		{
+			StartPreload(ActiveData, ChangeContext);
+		}
+
 		if (UGameFrameworkComponentManager* ComponentMan = UGameInstance::GetSubsystem<UGameFrameworkComponentManager>(GameInstance))
 		{			
 			int32 EntryIndex = 0;
@@ -139,6 +174,91 @@ void UGameFeatureAction_AddAbilities::Reset(FPerContextData& ActiveData)
 	}
 
 	ActiveData.ComponentRequests.Empty();
+	ActiveData.PendingGrants.Empty();
+
+	if (ActiveData.PreloadHandle.IsValid())
+	{
+		ActiveData.PreloadHandle->CancelHandle();
+		ActiveData.PreloadHandle.Reset();
+	}
+	ActiveData.bAssetsLoaded = false;
+}
+
+void UGameFeatureAction_AddAbilities::StartPreload(FPerContextData& ActiveData, const FGameFeatureStateChangeContext& ChangeContext)
+{
+	TArray<FSoftObjectPath> AssetsToLoad;
+	for (const FGameFeatureAbilitiesEntry& Entry : AbilitiesList)
+	{
+		for (const FLyraAbilityGrant& Ability : Entry.GrantedAbilities)
+		{
+			if (!Ability.AbilityType.IsNull())
+			{
+				AssetsToLoad.AddUnique(Ability.AbilityType.ToSoftObjectPath());
+			}
+		}
+
+		for (const FLyraAttributeSetGrant& Attributes : Entry.GrantedAttributes)
+		{
+			if (!Attributes.AttributeSetType.IsNull())
+			{
+				AssetsToLoad.AddUnique(Attributes.AttributeSetType.ToSoftObjectPath());
+			}
+			if (!Attributes.InitializationData.IsNull())
+			{
+				AssetsToLoad.AddUnique(Attributes.InitializationData.ToSoftObjectPath());
+			}
+		}
+
+		for (const TSoftObjectPtr<const ULyraAbilitySet>& SetPtr : Entry.GrantedAbilitySets)
+		{
+			if (!SetPtr.IsNull())
+			{
+				AssetsToLoad.AddUnique(SetPtr.ToSoftObjectPath());
+			}
+		}
+	}
+
+	if (AssetsToLoad.IsEmpty())
+	{
+		ActiveData.bAssetsLoaded = true;
+		return;
+	}
+
+	// Hold the handle even if everything is already loaded, so it stays loaded while the feature is active
+	ActiveData.bAssetsLoaded = false;
+	ActiveData.PreloadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetsToLoad,
+		FStreamableDelegate::CreateUObject(this, &ThisClass::HandlePreloadComplete, ChangeContext),
+		FStreamableManager::AsyncLoadHighPriority);
+
+	if (!ActiveData.PreloadHandle.IsValid())
+	{
+		ActiveData.bAssetsLoaded = true;
+	}
+}
+
+void UGameFeatureAction_AddAbilities::HandlePreloadComplete(FGameFeatureStateChangeContext ChangeContext)
+{
+	FPerContextData* ActiveData = ContextData.Find(ChangeContext);
+	if ((ActiveData == nullptr) || ActiveData->bAssetsLoaded)
+	{
+		return;
+	}
+
+	ActiveData->bAssetsLoaded = true;
+
+	TArray<TPair<TWeakObjectPtr<AActor>, int32>> PendingGrants = MoveTemp(ActiveData->PendingGrants);
+	ActiveData->PendingGrants.Reset();
+
+	UE_CLOG(PendingGrants.Num() > 0, LogGameFeatures, Verbose, TEXT("AddAbilities: Preload finished, granting to %d queued actor(s)"), PendingGrants.Num());
+
+	for (const TPair<TWeakObjectPtr<AActor>, int32>& PendingGrant : PendingGrants)
+	{
+		AActor* Actor = PendingGrant.Key.Get();
+		if (Actor && AbilitiesList.IsValidIndex(PendingGrant.Value))
+		{
+			AddActorAbilities(Actor, AbilitiesList[PendingGrant.Value], *ActiveData);
+		}
+	}
 }
 
 void UGameFeatureAction_AddAbilities::HandleActorExtension(AActor* Actor, FName EventName, int32 EntryIndex, FGameFeatureStateChangeContext ChangeContext)
@@ -149,10 +269,21 @@ void UGameFeatureAction_AddAbilities::HandleActorExtension(AActor* Actor, FName
 		const FGameFeatureAbilitiesEntry& Entry = AbilitiesList[EntryIndex];
 		if ((EventName == UGameFrameworkComponentManager::NAME_ExtensionRemoved) || (EventName == UGameFrameworkComponentManager::NAME_ReceiverRemoved))
 		{
+			ActiveData->PendingGrants.Remove(MakeTuple(TWeakObjectPtr<AActor>(Actor), EntryIndex));
 			RemoveActorAbilities(Actor, *ActiveData);
 		}
 		else if ((EventName == UGameFrameworkComponentManager::NAME_ExtensionAdded) || (EventName == ALyraPlayerState::NAME_LyraAbilityReady))
 		{
+			if (!ActiveData->bAssetsLoaded)
+			{
+				// Granted in one batch once the preload completes
+				if (Actor->HasAuthority())
+				{
+					ActiveData->PendingGrants.AddUnique(MakeTuple(TWeakObjectPtr<AActor>(Actor), EntryIndex));
+				}
+				return;
+			}
+
 			AddActorAbilities(Actor, Entry, *ActiveData);
 		}
 	}
@@ -183,7 +314,7 @@ void UGameFeatureAction_AddAbilities::AddActorAbilities(AActor* Actor, const FGa
 		{
 			if (!Ability.AbilityType.IsNull())
 			{
-				FGameplayAbilitySpec NewAbilitySpec(Ability.AbilityType.LoadSynchronous());
+				FGameplayAbilitySpec NewAbilitySpec(LyraAddAbilities::GetLoadedAsset(Ability.AbilityType));
 				FGameplayAbilitySpecHandle AbilityHandle = AbilitySystemComponent->GiveAbility(NewAbilitySpec);
 
 				AddedExtensions.Abilities.Add(AbilityHandle);
@@ -194,13 +325,13 @@ void UGameFeatureAction_AddAbilities::AddActorAbilities(AActor* Actor, const FGa
 		{
 			if (!Attributes.AttributeSetType.IsNull())
 			{
-				TSubclassOf<UAttributeSet> SetType = Attributes.AttributeSetType.LoadSynchronous();
+				TSubclassOf<UAttributeSet> SetType = LyraAddAbilities::GetLoadedAsset(Attributes.AttributeSetType);
 				if (SetType)
 				{
 					UAttributeSet* NewSet = NewObject<UAttributeSet>(AbilitySystemComponent->GetOwner(), SetType);
 					if (!Attributes.InitializationData.IsNull())
 					{
-						UDataTable* InitData = Attributes.InitializationData.LoadSynchronous();
+						UDataTable* InitData = LyraAddAbilities::GetLoadedAsset(Attributes.InitializationData);
 						if (InitData)
 						{
 							NewSet->InitFromMetaDataTable(InitData);
@@ -216,7 +347,7 @@ void UGameFeatureAction_AddAbilities::AddActorAbilities(AActor* Actor, const FGa
 		ULyraAbilitySystemComponent* LyraASC = CastChecked<ULyraAbilitySystemComponent>(AbilitySystemComponent);
 		for (const TSoftObjectPtr<const ULyraAbilitySet>& SetPtr : AbilitiesEntry.GrantedAbilitySets)
 		{
-			if (const ULyraAbilitySet* Set = SetPtr.Get())
+			if (const ULyraAbilitySet* Set = LyraAddAbilities::GetLoadedAsset(SetPtr))
 			{
 				Set->GiveToAbilitySystem(LyraASC, &AddedExtensions.AbilitySetHandles.AddDefaulted_GetRef());
 			}
@@ -13,6 +13,7 @@ class UInputAction;
 class UAttributeSet;
 class UDataTable;
 struct FComponentRequestHandle;
+struct FStreamableHandle;
 class ULyraAbilitySet;
 
 USTRUCT(BlueprintType)
@@ -70,6 +71,9 @@ struct FGameFeatureAbilitiesEntry
 
 /**
  * GameFeatureAction responsible for granting abilities (and attributes) to actors of a specified type.
+ *
+ * On the server, everything the entries reference is loaded through a single async request when the feature is
+ * added to the world, actors that show up before that finishes are granted in one batch once it does.
  */
 UCLASS(MinimalAPI, meta = (DisplayName = "Add Abilities"))
 class UGameFeatureAction_AddAbilities final : public UGameFeatureAction_WorldActionBase
@@ -92,6 +96,9 @@ public:
 	UPROPERTY(EditAnywhere, Category="Abilities", meta=(TitleProperty="ActorClass", ShowOnlyInnerProperties))
 	TArray<FGameFeatureAbilitiesEntry> AbilitiesList;
 
+	// Number of times granting had to fall back to a synchronous load because an asset wasn't preloaded (across all instances)
+	static int32 GetNumSynchronousGrantLoads();
+
 private:
 	struct FActorExtensions
 	{
@@ -104,6 +111,13 @@ private:
 	{
 		TMap<AActor*, FActorExtensions> ActiveExtensions;
 		TArray<TSharedPtr<FComponentRequestHandle>> ComponentRequests;
+
+		// Keeps everything in AbilitiesList loaded while the feature is active
+		TSharedPtr<FStreamableHandle> PreloadHandle;
+		bool bAssetsLoaded = false;
+
+		// Actors (and their entry index) that arrived while the preload was still in flight
+		TArray<TPair<TWeakObjectPtr<AActor>, int32>> PendingGrants;
 	};
 	
 	TMap<FGameFeatureStateChangeContext, FPerContextData> ContextData;	
@@ -113,6 +127,8 @@ private:
 	//~ End UGameFeatureAction_WorldActionBase interface
 
 	void Reset(FPerContextData& ActiveData);
+	void StartPreload(FPerContextData& ActiveData, const FGameFeatureStateChangeContext& ChangeContext);
+	void HandlePreloadComplete(FGameFeatureStateChangeContext ChangeContext);
 	void HandleActorExtension(AActor* Actor, FName EventName, int32 EntryIndex, FGameFeatureStateChangeContext ChangeContext);
 	void AddActorAbilities(AActor* Actor, const FGameFeatureAbilitiesEntry& AbilitiesEntry, FPerContextData& ActiveData);
 	void RemoveActorAbilities(AActor* Actor, FPerContextData& ActiveData);
@@ -124,4 +140,8 @@ private:
 		return Cast<ComponentType>(FindOrAddComponentForActor(ComponentType::StaticClass(), Actor, AbilitiesEntry, ActiveData));
 	}
 	UActorComponent* FindOrAddComponentForActor(UClass* ComponentType, AActor* Actor, const FGameFeatureAbilitiesEntry& AbilitiesEntry, FPerContextData& ActiveData);
+
+#if WITH_DEV_AUTOMATION_TESTS
+	friend class FGameFeatureActionAddAbilitiesPreloadTest;
+#endif
 };
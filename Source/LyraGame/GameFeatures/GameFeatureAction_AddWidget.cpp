@@ -5,6 +5,7 @@
 #include "Engine/GameInstance.h"
 #include "GameFeatures/GameFeatureAction_WorldActionBase.h"
 #include "GameFeaturesSubsystemSettings.h"
+#include "CommonLocalPlayer.h"
 #include "CommonUIExtensions.h"
 #include "UI/LyraHUD.h"
 
@@ -114,6 +115,8 @@ void UGameFeatureAction_AddWidgets::Reset(FPerContextData& ActiveData)
 
 	for (TPair<FObjectKey, FPerActorData>& Pair : ActiveData.ActorData)
 	{
+		StopWaitingForRootLayout(Pair.Value);
+
 		for (FUIExtensionHandle& Handle : Pair.Value.ExtensionHandles)
 		{
 			Handle.Unregister();
@@ -131,11 +134,11 @@ void UGameFeatureAction_AddWidgets::HandleActorExtension(AActor* Actor, FName Ev
 	}
 	else if ((EventName == UGameFrameworkComponentManager::NAME_ExtensionAdded) || (EventName == UGameFrameworkComponentManager::NAME_GameActorReady))
 	{
-		AddWidgets(Actor, ActiveData);
+		AddWidgets(Actor, ActiveData, ChangeContext);
 	}
 }
 
-void UGameFeatureAction_AddWidgets::AddWidgets(AActor* Actor, FPerContextData& ActiveData)
+void UGameFeatureAction_AddWidgets::AddWidgets(AActor* Actor, FPerContextData& ActiveData, const FGameFeatureStateChangeContext& ChangeContext)
 {
 	ALyraHUD* HUD = CastChecked<ALyraHUD>(Actor);
 
@@ -143,12 +146,17 @@ void UGameFeatureAction_AddWidgets::AddWidgets(AActor* Actor, FPerContextData& A
 	{
 		FPerActorData& ActorData = ActiveData.ActorData.FindOrAdd(HUD);
 
-		for (const FLyraHUDLayoutRequest& Entry : Layout)
+		// The UI policy creates the root layout once its layout class has loaded, which can be after the HUD is ready
+		UCommonLocalPlayer* CommonLocalPlayer = Cast<UCommonLocalPlayer>(LocalPlayer);
+		if ((CommonLocalPlayer != nullptr) && (CommonLocalPlayer->GetRootUILayout() == nullptr))
 		{
-			if (TSubclassOf<UCommonActivatableWidget> ConcreteWidgetClass = Entry.LayoutClass.Get())
-			{
-				ActorData.LayoutsAdded.Add(UCommonUIExtensions::PushContentToLayer_ForPlayer(LocalPlayer, Entry.LayerID, ConcreteWidgetClass));
-			}
+			StopWaitingForRootLayout(ActorData);
+			ActorData.LayoutPlayer = CommonLocalPlayer;
+			ActorData.RootLayoutSetHandle = CommonLocalPlayer->OnRootLayoutSet.AddUObject(this, &ThisClass::HandleRootLayoutSet, FObjectKey(HUD), ChangeContext);
+		}
+		else
+		{
+			AddLayouts(LocalPlayer, ActorData);
 		}
 
 		UUIExtensionSubsystem* ExtensionSubsystem = HUD->GetWorld()->GetSubsystem<UUIExtensionSubsystem>();
@@ -159,6 +167,38 @@ void UGameFeatureAction_AddWidgets::AddWidgets(AActor* Actor, FPerContextData& A
 	}
 }
 
+void UGameFeatureAction_AddWidgets::AddLayouts(ULocalPlayer* LocalPlayer, FPerActorData& ActorData)
+{
+	for (const FLyraHUDLayoutRequest& Entry : Layout)
+	{
+		if (TSubclassOf<UCommonActivatableWidget> ConcreteWidgetClass = Entry.LayoutClass.Get())
+		{
+			ActorData.LayoutsAdded.Add(UCommonUIExtensions::PushContentToLayer_ForPlayer(LocalPlayer, Entry.LayerID, ConcreteWidgetClass));
+		}
+	}
+}
+
+void UGameFeatureAction_AddWidgets::HandleRootLayoutSet(UCommonLocalPlayer* LocalPlayer, UPrimaryGameLayout* RootLayout, FObjectKey HUDKey, FGameFeatureStateChangeContext ChangeContext)
+{
+	FPerContextData* ActiveData = ContextData.Find(ChangeContext);
+	FPerActorData* ActorData = ActiveData ? ActiveData->ActorData.Find(HUDKey) : nullptr;
+	if (ActorData && (ActorData->LayoutPlayer == LocalPlayer))
+	{
+		StopWaitingForRootLayout(*ActorData);
+		AddLayouts(LocalPlayer, *ActorData);
+	}
+}
+
+void UGameFeatureAction_AddWidgets::StopWaitingForRootLayout(FPerActorData& ActorData)
+{
+	if (UCommonLocalPlayer* LocalPlayer = ActorData.LayoutPlayer.Get())
+	{
+		LocalPlayer->OnRootLayoutSet.Remove(ActorData.RootLayoutSetHandle);
+	}
+	ActorData.LayoutPlayer.Reset();
+	ActorData.RootLayoutSetHandle.Reset();
+}
+
 void UGameFeatureAction_AddWidgets::RemoveWidgets(AActor* Actor, FPerContextData& ActiveData)
 {
 	ALyraHUD* HUD = CastChecked<ALyraHUD>(Actor);
@@ -168,6 +208,8 @@ void UGameFeatureAction_AddWidgets::RemoveWidgets(AActor* Actor, FPerContextData
 
 	if (ActorData)
 	{
+		StopWaitingForRootLayout(*ActorData);
+
 		for (TWeakObjectPtr<UCommonActivatableWidget>& AddedLayout : ActorData->LayoutsAdded)
 		{
 			if (AddedLayout.IsValid())
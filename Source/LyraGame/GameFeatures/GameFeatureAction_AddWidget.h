@@ -10,6 +10,8 @@
 
 struct FWorldContext;
 struct FComponentRequestHandle;
+class UCommonLocalPlayer;
+class UPrimaryGameLayout;
 
 USTRUCT()
 struct FLyraHUDLayoutRequest
@@ -80,6 +82,10 @@ private:
 	{
 		TArray<TWeakObjectPtr<UCommonActivatableWidget>> LayoutsAdded;
 		TArray<FUIExtensionHandle> ExtensionHandles;
+
+		// Set while waiting for the player's root layout to be created, so the layouts can be pushed then
+		TWeakObjectPtr<UCommonLocalPlayer> LayoutPlayer;
+		FDelegateHandle RootLayoutSetHandle;
 	};
 
 	struct FPerContextData
@@ -98,6 +104,9 @@ private:
 
 	void HandleActorExtension(AActor* Actor, FName EventName, FGameFeatureStateChangeContext ChangeContext);
 
-	void AddWidgets(AActor* Actor, FPerContextData& ActiveData);
+	void AddWidgets(AActor* Actor, FPerContextData& ActiveData, const FGameFeatureStateChangeContext& ChangeContext);
+	void AddLayouts(ULocalPlayer* LocalPlayer, FPerActorData& ActorData);
+	void HandleRootLayoutSet(UCommonLocalPlayer* LocalPlayer, UPrimaryGameLayout* RootLayout, FObjectKey HUDKey, FGameFeatureStateChangeContext ChangeContext);
+	void StopWaitingForRootLayout(FPerActorData& ActorData);
 	void RemoveWidgets(AActor* Actor, FPerContextData& ActiveData);
 };
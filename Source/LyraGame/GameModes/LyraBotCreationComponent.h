@@ -46,6 +46,8 @@ public:
 	void Cheat_AddBot() { SpawnOneBot(); }
 	void Cheat_RemoveBot() { RemoveOneBot(); }
 
+	int32 GetNumSpawnedBots() const { return SpawnedBotList.Num(); }
+
 protected:
 	virtual void ServerCreateBots();
 
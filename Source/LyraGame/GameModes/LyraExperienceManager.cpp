@@ -3,10 +3,39 @@
 #include "LyraExperienceManager.h"
 #include "GameModes/LyraExperienceManager.h"
 #include "Engine/Engine.h"
+#include "GameFeaturesSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "LyraExperienceActionSet.h"
+#include "LyraExperienceDefinition.h"
+#include "LyraLogChannels.h"
 #include "Subsystems/SubsystemCollection.h"
+#include "System/LyraAssetManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraExperienceManager)
 
+namespace LyraConsoleVariables
+{
+	static int32 ExperiencePreloadMinFreeMemoryMB = 1024;
+	static FAutoConsoleVariableRef CVarExperiencePreloadMinFreeMemoryMB(
+		TEXT("Lyra.Experience.PreloadMinFreeMemoryMB"),
+		ExperiencePreloadMinFreeMemoryMB,
+		TEXT("Experience preloads are skipped (or dropped) when less than this much physical memory (in MB) is available, 0 disables the check"),
+		ECVF_Default);
+}
+
+static const TCHAR* LexToString(ELyraExperiencePreloadStage Stage)
+{
+	switch (Stage)
+	{
+	case ELyraExperiencePreloadStage::None: return TEXT("None");
+	case ELyraExperiencePreloadStage::LoadingExperience: return TEXT("Experience");
+	case ELyraExperiencePreloadStage::LoadingActionSets: return TEXT("ActionSets");
+	case ELyraExperiencePreloadStage::LoadingGameFeatures: return TEXT("GameFeatures");
+	case ELyraExperiencePreloadStage::Ready: return TEXT("Ready");
+	default: return TEXT("Unknown");
+	}
+}
+
 #if WITH_EDITOR
 
 void ULyraExperienceManager::OnPlayInEditorBegun()
@@ -52,3 +81,342 @@ bool ULyraExperienceManager::RequestToDeactivatePlugin(const FString PluginURL)
 }
 
 #endif
+
+//////////////////////////////////////////////////////////////////////
+// Experience preloading
+
+bool ULyraExperienceManager::PreloadExperience(FPrimaryAssetId ExperienceId, const TArray<FName>& BundlesToLoad)
+{
+	if (!ExperienceId.IsValid())
+	{
+		return false;
+	}
+
+	if ((PreloadExperienceId == ExperienceId) && (PreloadStage != ELyraExperiencePreloadStage::None))
+	{
+		// Already preloading (or preloaded) this one
+		return true;
+	}
+
+	CancelPreload();
+
+	if (!HasMemoryForPreload())
+	{
+		UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: Skipping preload of %s, not enough free memory"), *ExperienceId.ToString());
+		return false;
+	}
+
+	UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: Preloading %s"), *ExperienceId.ToString());
+
+	PreloadExperienceId = ExperienceId;
+	PreloadBundles = BundlesToLoad;
+	PreloadStartTime = FPlatformTime::Seconds();
+	PreloadStageStartTime = PreloadStartTime;
+	PreloadStageDurations.Reset();
+	PreloadStage = ELyraExperiencePreloadStage::LoadingExperience;
+
+	// Default priority so that anything the current experience still needs is loaded first
+	const uint32 Generation = PreloadGeneration;
+	ULyraAssetManager& AssetManager = ULyraAssetManager::Get();
+	RequestPreloadOfPrimaryAssets({ ExperienceId });
+	PreloadExperienceHandle = AssetManager.LoadPrimaryAsset(ExperienceId, PreloadBundles, FStreamableDelegate(), FStreamableManager::DefaultAsyncLoadPriority);
+
+	if (!PreloadExperienceHandle.IsValid() || PreloadExperienceHandle->HasLoadCompleted())
+	{
+		OnPreloadExperienceLoaded(Generation);
+	}
+	else
+	{
+		PreloadExperienceHandle->BindCompleteDelegate(FStreamableDelegate::CreateWeakLambda(this, [this, Generation]()
+		{
+			OnPreloadExperienceLoaded(Generation);
+		}));
+	}
+
+	return true;
+}
+
+void ULyraExperienceManager::CancelPreload()
+{
+	if (PreloadStage != ELyraExperiencePreloadStage::None)
+	{
+		UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: Dropping preload of %s (stage %s)"), *PreloadExperienceId.ToString(), LexToString(PreloadStage));
+	}
+
+	ResetPreload(/*bReleaseLoadedAssets=*/ true);
+}
+
+void ULyraExperienceManager::NotifyExperienceLoaded(FPrimaryAssetId ExperienceId)
+{
+	if ((PreloadExperienceId == ExperienceId) && (PreloadStage != ELyraExperiencePreloadStage::None))
+	{
+		UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: Preload of %s consumed (stage %s)"), *ExperienceId.ToString(), LexToString(PreloadStage));
+
+		// The experience holds on to everything it needs now
+		ResetPreload(/*bReleaseLoadedAssets=*/ false);
+	}
+}
+
+void ULyraExperienceManager::AddExperienceAssetReferences(const TArray<FPrimaryAssetId>& AssetIds)
+{
+	for (const FPrimaryAssetId& AssetId : AssetIds)
+	{
+		++ExperienceAssetRefCounts.FindOrAdd(AssetId);
+	}
+}
+
+void ULyraExperienceManager::RemoveExperienceAssetReferences(const TArray<FPrimaryAssetId>& AssetIds)
+{
+	for (const FPrimaryAssetId& AssetId : AssetIds)
+	{
+		if (int32* RefCount = ExperienceAssetRefCounts.Find(AssetId))
+		{
+			if (--(*RefCount) <= 0)
+			{
+				ExperienceAssetRefCounts.Remove(AssetId);
+			}
+		}
+	}
+}
+
+void ULyraExperienceManager::ResetPreload(bool bReleaseLoadedAssets)
+{
+	// Stops any further stages (and late callbacks) of this preload
+	++PreloadGeneration;
+
+	if (bReleaseLoadedAssets)
+	{
+		ReleasePreloadedAssets();
+	}
+
+	PreloadExperienceHandle.Reset();
+	PreloadActionSetHandle.Reset();
+	PreloadLoadedAssetIds.Reset();
+	PreloadLoadedPluginURLs.Reset();
+
+	PreloadExperienceId = FPrimaryAssetId();
+	PreloadBundles.Reset();
+	PreloadStage = ELyraExperiencePreloadStage::None;
+	NumPreloadPluginsLoading = 0;
+}
+
+void ULyraExperienceManager::ReleasePreloadedAssets()
+{
+	// Anything an experience started using since the preload asked for it belongs to that experience now
+	TArray<FPrimaryAssetId> AssetIdsToUnload;
+	for (const FPrimaryAssetId& AssetId : PreloadLoadedAssetIds)
+	{
+		if (!ExperienceAssetRefCounts.Contains(AssetId))
+		{
+			AssetIdsToUnload.Add(AssetId);
+		}
+	}
+
+	if (AssetIdsToUnload.Num() > 0)
+	{
+		// Cancels the loads that are still in flight too
+		const int32 NumUnloaded = ULyraAssetManager::Get().UnloadPrimaryAssets(AssetIdsToUnload);
+		UE_LOG(LogLyraExperience, Verbose, TEXT("EXPERIENCE: Released %d preloaded primary asset(s)"), NumUnloaded);
+	}
+
+	// Plugins that got activated in the meantime are used by an experience, the rest go back to being registered
+	UGameFeaturesSubsystem& GameFeaturesSubsystem = UGameFeaturesSubsystem::Get();
+	for (const FString& PluginURL : PreloadLoadedPluginURLs)
+	{
+		if (!GameFeaturesSubsystem.IsGameFeaturePluginActive(PluginURL, /*bCheckForActivating=*/ true))
+		{
+			GameFeaturesSubsystem.UnloadGameFeaturePlugin(PluginURL, /*bKeepRegistered=*/ true);
+		}
+	}
+}
+
+void ULyraExperienceManager::RequestPreloadOfPrimaryAssets(const TArray<FPrimaryAssetId>& AssetIds)
+{
+	// Only what isn't loaded (or loading) yet is the preload's to release, the rest is already held by someone else
+	ULyraAssetManager& AssetManager = ULyraAssetManager::Get();
+	for (const FPrimaryAssetId& AssetId : AssetIds)
+	{
+		if (!AssetManager.GetPrimaryAssetHandle(AssetId).IsValid() && !ExperienceAssetRefCounts.Contains(AssetId))
+		{
+			PreloadLoadedAssetIds.AddUnique(AssetId);
+		}
+	}
+}
+
+bool ULyraExperienceManager::HasMemoryForPreload() const
+{
+	if (LyraConsoleVariables::ExperiencePreloadMinFreeMemoryMB <= 0)
+	{
+		return true;
+	}
+
+	const uint64 MinFreeBytes = (uint64)LyraConsoleVariables::ExperiencePreloadMinFreeMemoryMB * 1024 * 1024;
+	return FPlatformMemory::GetStats().AvailablePhysical >= MinFreeBytes;
+}
+
+void ULyraExperienceManager::AdvancePreloadStage(ELyraExperiencePreloadStage NewStage)
+{
+	const double CurrentTime = FPlatformTime::Seconds();
+	PreloadStageDurations.Emplace(PreloadStage, CurrentTime - PreloadStageStartTime);
+	PreloadStageStartTime = CurrentTime;
+	PreloadStage = NewStage;
+}
+
+void ULyraExperienceManager::OnPreloadExperienceLoaded(uint32 Generation)
+{
+	if ((Generation != PreloadGeneration) || (PreloadStage != ELyraExperiencePreloadStage::LoadingExperience))
+	{
+		return;
+	}
+
+	ULyraAssetManager& AssetManager = ULyraAssetManager::Get();
+	const UClass* ExperienceClass = Cast<UClass>(AssetManager.GetPrimaryAssetPath(PreloadExperienceId).ResolveObject());
+	const ULyraExperienceDefinition* Experience = (ExperienceClass != nullptr) ? GetDefault<ULyraExperienceDefinition>(ExperienceClass) : nullptr;
+	if (Experience == nullptr)
+	{
+		UE_LOG(LogLyraExperience, Warning, TEXT("EXPERIENCE: Preload of %s failed to load the experience definition"), *PreloadExperienceId.ToString());
+		CancelPreload();
+		return;
+	}
+
+	if (!HasMemoryForPreload())
+	{
+		UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: Stopping preload of %s, not enough free memory"), *PreloadExperienceId.ToString());
+		CancelPreload();
+		return;
+	}
+
+	AdvancePreloadStage(ELyraExperiencePreloadStage::LoadingActionSets);
+
+	TArray<FPrimaryAssetId> ActionSetIds;
+	for (const TObjectPtr<ULyraExperienceActionSet>& ActionSet : Experience->ActionSets)
+	{
+		if (ActionSet != nullptr)
+		{
+			ActionSetIds.AddUnique(ActionSet->GetPrimaryAssetId());
+		}
+	}
+
+	if (ActionSetIds.Num() > 0)
+	{
+		RequestPreloadOfPrimaryAssets(ActionSetIds);
+		PreloadActionSetHandle = AssetManager.ChangeBundleStateForPrimaryAssets(ActionSetIds, PreloadBundles, {}, false, FStreamableDelegate(), FStreamableManager::DefaultAsyncLoadPriority);
+	}
+
+	if (!PreloadActionSetHandle.IsValid() || PreloadActionSetHandle->HasLoadCompleted())
+	{
+		OnPreloadActionSetsLoaded(Generation);
+	}
+	else
+	{
+		PreloadActionSetHandle->BindCompleteDelegate(FStreamableDelegate::CreateWeakLambda(this, [this, Generation]()
+		{
+			OnPreloadActionSetsLoaded(Generation);
+		}));
+	}
+}
+
+void ULyraExperienceManager::OnPreloadActionSetsLoaded(uint32 Generation)
+{
+	if ((Generation != PreloadGeneration) || (PreloadStage != ELyraExperiencePreloadStage::LoadingActionSets))
+	{
+		return;
+	}
+
+	if (!HasMemoryForPreload())
+	{
+		UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: Stopping preload of %s, not enough free memory"), *PreloadExperienceId.ToString());
+		CancelPreload();
+		return;
+	}
+
+	AdvancePreloadStage(ELyraExperiencePreloadStage::LoadingGameFeatures);
+
+	const UClass* ExperienceClass = Cast<UClass>(ULyraAssetManager::Get().GetPrimaryAssetPath(PreloadExperienceId).ResolveObject());
+	const ULyraExperienceDefinition* Experience = (ExperienceClass != nullptr) ? GetDefault<ULyraExperienceDefinition>(ExperienceClass) : nullptr;
+
+	TArray<FString> PluginURLs;
+	auto CollectGameFeaturePluginURLs = [&PluginURLs](const TArray<FString>& FeaturePluginList)
+	{
+		for (const FString& PluginName : FeaturePluginList)
+		{
+			FString PluginURL;
+			if (UGameFeaturesSubsystem::Get().GetPluginURLByName(PluginName, /*out*/ PluginURL))
+			{
+				PluginURLs.AddUnique(PluginURL);
+			}
+		}
+	};
+
+	if (Experience != nullptr)
+	{
+		CollectGameFeaturePluginURLs(Experience->GameFeaturesToEnable);
+		for (const TObjectPtr<ULyraExperienceActionSet>& ActionSet : Experience->ActionSets)
+		{
+			if (ActionSet != nullptr)
+			{
+				CollectGameFeaturePluginURLs(ActionSet->GameFeaturesToEnable);
+			}
+		}
+	}
+
+	// Plugins that are already loaded or active (e.g., used by the current experience) are left alone, asking for them
+	// to be loaded would move an active plugin back down to the loaded state
+	UGameFeaturesSubsystem& GameFeaturesSubsystem = UGameFeaturesSubsystem::Get();
+	PluginURLs.RemoveAll([&GameFeaturesSubsystem](const FString& PluginURL)
+	{
+		return GameFeaturesSubsystem.IsGameFeaturePluginLoaded(PluginURL) || GameFeaturesSubsystem.IsGameFeaturePluginActive(PluginURL, /*bCheckForActivating=*/ true);
+	});
+
+	PreloadLoadedPluginURLs = PluginURLs;
+	NumPreloadPluginsLoading = PluginURLs.Num();
+	if (NumPreloadPluginsLoading == 0)
+	{
+		OnPreloadReady();
+		return;
+	}
+
+	for (const FString& PluginURL : PluginURLs)
+	{
+		GameFeaturesSubsystem.LoadGameFeaturePlugin(PluginURL, FGameFeaturePluginLoadComplete::CreateWeakLambda(this, [this, Generation](const UE::GameFeatures::FResult& Result)
+		{
+			OnPreloadGameFeaturePluginLoaded(Result, Generation);
+		}));
+	}
+}
+
+void ULyraExperienceManager::OnPreloadGameFeaturePluginLoaded(const UE::GameFeatures::FResult& Result, uint32 Generation)
+{
+	if ((Generation != PreloadGeneration) || (PreloadStage != ELyraExperiencePreloadStage::LoadingGameFeatures))
+	{
+		return;
+	}
+
+	if (Result.HasError())
+	{
+		// Not fatal, the real load will try (and report) again
+		UE_LOG(LogLyraExperience, Warning, TEXT("EXPERIENCE: Preload of %s failed to load a game feature plugin: %s"), *PreloadExperienceId.ToString(), *Result.GetError());
+	}
+
+	--NumPreloadPluginsLoading;
+	if (NumPreloadPluginsLoading == 0)
+	{
+		OnPreloadReady();
+	}
+}
+
+void ULyraExperienceManager::OnPreloadReady()
+{
+	AdvancePreloadStage(ELyraExperiencePreloadStage::Ready);
+
+	TStringBuilder<256> StageTimings;
+	for (const TPair<ELyraExperiencePreloadStage, double>& StageDuration : PreloadStageDurations)
+	{
+		StageTimings.Appendf(TEXT(" %s=%.1fms"), LexToString(StageDuration.Key), StageDuration.Value * 1000.0);
+	}
+
+	UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: Preload of %s ready in %.1fms:%s"),
+		*PreloadExperienceId.ToString(),
+		(FPlatformTime::Seconds() - PreloadStartTime) * 1000.0,
+		StageTimings.ToString());
+}
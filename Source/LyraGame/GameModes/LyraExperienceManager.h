@@ -3,10 +3,27 @@
 #pragma once
 
 #include "Subsystems/EngineSubsystem.h"
+#include "UObject/PrimaryAssetId.h"
 #include "LyraExperienceManager.generated.h"
 
+namespace UE::GameFeatures { struct FResult; }
+
+struct FStreamableHandle;
+
+enum class ELyraExperiencePreloadStage : uint8
+{
+	None,
+	LoadingExperience,
+	LoadingActionSets,
+	LoadingGameFeatures,
+	Ready
+};
+
 /**
  * Manager for experiences - primarily for arbitration between multiple PIE sessions
+ *
+ * Also holds the (single) warm standby experience: an experience that is expected to be used after the next map change
+ * can be preloaded in the background, which survives the game state (and its experience manager component) going away
  */
 UCLASS(MinimalAPI)
 class ULyraExperienceManager : public UEngineSubsystem
@@ -24,6 +41,64 @@ public:
 	static bool RequestToDeactivatePlugin(const FString PluginURL) { return true; }
 #endif
 
+	/**
+	 * Streams in an experience definition, the given bundles of it and its action sets, and loads (without activating) the
+	 * game feature plugins it needs, at a lower priority than regular loads so the current experience is not disturbed.
+	 * Replaces any previous preload. Returns false if the preload could not be started (e.g., not enough free memory)
+	 */
+	LYRAGAME_API bool PreloadExperience(FPrimaryAssetId ExperienceId, const TArray<FName>& BundlesToLoad);
+
+	/**
+	 * Drops the preloaded experience (if any), stopping any stages that haven't started yet. The primary assets and game
+	 * feature plugins the preload loaded are unloaded again, unless an experience in use needs them
+	 */
+	LYRAGAME_API void CancelPreload();
+
+	/** Called once an experience has finished loading for real, hands the preload over to it if there was one */
+	void NotifyExperienceLoaded(FPrimaryAssetId ExperienceId);
+
+	/** Called by experiences when they start loading and when they go away, so a cancelled preload leaves their assets alone */
+	void AddExperienceAssetReferences(const TArray<FPrimaryAssetId>& AssetIds);
+	void RemoveExperienceAssetReferences(const TArray<FPrimaryAssetId>& AssetIds);
+
+	FPrimaryAssetId GetPreloadedExperienceId() const { return PreloadExperienceId; }
+	ELyraExperiencePreloadStage GetPreloadStage() const { return PreloadStage; }
+
+private:
+	bool HasMemoryForPreload() const;
+	void ResetPreload(bool bReleaseLoadedAssets);
+	void ReleasePreloadedAssets();
+	void RequestPreloadOfPrimaryAssets(const TArray<FPrimaryAssetId>& AssetIds);
+	void AdvancePreloadStage(ELyraExperiencePreloadStage NewStage);
+	void OnPreloadExperienceLoaded(uint32 Generation);
+	void OnPreloadActionSetsLoaded(uint32 Generation);
+	void OnPreloadGameFeaturePluginLoaded(const UE::GameFeatures::FResult& Result, uint32 Generation);
+	void OnPreloadReady();
+
+private:
+	FPrimaryAssetId PreloadExperienceId;
+	TArray<FName> PreloadBundles;
+	ELyraExperiencePreloadStage PreloadStage = ELyraExperiencePreloadStage::None;
+
+	// Incremented whenever the preload is replaced or cancelled, so callbacks from an older preload are ignored
+	uint32 PreloadGeneration = 0;
+
+	TSharedPtr<FStreamableHandle> PreloadExperienceHandle;
+	TSharedPtr<FStreamableHandle> PreloadActionSetHandle;
+	int32 NumPreloadPluginsLoading = 0;
+
+	// What the preload loaded that wasn't loaded before, released again if the preload is cancelled
+	TArray<FPrimaryAssetId> PreloadLoadedAssetIds;
+	TArray<FString> PreloadLoadedPluginURLs;
+
+	// Primary assets used by experiences that are loading or loaded, by number of experiences using them
+	TMap<FPrimaryAssetId, int32> ExperienceAssetRefCounts;
+
+	// Timing of the preload stages (in seconds)
+	double PreloadStartTime = 0.0;
+	double PreloadStageStartTime = 0.0;
+	TArray<TPair<ELyraExperiencePreloadStage, double>> PreloadStageDurations;
+
 private:
 	// The map of requests to active count for a given game feature plugin
 	// (to allow first in, last out activation management during PIE)
@@ -2,6 +2,7 @@
 
 #include "LyraExperienceManagerComponent.h"
 #include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
 #include "Net/UnrealNetwork.h"
 #include "LyraExperienceDefinition.h"
 #include "LyraExperienceActionSet.h"
@@ -45,6 +46,19 @@ namespace LyraConsoleVariables
 	{
 		return FMath::Max(0.0f, ExperienceLoadRandomDelayMin + FMath::FRand() * ExperienceLoadRandomDelayRange);
 	}
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdPreloadExperience(
+		TEXT("Lyra.Experience.Preload"),
+		TEXT("Preloads an experience in the background for use after the next map change (e.g., Lyra.Experience.Preload LyraExperienceDefinition:B_ShooterGame_Elimination)"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			const AGameStateBase* GameState = (World != nullptr) ? World->GetGameState() : nullptr;
+			const ULyraExperienceManagerComponent* ExperienceComponent = (GameState != nullptr) ? GameState->FindComponentByClass<ULyraExperienceManagerComponent>() : nullptr;
+			if ((ExperienceComponent != nullptr) && (Args.Num() > 0))
+			{
+				ExperienceComponent->PreloadNextExperience(FPrimaryAssetId::FromString(Args[0]));
+			}
+		}));
 }
 
 ULyraExperienceManagerComponent::ULyraExperienceManagerComponent(const FObjectInitializer& ObjectInitializer)
@@ -130,6 +144,10 @@ void ULyraExperienceManagerComponent::StartExperienceLoad()
 		*GetClientServerContextString(this));
 
 	LoadState = ELyraExperienceLoadState::Loading;
+	LoadStartTime = FPlatformTime::Seconds();
+
+	ULyraExperienceManager* ExperienceManagerSubsystem = GEngine->GetEngineSubsystem<ULyraExperienceManager>();
+	bLoadStartedFromPreload = (ExperienceManagerSubsystem != nullptr) && (ExperienceManagerSubsystem->GetPreloadedExperienceId() == CurrentExperience->GetPrimaryAssetId());
 
 	ULyraAssetManager& AssetManager = ULyraAssetManager::Get();
 
@@ -145,24 +163,16 @@ void ULyraExperienceManagerComponent::StartExperienceLoad()
 		}
 	}
 
-	// Load assets associated with the experience
-
-	TArray<FName> BundlesToLoad;
-	BundlesToLoad.Add(FLyraBundles::Equipped);
-
-	//@TODO: Centralize this client/server stuff into the LyraAssetManager
-	const ENetMode OwnerNetMode = GetOwner()->GetNetMode();
-	const bool bLoadClient = GIsEditor || (OwnerNetMode != NM_DedicatedServer);
-	const bool bLoadServer = GIsEditor || (OwnerNetMode != NM_Client);
-	if (bLoadClient)
+	// A preload being cancelled from now on mustn't unload anything this experience uses
+	ExperienceAssetIds = BundleAssetList.Array();
+	if (ExperienceManagerSubsystem != nullptr)
 	{
-		BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateClient);
-	}
-	if (bLoadServer)
-	{
-		BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateServer);
+		ExperienceManagerSubsystem->AddExperienceAssetReferences(ExperienceAssetIds);
 	}
 
+	// Load assets associated with the experience
+	const TArray<FName> BundlesToLoad = GetBundlesToLoad();
+
 	TSharedPtr<FStreamableHandle> BundleLoadHandle = nullptr;
 	if (BundleAssetList.Num() > 0)
 	{
@@ -216,6 +226,8 @@ void ULyraExperienceManagerComponent::OnExperienceLoadComplete()
 	check(LoadState == ELyraExperienceLoadState::Loading);
 	check(CurrentExperience != nullptr);
 
+	AssetsLoadedTime = FPlatformTime::Seconds();
+
 	UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: OnExperienceLoadComplete(CurrentExperience = %s, %s)"),
 		*CurrentExperience->GetPrimaryAssetId().ToString(),
 		*GetClientServerContextString(this));
@@ -293,6 +305,8 @@ void ULyraExperienceManagerComponent::OnExperienceFullLoadCompleted()
 	// Insert a random delay for testing (if configured)
 	if (LoadState != ELyraExperienceLoadState::LoadingChaosTestingDelay)
 	{
+		GameFeaturesLoadedTime = FPlatformTime::Seconds();
+
 		const float DelaySecs = LyraConsoleVariables::GetExperienceLoadDelayDuration();
 		if (DelaySecs > 0.0f)
 		{
@@ -306,6 +320,7 @@ void ULyraExperienceManagerComponent::OnExperienceFullLoadCompleted()
 	}
 
 	LoadState = ELyraExperienceLoadState::ExecutingActions;
+	const double ActionsStartTime = FPlatformTime::Seconds();
 
 	// Execute the actions
 	FGameFeatureActivatingContext Context;
@@ -344,6 +359,22 @@ void ULyraExperienceManagerComponent::OnExperienceFullLoadCompleted()
 
 	LoadState = ELyraExperienceLoadState::Loaded;
 
+	const double LoadEndTime = FPlatformTime::Seconds();
+	UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: Load timing for %s (%s%s): Assets=%.1fms GameFeatures=%.1fms Delay=%.1fms Actions=%.1fms Total=%.1fms"),
+		*CurrentExperience->GetPrimaryAssetId().ToString(),
+		*GetClientServerContextString(this),
+		bLoadStartedFromPreload ? TEXT(", preloaded") : TEXT(""),
+		(AssetsLoadedTime - LoadStartTime) * 1000.0,
+		(GameFeaturesLoadedTime - AssetsLoadedTime) * 1000.0,
+		(ActionsStartTime - GameFeaturesLoadedTime) * 1000.0,
+		(LoadEndTime - ActionsStartTime) * 1000.0,
+		(LoadEndTime - LoadStartTime) * 1000.0);
+
+	if (ULyraExperienceManager* ExperienceManagerSubsystem = GEngine->GetEngineSubsystem<ULyraExperienceManager>())
+	{
+		ExperienceManagerSubsystem->NotifyExperienceLoaded(CurrentExperience->GetPrimaryAssetId());
+	}
+
 	OnExperienceLoaded_HighPriority.Broadcast(CurrentExperience);
 	OnExperienceLoaded_HighPriority.Clear();
 
@@ -381,6 +412,12 @@ void ULyraExperienceManagerComponent::EndPlay(const EEndPlayReason::Type EndPlay
 {
 	Super::EndPlay(EndPlayReason);
 
+	if (ULyraExperienceManager* ExperienceManagerSubsystem = GEngine->GetEngineSubsystem<ULyraExperienceManager>())
+	{
+		ExperienceManagerSubsystem->RemoveExperienceAssetReferences(ExperienceAssetIds);
+	}
+	ExperienceAssetIds.Reset();
+
 	// deactivate any features this experience loaded
 	//@TODO: This should be handled FILO as well
 	for (const FString& PluginURL : GameFeaturePluginURLs)
@@ -457,6 +494,37 @@ bool ULyraExperienceManagerComponent::ShouldShowLoadingScreen(FString& OutReason
 	}
 }
 
+bool ULyraExperienceManagerComponent::PreloadNextExperience(FPrimaryAssetId ExperienceId) const
+{
+	if (ULyraExperienceManager* ExperienceManagerSubsystem = GEngine->GetEngineSubsystem<ULyraExperienceManager>())
+	{
+		return ExperienceManagerSubsystem->PreloadExperience(ExperienceId, GetBundlesToLoad());
+	}
+
+	return false;
+}
+
+TArray<FName> ULyraExperienceManagerComponent::GetBundlesToLoad() const
+{
+	TArray<FName> BundlesToLoad;
+	BundlesToLoad.Add(FLyraBundles::Equipped);
+
+	//@TODO: Centralize this client/server stuff into the LyraAssetManager
+	const ENetMode OwnerNetMode = GetOwner()->GetNetMode();
+	const bool bLoadClient = GIsEditor || (OwnerNetMode != NM_DedicatedServer);
+	const bool bLoadServer = GIsEditor || (OwnerNetMode != NM_Client);
+	if (bLoadClient)
+	{
+		BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateClient);
+	}
+	if (bLoadServer)
+	{
+		BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateServer);
+	}
+
+	return BundlesToLoad;
+}
+
 void ULyraExperienceManagerComponent::OnAllActionsDeactivated()
 {
 	//@TODO: We actually only deactivated and didn't fully unload...
@@ -64,6 +64,11 @@ public:
 	// Returns true if the experience is fully loaded
 	bool IsExperienceLoaded() const;
 
+	// Starts streaming in an experience that is expected to be used after the next map change (e.g., the next playlist
+	// entry) in the background, without affecting the current experience. The preload is kept by ULyraExperienceManager
+	// so it survives the travel; returns false if it couldn't be started
+	bool PreloadNextExperience(FPrimaryAssetId ExperienceId) const;
+
 private:
 	UFUNCTION()
 	void OnRep_CurrentExperience();
@@ -76,6 +81,9 @@ private:
 	void OnActionDeactivationCompleted();
 	void OnAllActionsDeactivated();
 
+	// Returns the bundles to load for experiences in this net mode
+	TArray<FName> GetBundlesToLoad() const;
+
 private:
 	UPROPERTY(ReplicatedUsing=OnRep_CurrentExperience)
 	TObjectPtr<const ULyraExperienceDefinition> CurrentExperience;
@@ -85,9 +93,18 @@ private:
 	int32 NumGameFeaturePluginsLoading = 0;
 	TArray<FString> GameFeaturePluginURLs;
 
+	// The experience and its action sets, registered with ULyraExperienceManager while this experience uses them
+	TArray<FPrimaryAssetId> ExperienceAssetIds;
+
 	int32 NumObservedPausers = 0;
 	int32 NumExpectedPausers = 0;
 
+	// Timing of the load stages (FPlatformTime::Seconds), reported once the experience is loaded
+	double LoadStartTime = 0.0;
+	double AssetsLoadedTime = 0.0;
+	double GameFeaturesLoadedTime = 0.0;
+	bool bLoadStartedFromPreload = false;
+
 	/**
 	 * Delegate called when the experience has finished loading just before others
 	 * (e.g., subsystems that set up for regular gameplay)
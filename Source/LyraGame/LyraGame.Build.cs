@@ -60,6 +60,7 @@ public class LyraGame : ModuleRules
 				"RHI",
 				"Projects",
 				"Gauntlet",
+				"Json",
 				"UMG",
 				"CommonUI",
 				"CommonInput",
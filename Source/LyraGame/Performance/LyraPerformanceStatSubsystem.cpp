@@ -2,21 +2,165 @@
 
 #include "LyraPerformanceStatSubsystem.h"
 
+#include "Dom/JsonObject.h"
 #include "Engine/Engine.h"
 #include "Engine/GameInstance.h"
 #include "Engine/NetConnection.h"
 #include "Engine/World.h"
 #include "GameFramework/PlayerState.h"
 #include "GameModes/LyraGameState.h"
+#include "HAL/IConsoleManager.h"
+#include "LyraLogChannels.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 #include "Performance/LyraPerformanceStatTypes.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraPerformanceStatSubsystem)
 
 class FSubsystemCollectionBase;
 
+namespace LyraPerformanceStats
+{
+	static bool bExportHistogramsOnMatchEnd = false;
+	static FAutoConsoleVariableRef CVarExportHistogramsOnMatchEnd(
+		TEXT("Lyra.Perf.ExportHistogramsOnMatchEnd"),
+		bExportHistogramsOnMatchEnd,
+		TEXT("If true, the performance stat histograms (p50/p95/p99/max) are written to Saved/Profiling/PerfStats whenever a map is unloaded and on shutdown."),
+		ECVF_Default);
+
+	static const double ExportedPercentiles[] = { 50.0, 95.0, 99.0 };
+
+	static FString GetStatName(ELyraDisplayablePerformanceStat Stat)
+	{
+		return StaticEnum<ELyraDisplayablePerformanceStat>()->GetNameStringByValue((int64)Stat);
+	}
+
+	static void ForEachPerformanceStatSubsystem(UWorld* World, TFunctionRef<void(ULyraPerformanceStatSubsystem*)> Func)
+	{
+		if (UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr)
+		{
+			if (ULyraPerformanceStatSubsystem* Subsystem = GameInstance->GetSubsystem<ULyraPerformanceStatSubsystem>())
+			{
+				Func(Subsystem);
+			}
+		}
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs CVarDumpHistograms(
+		TEXT("Lyra.Perf.DumpStatHistograms"),
+		TEXT("Logs p50/p95/p99/max of every performance stat recorded since the current map was loaded."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			ForEachPerformanceStatSubsystem(World, [](ULyraPerformanceStatSubsystem* Subsystem) { Subsystem->DumpStatHistograms(); });
+		}));
+
+	static FAutoConsoleCommandWithWorldAndArgs CVarExportHistograms(
+		TEXT("Lyra.Perf.ExportStatHistograms"),
+		TEXT("Writes p50/p95/p99/max of every performance stat to a CSV and a JSON file. Optionally takes the path of the files (without extension)."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			const FString BaseFilename = (Args.Num() > 0) ? Args[0] : FString();
+			ForEachPerformanceStatSubsystem(World, [&BaseFilename](ULyraPerformanceStatSubsystem* Subsystem) { Subsystem->ExportStatHistograms(BaseFilename); });
+		}));
+
+	static FAutoConsoleCommandWithWorldAndArgs CVarResetHistograms(
+		TEXT("Lyra.Perf.ResetStatHistograms"),
+		TEXT("Clears the performance stat histograms."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			ForEachPerformanceStatSubsystem(World, [](ULyraPerformanceStatSubsystem* Subsystem) { Subsystem->ResetStatHistograms(); });
+		}));
+}
+
+//////////////////////////////////////////////////////////////////////
+// FLyraPerformanceStatHistogram
+
+FLyraPerformanceStatHistogram::FLyraPerformanceStatHistogram()
+{
+	Reset();
+}
+
+void FLyraPerformanceStatHistogram::AddSample(double Value)
+{
+	if (NumSamples == 0)
+	{
+		MinValue = Value;
+		MaxValue = Value;
+	}
+	else
+	{
+		MinValue = FMath::Min(MinValue, Value);
+		MaxValue = FMath::Max(MaxValue, Value);
+	}
+	SumValue += Value;
+	++NumSamples;
+
+	if (Value <= 0.0)
+	{
+		++NumNonPositiveSamples;
+		return;
+	}
+
+	const double Octaves = FMath::Log2(FMath::Max(Value, MinTrackedValue) / MinTrackedValue);
+	const int32 BucketIndex = FMath::Clamp(FMath::FloorToInt(Octaves * BucketsPerOctave), 0, NumBuckets - 1);
+	++Buckets[BucketIndex];
+}
+
+void FLyraPerformanceStatHistogram::Reset()
+{
+	FMemory::Memzero(Buckets);
+	NumNonPositiveSamples = 0;
+	NumSamples = 0;
+	MinValue = 0.0;
+	MaxValue = 0.0;
+	SumValue = 0.0;
+}
+
+double FLyraPerformanceStatHistogram::GetPercentile(double Fraction) const
+{
+	if (NumSamples == 0)
+	{
+		return 0.0;
+	}
+
+	// Nearest-rank, matching how the bot soak report computes percentiles from raw samples
+	const uint64 TargetRank = FMath::Clamp<uint64>((uint64)FMath::CeilToDouble(FMath::Clamp(Fraction, 0.0, 1.0) * (double)NumSamples), 1, NumSamples);
+	if (TargetRank == NumSamples)
+	{
+		return MaxValue;
+	}
+
+	uint64 Rank = NumNonPositiveSamples;
+	if (Rank >= TargetRank)
+	{
+		return FMath::Min(MinValue, 0.0);
+	}
+
+	for (int32 BucketIndex = 0; BucketIndex < NumBuckets; ++BucketIndex)
+	{
+		Rank += Buckets[BucketIndex];
+		if (Rank >= TargetRank)
+		{
+			const double BucketMidpoint = MinTrackedValue * FMath::Pow(2.0, (BucketIndex + 0.5) / BucketsPerOctave);
+			return FMath::Clamp(BucketMidpoint, MinValue, MaxValue);
+		}
+	}
+
+	return MaxValue;
+}
+
 //////////////////////////////////////////////////////////////////////
 // FLyraPerformanceStatCache
 
+FLyraPerformanceStatCache::FLyraPerformanceStatCache(ULyraPerformanceStatSubsystem* InSubsystem)
+	: MySubsystem(InSubsystem)
+{
+	Histograms.SetNum((int32)ELyraDisplayablePerformanceStat::Count);
+	RecordingStartTime = FPlatformTime::Seconds();
+}
+
 void FLyraPerformanceStatCache::StartCharting()
 {
 }
@@ -24,6 +168,9 @@ void FLyraPerformanceStatCache::StartCharting()
 void FLyraPerformanceStatCache::ProcessFrame(const FFrameData& FrameData)
 {
 	CachedData = FrameData;
+	bHasServerFPS = false;
+	bHasPing = false;
+	bHasNetConnection = false;
 	CachedServerFPS = 0.0f;
 	CachedPingMS = 0.0f;
 	CachedPacketLossIncomingPercent = 0.0f;
@@ -38,6 +185,7 @@ void FLyraPerformanceStatCache::ProcessFrame(const FFrameData& FrameData)
 		if (const ALyraGameState* GameState = World->GetGameState<ALyraGameState>())
 		{
 			CachedServerFPS = GameState->GetServerFPS();
+			bHasServerFPS = true;
 		}
 
 		if (APlayerController* LocalPC = GEngine->GetFirstLocalPlayerController(World))
@@ -45,10 +193,13 @@ void FLyraPerformanceStatCache::ProcessFrame(const FFrameData& FrameData)
 			if (APlayerState* PS = LocalPC->GetPlayerState<APlayerState>())
 			{
 				CachedPingMS = PS->GetPingInMilliseconds();
+				bHasPing = true;
 			}
 
 			if (UNetConnection* NetConnection = LocalPC->GetNetConnection())
 			{
+				bHasNetConnection = true;
+
 				const UNetConnection::FNetConnectionPacketLoss& InLoss = NetConnection->GetInLossPercentage();
 				CachedPacketLossIncomingPercent = InLoss.GetAvgLossPercentage();
 				const UNetConnection::FNetConnectionPacketLoss& OutLoss = NetConnection->GetOutLossPercentage();
@@ -62,12 +213,58 @@ void FLyraPerformanceStatCache::ProcessFrame(const FFrameData& FrameData)
 			}
 		}
 	}
+
+	for (ELyraDisplayablePerformanceStat Stat : TEnumRange<ELyraDisplayablePerformanceStat>())
+	{
+		if (IsStatAvailable(Stat))
+		{
+			Histograms[(int32)Stat].AddSample(GetCachedStat(Stat));
+		}
+	}
+	++NumRecordedFrames;
 }
 
 void FLyraPerformanceStatCache::StopCharting()
 {
 }
 
+bool FLyraPerformanceStatCache::IsStatAvailable(ELyraDisplayablePerformanceStat Stat) const
+{
+	switch (Stat)
+	{
+	case ELyraDisplayablePerformanceStat::ClientFPS:
+		return CachedData.TrueDeltaSeconds != 0.0;
+	case ELyraDisplayablePerformanceStat::ServerFPS:
+		return bHasServerFPS;
+	case ELyraDisplayablePerformanceStat::Ping:
+		return bHasPing;
+	case ELyraDisplayablePerformanceStat::PacketLoss_Incoming:
+	case ELyraDisplayablePerformanceStat::PacketLoss_Outgoing:
+	case ELyraDisplayablePerformanceStat::PacketRate_Incoming:
+	case ELyraDisplayablePerformanceStat::PacketRate_Outgoing:
+	case ELyraDisplayablePerformanceStat::PacketSize_Incoming:
+	case ELyraDisplayablePerformanceStat::PacketSize_Outgoing:
+		return bHasNetConnection;
+	default:
+		return true;
+	}
+}
+
+const FLyraPerformanceStatHistogram& FLyraPerformanceStatCache::GetStatHistogram(ELyraDisplayablePerformanceStat Stat) const
+{
+	return Histograms[(int32)Stat];
+}
+
+void FLyraPerformanceStatCache::ResetStatHistograms()
+{
+	for (FLyraPerformanceStatHistogram& Histogram : Histograms)
+	{
+		Histogram.Reset();
+	}
+	NumRecordedFrames = 0;
+	RecordingStartTime = FPlatformTime::Seconds();
+}
+
 double FLyraPerformanceStatCache::GetCachedStat(ELyraDisplayablePerformanceStat Stat) const
 {
 	static_assert((int32)ELyraDisplayablePerformanceStat::Count == 15, "Need to update this function to deal with new performance stats");
@@ -115,10 +312,21 @@ void ULyraPerformanceStatSubsystem::Initialize(FSubsystemCollectionBase& Collect
 {
 	Tracker = MakeShared<FLyraPerformanceStatCache>(this);
 	GEngine->AddPerformanceDataConsumer(Tracker);
+
+	FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &ThisClass::HandlePreLoadMap);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::HandlePostLoadMap);
 }
 
 void ULyraPerformanceStatSubsystem::Deinitialize()
 {
+	FCoreUObjectDelegates::PreLoadMap.RemoveAll(this);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
+
+	if (LyraPerformanceStats::bExportHistogramsOnMatchEnd && (Tracker->GetNumRecordedFrames() > 0))
+	{
+		ExportStatHistograms();
+	}
+
 	GEngine->RemovePerformanceDataConsumer(Tracker);
 	Tracker.Reset();
 }
@@ -128,3 +336,123 @@ double ULyraPerformanceStatSubsystem::GetCachedStat(ELyraDisplayablePerformanceS
 	return Tracker->GetCachedStat(Stat);
 }
 
+double ULyraPerformanceStatSubsystem::GetStatPercentile(ELyraDisplayablePerformanceStat Stat, double Percentile) const
+{
+	return Tracker->GetStatHistogram(Stat).GetPercentile(Percentile / 100.0);
+}
+
+double ULyraPerformanceStatSubsystem::GetStatMax(ELyraDisplayablePerformanceStat Stat) const
+{
+	return Tracker->GetStatHistogram(Stat).GetMax();
+}
+
+void ULyraPerformanceStatSubsystem::ResetStatHistograms()
+{
+	Tracker->ResetStatHistograms();
+}
+
+void ULyraPerformanceStatSubsystem::HandlePreLoadMap(const FString& MapName)
+{
+	// Leaving the current map is the end of the match as far as the histograms are concerned
+	if (LyraPerformanceStats::bExportHistogramsOnMatchEnd && (Tracker->GetNumRecordedFrames() > 0))
+	{
+		ExportStatHistograms();
+	}
+}
+
+void ULyraPerformanceStatSubsystem::HandlePostLoadMap(UWorld* LoadedWorld)
+{
+	if (LoadedWorld && (LoadedWorld->GetGameInstance() == GetGameInstance()))
+	{
+		ResetStatHistograms();
+	}
+}
+
+FString ULyraPerformanceStatSubsystem::GetDefaultExportFilename() const
+{
+	const UWorld* World = GetGameInstance()->GetWorld();
+	const FString MapName = World ? World->GetMapName() : TEXT("NoMap");
+	return FPaths::ProjectSavedDir() / TEXT("Profiling") / TEXT("PerfStats") / FString::Printf(TEXT("PerfStats_%s_%s"), *MapName, *FDateTime::Now().ToString());
+}
+
+void ULyraPerformanceStatSubsystem::DumpStatHistograms() const
+{
+	UE_LOG(LogLyra, Log, TEXT("Performance stats over %llu frames (%.1fs):"), Tracker->GetNumRecordedFrames(), FPlatformTime::Seconds() - Tracker->GetRecordingStartTime());
+	UE_LOG(LogLyra, Log, TEXT("  Stat\tSamples\tAvg\tP50\tP95\tP99\tMax"));
+
+	for (ELyraDisplayablePerformanceStat Stat : TEnumRange<ELyraDisplayablePerformanceStat>())
+	{
+		const FLyraPerformanceStatHistogram& Histogram = Tracker->GetStatHistogram(Stat);
+		if (Histogram.GetNumSamples() > 0)
+		{
+			UE_LOG(LogLyra, Log, TEXT("  %s\t%llu\t%.4f\t%.4f\t%.4f\t%.4f\t%.4f"),
+				*LyraPerformanceStats::GetStatName(Stat),
+				Histogram.GetNumSamples(),
+				Histogram.GetAverage(),
+				Histogram.GetPercentile(0.50),
+				Histogram.GetPercentile(0.95),
+				Histogram.GetPercentile(0.99),
+				Histogram.GetMax());
+		}
+	}
+}
+
+bool ULyraPerformanceStatSubsystem::ExportStatHistograms(const FString& BaseFilename)
+{
+	const FString FilenameWithoutExtension = BaseFilename.IsEmpty() ? GetDefaultExportFilename() : FPaths::ChangeExtension(BaseFilename, FString());
+
+	FString CsvText = TEXT("Stat,Samples,Average,Min,P50,P95,P99,Max\n");
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetNumberField(TEXT("frames"), (double)Tracker->GetNumRecordedFrames());
+	Report->SetNumberField(TEXT("durationSeconds"), FPlatformTime::Seconds() - Tracker->GetRecordingStartTime());
+	if (const UWorld* World = GetGameInstance()->GetWorld())
+	{
+		Report->SetStringField(TEXT("map"), World->GetMapName());
+	}
+
+	TSharedRef<FJsonObject> StatsObject = MakeShared<FJsonObject>();
+	for (ELyraDisplayablePerformanceStat Stat : TEnumRange<ELyraDisplayablePerformanceStat>())
+	{
+		const FLyraPerformanceStatHistogram& Histogram = Tracker->GetStatHistogram(Stat);
+		if (Histogram.GetNumSamples() == 0)
+		{
+			continue;
+		}
+
+		const FString StatName = LyraPerformanceStats::GetStatName(Stat);
+		CsvText += FString::Printf(TEXT("%s,%llu,%f,%f"), *StatName, Histogram.GetNumSamples(), Histogram.GetAverage(), Histogram.GetMin());
+
+		TSharedRef<FJsonObject> StatObject = MakeShared<FJsonObject>();
+		StatObject->SetNumberField(TEXT("samples"), (double)Histogram.GetNumSamples());
+		StatObject->SetNumberField(TEXT("avg"), Histogram.GetAverage());
+		StatObject->SetNumberField(TEXT("min"), Histogram.GetMin());
+		for (double Percentile : LyraPerformanceStats::ExportedPercentiles)
+		{
+			const double Value = Histogram.GetPercentile(Percentile / 100.0);
+			CsvText += FString::Printf(TEXT(",%f"), Value);
+			StatObject->SetNumberField(FString::Printf(TEXT("p%d"), FMath::RoundToInt(Percentile)), Value);
+		}
+		StatObject->SetNumberField(TEXT("max"), Histogram.GetMax());
+		CsvText += FString::Printf(TEXT(",%f\n"), Histogram.GetMax());
+
+		StatsObject->SetObjectField(StatName, StatObject);
+	}
+	Report->SetObjectField(TEXT("stats"), StatsObject);
+
+	FString JsonText;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonText);
+	FJsonSerializer::Serialize(Report, Writer);
+
+	const FString CsvFilename = FilenameWithoutExtension + TEXT(".csv");
+	const FString JsonFilename = FilenameWithoutExtension + TEXT(".json");
+	if (!FFileHelper::SaveStringToFile(CsvText, *CsvFilename) || !FFileHelper::SaveStringToFile(JsonText, *JsonFilename))
+	{
+		UE_LOG(LogLyra, Error, TEXT("Failed to write performance stat histograms to %s"), *FilenameWithoutExtension);
+		return false;
+	}
+
+	UE_LOG(LogLyra, Display, TEXT("Wrote performance stat histograms (%llu frames) to %s.csv/.json"), Tracker->GetNumRecordedFrames(), *FPaths::ConvertRelativePathToFull(FilenameWithoutExtension));
+	return true;
+}
+
@@ -16,14 +16,50 @@ struct FFrame;
 
 //////////////////////////////////////////////////////////////////////
 
-// Observer which caches the stats for the previous frame
+// Fixed-size streaming histogram for a single stat, used to answer percentile queries (p50/p95/p99) over a whole match.
+// Buckets are log-spaced so relative precision is the same for frame times in seconds and packet sizes in bytes
+// (each bucket is ~4.4% wide, percentiles are reported at the bucket's geometric midpoint); min/max/average are exact.
+struct FLyraPerformanceStatHistogram
+{
+public:
+	static constexpr int32 BucketsPerOctave = 16;
+	static constexpr int32 NumOctaves = 40;
+	static constexpr int32 NumBuckets = BucketsPerOctave * NumOctaves;
+
+	// Smallest value with its own bucket; the range covers [1e-6, ~1.1e6] and values outside it land in the end buckets
+	static constexpr double MinTrackedValue = 1.0e-6;
+
+	FLyraPerformanceStatHistogram();
+
+	void AddSample(double Value);
+	void Reset();
+
+	// Returns the value below which Fraction (0..1) of the samples fall
+	double GetPercentile(double Fraction) const;
+
+	uint64 GetNumSamples() const { return NumSamples; }
+	double GetMin() const { return (NumSamples > 0) ? MinValue : 0.0; }
+	double GetMax() const { return (NumSamples > 0) ? MaxValue : 0.0; }
+	double GetAverage() const { return (NumSamples > 0) ? (SumValue / (double)NumSamples) : 0.0; }
+
+private:
+	uint32 Buckets[NumBuckets];
+
+	// Samples that are zero or negative (e.g., no packet loss), which would otherwise skew the lowest bucket
+	uint64 NumNonPositiveSamples = 0;
+	uint64 NumSamples = 0;
+	double MinValue = 0.0;
+	double MaxValue = 0.0;
+	double SumValue = 0.0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Observer which caches the stats for the previous frame and accumulates a histogram of each stat
 struct FLyraPerformanceStatCache : public IPerformanceDataConsumer
 {
 public:
-	FLyraPerformanceStatCache(ULyraPerformanceStatSubsystem* InSubsystem)
-		: MySubsystem(InSubsystem)
-	{
-	}
+	FLyraPerformanceStatCache(ULyraPerformanceStatSubsystem* InSubsystem);
 
 	//~IPerformanceDataConsumer interface
 	virtual void StartCharting() override;
@@ -33,6 +69,17 @@ public:
 
 	double GetCachedStat(ELyraDisplayablePerformanceStat Stat) const;
 
+	const FLyraPerformanceStatHistogram& GetStatHistogram(ELyraDisplayablePerformanceStat Stat) const;
+	void ResetStatHistograms();
+
+	// Number of frames recorded since the histograms were last reset
+	uint64 GetNumRecordedFrames() const { return NumRecordedFrames; }
+	double GetRecordingStartTime() const { return RecordingStartTime; }
+
+protected:
+	// Returns false for stats that have no source this frame (e.g., ping on a dedicated server), so they don't pollute the histogram with zeros
+	bool IsStatAvailable(ELyraDisplayablePerformanceStat Stat) const;
+
 protected:
 	IPerformanceDataConsumer::FFrameData CachedData;
 	ULyraPerformanceStatSubsystem* MySubsystem;
@@ -45,6 +92,15 @@ protected:
 	float CachedPacketRateOutgoing = 0.0f;
 	float CachedPacketSizeIncoming = 0.0f;
 	float CachedPacketSizeOutgoing = 0.0f;
+
+	bool bHasServerFPS = false;
+	bool bHasPing = false;
+	bool bHasNetConnection = false;
+
+	// One histogram per ELyraDisplayablePerformanceStat, allocated once up front
+	TArray<FLyraPerformanceStatHistogram> Histograms;
+	uint64 NumRecordedFrames = 0;
+	double RecordingStartTime = 0.0;
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -59,11 +115,37 @@ public:
 	UFUNCTION(BlueprintCallable)
 	double GetCachedStat(ELyraDisplayablePerformanceStat Stat) const;
 
+	// Returns the value of the stat at the given percentile (0..100) since the histograms were last reset (the start of the current map)
+	UFUNCTION(BlueprintCallable)
+	double GetStatPercentile(ELyraDisplayablePerformanceStat Stat, double Percentile) const;
+
+	// Returns the largest value of the stat since the histograms were last reset
+	UFUNCTION(BlueprintCallable)
+	double GetStatMax(ELyraDisplayablePerformanceStat Stat) const;
+
+	// Clears the accumulated histograms; this happens automatically whenever a new map is loaded
+	UFUNCTION(BlueprintCallable)
+	void ResetStatHistograms();
+
+	// Writes p50/p95/p99/max for every recorded stat to <BaseFilename>.csv and <BaseFilename>.json.
+	// If BaseFilename is empty a timestamped file in Saved/Profiling/PerfStats is used. Returns false if nothing could be written.
+	UFUNCTION(BlueprintCallable)
+	bool ExportStatHistograms(const FString& BaseFilename = TEXT(""));
+
+	// Logs p50/p95/p99/max for every recorded stat
+	void DumpStatHistograms() const;
+
 	//~USubsystem interface
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
 	//~End of USubsystem interface
 
+protected:
+	void HandlePreLoadMap(const FString& MapName);
+	void HandlePostLoadMap(UWorld* LoadedWorld);
+
+	FString GetDefaultExportFilename() const;
+
 protected:
 	TSharedPtr<FLyraPerformanceStatCache> Tracker;
 };
@@ -1,11 +1,19 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "LyraReplaySubsystem.h"
+#include "Algo/BinarySearch.h"
+#include "Dom/JsonObject.h"
 #include "Engine/GameInstance.h"
 #include "Engine/World.h"
 #include "Engine/DemoNetDriver.h"
+#include "HAL/FileManager.h"
 #include "Internationalization/Text.h"
 #include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
 #include "CommonUISettings.h"
 #include "ICommonUIModule.h"
 #include "LyraLogChannels.h"
@@ -16,10 +24,41 @@
 
 UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Platform_Trait_ReplaySupport, "Platform.Trait.ReplaySupport");
 
+namespace LyraReplayCVars
+{
+	static FAutoConsoleCommandWithWorldAndArgs MeasureSeekLatencyCmd(
+		TEXT("Lyra.Replay.MeasureSeekLatency"),
+		TEXT("While a replay is playing, seeks to N random times (default 20) one after another and logs the latency. Add 'preview' to measure checkpoint-only scrub previews instead."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(ULyraReplaySubsystem::MeasureSeekLatency));
+
+	static float IndexMaxAgeHours = 24.0f;
+	static FAutoConsoleVariableRef CVarIndexMaxAgeHours(
+		TEXT("Lyra.Replay.IndexMaxAgeHours"),
+		IndexMaxAgeHours,
+		TEXT("CleanupLocalReplays enumerates the streams again instead of trusting the local replay index once it is older than this"),
+		ECVF_Default);
+}
+
 ULyraReplaySubsystem::ULyraReplaySubsystem()
 {
 }
 
+void ULyraReplaySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Polls the demo driver while recording to note where checkpoints land
+	ReplayIndexTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::TickReplayIndex), 0.0f);
+}
+
+void ULyraReplaySubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(ReplayIndexTickHandle);
+	FinishRecordingIndexEntry();
+
+	Super::Deinitialize();
+}
+
 bool ULyraReplaySubsystem::DoesPlatformSupportReplays()
 {
 	if (ICommonUIModule::GetSettings().GetPlatformTraits().HasTag(GetPlatformSupportTraitTag()))
@@ -48,7 +87,8 @@ void ULyraReplaySubsystem::RecordClientReplay(APlayerController* PlayerControlle
 	if (ensure(DoesPlatformSupportReplays() && PlayerController))
 	{
 		FText FriendlyNameText = FText::Format(NSLOCTEXT("Lyra", "LyraReplayName_Format", "Client Replay {0}"), FText::AsDateTime(FDateTime::UtcNow(), EDateTimeStyle::Short, EDateTimeStyle::Short));
-		GetGameInstance()->StartRecordingReplay(FString(), FriendlyNameText.ToString());
+		PendingRecordingFriendlyName = FriendlyNameText.ToString();
+		GetGameInstance()->StartRecordingReplay(FString(), PendingRecordingFriendlyName);
 
 		if (ULyraLocalPlayer* LyraLocalPlayer = Cast<ULyraLocalPlayer>(PlayerController->GetLocalPlayer()))
 		{
@@ -72,6 +112,14 @@ void ULyraReplaySubsystem::CleanupLocalReplays(ULocalPlayer* LocalPlayer, int32
 		CurrentReplayStreamer = FNetworkReplayStreaming::Get().GetFactory().CreateReplayStreamer();
 		if (CurrentReplayStreamer.IsValid())
 		{
+			// Once the index knows about the local replays there's no need to enumerate (and re-enumerate after every delete)
+			if (GatherIndexedReplaysToDelete())
+			{
+				bDeletingFromIndex = true;
+				DeleteNextIndexedReplay();
+				return;
+			}
+
 			// Use the default version to get old version replays as well
 			FNetworkReplayVersion EnumerateStreamsVersion;
 
@@ -80,6 +128,152 @@ void ULyraReplaySubsystem::CleanupLocalReplays(ULocalPlayer* LocalPlayer, int32
 	}
 }
 
+bool ULyraReplaySubsystem::GatherIndexedReplaysToDelete()
+{
+	LoadReplayIndex();
+	IndexedReplaysToDelete.Reset();
+
+	// The index only works for replays written to local files (and written by a build that has the index), otherwise enumerate
+	const FString DemoDir = FPaths::GetPath(GetReplayIndexFilename());
+	TArray<FString> ReplayFiles;
+	IFileManager::Get().FindFiles(ReplayFiles, *(DemoDir / TEXT("*.replay")), /*Files=*/ true, /*Directories=*/ false);
+
+	TSet<FString> StreamsOnDisk;
+	for (const FString& ReplayFile : ReplayFiles)
+	{
+		StreamsOnDisk.Add(FPaths::GetBaseFilename(ReplayFile));
+	}
+
+	bool bRemovedMissing = false;
+	for (auto It = ReplayIndex.CreateIterator(); It; ++It)
+	{
+		if (!StreamsOnDisk.Contains(It.Key()))
+		{
+			It.RemoveCurrent();
+			bRemovedMissing = true;
+		}
+	}
+
+	if (bRemovedMissing)
+	{
+		SaveReplayIndex();
+	}
+
+	// The replay being recorded isn't indexed until it finishes, so it isn't a miss
+	const FTimespan MaxAge = FTimespan::FromHours(FMath::Max(LyraReplayCVars::IndexMaxAgeHours, 0.0f));
+	if ((ReplayIndex.Num() == 0) || IsReplayIndexStale(ReplayIndex, StreamsOnDisk, RecordingIndexEntry.StreamName, LastReplayIndexEnumerateTime, FDateTime::UtcNow(), MaxAge))
+	{
+		return false;
+	}
+
+	// The replay being recorded still counts towards the limit
+	int32 NumToKeep = DeletingReplaysNumberToKeep;
+	if (UDemoNetDriver* DemoDriver = GetDemoDriver())
+	{
+		if (DemoDriver->IsRecording())
+		{
+			NumToKeep = FMath::Max(NumToKeep - 1, 0);
+		}
+	}
+
+	SelectIndexedReplaysToDelete(ReplayIndex, NumToKeep, IndexedReplaysToDelete);
+	return true;
+}
+
+void ULyraReplaySubsystem::SelectIndexedReplaysToDelete(const TMap<FString, FLyraReplayIndexEntry>& Index, int32 NumReplaysToKeep, TArray<FString>& OutReplaysToDelete)
+{
+	OutReplaysToDelete.Reset();
+
+	TArray<const FLyraReplayIndexEntry*> Entries;
+	for (const TPair<FString, FLyraReplayIndexEntry>& Pair : Index)
+	{
+		// Never delete keep streams
+		if (!Pair.Value.bShouldKeep)
+		{
+			Entries.Add(&Pair.Value);
+		}
+	}
+	Algo::SortBy(Entries, [](const FLyraReplayIndexEntry* Entry) { return Entry->Timestamp.GetTicks(); }, TGreater<>());
+
+	// Newest first, so the oldest ends up last and is deleted first
+	for (int32 EntryIndex = FMath::Max(NumReplaysToKeep, 0); EntryIndex < Entries.Num(); ++EntryIndex)
+	{
+		OutReplaysToDelete.Add(Entries[EntryIndex]->StreamName);
+	}
+}
+
+bool ULyraReplaySubsystem::MergeEnumeratedStreams(TMap<FString, FLyraReplayIndexEntry>& Index, const TArray<FNetworkReplayStreamInfo>& Streams)
+{
+	bool bIndexChanged = false;
+	for (const FNetworkReplayStreamInfo& StreamInfo : Streams)
+	{
+		if (StreamInfo.bIsLive)
+		{
+			continue;
+		}
+
+		FLyraReplayIndexEntry* Entry = Index.Find(StreamInfo.Name);
+		if (Entry == nullptr)
+		{
+			Entry = &Index.Add(StreamInfo.Name);
+			Entry->StreamName = StreamInfo.Name;
+			Entry->FriendlyName = StreamInfo.FriendlyName;
+			Entry->Timestamp = StreamInfo.Timestamp;
+			Entry->LengthInMS = StreamInfo.LengthInMS;
+			bIndexChanged = true;
+		}
+
+		if (Entry->bShouldKeep != StreamInfo.bShouldKeep)
+		{
+			Entry->bShouldKeep = StreamInfo.bShouldKeep;
+			bIndexChanged = true;
+		}
+	}
+	return bIndexChanged;
+}
+
+bool ULyraReplaySubsystem::IsReplayIndexStale(const TMap<FString, FLyraReplayIndexEntry>& Index, const TSet<FString>& StreamsOnDisk, const FString& IgnoredStreamName, const FDateTime& LastEnumerateTime, const FDateTime& Now, const FTimespan& MaxAge)
+{
+	if ((Now - LastEnumerateTime) > MaxAge)
+	{
+		return true;
+	}
+
+	for (const FString& StreamName : StreamsOnDisk)
+	{
+		if ((StreamName != IgnoredStreamName) && !Index.Contains(StreamName))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void ULyraReplaySubsystem::DeleteNextIndexedReplay()
+{
+	if (!CurrentReplayStreamer.IsValid() || !IsValid(LocalPlayerDeletingReplays) || (IndexedReplaysToDelete.Num() == 0))
+	{
+		StopDeletingReplays();
+		return;
+	}
+
+	const FString ReplayName = IndexedReplaysToDelete.Pop();
+	ReplayBeingDeleted = ReplayName;
+	UE_LOG(LogLyra, Log, TEXT("LyraReplaySubsystem asked to delete replay %s"), *ReplayName);
+	CurrentReplayStreamer->DeleteFinishedStream(ReplayName, LocalPlayerDeletingReplays->GetPlatformUserIndex(), FDeleteFinishedStreamCallback::CreateUObject(this, &ThisClass::OnDeleteReplay));
+}
+
+void ULyraReplaySubsystem::StopDeletingReplays()
+{
+	CurrentReplayStreamer = nullptr;
+	LocalPlayerDeletingReplays = nullptr;
+	DeletingReplaysNumberToKeep = 0;
+	IndexedReplaysToDelete.Reset();
+	ReplayBeingDeleted.Reset();
+	bDeletingFromIndex = false;
+}
+
 void ULyraReplaySubsystem::OnEnumerateStreamsCompleteForDelete(const FEnumerateStreamsResult& Result)
 {
 	if (!CurrentReplayStreamer.IsValid() || !IsValid(LocalPlayerDeletingReplays))
@@ -88,6 +282,12 @@ void ULyraReplaySubsystem::OnEnumerateStreamsCompleteForDelete(const FEnumerateS
 		return;
 	}
 
+	// Bring the index up to date (new replays and keep flags), so later cleanups can skip enumerating
+	LoadReplayIndex();
+	MergeEnumeratedStreams(ReplayIndex, Result.FoundStreams);
+	LastReplayIndexEnumerateTime = FDateTime::UtcNow();
+	SaveReplayIndex();
+
 	TArray<FNetworkReplayStreamInfo> StreamsToDelete;
 	for (const FNetworkReplayStreamInfo& StreamInfo : Result.FoundStreams)
 	{
@@ -119,15 +319,14 @@ void ULyraReplaySubsystem::OnEnumerateStreamsCompleteForDelete(const FEnumerateS
 		// Delete the first replay above the limit, if successful it won't be in the loop during the next loop
 		// If unsuccessful, it will stop looping
 		FString ReplayName = StreamsToDelete[DeletingReplaysNumberToKeep].Name;
+		ReplayBeingDeleted = ReplayName;
 		UE_LOG(LogLyra, Log, TEXT("LyraReplaySubsystem asked to delete replay %s"), *ReplayName);
 		CurrentReplayStreamer->DeleteFinishedStream(ReplayName, LocalPlayerDeletingReplays->GetPlatformUserIndex(), FDeleteFinishedStreamCallback::CreateUObject(this, &ThisClass::OnDeleteReplay));
 	}
 	else
 	{
 		// We're below the limit so stop iterating
-		CurrentReplayStreamer = nullptr;
-		LocalPlayerDeletingReplays = nullptr;
-		DeletingReplaysNumberToKeep = 0;
+		StopDeletingReplays();
 	}
 }
 
@@ -139,7 +338,17 @@ void ULyraReplaySubsystem::OnDeleteReplay(const FDeleteFinishedStreamResult& Del
 		return;
 	}
 
-	if (DeleteResult.WasSuccessful())
+	if (DeleteResult.WasSuccessful() && (ReplayIndex.Remove(ReplayBeingDeleted) > 0))
+	{
+		SaveReplayIndex();
+	}
+
+	if (DeleteResult.WasSuccessful() && bDeletingFromIndex)
+	{
+		// The list to delete was worked out up front from the index
+		DeleteNextIndexedReplay();
+	}
+	else if (DeleteResult.WasSuccessful())
 	{
 		// Enumerate list again to see if we're under the limit yet
 		FNetworkReplayVersion EnumerateStreamsVersion;
@@ -152,20 +361,188 @@ void ULyraReplaySubsystem::OnDeleteReplay(const FDeleteFinishedStreamResult& Del
 		// TODO properly integrate with platform-specific error reporting
 		UE_LOG(LogLyra, Warning, TEXT("Failed to delete replay with error %d!"), (int32)DeleteResult.Result);
 
-		CurrentReplayStreamer = nullptr;
-		LocalPlayerDeletingReplays = nullptr;
-		DeletingReplaysNumberToKeep = 0;
+		StopDeletingReplays();
 	}
 }
 
 void ULyraReplaySubsystem::SeekInActiveReplay(float TimeInSeconds)
+{
+	// Only the latest position matters while the user is dragging, so don't queue up every intermediate seek.
+	// A seek that never reports back shouldn't block seeking forever though.
+	const double MaxSeekSeconds = 10.0;
+	if (bSeekInProgress && ((FPlatformTime::Seconds() - SeekStartTime) < MaxSeekSeconds))
+	{
+		PendingSeekTime = TimeInSeconds;
+	}
+	else
+	{
+		StartSeek(TimeInSeconds);
+	}
+
+	// Wherever this lands, it isn't a checkpoint that a preview can skip restoring
+	LastPreviewCheckpointTimeInMS = MAX_uint32;
+}
+
+void ULyraReplaySubsystem::ScrubPreviewInActiveReplay(float TimeInSeconds)
+{
+	const FLyraReplayIndexEntry* Entry = FindActiveReplayIndexEntry();
+	if ((Entry == nullptr) || (Entry->CheckpointTimesInMS.Num() == 0))
+	{
+		SeekInActiveReplay(TimeInSeconds);
+		return;
+	}
+
+	// Checkpoint at or before the requested time, or the start of the replay
+	const uint32 TimeInMS = (uint32)FMath::Max(FMath::RoundToInt32(TimeInSeconds * 1000.0f), 0);
+	const int32 CheckpointIndex = Algo::UpperBound(Entry->CheckpointTimesInMS, TimeInMS) - 1;
+	const uint32 CheckpointTimeInMS = (CheckpointIndex >= 0) ? Entry->CheckpointTimesInMS[CheckpointIndex] : 0;
+
+	// Still within the same checkpoint as the last preview, nothing to restore
+	if ((CheckpointTimeInMS == LastPreviewCheckpointTimeInMS) && (PendingSeekTime < 0.0f))
+	{
+		return;
+	}
+
+	SeekInActiveReplay(CheckpointTimeInMS / 1000.0f);
+	LastPreviewCheckpointTimeInMS = CheckpointTimeInMS;
+}
+
+TArray<float> ULyraReplaySubsystem::GetActiveReplayCheckpointTimes() const
+{
+	TArray<float> Result;
+	if (const FLyraReplayIndexEntry* Entry = FindActiveReplayIndexEntry())
+	{
+		Result.Reserve(Entry->CheckpointTimesInMS.Num());
+		for (uint32 CheckpointTimeInMS : Entry->CheckpointTimesInMS)
+		{
+			Result.Add(CheckpointTimeInMS / 1000.0f);
+		}
+	}
+	return Result;
+}
+
+void ULyraReplaySubsystem::StartSeek(float TimeInSeconds)
 {
 	if (UDemoNetDriver* DemoDriver = GetDemoDriver())
 	{
-		DemoDriver->GotoTimeInSeconds(TimeInSeconds);
+		bSeekInProgress = true;
+		SeekStartTime = FPlatformTime::Seconds();
+		DemoDriver->GotoTimeInSeconds(TimeInSeconds, FOnGotoTimeDelegate::CreateUObject(this, &ThisClass::OnSeekComplete));
 	}
 }
 
+void ULyraReplaySubsystem::OnSeekComplete(bool bWasSuccessful)
+{
+	bSeekInProgress = false;
+
+	if (!bWasSuccessful)
+	{
+		// The scrubbed-to checkpoint is unknown now
+		LastPreviewCheckpointTimeInMS = MAX_uint32;
+	}
+
+#if !UE_BUILD_SHIPPING
+	if (MeasureSeeksRemaining > 0)
+	{
+		MeasuredSeekLatenciesMS.Add((FPlatformTime::Seconds() - SeekStartTime) * 1000.0);
+		if (--MeasureSeeksRemaining > 0)
+		{
+			StartMeasuredSeek();
+		}
+		else
+		{
+			FinishSeekLatencyMeasurement();
+		}
+		return;
+	}
+#endif
+
+	if (PendingSeekTime >= 0.0f)
+	{
+		const float NextSeekTime = PendingSeekTime;
+		PendingSeekTime = -1.0f;
+		StartSeek(NextSeekTime);
+	}
+}
+
+void ULyraReplaySubsystem::MeasureSeekLatency(const TArray<FString>& Args, UWorld* World)
+{
+#if !UE_BUILD_SHIPPING
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	ULyraReplaySubsystem* ReplaySubsystem = GameInstance ? GameInstance->GetSubsystem<ULyraReplaySubsystem>() : nullptr;
+	UDemoNetDriver* DemoDriver = ReplaySubsystem ? ReplaySubsystem->GetDemoDriver() : nullptr;
+	if (!DemoDriver || !DemoDriver->IsPlaying())
+	{
+		UE_LOG(LogLyra, Warning, TEXT("Lyra.Replay.MeasureSeekLatency needs a replay to be playing"));
+		return;
+	}
+
+	int32 NumSeeks = 20;
+	for (const FString& Arg : Args)
+	{
+		if (Arg.IsNumeric())
+		{
+			NumSeeks = FMath::Max(FCString::Atoi(*Arg), 1);
+		}
+	}
+
+	ReplaySubsystem->StartSeekLatencyMeasurement(NumSeeks, Args.Contains(TEXT("preview")));
+#endif
+}
+
+#if !UE_BUILD_SHIPPING
+bool ULyraReplaySubsystem::StartSeekLatencyMeasurement(int32 NumSeeks, bool bPreviewSeeks)
+{
+	UDemoNetDriver* DemoDriver = GetDemoDriver();
+	if (!DemoDriver || !DemoDriver->IsPlaying() || (NumSeeks <= 0))
+	{
+		return false;
+	}
+
+	bMeasurePreviewSeeks = bPreviewSeeks;
+	MeasureSeeksRemaining = NumSeeks;
+	MeasuredSeekLatenciesMS.Reset();
+	MeasureRandom.Initialize(NumSeeks);
+	PendingSeekTime = -1.0f;
+	StartMeasuredSeek();
+	return true;
+}
+
+void ULyraReplaySubsystem::FinishSeekLatencyMeasurement()
+{
+	MeasuredSeekLatenciesMS.Sort();
+	double TotalMS = 0.0;
+	for (double LatencyMS : MeasuredSeekLatenciesMS)
+	{
+		TotalMS += LatencyMS;
+	}
+	const int32 NumSeeks = MeasuredSeekLatenciesMS.Num();
+	UE_LOG(LogLyra, Display, TEXT("Replay seek latency (%s, %d seeks, %d checkpoints): avg %.1fms, p50 %.1fms, p95 %.1fms, max %.1fms"),
+		bMeasurePreviewSeeks ? TEXT("preview") : TEXT("full"), NumSeeks, GetActiveReplayCheckpointTimes().Num(),
+		TotalMS / NumSeeks, MeasuredSeekLatenciesMS[NumSeeks / 2], MeasuredSeekLatenciesMS[FMath::Min((NumSeeks * 95) / 100, NumSeeks - 1)], MeasuredSeekLatenciesMS.Last());
+}
+
+void ULyraReplaySubsystem::StartMeasuredSeek()
+{
+	const float TargetTime = MeasureRandom.FRandRange(0.0f, GetReplayLengthInSeconds());
+	if (bMeasurePreviewSeeks)
+	{
+		// Every sample should restore a checkpoint, rather than being skipped for landing on the same one twice
+		LastPreviewCheckpointTimeInMS = MAX_uint32;
+		const FLyraReplayIndexEntry* Entry = FindActiveReplayIndexEntry();
+		if (Entry && (Entry->CheckpointTimesInMS.Num() > 0))
+		{
+			const uint32 TimeInMS = (uint32)FMath::RoundToInt32(TargetTime * 1000.0f);
+			const int32 CheckpointIndex = Algo::UpperBound(Entry->CheckpointTimesInMS, TimeInMS) - 1;
+			StartSeek((CheckpointIndex >= 0) ? (Entry->CheckpointTimesInMS[CheckpointIndex] / 1000.0f) : 0.0f);
+			return;
+		}
+	}
+
+	StartSeek(TargetTime);
+}
+#endif
+
 float ULyraReplaySubsystem::GetReplayLengthInSeconds() const
 {
 	if (UDemoNetDriver* DemoDriver = GetDemoDriver())
@@ -193,5 +570,170 @@ UDemoNetDriver* ULyraReplaySubsystem::GetDemoDriver() const
 	return nullptr;
 }
 
+FString ULyraReplaySubsystem::GetReplayIndexFilename() const
+{
+	// Next to the local file streamer's .replay files
+	return FPaths::ProjectSavedDir() / TEXT("Demos") / TEXT("LyraReplayIndex.json");
+}
+
+void ULyraReplaySubsystem::LoadReplayIndex()
+{
+	if (bReplayIndexLoaded)
+	{
+		return;
+	}
+	bReplayIndexLoaded = true;
+
+	FString IndexText;
+	if (!FFileHelper::LoadFileToString(IndexText, *GetReplayIndexFilename()))
+	{
+		return;
+	}
+
+	TSharedPtr<FJsonObject> IndexObject;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(IndexText), IndexObject) || !IndexObject.IsValid())
+	{
+		UE_LOG(LogLyra, Warning, TEXT("LyraReplaySubsystem could not parse %s, rebuilding the replay index"), *GetReplayIndexFilename());
+		return;
+	}
+
+	// Missing from version 1 indices, which leaves it at the minimum date so the first cleanup enumerates
+	FString LastEnumerateString;
+	if (IndexObject->TryGetStringField(TEXT("lastEnumerated"), LastEnumerateString))
+	{
+		FDateTime::ParseIso8601(*LastEnumerateString, LastReplayIndexEnumerateTime);
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* ReplayValues = nullptr;
+	if (IndexObject->TryGetArrayField(TEXT("replays"), ReplayValues))
+	{
+		for (const TSharedPtr<FJsonValue>& ReplayValue : *ReplayValues)
+		{
+			const TSharedPtr<FJsonObject>* ReplayObject = nullptr;
+			if (!ReplayValue->TryGetObject(ReplayObject))
+			{
+				continue;
+			}
+
+			FLyraReplayIndexEntry Entry;
+			if (!(*ReplayObject)->TryGetStringField(TEXT("name"), Entry.StreamName) || Entry.StreamName.IsEmpty())
+			{
+				continue;
+			}
+
+			FString TimestampString;
+			(*ReplayObject)->TryGetStringField(TEXT("friendlyName"), Entry.FriendlyName);
+			(*ReplayObject)->TryGetStringField(TEXT("timestamp"), TimestampString);
+			FDateTime::ParseIso8601(*TimestampString, Entry.Timestamp);
+			(*ReplayObject)->TryGetNumberField(TEXT("lengthMS"), Entry.LengthInMS);
+			(*ReplayObject)->TryGetBoolField(TEXT("shouldKeep"), Entry.bShouldKeep);
+
+			const TArray<TSharedPtr<FJsonValue>>* CheckpointValues = nullptr;
+			if ((*ReplayObject)->TryGetArrayField(TEXT("checkpointsMS"), CheckpointValues))
+			{
+				for (const TSharedPtr<FJsonValue>& CheckpointValue : *CheckpointValues)
+				{
+					Entry.CheckpointTimesInMS.Add((uint32)CheckpointValue->AsNumber());
+				}
+				Entry.CheckpointTimesInMS.Sort();
+			}
+
+			ReplayIndex.Add(Entry.StreamName, MoveTemp(Entry));
+		}
+	}
+}
+
+void ULyraReplaySubsystem::SaveReplayIndex() const
+{
+	TArray<TSharedPtr<FJsonValue>> ReplayValues;
+	for (const TPair<FString, FLyraReplayIndexEntry>& Pair : ReplayIndex)
+	{
+		const FLyraReplayIndexEntry& Entry = Pair.Value;
 
+		TArray<TSharedPtr<FJsonValue>> CheckpointValues;
+		for (uint32 CheckpointTimeInMS : Entry.CheckpointTimesInMS)
+		{
+			CheckpointValues.Add(MakeShared<FJsonValueNumber>(CheckpointTimeInMS));
+		}
 
+		TSharedRef<FJsonObject> ReplayObject = MakeShared<FJsonObject>();
+		ReplayObject->SetStringField(TEXT("name"), Entry.StreamName);
+		ReplayObject->SetStringField(TEXT("friendlyName"), Entry.FriendlyName);
+		ReplayObject->SetStringField(TEXT("timestamp"), Entry.Timestamp.ToIso8601());
+		ReplayObject->SetNumberField(TEXT("lengthMS"), Entry.LengthInMS);
+		ReplayObject->SetBoolField(TEXT("shouldKeep"), Entry.bShouldKeep);
+		ReplayObject->SetArrayField(TEXT("checkpointsMS"), CheckpointValues);
+		ReplayValues.Add(MakeShared<FJsonValueObject>(ReplayObject));
+	}
+
+	TSharedRef<FJsonObject> IndexObject = MakeShared<FJsonObject>();
+	IndexObject->SetNumberField(TEXT("version"), 2);
+	IndexObject->SetStringField(TEXT("lastEnumerated"), LastReplayIndexEnumerateTime.ToIso8601());
+	IndexObject->SetArrayField(TEXT("replays"), ReplayValues);
+
+	FString IndexText;
+	FJsonSerializer::Serialize(IndexObject, TJsonWriterFactory<>::Create(&IndexText));
+	if (!FFileHelper::SaveStringToFile(IndexText, *GetReplayIndexFilename()))
+	{
+		UE_LOG(LogLyra, Warning, TEXT("LyraReplaySubsystem could not write %s"), *GetReplayIndexFilename());
+	}
+}
+
+bool ULyraReplaySubsystem::TickReplayIndex(float DeltaTime)
+{
+	UDemoNetDriver* DemoDriver = GetDemoDriver();
+	const FString StreamName = (DemoDriver && DemoDriver->IsRecording()) ? DemoDriver->GetActiveReplayName() : FString();
+
+	if (StreamName != RecordingIndexEntry.StreamName)
+	{
+		FinishRecordingIndexEntry();
+
+		if (!StreamName.IsEmpty())
+		{
+			RecordingIndexEntry.StreamName = StreamName;
+			RecordingIndexEntry.FriendlyName = PendingRecordingFriendlyName.IsEmpty() ? StreamName : PendingRecordingFriendlyName;
+			RecordingIndexEntry.Timestamp = FDateTime::UtcNow();
+			PendingRecordingFriendlyName.Reset();
+			bWasSavingCheckpoint = false;
+		}
+	}
+
+	if (!RecordingIndexEntry.StreamName.IsEmpty())
+	{
+		// Checkpoint saves can be spread over several frames, the time it started is the time it restores to
+		const bool bSavingCheckpoint = DemoDriver->IsSavingCheckpoint();
+		if (bSavingCheckpoint && !bWasSavingCheckpoint)
+		{
+			RecordingIndexEntry.CheckpointTimesInMS.Add((uint32)FMath::Max(FMath::RoundToInt32(DemoDriver->GetDemoCurrentTime() * 1000.0f), 0));
+		}
+		bWasSavingCheckpoint = bSavingCheckpoint;
+		RecordingIndexEntry.LengthInMS = (uint32)FMath::Max(FMath::RoundToInt32(DemoDriver->GetDemoTotalTime() * 1000.0f), 0);
+	}
+
+	return true;
+}
+
+void ULyraReplaySubsystem::FinishRecordingIndexEntry()
+{
+	if (RecordingIndexEntry.StreamName.IsEmpty())
+	{
+		return;
+	}
+
+	LoadReplayIndex();
+	ReplayIndex.Add(RecordingIndexEntry.StreamName, MoveTemp(RecordingIndexEntry));
+	RecordingIndexEntry = FLyraReplayIndexEntry();
+	SaveReplayIndex();
+}
+
+const FLyraReplayIndexEntry* ULyraReplaySubsystem::FindActiveReplayIndexEntry() const
+{
+	UDemoNetDriver* DemoDriver = GetDemoDriver();
+	if (!DemoDriver || !DemoDriver->IsPlaying())
+	{
+		return nullptr;
+	}
+
+	const_cast<ThisClass*>(this)->LoadReplayIndex();
+	return ReplayIndex.Find(DemoDriver->GetActiveReplayName());
+}
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "Containers/Ticker.h"
 #include "NetworkReplayStreaming.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "GameplayTagContainer.h"
@@ -11,8 +12,24 @@
 class UDemoNetDriver;
 class APlayerController;
 class ULocalPlayer;
+class UWorld;
 struct FFrame;
 
+/** What we know about a replay recorded on this machine, kept in Saved/Demos/LyraReplayIndex.json */
+struct FLyraReplayIndexEntry
+{
+	FString StreamName;
+	FString FriendlyName;
+	FDateTime Timestamp;
+	uint32 LengthInMS = 0;
+
+	/** Keep streams are never deleted by CleanupLocalReplays and don't count towards the number to keep */
+	bool bShouldKeep = false;
+
+	/** Demo times that checkpoints were saved at, ascending */
+	TArray<uint32> CheckpointTimesInMS;
+};
+
 /** An available replay for display in the UI */
 UCLASS(BlueprintType)
 class LYRAGAME_API ULyraReplayListEntry : public UObject
@@ -63,6 +80,11 @@ class LYRAGAME_API ULyraReplaySubsystem : public UGameInstanceSubsystem
 public:
 	ULyraReplaySubsystem();
 
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
 	/** Returns true if this platform supports replays at all */
 	UFUNCTION(BlueprintCallable, Category = Replays, BlueprintPure = false)
 	static bool DoesPlatformSupportReplays();
@@ -82,10 +104,42 @@ public:
 	UFUNCTION(BlueprintCallable, Category = Replays)
 	void CleanupLocalReplays(ULocalPlayer* LocalPlayer, int32 NumReplaysToKeep);
 
-	/** Move forward or back in currently playing replay */
+	/** Move forward or back in currently playing replay, seeks requested while one is in progress are collapsed into the latest */
 	UFUNCTION(BlueprintCallable, Category=Replays)
 	void SeekInActiveReplay(float TimeInSeconds);
 
+	/**
+	 * Cheap seek for scrubbing, jumps to the nearest checkpoint at or before the given time so only the checkpoint is restored.
+	 * Falls back to a normal seek if the replay has no checkpoint index.
+	 */
+	UFUNCTION(BlueprintCallable, Category=Replays)
+	void ScrubPreviewInActiveReplay(float TimeInSeconds);
+
+	/** Gets the checkpoint times of the current replay from the local index, empty if it isn't indexed */
+	UFUNCTION(BlueprintCallable, Category=Replays, BlueprintPure=false)
+	TArray<float> GetActiveReplayCheckpointTimes() const;
+
+	static void MeasureSeekLatency(const TArray<FString>& Args, UWorld* World);
+
+#if !UE_BUILD_SHIPPING
+	/** Seeks to NumSeeks random times in the playing replay one after another, timing each one (checkpoint-only seeks if bPreviewSeeks) */
+	bool StartSeekLatencyMeasurement(int32 NumSeeks, bool bPreviewSeeks);
+	bool IsMeasuringSeekLatency() const { return MeasureSeeksRemaining > 0; }
+	const TArray<double>& GetMeasuredSeekLatenciesMS() const { return MeasuredSeekLatenciesMS; }
+#endif
+
+	/** Works out which indexed replays to delete to get down to NumReplaysToKeep, oldest last. Keep streams are never picked and don't count */
+	static void SelectIndexedReplaysToDelete(const TMap<FString, FLyraReplayIndexEntry>& Index, int32 NumReplaysToKeep, TArray<FString>& OutReplaysToDelete);
+
+	/** Adds enumerated streams the index doesn't know about and refreshes the keep flag of the ones it does, returns true if the index changed */
+	static bool MergeEnumeratedStreams(TMap<FString, FLyraReplayIndexEntry>& Index, const TArray<FNetworkReplayStreamInfo>& Streams);
+
+	/**
+	 * Returns true if the index can't be trusted for cleanup: a replay on disk is missing from it (other than IgnoredStreamName),
+	 * or the streams haven't been enumerated for longer than MaxAge (keep flags can change outside of the game)
+	 */
+	static bool IsReplayIndexStale(const TMap<FString, FLyraReplayIndexEntry>& Index, const TSet<FString>& StreamsOnDisk, const FString& IgnoredStreamName, const FDateTime& LastEnumerateTime, const FDateTime& Now, const FTimespan& MaxAge);
+
 	/** Gets length of current replay */
 	UFUNCTION(BlueprintCallable, Category = Replays, BlueprintPure = false)
 	float GetReplayLengthInSeconds() const;
@@ -106,4 +160,56 @@ private:
 
 	void OnEnumerateStreamsCompleteForDelete(const FEnumerateStreamsResult& Result);
 	void OnDeleteReplay(const FDeleteFinishedStreamResult& DeleteResult);
+	void StopDeletingReplays();
+
+	// Replay index
+	FString GetReplayIndexFilename() const;
+	void LoadReplayIndex();
+	void SaveReplayIndex() const;
+	bool TickReplayIndex(float DeltaTime);
+	void FinishRecordingIndexEntry();
+	const FLyraReplayIndexEntry* FindActiveReplayIndexEntry() const;
+	bool GatherIndexedReplaysToDelete();
+	void DeleteNextIndexedReplay();
+
+	// Seeking
+	void StartSeek(float TimeInSeconds);
+	void OnSeekComplete(bool bWasSuccessful);
+
+private:
+	// Local replays by stream name
+	TMap<FString, FLyraReplayIndexEntry> ReplayIndex;
+	bool bReplayIndexLoaded = false;
+
+	// When the index was last refreshed from EnumerateStreams
+	FDateTime LastReplayIndexEnumerateTime;
+
+	// The replay currently being recorded, added to the index when recording stops
+	FLyraReplayIndexEntry RecordingIndexEntry;
+	FString PendingRecordingFriendlyName;
+	bool bWasSavingCheckpoint = false;
+
+	FTSTicker::FDelegateHandle ReplayIndexTickHandle;
+
+	// Replays left to delete when cleaning up through the index, oldest last
+	TArray<FString> IndexedReplaysToDelete;
+	FString ReplayBeingDeleted;
+	bool bDeletingFromIndex = false;
+
+	// Seek in flight and the latest seek requested while it was running (negative when none)
+	bool bSeekInProgress = false;
+	double SeekStartTime = 0.0;
+	float PendingSeekTime = -1.0f;
+	uint32 LastPreviewCheckpointTimeInMS = MAX_uint32;
+
+#if !UE_BUILD_SHIPPING
+	// Lyra.Replay.MeasureSeekLatency state
+	int32 MeasureSeeksRemaining = 0;
+	bool bMeasurePreviewSeeks = false;
+	TArray<double> MeasuredSeekLatenciesMS;
+	FRandomStream MeasureRandom;
+
+	void StartMeasuredSeek();
+	void FinishSeekLatencyMeasurement();
+#endif
 };
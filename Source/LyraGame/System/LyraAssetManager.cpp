@@ -11,6 +11,7 @@
 #include "Engine/Engine.h"
 #include "AbilitySystem/LyraGameplayCueManager.h"
 #include "Misc/ScopedSlowTask.h"
+#include "Misc/FileHelper.h"
 #include "System/LyraAssetManagerStartupJob.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraAssetManager)
@@ -27,7 +28,7 @@ static FAutoConsoleCommand CVarDumpLoadedAssets(
 
 //////////////////////////////////////////////////////////////////////
 
-#define STARTUP_JOB_WEIGHTED(JobFunc, JobWeight) StartupJobs.Add(FLyraAssetManagerStartupJob(#JobFunc, [this](const FLyraAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& LoadHandle){JobFunc;}, JobWeight))
+#define STARTUP_JOB_WEIGHTED(JobFunc, JobWeight) StartupJobs.Add_GetRef(FLyraAssetManagerStartupJob(#JobFunc, [this](const FLyraAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& LoadHandle){JobFunc;}, JobWeight))
 #define STARTUP_JOB(JobFunc) STARTUP_JOB_WEIGHTED(JobFunc, 1.f)
 
 //////////////////////////////////////////////////////////////////////
@@ -81,6 +82,13 @@ bool ULyraAssetManager::ShouldLogAssetLoads()
 	return bLogAssetLoads;
 }
 
+bool ULyraAssetManager::ShouldRunStartupJobsSerially()
+{
+	// Runs each startup job to completion before starting the next, used to compare against the overlapped path
+	static bool bSerialStartupJobs = FParse::Param(FCommandLine::Get(), TEXT("LyraSerialStartupJobs"));
+	return bSerialStartupJobs;
+}
+
 void ULyraAssetManager::AddLoadedAsset(const UObject* Asset)
 {
 	if (ensureAlways(Asset))
@@ -110,13 +118,16 @@ void ULyraAssetManager::StartInitialLoading()
 	// This does all of the scanning, need to do this now even if loads are deferred
 	Super::StartInitialLoading();
 
-	STARTUP_JOB(InitializeGameplayCueManager());
+	// Jobs start in the order they are queued and synchronous jobs block until they finish, so queue the async
+	// game data load first to have it stream in while the gameplay cue manager loads its cues
 
 	{
-		// Load base game data asset
-		STARTUP_JOB_WEIGHTED(GetGameData(), 25.f);
+		// Load base game data asset. The primary assets stream in while the other jobs run, and GetGameData picks them up once resident
+		STARTUP_JOB_WEIGHTED(StartLoadingGameData(LoadHandle), 25.f).OnComplete([this]() { GetGameData(); });
 	}
 
+	STARTUP_JOB(InitializeGameplayCueManager());
+
 	// Run all the queued up startup jobs
 	DoAllStartupJobs();
 }
@@ -131,6 +142,15 @@ void ULyraAssetManager::InitializeGameplayCueManager()
 }
 
 
+void ULyraAssetManager::StartLoadingGameData(TSharedPtr<FStreamableHandle>& OutLoadHandle)
+{
+	// The editor loads game data on demand from PostLoad, leave it to the synchronous path in LoadGameDataOfClass
+	if (!GIsEditor && !LyraGameDataPath.IsNull() && !GameDataMap.Contains(ULyraGameData::StaticClass()))
+	{
+		OutLoadHandle = LoadPrimaryAssetsWithType(ULyraGameData::StaticClass()->GetFName());
+	}
+}
+
 const ULyraGameData& ULyraAssetManager::GetGameData()
 {
 	return GetOrLoadTypedGameData<ULyraGameData>(LyraGameDataPath);
@@ -195,54 +215,158 @@ void ULyraAssetManager::DoAllStartupJobs()
 	SCOPED_BOOT_TIMING("ULyraAssetManager::DoAllStartupJobs");
 	const double AllStartupJobsStartTime = FPlatformTime::Seconds();
 
-	if (IsRunningDedicatedServer())
+	const bool bRunSerially = ShouldRunStartupJobsSerially();
+
+	// No need for periodic progress updates on dedicated servers
+	const bool bReportProgress = !IsRunningDedicatedServer();
+
+	const int32 NumJobs = StartupJobs.Num();
+
+	float TotalJobValue = 0.0f;
+	for (const FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
 	{
-		// No need for periodic progress updates, just run the jobs
-		for (const FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
+		TotalJobValue += StartupJob.JobWeight;
+	}
+
+	enum class EJobState : uint8
+	{
+		Pending,
+		Loading,
+		Complete
+	};
+
+	TArray<EJobState> JobStates;
+	JobStates.Init(EJobState::Pending, NumJobs);
+
+	TArray<TSharedPtr<FStreamableHandle>> JobHandles;
+	JobHandles.SetNum(NumJobs);
+
+	// Progress of each job from 0 to 1, summed by weight for the overall percentage since several jobs can be loading at once
+	TArray<float> JobProgress;
+	JobProgress.Init(0.0f, NumJobs);
+
+	auto UpdateOverallProgress = [this, &JobProgress, TotalJobValue]()
+	{
+		float AccumulatedJobValue = 0.0f;
+		for (int32 JobIndex = 0; JobIndex < StartupJobs.Num(); ++JobIndex)
 		{
-			StartupJob.DoJob();
+			AccumulatedJobValue += JobProgress[JobIndex] * StartupJobs[JobIndex].JobWeight;
+		}
+		UpdateInitialGameContentLoadPercent((TotalJobValue > 0.0f) ? (AccumulatedJobValue / TotalJobValue) : 1.0f);
+	};
+
+	if (bReportProgress)
+	{
+		for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
+		{
+			StartupJobs[JobIndex].SubstepProgressDelegate.BindLambda([&JobProgress, &UpdateOverallProgress, JobIndex](float NewProgress)
+				{
+					JobProgress[JobIndex] = FMath::Clamp(NewProgress, 0.0f, 1.0f);
+					UpdateOverallProgress();
+				});
 		}
 	}
-	else
+
+	auto AreDependenciesComplete = [this, &JobStates](const FLyraAssetManagerStartupJob& StartupJob)
 	{
-		if (StartupJobs.Num() > 0)
+		for (const FString& Dependency : StartupJob.Dependencies)
 		{
-			float TotalJobValue = 0.0f;
-			for (const FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
+			const int32 DependencyIndex = StartupJobs.IndexOfByPredicate([&Dependency](const FLyraAssetManagerStartupJob& Other) { return Other.JobName == Dependency; });
+			if ((DependencyIndex != INDEX_NONE) && (JobStates[DependencyIndex] != EJobState::Complete))
 			{
-				TotalJobValue += StartupJob.JobWeight;
+				return false;
 			}
+		}
+		return true;
+	};
 
-			float AccumulatedJobValue = 0.0f;
-			for (FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
-			{
-				const float JobValue = StartupJob.JobWeight;
-				StartupJob.SubstepProgressDelegate.BindLambda([This = this, AccumulatedJobValue, JobValue, TotalJobValue](float NewProgress)
-					{
-						const float SubstepAdjustment = FMath::Clamp(NewProgress, 0.0f, 1.0f) * JobValue;
-						const float OverallPercentWithSubstep = (AccumulatedJobValue + SubstepAdjustment) / TotalJobValue;
+	auto CompleteJob = [&](int32 JobIndex)
+	{
+		StartupJobs[JobIndex].FinishJob(JobHandles[JobIndex]);
+		JobHandles[JobIndex].Reset();
+		JobStates[JobIndex] = EJobState::Complete;
+		JobProgress[JobIndex] = 1.0f;
 
-						This->UpdateInitialGameContentLoadPercent(OverallPercentWithSubstep);
-					});
+		if (bReportProgress)
+		{
+			UpdateOverallProgress();
+		}
+	};
 
-				StartupJob.DoJob();
+	int32 NumComplete = 0;
+	while (NumComplete < NumJobs)
+	{
+		// Start everything that is ready, or just the next job if running serially
+		bool bAnyLoading = JobStates.Contains(EJobState::Loading);
+		bool bStartedAny = false;
+		for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
+		{
+			if (bRunSerially && (bAnyLoading || bStartedAny))
+			{
+				break;
+			}
 
-				StartupJob.SubstepProgressDelegate.Unbind();
+			if ((JobStates[JobIndex] != EJobState::Pending) || !AreDependenciesComplete(StartupJobs[JobIndex]))
+			{
+				continue;
+			}
 
-				AccumulatedJobValue += JobValue;
+			bStartedAny = true;
+			JobHandles[JobIndex] = StartupJobs[JobIndex].StartJob();
 
-				UpdateInitialGameContentLoadPercent(AccumulatedJobValue / TotalJobValue);
+			if (!bRunSerially && JobHandles[JobIndex].IsValid() && !JobHandles[JobIndex]->HasLoadCompleted())
+			{
+				JobStates[JobIndex] = EJobState::Loading;
+				bAnyLoading = true;
+			}
+			else
+			{
+				CompleteJob(JobIndex);
+				++NumComplete;
 			}
 		}
-		else
+
+		if (bAnyLoading)
+		{
+			// Waiting on one handle keeps the async loader servicing every other outstanding request too
+			const int32 JobIndex = JobStates.IndexOfByKey(EJobState::Loading);
+			CompleteJob(JobIndex);
+			++NumComplete;
+		}
+		else if (!bStartedAny && (NumComplete < NumJobs))
 		{
-			UpdateInitialGameContentLoadPercent(1.0f);
+			// Nothing is loading and nothing could start, the remaining jobs have missing or circular dependencies
+			const int32 JobIndex = JobStates.IndexOfByKey(EJobState::Pending);
+			UE_LOG(LogLyra, Error, TEXT("Startup job \"%s\" has dependencies that can never complete, running it anyway"), *StartupJobs[JobIndex].JobName);
+			StartupJobs[JobIndex].Dependencies.Reset();
 		}
 	}
 
+	for (FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
+	{
+		StartupJob.SubstepProgressDelegate.Unbind();
+	}
+
+	if (bReportProgress && (NumJobs == 0))
+	{
+		UpdateInitialGameContentLoadPercent(1.0f);
+	}
+
 	StartupJobs.Empty();
 
-	UE_LOG(LogLyra, Display, TEXT("All startup jobs took %.2f seconds to complete"), FPlatformTime::Seconds() - AllStartupJobsStartTime);
+	const double AllStartupJobsTime = FPlatformTime::Seconds() - AllStartupJobsStartTime;
+	UE_LOG(LogLyra, Display, TEXT("All startup jobs took %.2f seconds to complete (%s)"), AllStartupJobsTime, bRunSerially ? TEXT("serial") : TEXT("parallel"));
+
+	FString ReportFile;
+	if (FParse::Value(FCommandLine::Get(), TEXT("LyraStartupJobs.ReportFile="), ReportFile))
+	{
+		// Read back by ULyraStartupTimingCommandlet
+		FFileHelper::SaveStringToFile(FString::Printf(TEXT("%s,%f"), bRunSerially ? TEXT("serial") : TEXT("parallel"), AllStartupJobsTime), *ReportFile);
+		if (FParse::Param(FCommandLine::Get(), TEXT("LyraStartupJobs.ExitWhenDone")))
+		{
+			FPlatformMisc::RequestExit(/*bForce=*/ false);
+		}
+	}
 }
 
 void ULyraAssetManager::UpdateInitialGameContentLoadPercent(float GameContentPercent)
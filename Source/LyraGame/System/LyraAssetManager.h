@@ -67,6 +67,7 @@ protected:
 
 	static UObject* SynchronousLoadAsset(const FSoftObjectPath& AssetPath);
 	static bool ShouldLogAssetLoads();
+	static bool ShouldRunStartupJobsSerially();
 
 	// Thread safe way of adding a loaded asset to keep in memory.
 	void AddLoadedAsset(const UObject* Asset);
@@ -95,12 +96,15 @@ protected:
 	TSoftObjectPtr<ULyraPawnData> DefaultPawnData;
 
 private:
-	// Flushes the StartupJobs array. Processes all startup work.
+	// Flushes the StartupJobs array. Processes all startup work, overlapping the loads of jobs that don't depend on each other.
 	void DoAllStartupJobs();
 
 	// Sets up the ability system
 	void InitializeGameplayCueManager();
 
+	// Starts streaming in the game data so it can load alongside other startup jobs (GetGameData finishes it)
+	void StartLoadingGameData(TSharedPtr<FStreamableHandle>& OutLoadHandle);
+
 	// Called periodically during loads, could be used to feed the status to a loading screen
 	void UpdateInitialGameContentLoadPercent(float GameContentPercent);
 
@@ -4,9 +4,9 @@
 
 #include "LyraLogChannels.h"
 
-TSharedPtr<FStreamableHandle> FLyraAssetManagerStartupJob::DoJob() const
+TSharedPtr<FStreamableHandle> FLyraAssetManagerStartupJob::StartJob() const
 {
-	const double JobStartTime = FPlatformTime::Seconds();
+	JobStartTime = FPlatformTime::Seconds();
 
 	TSharedPtr<FStreamableHandle> Handle;
 	UE_LOG(LogLyra, Display, TEXT("Startup job \"%s\" starting"), *JobName);
@@ -15,11 +15,30 @@ TSharedPtr<FStreamableHandle> FLyraAssetManagerStartupJob::DoJob() const
 	if (Handle.IsValid())
 	{
 		Handle->BindUpdateDelegate(FStreamableUpdateDelegate::CreateRaw(this, &FLyraAssetManagerStartupJob::UpdateSubstepProgressFromStreamable));
+	}
+
+	return Handle;
+}
+
+void FLyraAssetManagerStartupJob::FinishJob(const TSharedPtr<FStreamableHandle>& Handle) const
+{
+	if (Handle.IsValid())
+	{
 		Handle->WaitUntilComplete(0.0f, false);
 		Handle->BindUpdateDelegate(FStreamableUpdateDelegate());
 	}
 
+	if (CompletionFunc)
+	{
+		CompletionFunc();
+	}
+
 	UE_LOG(LogLyra, Display, TEXT("Startup job \"%s\" took %.2f seconds to complete"), *JobName, FPlatformTime::Seconds() - JobStartTime);
+}
 
+TSharedPtr<FStreamableHandle> FLyraAssetManagerStartupJob::DoJob() const
+{
+	TSharedPtr<FStreamableHandle> Handle = StartJob();
+	FinishJob(Handle);
 	return Handle;
 }
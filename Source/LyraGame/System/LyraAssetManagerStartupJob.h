@@ -6,14 +6,23 @@
 
 DECLARE_DELEGATE_OneParam(FLyraAssetManagerStartupJobSubstepProgress, float /*NewProgress*/);
 
-/** Handles reporting progress from streamable handles */
+/**
+ * Handles reporting progress from streamable handles
+ *
+ * A job may hand back a streamable handle instead of blocking on it, in which case the asset manager keeps the
+ * load in flight alongside other jobs and calls FinishJob once it has completed. Jobs only start once every job
+ * named in Dependencies has finished.
+ */
 struct FLyraAssetManagerStartupJob
 {
 	FLyraAssetManagerStartupJobSubstepProgress SubstepProgressDelegate;
 	TFunction<void(const FLyraAssetManagerStartupJob&, TSharedPtr<FStreamableHandle>&)> JobFunc;
+	TFunction<void()> CompletionFunc;
+	TArray<FString> Dependencies;
 	FString JobName;
 	float JobWeight;
 	mutable double LastUpdate = 0;
+	mutable double JobStartTime = 0;
 
 	/** Simple job that is all synchronous */
 	FLyraAssetManagerStartupJob(const FString& InJobName, const TFunction<void(const FLyraAssetManagerStartupJob&, TSharedPtr<FStreamableHandle>&)>& InJobFunc, float InJobWeight)
@@ -22,7 +31,27 @@ struct FLyraAssetManagerStartupJob
 		, JobWeight(InJobWeight)
 	{}
 
-	/** Perform actual loading, will return a handle if it created one */
+	/** Adds a job that must finish before this one starts */
+	FLyraAssetManagerStartupJob& DependsOn(const FString& InJobName)
+	{
+		Dependencies.Add(InJobName);
+		return *this;
+	}
+
+	/** Adds work to run on the game thread once the job's load has completed */
+	FLyraAssetManagerStartupJob& OnComplete(const TFunction<void()>& InCompletionFunc)
+	{
+		CompletionFunc = InCompletionFunc;
+		return *this;
+	}
+
+	/** Perform actual loading, will return a handle if it created one, which may still be loading */
+	TSharedPtr<FStreamableHandle> StartJob() const;
+
+	/** Waits for the handle returned by StartJob (if it is still loading) and runs the completion work */
+	void FinishJob(const TSharedPtr<FStreamableHandle>& Handle) const;
+
+	/** Starts and finishes the job in one go */
 	TSharedPtr<FStreamableHandle> DoJob() const;
 
 	void UpdateSubstepProgress(float NewProgress) const
@@ -36,7 +65,7 @@ struct FLyraAssetManagerStartupJob
 		{
 			// StreamableHandle::GetProgress traverses() a large graph and is quite expensive
 			double Now = FPlatformTime::Seconds();
-			if (LastUpdate - Now > 1.0 / 60)
+			if (Now - LastUpdate > 1.0 / 60)
 			{
 				SubstepProgressDelegate.Execute(StreamableHandle->GetProgress());
 				LastUpdate = Now;
@@ -38,7 +38,11 @@
 *		ULyraReplicationGraphNode_PlayerStateFrequencyLimiter
 *		A custom node for handling player state replication. This replicates a small rolling set of player states (currently 2/frame). This is so player states replicate
 *		to simulated connections at a low, steady frequency, and to take advantage of serialization sharing. Auto proxy player states are replicated at higher frequency (to the
-*		owning connection only) via ULyraReplicationGraphNode_AlwaysRelevant_ForConnection.
+*		owning connection only) via ULyraReplicationGraphNode_AlwaysRelevant_ForConnection. The node keeps a persistent list that only changes as player states are added/removed.
+*		
+*		ULyraReplicationGraphNode_TeamRelevancy
+*		A node for actors that are only relevant to one team (EClassRepNodeMapping::RelevantTeamConnections, e.g., ALyraTeamPrivateInfo). It keeps one list per team
+*		(using ULyraTeamSubsystem) and each connection gathers the list for its viewer's team.
 *		
 *		UReplicationGraphNode_TearOff_ForConnection
 *		Connection specific node for handling tear off actors. This is created and managed in the base implementation of Replication Graph.
@@ -50,6 +54,8 @@
 *		Making something always relevant to connection: You will need to modify ULyraReplicationGraphNode_AlwaysRelevant_ForConnection::GatherActorListsForConnection. You will also want 
 *		to make sure the actor does not get put in one of the other nodes. The safest way to do this is by setting its EClassRepNodeMapping to NotRouted in ULyraReplicationGraph::InitGlobalActorClassSettings.
 *
+*		Making something relevant to its team only: map its class to RelevantTeamConnections in the ClassSettings of ULyraReplicationGraphSettings. The actor's team is resolved through ULyraTeamSubsystem::FindTeamFromObject.
+*
 *	How To Debug
 *	
 *		Its a good idea to just disable rep graph to see if your problem is specific to this system or just general replication/game play problem.
@@ -66,6 +72,15 @@
 *		
 *		Lyra.RepGraph.PrintRouting - will print the EClassRepNodeMapping for each class. That is, how a given actor class is routed (or not) in the Replication Graph.
 *	
+*	How To Benchmark
+*	
+*		Run the bot soak Gauntlet test (ULyraTestControllerBotSoak) with -LyraSoak.SimulatedClients=N -LyraSoak.CompareReplication. It adds N simulated
+*		client connections (bots have no connections, so a server with only bots has nothing to replicate to), runs once with the graph and once with the
+*		net driver, and writes both reports plus a side-by-side comparison of the net driver flush time per connection.
+*		
+*		Pass -LyraRepGraph=1 or -LyraRepGraph=0 (or set Lyra.RepGraph.Force before the net driver is created) to force the graph on or off regardless of
+*		ULyraReplicationGraphSettings.
+*	
 */
 
 #include "LyraReplicationGraph.h"
@@ -74,6 +89,7 @@
 #include "Engine/LevelStreaming.h"
 #include "EngineUtils.h"
 #include "CoreGlobals.h"
+#include "Misc/CommandLine.h"
 
 #if WITH_GAMEPLAY_DEBUGGER
 #include "GameplayDebuggerCategoryReplicator.h"
@@ -86,13 +102,18 @@
 #include "Engine/LevelScriptActor.h"
 #include "Engine/NetConnection.h"
 #include "UObject/UObjectIterator.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 
 #include "LyraReplicationGraphSettings.h"
 #include "Character/LyraCharacter.h"
 #include "Player/LyraPlayerController.h"
+#include "Teams/LyraTeamAgentInterface.h"
+#include "Teams/LyraTeamSubsystem.h"
 
 DEFINE_LOG_CATEGORY( LogLyraRepGraph );
 
+CSV_DEFINE_CATEGORY(LyraReplicationGraph, true);
+
 namespace Lyra::RepGraph
 {
 	float DestructionInfoMaxDist = 30000.f;
@@ -132,6 +153,27 @@ namespace Lyra::RepGraph
 	int32 EnableFastSharedPath = 1;
 	static FAutoConsoleVariableRef CVarLyraRepEnableFastSharedPath(TEXT("Lyra.RepGraph.EnableFastSharedPath"), EnableFastSharedPath, TEXT(""), ECVF_Default);
 
+	// Lets benchmarks switch between the graph and the net driver within a session. Only net drivers created after it's set are affected
+	int32 ForceReplicationGraph = -1;
+	static FAutoConsoleVariableRef CVarLyraRepGraphForce(TEXT("Lyra.RepGraph.Force"), ForceReplicationGraph, TEXT("-1 uses -LyraRepGraph / LyraReplicationGraphSettings, 0 forces the graph off, 1 forces it on"), ECVF_Default);
+
+	// Lets benchmarks run the same build with and without the graph: -LyraRepGraph=1 forces it on, -LyraRepGraph=0 forces it off
+	bool IsReplicationGraphDisabled(const ULyraReplicationGraphSettings* Settings)
+	{
+		if (ForceReplicationGraph >= 0)
+		{
+			return (ForceReplicationGraph == 0);
+		}
+
+		bool bEnableFromCommandLine = false;
+		if (FParse::Bool(FCommandLine::Get(), TEXT("LyraRepGraph="), bEnableFromCommandLine))
+		{
+			return !bEnableFromCommandLine;
+		}
+
+		return Settings && Settings->bDisableReplicationGraph;
+	}
+
 	UReplicationDriver* ConditionalCreateReplicationDriver(UNetDriver* ForNetDriver, UWorld* World)
 	{
 		// Only create for GameNetDriver
@@ -140,9 +182,9 @@ namespace Lyra::RepGraph
 			const ULyraReplicationGraphSettings* LyraRepGraphSettings = GetDefault<ULyraReplicationGraphSettings>();
 
 			// Enable/Disable via developer settings
-			if (LyraRepGraphSettings && LyraRepGraphSettings->bDisableReplicationGraph)
+			if (IsReplicationGraphDisabled(LyraRepGraphSettings))
 			{
-				UE_LOG(LogLyraRepGraph, Display, TEXT("Replication graph is disabled via LyraReplicationGraphSettings."));
+				UE_LOG(LogLyraRepGraph, Display, TEXT("Replication graph is disabled via LyraReplicationGraphSettings or -LyraRepGraph=0."));
 				return nullptr;
 			}
 
@@ -555,8 +597,14 @@ void ULyraReplicationGraph::InitGlobalGraphNodes()
 	// -----------------------------------------------
 	//	Player State specialization. This will return a rolling subset of the player states to replicate
 	// -----------------------------------------------
-	ULyraReplicationGraphNode_PlayerStateFrequencyLimiter* PlayerStateNode = CreateNewNode<ULyraReplicationGraphNode_PlayerStateFrequencyLimiter>();
+	PlayerStateNode = CreateNewNode<ULyraReplicationGraphNode_PlayerStateFrequencyLimiter>();
 	AddGlobalGraphNode(PlayerStateNode);
+
+	// -----------------------------------------------
+	//	Team only actors. Each connection only gathers the actors that belong to its own team
+	// -----------------------------------------------
+	TeamRelevancyNode = CreateNewNode<ULyraReplicationGraphNode_TeamRelevancy>();
+	AddGlobalGraphNode(TeamRelevancyNode);
 }
 
 void ULyraReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
@@ -581,11 +629,18 @@ EClassRepNodeMapping ULyraReplicationGraph::GetMappingPolicy(UClass* Class)
 
 void ULyraReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
 {
+	CSV_SCOPED_TIMING_STAT(LyraReplicationGraph, RouteAddActor);
+
 	EClassRepNodeMapping Policy = GetMappingPolicy(ActorInfo.Class);
 	switch(Policy)
 	{
 		case EClassRepNodeMapping::NotRouted:
 		{
+			// Player states are not routed through the policies but are tracked by the frequency limiter
+			if (ActorInfo.Class->IsChildOf(APlayerState::StaticClass()))
+			{
+				PlayerStateNode->NotifyAddNetworkActor(ActorInfo);
+			}
 			break;
 		}
 		
@@ -603,6 +658,12 @@ void ULyraReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActo
 			break;
 		}
 
+		case EClassRepNodeMapping::RelevantTeamConnections:
+		{
+			TeamRelevancyNode->NotifyAddNetworkActor(ActorInfo);
+			break;
+		}
+
 		case EClassRepNodeMapping::Spatialize_Static:
 		{
 			GridNode->AddActor_Static(ActorInfo, GlobalInfo);
@@ -630,6 +691,10 @@ void ULyraReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedA
 	{
 		case EClassRepNodeMapping::NotRouted:
 		{
+			if (ActorInfo.Class->IsChildOf(APlayerState::StaticClass()))
+			{
+				PlayerStateNode->NotifyRemoveNetworkActor(ActorInfo);
+			}
 			break;
 		}
 		
@@ -653,6 +718,15 @@ void ULyraReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedA
 			break;
 		}
 
+		case EClassRepNodeMapping::RelevantTeamConnections:
+		{
+			TeamRelevancyNode->NotifyRemoveNetworkActor(ActorInfo);
+
+			SetActorDestructionInfoToIgnoreDistanceCulling(ActorInfo.GetActor());
+
+			break;
+		}
+
 		case EClassRepNodeMapping::Spatialize_Static:
 		{
 			GridNode->RemoveActor_Static(ActorInfo);
@@ -734,6 +808,8 @@ void ULyraReplicationGraphNode_AlwaysRelevant_ForConnection::ResetGameWorldState
 
 void ULyraReplicationGraphNode_AlwaysRelevant_ForConnection::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
 {
+	CSV_SCOPED_TIMING_STAT(LyraReplicationGraph, AlwaysRelevantForConnection);
+
 	ULyraReplicationGraph* LyraGraph = CastChecked<ULyraReplicationGraph>(GetOuter());
 
 	ReplicationActorList.Reset();
@@ -882,25 +958,82 @@ ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::ULyraReplicationGraphNode
 	bRequiresPrepareForReplicationCall = true;
 }
 
+void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	if (!AllPlayerStates.Contains(ActorInfo.Actor))
+	{
+		AllPlayerStates.Add(ActorInfo.Actor);
+		bReplicationActorListsDirty = true;
+	}
+}
+
+bool ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+	// Keep the order so the remaining player states stay in their buckets
+	const bool bRemoved = AllPlayerStates.RemoveSlow(ActorInfo.Actor);
+	if (bRemoved)
+	{
+		bReplicationActorListsDirty = true;
+	}
+	else
+	{
+		UE_CLOG(bWarnIfNotFound, LogLyraRepGraph, Warning, TEXT("ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyRemoveNetworkActor - %s was not found"), *GetActorRepListTypeDebugString(ActorInfo.Actor));
+	}
+
+	return bRemoved;
+}
+
+void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyResetAllNetworkActors()
+{
+	AllPlayerStates.Reset();
+	bReplicationActorListsDirty = true;
+}
+
 void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::PrepareForReplication()
 {
+	CSV_SCOPED_TIMING_STAT(LyraReplicationGraph, PlayerStatePrepare);
+
+	// A player state can stop (or start) being valid for gathering without being removed from the graph, e.g. while it is being destroyed
+	if (!bReplicationActorListsDirty)
+	{
+		for (int32 Idx = 0; Idx < AllPlayerStates.Num(); ++Idx)
+		{
+			if (IsActorValidForReplicationGather(AllPlayerStates[Idx]) != GatherablePlayerStates[Idx])
+			{
+				bReplicationActorListsDirty = true;
+				break;
+			}
+		}
+	}
+
+	if (bReplicationActorListsDirty)
+	{
+		RebuildReplicationActorLists();
+	}
+}
+
+void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::RebuildReplicationActorLists()
+{
+	bReplicationActorListsDirty = false;
+
 	ReplicationActorLists.Reset();
 	ForceNetUpdateReplicationActorList.Reset();
 
 	ReplicationActorLists.AddDefaulted();
 	FActorRepListRefView* CurrentList = &ReplicationActorLists[0];
 
-	// We rebuild our lists of player states each frame. This is not as efficient as it could be but its the simplest way
-	// to handle players disconnecting and keeping the lists compact. If the lists were persistent we would need to defrag them as players left.
+	GatherablePlayerStates.Init(false, AllPlayerStates.Num());
 
-	for (TActorIterator<APlayerState> It(GetWorld()); It; ++It)
+	for (int32 Idx = 0; Idx < AllPlayerStates.Num(); ++Idx)
 	{
-		APlayerState* PS = *It;
+		FActorRepListType PS = AllPlayerStates[Idx];
 		if (IsActorValidForReplicationGather(PS) == false)
 		{
 			continue;
 		}
 
+		GatherablePlayerStates[Idx] = true;
+
 		if (CurrentList->Num() >= TargetActorsPerFrame)
 		{
 			ReplicationActorLists.AddDefaulted();
@@ -908,11 +1041,13 @@ void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::PrepareForReplicatio
 		}
 		
 		CurrentList->Add(PS);
-	}	
+	}
 }
 
 void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
 {
+	CSV_SCOPED_TIMING_STAT(LyraReplicationGraph, PlayerStateGather);
+
 	const int32 ListIdx = Params.ReplicationFrameNum % ReplicationActorLists.Num();
 	Params.OutGatheredReplicationLists.AddReplicationActorList(ReplicationActorLists[ListIdx]);
 
@@ -938,6 +1073,210 @@ void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::LogNode(FReplication
 
 // ------------------------------------------------------------------------------
 
+ULyraReplicationGraphNode_TeamRelevancy::ULyraReplicationGraphNode_TeamRelevancy()
+{
+	bRequiresPrepareForReplicationCall = true;
+}
+
+void ULyraReplicationGraphNode_TeamRelevancy::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	AActor* Actor = ActorInfo.GetActor();
+
+	if (ILyraTeamAgentInterface* TeamAgent = Cast<ILyraTeamAgentInterface>(Actor))
+	{
+		if (FOnLyraTeamIndexChangedDelegate* TeamChangedDelegate = TeamAgent->GetOnTeamIndexChangedDelegate())
+		{
+			TeamChangedDelegate->AddDynamic(this, &ThisClass::OnActorTeamChanged);
+		}
+	}
+
+	const ULyraTeamSubsystem* TeamSubsystem = GetWorld() ? GetWorld()->GetSubsystem<ULyraTeamSubsystem>() : nullptr;
+	const int32 TeamId = TeamSubsystem ? TeamSubsystem->FindTeamFromObject(Actor) : INDEX_NONE;
+
+	if (TeamId == INDEX_NONE)
+	{
+		PendingActors.ConditionalAdd(Actor);
+	}
+	else
+	{
+		AddActorToTeam(Actor, TeamId);
+	}
+}
+
+bool ULyraReplicationGraphNode_TeamRelevancy::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+	AActor* Actor = ActorInfo.GetActor();
+
+	UnbindTeamChangedDelegate(Actor);
+
+	bool bRemoved = PendingActors.RemoveFast(Actor);
+
+	int32 TeamId = INDEX_NONE;
+	if (ActorToTeam.RemoveAndCopyValue(Actor, /*out*/ TeamId))
+	{
+		RemoveActorFromTeam(Actor, TeamId);
+		bRemoved = true;
+	}
+
+	UE_CLOG(!bRemoved && bWarnIfNotFound, LogLyraRepGraph, Warning, TEXT("ULyraReplicationGraphNode_TeamRelevancy::NotifyRemoveNetworkActor - %s was not found"), *GetActorRepListTypeDebugString(Actor));
+
+	return bRemoved;
+}
+
+void ULyraReplicationGraphNode_TeamRelevancy::NotifyResetAllNetworkActors()
+{
+	for (const TPair<FActorRepListType, int32>& Pair : ActorToTeam)
+	{
+		UnbindTeamChangedDelegate(Pair.Key);
+	}
+
+	for (FActorRepListType Actor : PendingActors)
+	{
+		UnbindTeamChangedDelegate(Actor);
+	}
+
+	TeamActorLists.Reset();
+	ActorToTeam.Reset();
+	PendingActors.Reset();
+}
+
+void ULyraReplicationGraphNode_TeamRelevancy::UnbindTeamChangedDelegate(AActor* Actor)
+{
+	if (ILyraTeamAgentInterface* TeamAgent = Cast<ILyraTeamAgentInterface>(Actor))
+	{
+		if (FOnLyraTeamIndexChangedDelegate* TeamChangedDelegate = TeamAgent->GetOnTeamIndexChangedDelegate())
+		{
+			TeamChangedDelegate->RemoveDynamic(this, &ThisClass::OnActorTeamChanged);
+		}
+	}
+}
+
+void ULyraReplicationGraphNode_TeamRelevancy::AddActorToTeam(AActor* Actor, int32 TeamId)
+{
+	ActorToTeam.Add(Actor, TeamId);
+	TeamActorLists.FindOrAdd(TeamId).ConditionalAdd(Actor);
+}
+
+void ULyraReplicationGraphNode_TeamRelevancy::RemoveActorFromTeam(AActor* Actor, int32 TeamId)
+{
+	if (FActorRepListRefView* TeamList = TeamActorLists.Find(TeamId))
+	{
+		TeamList->RemoveFast(Actor);
+		if (TeamList->Num() == 0)
+		{
+			TeamActorLists.Remove(TeamId);
+		}
+	}
+}
+
+void ULyraReplicationGraphNode_TeamRelevancy::OnActorTeamChanged(UObject* ObjectChangingTeam, int32 OldTeamID, int32 NewTeamID)
+{
+	AActor* Actor = Cast<AActor>(ObjectChangingTeam);
+	if (Actor == nullptr)
+	{
+		return;
+	}
+
+	int32* CurrentTeamId = ActorToTeam.Find(Actor);
+	if (CurrentTeamId == nullptr)
+	{
+		// Still pending, PrepareForReplication will pick up the new team
+		return;
+	}
+
+	if (*CurrentTeamId != NewTeamID)
+	{
+		RemoveActorFromTeam(Actor, *CurrentTeamId);
+		ActorToTeam.Remove(Actor);
+
+		if (NewTeamID == INDEX_NONE)
+		{
+			PendingActors.ConditionalAdd(Actor);
+		}
+		else
+		{
+			AddActorToTeam(Actor, NewTeamID);
+		}
+	}
+}
+
+void ULyraReplicationGraphNode_TeamRelevancy::PrepareForReplication()
+{
+	if (PendingActors.Num() == 0)
+	{
+		return;
+	}
+
+	CSV_SCOPED_TIMING_STAT(LyraReplicationGraph, TeamRelevancyPrepare);
+
+	const ULyraTeamSubsystem* TeamSubsystem = GetWorld() ? GetWorld()->GetSubsystem<ULyraTeamSubsystem>() : nullptr;
+	if (TeamSubsystem == nullptr)
+	{
+		return;
+	}
+
+	for (int32 Idx = PendingActors.Num() - 1; Idx >= 0; --Idx)
+	{
+		AActor* Actor = PendingActors[Idx];
+		const int32 TeamId = TeamSubsystem->FindTeamFromObject(Actor);
+		if (TeamId != INDEX_NONE)
+		{
+			PendingActors.RemoveAtSwap(Idx);
+			AddActorToTeam(Actor, TeamId);
+		}
+	}
+}
+
+void ULyraReplicationGraphNode_TeamRelevancy::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	CSV_SCOPED_TIMING_STAT(LyraReplicationGraph, TeamRelevancyGather);
+
+	if (TeamActorLists.Num() == 0)
+	{
+		return;
+	}
+
+	const ULyraTeamSubsystem* TeamSubsystem = GetWorld() ? GetWorld()->GetSubsystem<ULyraTeamSubsystem>() : nullptr;
+	if (TeamSubsystem == nullptr)
+	{
+		return;
+	}
+
+	// Split screen connections can have viewers on different teams, only add each team's list once
+	TArray<int32, TInlineAllocator<4>> GatheredTeams;
+	for (const FNetViewer& CurViewer : Params.Viewers)
+	{
+		const int32 TeamId = TeamSubsystem->FindTeamFromObject(CurViewer.InViewer);
+		if ((TeamId == INDEX_NONE) || GatheredTeams.Contains(TeamId))
+		{
+			continue;
+		}
+		GatheredTeams.Add(TeamId);
+
+		if (const FActorRepListRefView* TeamList = TeamActorLists.Find(TeamId))
+		{
+			Params.OutGatheredReplicationLists.AddReplicationActorList(*TeamList);
+		}
+	}
+}
+
+void ULyraReplicationGraphNode_TeamRelevancy::LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const
+{
+	DebugInfo.Log(NodeName);
+	DebugInfo.PushIndent();
+
+	for (const TPair<int32, FActorRepListRefView>& Pair : TeamActorLists)
+	{
+		LogActorRepList(DebugInfo, FString::Printf(TEXT("Team[%d]"), Pair.Key), Pair.Value);
+	}
+
+	LogActorRepList(DebugInfo, TEXT("Pending"), PendingActors);
+
+	DebugInfo.PopIndent();
+}
+
+// ------------------------------------------------------------------------------
+
 void ULyraReplicationGraph::PrintRepNodePolicies()
 {
 	UEnum* Enum = StaticEnum<EClassRepNodeMapping>();
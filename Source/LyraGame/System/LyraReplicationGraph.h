@@ -7,6 +7,8 @@
 #include "LyraReplicationGraph.generated.h"
 
 class AGameplayDebuggerCategoryReplicator;
+class ULyraReplicationGraphNode_PlayerStateFrequencyLimiter;
+class ULyraReplicationGraphNode_TeamRelevancy;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogLyraRepGraph, Display, All);
 
@@ -36,6 +38,12 @@ public:
 	UPROPERTY()
 	TObjectPtr<UReplicationGraphNode_ActorList> AlwaysRelevantNode;
 
+	UPROPERTY()
+	TObjectPtr<ULyraReplicationGraphNode_PlayerStateFrequencyLimiter> PlayerStateNode;
+
+	UPROPERTY()
+	TObjectPtr<ULyraReplicationGraphNode_TeamRelevancy> TeamRelevancyNode;
+
 	TMap<FName, FActorRepListRefView> AlwaysRelevantStreamingLevelActors;
 
 #if WITH_GAMEPLAY_DEBUGGER
@@ -95,16 +103,20 @@ private:
 /** 
 	This is a specialized node for handling PlayerState replication in a frequency limited fashion. It tracks all player states but only returns a subset of them to the replication driver each frame. 
 	This is an optimization for large player connection counts, and not a requirement.
+
+	Player states are routed here by ULyraReplicationGraph as they are added and removed, and the buckets are only rebuilt when that set changes.
 */
 UCLASS()
 class ULyraReplicationGraphNode_PlayerStateFrequencyLimiter : public UReplicationGraphNode
 {
 	GENERATED_BODY()
 
+public:
 	ULyraReplicationGraphNode_PlayerStateFrequencyLimiter();
 
-	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& Actor) override { }
-	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound=true) override { return false; }
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& Actor) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound=true) override;
+	virtual void NotifyResetAllNetworkActors() override;
 
 	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
 
@@ -115,8 +127,62 @@ class ULyraReplicationGraphNode_PlayerStateFrequencyLimiter : public UReplicatio
 	/** How many actors we want to return to the replication driver per frame. Will not suppress ForceNetUpdate. */
 	int32 TargetActorsPerFrame = 2;
 
+private:
+	void RebuildReplicationActorLists();
+
 private:
 	
 	TArray<FActorRepListRefView> ReplicationActorLists;
 	FActorRepListRefView ForceNetUpdateReplicationActorList;
+
+	/** Every player state routed to this node, in the order they were added so buckets stay stable as players come and go */
+	FActorRepListRefView AllPlayerStates;
+
+	/** Whether each entry of AllPlayerStates was valid for gathering (and so put in a bucket) when the buckets were last built */
+	TBitArray<> GatherablePlayerStates;
+
+	/** Set when AllPlayerStates changed since the buckets were last built */
+	bool bReplicationActorListsDirty = true;
+};
+
+/**
+	Handles actors that should only replicate to connections on the same team (e.g., ALyraTeamPrivateInfo).
+	Actors are kept in one list per team, and each connection gathers the list for the team its viewer belongs to (as reported by ULyraTeamSubsystem).
+	Actors whose team isn't known yet when they are added (team info actors get their id right after spawning) are resolved during PrepareForReplication.
+*/
+UCLASS()
+class ULyraReplicationGraphNode_TeamRelevancy : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	ULyraReplicationGraphNode_TeamRelevancy();
+
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& Actor) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound=true) override;
+	virtual void NotifyResetAllNetworkActors() override;
+
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+	virtual void PrepareForReplication() override;
+
+	virtual void LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const override;
+
+private:
+	void AddActorToTeam(AActor* Actor, int32 TeamId);
+	void RemoveActorFromTeam(AActor* Actor, int32 TeamId);
+	void UnbindTeamChangedDelegate(AActor* Actor);
+
+	UFUNCTION()
+	void OnActorTeamChanged(UObject* ObjectChangingTeam, int32 OldTeamID, int32 NewTeamID);
+
+private:
+	/** Actors relevant to each team, keyed by team id */
+	TMap<int32, FActorRepListRefView> TeamActorLists;
+
+	/** The team each tracked actor was last filed under */
+	TMap<FActorRepListType, int32> ActorToTeam;
+
+	/** Actors that were added before they had a team */
+	FActorRepListRefView PendingActors;
 };
\ No newline at end of file
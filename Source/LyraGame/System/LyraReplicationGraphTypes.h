@@ -11,6 +11,7 @@ enum class EClassRepNodeMapping : uint32
 {
 	NotRouted,						// Doesn't map to any node. Used for special case actors that handled by special case nodes (ULyraReplicationGraphNode_PlayerStateFrequencyLimiter)
 	RelevantAllConnections,			// Routes to an AlwaysRelevantNode or AlwaysRelevantStreamingLevelNode node
+	RelevantTeamConnections,		// Routes to TeamRelevancyNode: only relevant to connections on the same team as the actor (ULyraReplicationGraphNode_TeamRelevancy)
 
 	// ONLY SPATIALIZED Enums below here! See ULyraReplicationGraph::IsSpatialized
 
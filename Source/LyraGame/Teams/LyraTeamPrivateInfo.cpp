@@ -8,6 +8,6 @@
 ALyraTeamPrivateInfo::ALyraTeamPrivateInfo(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
-	//@TODO: Actually make private (using replication graph)
+	// Only replicated to members of this team when the replication graph is enabled (see EClassRepNodeMapping::RelevantTeamConnections)
 }
 
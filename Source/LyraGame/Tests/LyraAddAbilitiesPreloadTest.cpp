@@ -0,0 +1,230 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GameFeatures/GameFeatureAction_AddAbilities.h"
+
+#include "AbilitySystem/LyraAbilitySystemComponent.h"
+#include "Components/GameFrameworkComponentManager.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LyraAddAbilitiesPreloadTest
+{
+	// Blueprint abilities nothing in the test references directly, the first one that isn't loaded yet is granted
+	static const TCHAR* CandidateAbilityPaths[] =
+	{
+		TEXT("/Game/Game/Emote/GA_Emote.GA_Emote_C"),
+		TEXT("/Game/Game/Melee/GA_Melee.GA_Melee_C"),
+		TEXT("/Game/Game/Dash/GA_Hero_Dash.GA_Hero_Dash_C"),
+		TEXT("/Game/Game/Flashlight/GA_Flashlight.GA_Flashlight_C"),
+	};
+
+	// Enough actors that granting one by one with a synchronous load each would show up as a hitch
+	static const int32 NumActorsPresentAtActivation = 64;
+
+	/** A standalone game instance (so the component manager exists) with actors that have a Lyra ability system */
+	struct FTestWorld
+	{
+		FTestWorld()
+		{
+			GameInstance = NewObject<UGameInstance>(GEngine);
+			GameInstance->AddToRoot();
+			GameInstance->InitializeStandalone();
+			World = GameInstance->GetWorld();
+			ComponentManager = UGameInstance::GetSubsystem<UGameFrameworkComponentManager>(GameInstance);
+		}
+
+		~FTestWorld()
+		{
+			GameInstance->Shutdown();
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+			GameInstance->RemoveFromRoot();
+		}
+
+		// Registering the actor as a receiver fires the action's extension handler, like a pawn or player state would
+		AActor* AddActor(bool bAuthority)
+		{
+			AActor* Actor = World->SpawnActor<AActor>();
+
+			// Marked as not native, so the action finds it instead of asking the component manager to add another one
+			ULyraAbilitySystemComponent* AbilitySystem = NewObject<ULyraAbilitySystemComponent>(Actor);
+			AbilitySystem->CreationMethod = EComponentCreationMethod::Instance;
+			AbilitySystem->RegisterComponent();
+			AbilitySystem->InitAbilityActorInfo(Actor, Actor);
+
+			if (!bAuthority)
+			{
+				Actor->SetRole(ROLE_SimulatedProxy);
+			}
+
+			ComponentManager->AddReceiver(Actor);
+			return Actor;
+		}
+
+		UGameInstance* GameInstance = nullptr;
+		UWorld* World = nullptr;
+		UGameFrameworkComponentManager* ComponentManager = nullptr;
+	};
+
+	/** Counts synchronous loads of one package while it exists */
+	struct FSyncLoadCounter
+	{
+		explicit FSyncLoadCounter(const FString& InPackageName)
+			: PackageName(InPackageName)
+		{
+			Handle = FCoreUObjectDelegates::OnSyncLoadPackage.AddLambda([this](const FString& LoadedPackageName)
+			{
+				NumLoads += (LoadedPackageName == PackageName) ? 1 : 0;
+			});
+		}
+
+		~FSyncLoadCounter()
+		{
+			FCoreUObjectDelegates::OnSyncLoadPackage.Remove(Handle);
+		}
+
+		FString PackageName;
+		FDelegateHandle Handle;
+		int32 NumLoads = 0;
+	};
+
+	static int32 GetNumGrantedAbilities(AActor* Actor, const FSoftClassPath& AbilityClassPath)
+	{
+		int32 NumAbilities = 0;
+		for (const FGameplayAbilitySpec& Spec : Actor->FindComponentByClass<ULyraAbilitySystemComponent>()->GetActivatableAbilities())
+		{
+			NumAbilities += (Spec.Ability && (FSoftClassPath(Spec.Ability->GetClass()) == AbilityClassPath)) ? 1 : 0;
+		}
+		return NumAbilities;
+	}
+
+	static int32 GetNumActorsWithAbility(const TArray<AActor*>& Actors, const FSoftClassPath& AbilityClassPath)
+	{
+		int32 NumGranted = 0;
+		for (AActor* Actor : Actors)
+		{
+			NumGranted += (GetNumGrantedAbilities(Actor, AbilityClassPath) > 0) ? 1 : 0;
+		}
+		return NumGranted;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameFeatureActionAddAbilitiesPreloadTest, "Lyra.GameFeatures.AddAbilities.Preload", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGameFeatureActionAddAbilitiesPreloadTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraAddAbilitiesPreloadTest;
+
+	FSoftClassPath AbilityClassPath;
+	for (const TCHAR* CandidatePath : CandidateAbilityPaths)
+	{
+		const FSoftClassPath Candidate(CandidatePath);
+		if ((Candidate.ResolveClass() == nullptr) && FPackageName::DoesPackageExist(Candidate.GetLongPackageName()))
+		{
+			AbilityClassPath = Candidate;
+			break;
+		}
+	}
+
+	if (AbilityClassPath.IsNull())
+	{
+		AddWarning(TEXT("Every candidate Blueprint ability is already loaded (or missing), so the preload can't be exercised"));
+		return true;
+	}
+
+	FTestWorld TestWorld;
+	if (!TestNotNull(TEXT("Component manager"), TestWorld.ComponentManager))
+	{
+		return false;
+	}
+
+	UGameFeatureAction_AddAbilities* Action = NewObject<UGameFeatureAction_AddAbilities>(GetTransientPackage());
+	Action->AddToRoot();
+
+	FGameFeatureAbilitiesEntry& Entry = Action->AbilitiesList.AddDefaulted_GetRef();
+	Entry.ActorClass = AActor::StaticClass();
+	Entry.GrantedAbilities.AddDefaulted_GetRef().AbilityType = TSoftClassPtr<UGameplayAbility>(AbilityClassPath);
+
+	// Actors that already exist when the feature activates
+	TArray<AActor*> AuthorityActors;
+	for (int32 Index = 0; Index < NumActorsPresentAtActivation; ++Index)
+	{
+		AuthorityActors.Add(TestWorld.AddActor(/*bAuthority=*/ true));
+	}
+	AActor* RemoteActor = TestWorld.AddActor(/*bAuthority=*/ false);
+	AActor* RemovedActor = TestWorld.AddActor(/*bAuthority=*/ true);
+
+	const FSyncLoadCounter SyncLoads(AbilityClassPath.GetLongPackageName());
+	const int32 FallbackLoadsBefore = UGameFeatureAction_AddAbilities::GetNumSynchronousGrantLoads();
+
+	// What the game features subsystem does when the plugin activates, limited to the test world
+	FWorldContext& WorldContext = GEngine->GetWorldContextFromWorldChecked(TestWorld.World);
+	FGameFeatureActivatingContext ActivatingContext;
+	ActivatingContext.SetRequiredWorldContextHandle(WorldContext.ContextHandle);
+	Action->OnGameFeatureActivating(ActivatingContext);
+
+	UGameFeatureAction_AddAbilities::FPerContextData* ActiveData = Action->ContextData.Find(ActivatingContext);
+	if (!TestNotNull(TEXT("Activation added the action to the test world"), ActiveData) ||
+		!TestTrue(TEXT("The server starts the preload"), ActiveData->PreloadHandle.IsValid()))
+	{
+		Action->RemoveFromRoot();
+		return false;
+	}
+
+	TestFalse(TEXT("The ability isn't loaded yet"), ActiveData->PreloadHandle->HasLoadCompleted());
+	TestFalse(TEXT("Grants wait for the preload"), ActiveData->bAssetsLoaded);
+	TestEqual(TEXT("Every authority actor is queued"), ActiveData->PendingGrants.Num(), NumActorsPresentAtActivation + 1);
+	TestEqual(TEXT("Nothing is granted before the preload completes"), GetNumActorsWithAbility(AuthorityActors, AbilityClassPath), 0);
+
+	TestWorld.ComponentManager->RemoveReceiver(RemovedActor);
+	TestEqual(TEXT("Removed actors leave the queue"), ActiveData->PendingGrants.Num(), NumActorsPresentAtActivation);
+
+	AActor* LateActor = TestWorld.AddActor(/*bAuthority=*/ true);
+	TestEqual(TEXT("Actors arriving during the preload are queued"), ActiveData->PendingGrants.Num(), NumActorsPresentAtActivation + 1);
+	TestEqual(TEXT("Actors arriving during the preload wait too"), GetNumGrantedAbilities(LateActor, AbilityClassPath), 0);
+
+	FlushAsyncLoading();
+	TestTrue(TEXT("Preload completed"), ActiveData->PreloadHandle->HasLoadCompleted());
+	TestNotNull(TEXT("The ability class was loaded by the preload"), AbilityClassPath.ResolveClass());
+
+	// The streamable delegate may be deferred to a later frame (s.StreamableDelegateDelayFrames), run it like it would
+	if (!ActiveData->bAssetsLoaded)
+	{
+		Action->HandlePreloadComplete(ActivatingContext);
+	}
+
+	TestTrue(TEXT("Assets are loaded"), ActiveData->bAssetsLoaded);
+	TestTrue(TEXT("Queue is empty"), ActiveData->PendingGrants.IsEmpty());
+	TestEqual(TEXT("Every actor present at activation is granted"), GetNumActorsWithAbility(AuthorityActors, AbilityClassPath), NumActorsPresentAtActivation);
+	TestEqual(TEXT("Early actors are granted once"), GetNumGrantedAbilities(AuthorityActors[0], AbilityClassPath), 1);
+	TestEqual(TEXT("Non-authority actor is never granted"), GetNumGrantedAbilities(RemoteActor, AbilityClassPath), 0);
+	TestEqual(TEXT("Removed actor is not granted"), GetNumGrantedAbilities(RemovedActor, AbilityClassPath), 0);
+	TestEqual(TEXT("Late actor is granted once"), GetNumGrantedAbilities(LateActor, AbilityClassPath), 1);
+
+	// A late completion callback must not grant again
+	Action->HandlePreloadComplete(ActivatingContext);
+	TestEqual(TEXT("Early actors are still granted once"), GetNumGrantedAbilities(AuthorityActors[0], AbilityClassPath), 1);
+
+	// Actors arriving once everything is loaded are granted right away
+	AActor* AfterLoadActor = TestWorld.AddActor(/*bAuthority=*/ true);
+	TestEqual(TEXT("Actor arriving after the preload is granted once"), GetNumGrantedAbilities(AfterLoadActor, AbilityClassPath), 1);
+
+	TestEqual(TEXT("The ability package was never loaded synchronously"), SyncLoads.NumLoads, 0);
+	TestEqual(TEXT("No synchronous fallback loads while granting"), UGameFeatureAction_AddAbilities::GetNumSynchronousGrantLoads(), FallbackLoadsBefore);
+
+	Action->Reset(*ActiveData);
+	Action->ContextData.Remove(ActivatingContext);
+	Action->RemoveFromRoot();
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
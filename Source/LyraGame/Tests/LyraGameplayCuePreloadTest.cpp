@@ -0,0 +1,95 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AbilitySystem/LyraGameplayCueManager.h"
+#include "GameplayCueSet.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraGameplayCuePreloadBudgetTest, "Lyra.GameplayCues.PreloadBudget", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLyraGameplayCuePreloadBudgetTest::RunTest(const FString& Parameters)
+{
+	ULyraGameplayCueManager* GCM = ULyraGameplayCueManager::Get();
+	if (!TestNotNull(TEXT("Lyra gameplay cue manager"), GCM) || !TestNotNull(TEXT("Runtime cue set"), GCM->RuntimeGameplayCueObjectLibrary.CueSet.Get()))
+	{
+		return false;
+	}
+
+	IConsoleVariable* MaxPreloadsPerFrameCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Lyra.GameplayCues.MaxPreloadsPerFrame"));
+	if (!TestNotNull(TEXT("Lyra.GameplayCues.MaxPreloadsPerFrame"), MaxPreloadsPerFrameCVar))
+	{
+		return false;
+	}
+
+	const int32 Budget = 4;
+	const int32 MaxCues = 64;
+
+	// Real cues from the project, whether or not they are loaded already; pacing is the same either way
+	TArray<FSoftObjectPath> TestPaths;
+	for (const FGameplayCueNotifyData& CueData : GCM->RuntimeGameplayCueObjectLibrary.CueSet->GameplayCueData)
+	{
+		if ((TestPaths.Num() < MaxCues) && CueData.GameplayCueNotifyObj.IsValid())
+		{
+			TestPaths.AddUnique(CueData.GameplayCueNotifyObj);
+		}
+	}
+
+	if (TestPaths.Num() <= Budget)
+	{
+		AddWarning(FString::Printf(TEXT("Only %d gameplay cues in the project, need more than %d to check the pacing"), TestPaths.Num(), Budget));
+		return true;
+	}
+
+	const int32 OldBudget = MaxPreloadsPerFrameCVar->GetInt();
+	MaxPreloadsPerFrameCVar->Set(Budget, ECVF_SetByConsole);
+
+	// The owner releases the preloaded cues again once it is garbage collected
+	UObject* Owner = NewObject<UPackage>(nullptr, MakeUniqueObjectName(nullptr, UPackage::StaticClass(), TEXT("/Temp/LyraGameplayCuePreloadTest")), RF_Transient);
+
+	for (const FSoftObjectPath& Path : TestPaths)
+	{
+		GCM->QueueCuePreload(Path, Owner);
+	}
+
+	// Drive the scheduler by hand instead of waiting on the core ticker
+	FTSTicker::GetCoreTicker().RemoveTicker(GCM->CuePreloadTickHandle);
+	GCM->CuePreloadTickHandle.Reset();
+
+	const int32 MaxTicks = FMath::DivideAndRoundUp(GCM->QueuedCuePreloads.Num(), Budget);
+	int32 NumTicks = 0;
+	while (!GCM->QueuedCuePreloads.IsEmpty() && (NumTicks < MaxTicks))
+	{
+		const int32 NumQueuedBefore = GCM->QueuedCuePreloads.Num();
+		GCM->TickCuePreloads(0.0f);
+		++NumTicks;
+
+		const int32 NumStarted = NumQueuedBefore - GCM->QueuedCuePreloads.Num();
+		TestEqual(FString::Printf(TEXT("Preloads started on tick %d"), NumTicks), NumStarted, FMath::Min(Budget, NumQueuedBefore));
+	}
+
+	TestTrue(FString::Printf(TEXT("Every queued preload started within %d ticks"), MaxTicks), GCM->QueuedCuePreloads.IsEmpty());
+
+	if (!GCM->QueuedCuePreloads.IsEmpty())
+	{
+		// Hand the rest back to the ticker so nothing is left stuck
+		GCM->CuePreloadTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(GCM, &ULyraGameplayCueManager::TickCuePreloads), 0.0f);
+	}
+
+	FlushAsyncLoading();
+
+	for (const FSoftObjectPath& Path : TestPaths)
+	{
+		TestNotNull(FString::Printf(TEXT("%s is loaded"), *Path.ToString()), Path.ResolveObject());
+	}
+
+	MaxPreloadsPerFrameCVar->Set(OldBudget, ECVF_SetByConsole);
+	Owner->MarkAsGarbage();
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
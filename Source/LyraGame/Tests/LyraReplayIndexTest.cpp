@@ -0,0 +1,129 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Replays/LyraReplaySubsystem.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LyraReplayIndexTest
+{
+	static const FDateTime BaseTime(2024, 1, 1);
+
+	static FLyraReplayIndexEntry& AddEntry(TMap<FString, FLyraReplayIndexEntry>& Index, const TCHAR* StreamName, int32 AgeInHours, bool bShouldKeep = false)
+	{
+		FLyraReplayIndexEntry& Entry = Index.Add(StreamName);
+		Entry.StreamName = StreamName;
+		Entry.FriendlyName = StreamName;
+		Entry.Timestamp = BaseTime - FTimespan::FromHours(AgeInHours);
+		Entry.bShouldKeep = bShouldKeep;
+		return Entry;
+	}
+
+	static FNetworkReplayStreamInfo MakeStream(const TCHAR* StreamName, int32 AgeInHours, bool bShouldKeep = false, bool bIsLive = false)
+	{
+		FNetworkReplayStreamInfo StreamInfo;
+		StreamInfo.Name = StreamName;
+		StreamInfo.FriendlyName = StreamName;
+		StreamInfo.Timestamp = BaseTime - FTimespan::FromHours(AgeInHours);
+		StreamInfo.LengthInMS = 60000;
+		StreamInfo.bShouldKeep = bShouldKeep;
+		StreamInfo.bIsLive = bIsLive;
+		return StreamInfo;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraReplayIndexSelectTest, "Lyra.Replays.Index.SelectReplaysToDelete", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLyraReplayIndexSelectTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraReplayIndexTest;
+
+	TMap<FString, FLyraReplayIndexEntry> Index;
+	AddEntry(Index, TEXT("Newest"), 1);
+	AddEntry(Index, TEXT("Kept"), 2, /*bShouldKeep=*/ true);
+	AddEntry(Index, TEXT("Middle"), 3);
+	AddEntry(Index, TEXT("Old"), 4);
+	AddEntry(Index, TEXT("OldestKept"), 6, /*bShouldKeep=*/ true);
+	AddEntry(Index, TEXT("Oldest"), 5);
+
+	// Keep streams are never picked and don't use up the number to keep; the oldest is last so it's deleted first
+	TArray<FString> ToDelete;
+	ULyraReplaySubsystem::SelectIndexedReplaysToDelete(Index, 2, ToDelete);
+	TestEqual(TEXT("Keep 2"), ToDelete, TArray<FString>({ TEXT("Old"), TEXT("Oldest") }));
+
+	ULyraReplaySubsystem::SelectIndexedReplaysToDelete(Index, 0, ToDelete);
+	TestEqual(TEXT("Keep 0"), ToDelete, TArray<FString>({ TEXT("Newest"), TEXT("Middle"), TEXT("Old"), TEXT("Oldest") }));
+
+	ULyraReplaySubsystem::SelectIndexedReplaysToDelete(Index, 4, ToDelete);
+	TestTrue(TEXT("Keep as many as there are"), ToDelete.IsEmpty());
+
+	// A replay the index recorded itself (TickReplayIndex) that was later marked as a keep stream
+	Index[TEXT("Newest")].bShouldKeep = true;
+	ULyraReplaySubsystem::SelectIndexedReplaysToDelete(Index, 1, ToDelete);
+	TestEqual(TEXT("Keep 1 after marking the newest as kept"), ToDelete, TArray<FString>({ TEXT("Old"), TEXT("Oldest") }));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraReplayIndexMergeTest, "Lyra.Replays.Index.MergeEnumeratedStreams", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLyraReplayIndexMergeTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraReplayIndexTest;
+
+	TMap<FString, FLyraReplayIndexEntry> Index;
+	FLyraReplayIndexEntry& Recorded = AddEntry(Index, TEXT("Recorded"), 1);
+	Recorded.CheckpointTimesInMS = { 0, 30000 };
+
+	const TArray<FNetworkReplayStreamInfo> Streams =
+	{
+		MakeStream(TEXT("Recorded"), 1, /*bShouldKeep=*/ true),
+		MakeStream(TEXT("FromOtherBuild"), 2),
+		MakeStream(TEXT("KeptFromOtherBuild"), 3, /*bShouldKeep=*/ true),
+		MakeStream(TEXT("Live"), 0, /*bShouldKeep=*/ false, /*bIsLive=*/ true),
+	};
+
+	TestTrue(TEXT("First merge changes the index"), ULyraReplaySubsystem::MergeEnumeratedStreams(Index, Streams));
+	TestEqual(TEXT("Entries"), Index.Num(), 3);
+	TestFalse(TEXT("Live streams aren't indexed"), Index.Contains(TEXT("Live")));
+
+	TestTrue(TEXT("Keep flag is picked up for recorded entries"), Index[TEXT("Recorded")].bShouldKeep);
+	TestEqual(TEXT("Recorded entry keeps its checkpoints"), Index[TEXT("Recorded")].CheckpointTimesInMS.Num(), 2);
+	TestFalse(TEXT("New entry"), Index[TEXT("FromOtherBuild")].bShouldKeep);
+	TestEqual(TEXT("New entry length"), Index[TEXT("FromOtherBuild")].LengthInMS, 60000u);
+	TestTrue(TEXT("New keep entry"), Index[TEXT("KeptFromOtherBuild")].bShouldKeep);
+
+	TestFalse(TEXT("Merging the same streams again changes nothing"), ULyraReplaySubsystem::MergeEnumeratedStreams(Index, Streams));
+
+	TArray<FNetworkReplayStreamInfo> Unkept = Streams;
+	Unkept[0].bShouldKeep = false;
+	TestTrue(TEXT("Clearing a keep flag changes the index"), ULyraReplaySubsystem::MergeEnumeratedStreams(Index, Unkept));
+	TestFalse(TEXT("Keep flag is cleared"), Index[TEXT("Recorded")].bShouldKeep);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraReplayIndexStaleTest, "Lyra.Replays.Index.Stale", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLyraReplayIndexStaleTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraReplayIndexTest;
+
+	TMap<FString, FLyraReplayIndexEntry> Index;
+	AddEntry(Index, TEXT("A"), 1);
+	AddEntry(Index, TEXT("B"), 2);
+
+	const FDateTime LastEnumerate = BaseTime;
+	const FTimespan MaxAge = FTimespan::FromHours(24);
+	const FDateTime Soon = BaseTime + FTimespan::FromHours(1);
+
+	TestFalse(TEXT("Everything on disk is indexed"), ULyraReplaySubsystem::IsReplayIndexStale(Index, { TEXT("A"), TEXT("B") }, FString(), LastEnumerate, Soon, MaxAge));
+	TestTrue(TEXT("A replay on disk is missing from the index"), ULyraReplaySubsystem::IsReplayIndexStale(Index, { TEXT("A"), TEXT("B"), TEXT("C") }, FString(), LastEnumerate, Soon, MaxAge));
+	TestFalse(TEXT("The replay being recorded isn't a miss"), ULyraReplaySubsystem::IsReplayIndexStale(Index, { TEXT("A"), TEXT("B"), TEXT("C") }, TEXT("C"), LastEnumerate, Soon, MaxAge));
+	TestTrue(TEXT("Too long since the last enumerate"), ULyraReplaySubsystem::IsReplayIndexStale(Index, { TEXT("A"), TEXT("B") }, FString(), LastEnumerate, BaseTime + FTimespan::FromHours(25), MaxAge));
+	TestTrue(TEXT("Never enumerated (index from an older build)"), ULyraReplaySubsystem::IsReplayIndexStale(Index, { TEXT("A"), TEXT("B") }, FString(), FDateTime(0), Soon, MaxAge));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
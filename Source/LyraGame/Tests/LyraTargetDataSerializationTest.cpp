@@ -0,0 +1,172 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AbilitySystem/LyraGameplayAbilityTargetData_SingleTargetHit.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/CoreNet.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LyraTargetDataSerializationTest
+{
+	// Positions are sent at 1cm
+	static FVector QuantizePosition(const FVector& Position)
+	{
+		return FVector(FMath::RoundToDouble(Position.X), FMath::RoundToDouble(Position.Y), FMath::RoundToDouble(Position.Z));
+	}
+
+	// Object references need a live package map, so only the value fields go through here
+	static bool RoundTrip(FLyraGameplayAbilityTargetData_SingleTargetHit Source, FLyraGameplayAbilityTargetData_SingleTargetHit& OutResult, int64& OutNumBits)
+	{
+		FNetBitWriter Writer(nullptr, 1024);
+		bool bWriteSuccess = false;
+		Source.NetSerialize(Writer, nullptr, bWriteSuccess);
+		OutNumBits = Writer.GetNumBits();
+
+		FNetBitReader Reader(nullptr, Writer.GetData(), Writer.GetNumBits());
+		bool bReadSuccess = false;
+		OutResult.NetSerialize(Reader, nullptr, bReadSuccess);
+
+		return bWriteSuccess && bReadSuccess && !Writer.IsError() && !Reader.IsError() && Reader.AtEnd();
+	}
+
+	static FLyraGameplayAbilityTargetData_SingleTargetHit MakeRandomHit(FRandomStream& Random)
+	{
+		static const FName BoneNames[] = { NAME_None, TEXT("head"), TEXT("spine_03"), TEXT("pelvis") };
+
+		FLyraGameplayAbilityTargetData_SingleTargetHit TargetData;
+		FHitResult& Hit = TargetData.HitResult;
+		Hit.bBlockingHit = Random.FRand() < 0.9f;
+		Hit.TraceStart = Random.GetUnitVector() * Random.FRandRange(0.0f, 200000.0f);
+		Hit.TraceEnd = Hit.TraceStart + Random.GetUnitVector() * Random.FRandRange(100.0f, 100000.0f);
+		Hit.Location = FMath::Lerp(Hit.TraceStart, Hit.TraceEnd, Random.FRand());
+		Hit.ImpactPoint = (Random.FRand() < 0.5f) ? Hit.Location : Hit.Location + Random.GetUnitVector() * 30.0f;
+		Hit.Normal = Hit.bBlockingHit ? Random.GetUnitVector() : FVector::ZeroVector;
+		Hit.ImpactNormal = (Random.FRand() < 0.5f) ? Hit.Normal : Random.GetUnitVector();
+		Hit.BoneName = BoneNames[Random.RandHelper(UE_ARRAY_COUNT(BoneNames))];
+		TargetData.CartridgeID = Random.RandRange(-1, 100000);
+		return TargetData;
+	}
+
+	static double GetAngleDegrees(const FVector& A, const FVector& B)
+	{
+		return FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(FVector::DotProduct(A.GetSafeNormal(), B.GetSafeNormal()), -1.0, 1.0)));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraTargetDataSerializationRoundTripTest, "Lyra.Net.TargetDataSerialization.RoundTrip", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLyraTargetDataSerializationRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraTargetDataSerializationTest;
+
+	// 12 bits per axis of octahedral encoding is ~0.05 degrees worst case
+	const double MaxNormalErrorDegrees = 0.1;
+	const int32 NumSamples = 10000;
+
+	FRandomStream Random(0x4C797261);
+	int64 TotalBits = 0;
+	int32 NumFailures = 0;
+
+	for (int32 SampleIndex = 0; (SampleIndex < NumSamples) && (NumFailures < 10); ++SampleIndex)
+	{
+		const FLyraGameplayAbilityTargetData_SingleTargetHit Source = MakeRandomHit(Random);
+		const FHitResult& Hit = Source.HitResult;
+
+		FLyraGameplayAbilityTargetData_SingleTargetHit Result;
+		int64 NumBits = 0;
+		const bool bStreamOk = RoundTrip(Source, Result, NumBits);
+		TotalBits += NumBits;
+
+		// Everything the damage execution, gameplay cues and hit confirmation read
+		TArray<const TCHAR*, TInlineAllocator<8>> Mismatches;
+		if (!bStreamOk) { Mismatches.Add(TEXT("Stream")); }
+		if (Result.HitResult.bBlockingHit != Hit.bBlockingHit) { Mismatches.Add(TEXT("bBlockingHit")); }
+		if (Result.HitResult.TraceStart != QuantizePosition(Hit.TraceStart)) { Mismatches.Add(TEXT("TraceStart")); }
+		if (Result.HitResult.TraceEnd != QuantizePosition(Hit.TraceEnd)) { Mismatches.Add(TEXT("TraceEnd")); }
+		if (Result.HitResult.Location != QuantizePosition(Hit.Location)) { Mismatches.Add(TEXT("Location")); }
+		if (Result.HitResult.ImpactPoint != QuantizePosition(Hit.ImpactPoint)) { Mismatches.Add(TEXT("ImpactPoint")); }
+		if (Hit.Normal.IsZero() ? !Result.HitResult.Normal.IsZero() : (GetAngleDegrees(Hit.Normal, Result.HitResult.Normal) > MaxNormalErrorDegrees)) { Mismatches.Add(TEXT("Normal")); }
+		if (Hit.ImpactNormal.IsZero() ? !Result.HitResult.ImpactNormal.IsZero() : (GetAngleDegrees(Hit.ImpactNormal, Result.HitResult.ImpactNormal) > MaxNormalErrorDegrees)) { Mismatches.Add(TEXT("ImpactNormal")); }
+		if (Result.HitResult.BoneName != Hit.BoneName) { Mismatches.Add(TEXT("BoneName")); }
+		if (Result.CartridgeID != Source.CartridgeID) { Mismatches.Add(TEXT("CartridgeID")); }
+
+		// Quantization has to be stable, so a client predicting from its own quantized hit sees exactly what the server sees
+		FLyraGameplayAbilityTargetData_SingleTargetHit SecondResult;
+		int64 SecondNumBits = 0;
+		RoundTrip(Result, SecondResult, SecondNumBits);
+		if ((SecondResult.HitResult.Location != Result.HitResult.Location) ||
+			(SecondResult.HitResult.ImpactPoint != Result.HitResult.ImpactPoint) ||
+			(SecondResult.HitResult.Normal != Result.HitResult.Normal) ||
+			(SecondResult.HitResult.ImpactNormal != Result.HitResult.ImpactNormal))
+		{
+			Mismatches.Add(TEXT("Requantization"));
+		}
+
+		if (Mismatches.Num() > 0)
+		{
+			AddError(FString::Printf(TEXT("Sample %d mismatched: %s"), SampleIndex, *FString::Join(Mismatches, TEXT(", "))));
+			++NumFailures;
+		}
+	}
+
+	AddInfo(FString::Printf(TEXT("%.1f bits per hit on average"), (double)TotalBits / NumSamples));
+
+	return NumFailures == 0;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraTargetDataSerializationZeroNormalsTest, "Lyra.Net.TargetDataSerialization.ZeroNormals", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLyraTargetDataSerializationZeroNormalsTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraTargetDataSerializationTest;
+
+	const FVector SomeNormal = FVector(1.0, 2.0, -3.0).GetSafeNormal();
+	const TPair<FVector, FVector> Cases[] =
+	{
+		{ FVector::ZeroVector, FVector::ZeroVector },
+		{ FVector::ZeroVector, SomeNormal },
+		{ SomeNormal, FVector::ZeroVector },
+	};
+
+	for (const TPair<FVector, FVector>& Case : Cases)
+	{
+		FLyraGameplayAbilityTargetData_SingleTargetHit Source;
+		Source.HitResult.TraceEnd = FVector(1000.0, 0.0, 0.0);
+		Source.HitResult.Location = FVector(500.0, 0.0, 0.0);
+		Source.HitResult.ImpactPoint = Source.HitResult.Location;
+		Source.HitResult.Normal = Case.Key;
+		Source.HitResult.ImpactNormal = Case.Value;
+
+		FLyraGameplayAbilityTargetData_SingleTargetHit Result;
+		int64 NumBits = 0;
+		TestTrue(TEXT("Stream round trips"), RoundTrip(Source, Result, NumBits));
+
+		TestEqual(TEXT("Normal is zero exactly when it was sent as zero"), Result.HitResult.Normal.IsZero(), Case.Key.IsZero());
+		TestEqual(TEXT("ImpactNormal is zero exactly when it was sent as zero"), Result.HitResult.ImpactNormal.IsZero(), Case.Value.IsZero());
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraTargetDataSerializationCartridgeIDTest, "Lyra.Net.TargetDataSerialization.CartridgeID", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLyraTargetDataSerializationCartridgeIDTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraTargetDataSerializationTest;
+
+	const int32 CartridgeIDs[] = { -1, 0, 1, 0xFFFF, 0x10000, MAX_int32 };
+	for (const int32 CartridgeID : CartridgeIDs)
+	{
+		FLyraGameplayAbilityTargetData_SingleTargetHit Source;
+		Source.CartridgeID = CartridgeID;
+
+		FLyraGameplayAbilityTargetData_SingleTargetHit Result;
+		int64 NumBits = 0;
+		TestTrue(TEXT("Stream round trips"), RoundTrip(Source, Result, NumBits));
+		TestEqual(FString::Printf(TEXT("CartridgeID %d round trips unchanged"), CartridgeID), Result.CartridgeID, CartridgeID);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
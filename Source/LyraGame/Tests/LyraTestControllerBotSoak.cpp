@@ -0,0 +1,827 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Tests/LyraTestControllerBotSoak.h"
+
+#include "Dom/JsonObject.h"
+#include "Engine/GameInstance.h"
+#include "Engine/NetDriver.h"
+#include "Engine/ReplicationDriver.h"
+#include "Engine/SimulatedClientNetConnection.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameModes/LyraBotCreationComponent.h"
+#include "GameModes/LyraExperienceManagerComponent.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "LyraLogChannels.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Performance/LyraPerformanceStatSubsystem.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestControllerBotSoak)
+
+namespace LyraBotSoak
+{
+	// CSV categories that make up the per-subsystem section of the report
+	static const TCHAR* TrackedCsvCategories[] =
+	{
+		TEXT("LyraReplicationGraph"),
+		TEXT("LyraAbilities"),
+		TEXT("LyraWeapons"),
+		TEXT("SmoothSync"),
+		TEXT("GameplayMessages"),
+	};
+
+	static const double MemorySampleInterval = 1.0;
+
+	// How often the simulated clients are moved onto the bots they follow
+	static const double ViewerUpdateInterval = 1.0;
+
+	static double Percentile(TArray<float> Values, double Fraction)
+	{
+		if (Values.Num() == 0)
+		{
+			return 0.0;
+		}
+
+		Values.Sort();
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(Fraction * Values.Num()) - 1, 0, Values.Num() - 1);
+		return Values[Index];
+	}
+
+	static double Average(const TArray<float>& Values)
+	{
+		double Sum = 0.0;
+		for (float Value : Values)
+		{
+			Sum += Value;
+		}
+		return (Values.Num() > 0) ? (Sum / Values.Num()) : 0.0;
+	}
+
+	static void GetNetDriverTotals(UWorld* World, uint64& OutInBytes, uint64& OutOutBytes)
+	{
+		OutInBytes = 0;
+		OutOutBytes = 0;
+		if (UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr)
+		{
+			OutInBytes = NetDriver->InTotalBytes;
+			OutOutBytes = NetDriver->OutTotalBytes;
+		}
+	}
+
+	// Applies to net drivers created from now on (see Lyra.RepGraph.Force in LyraReplicationGraph.cpp)
+	static void ForceReplicationGraph(bool bEnabled)
+	{
+		if (IConsoleVariable* ForceCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Lyra.RepGraph.Force")))
+		{
+			ForceCVar->Set(bEnabled ? 1 : 0, ECVF_SetByCode);
+		}
+	}
+}
+
+void ULyraTestControllerBotSoak::OnInit()
+{
+	Super::OnInit();
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	FParse::Value(CommandLine, TEXT("LyraSoak.Map="), TravelMap);
+	FParse::Value(CommandLine, TEXT("LyraSoak.Experience="), ExperienceName);
+	FParse::Value(CommandLine, TEXT("LyraSoak.Bots="), DesiredBotCount);
+	FParse::Value(CommandLine, TEXT("LyraSoak.Warmup="), WarmupSeconds);
+	FParse::Value(CommandLine, TEXT("LyraSoak.Duration="), DurationSeconds);
+	FParse::Value(CommandLine, TEXT("LyraSoak.Tolerance="), Tolerance);
+	FParse::Value(CommandLine, TEXT("LyraSoak.SimulatedClients="), DesiredSimulatedClientCount);
+	bWriteBaseline = FParse::Param(CommandLine, TEXT("LyraSoak.WriteBaseline"));
+	bCompareReplication = FParse::Param(CommandLine, TEXT("LyraSoak.CompareReplication"));
+
+	bool bUseReplicationGraph = false;
+	if (bCompareReplication)
+	{
+		// The first pass runs on the graph; travel even if we're on the right map, the current net driver may not be using it
+		ReplicationDriverOverride = TEXT("RepGraph");
+		LyraBotSoak::ForceReplicationGraph(true);
+		bTravelForReplicationDriver = true;
+	}
+	else if (FParse::Bool(CommandLine, TEXT("LyraRepGraph="), bUseReplicationGraph))
+	{
+		ReplicationDriverOverride = bUseReplicationGraph ? TEXT("RepGraph") : TEXT("NetDriver");
+	}
+
+	if (!FParse::Value(CommandLine, TEXT("LyraSoak.ReportDir="), ReportDir))
+	{
+		ReportDir = FPaths::ProjectSavedDir() / TEXT("Soak");
+	}
+
+	FParse::Value(CommandLine, TEXT("LyraSoak.Baseline="), BaselineFile);
+
+	UE_LOG(LogLyra, Display, TEXT("BotSoak: Map=%s Experience=%s Bots=%d SimulatedClients=%d Warmup=%.1fs Duration=%.1fs Baseline=%s%s"),
+		TravelMap.IsEmpty() ? TEXT("<current>") : *TravelMap,
+		ExperienceName.IsEmpty() ? TEXT("<default>") : *ExperienceName,
+		DesiredBotCount, DesiredSimulatedClientCount, WarmupSeconds, DurationSeconds, *GetBaselineFile(),
+		bCompareReplication ? TEXT(" (comparing replication graph and net driver)") : TEXT(""));
+
+	Phase = ESoakPhase::WaitingForWorld;
+	PhaseStartTime = FPlatformTime::Seconds();
+}
+
+void ULyraTestControllerBotSoak::OnPostMapChange(UWorld* World)
+{
+	Super::OnPostMapChange(World);
+
+	if ((Phase == ESoakPhase::Traveling) || (Phase == ESoakPhase::WaitingForWorld))
+	{
+		Phase = ESoakPhase::WaitingForExperience;
+		PhaseStartTime = FPlatformTime::Seconds();
+	}
+}
+
+void ULyraTestControllerBotSoak::OnTick(float TimeDelta)
+{
+	Super::OnTick(TimeDelta);
+
+	UWorld* World = GetWorld();
+	const double Now = FPlatformTime::Seconds();
+
+	switch (Phase)
+	{
+	case ESoakPhase::WaitingForWorld:
+		if ((World != nullptr) && (World->GetGameState() != nullptr))
+		{
+			const bool bWrongMap = !TravelMap.IsEmpty() && (FPackageName::GetShortName(World->GetMapName()) != FPackageName::GetShortName(TravelMap));
+			if (bWrongMap || bTravelForReplicationDriver)
+			{
+				FString TravelURL = TravelMap.IsEmpty() ? World->GetOutermost()->GetName() : TravelMap;
+				if (!ExperienceName.IsEmpty())
+				{
+					TravelURL += FString::Printf(TEXT("?Experience=%s"), *ExperienceName);
+				}
+				if (DesiredBotCount != INDEX_NONE)
+				{
+					TravelURL += FString::Printf(TEXT("?NumBots=%d"), DesiredBotCount);
+				}
+
+				if (bTravelForReplicationDriver)
+				{
+					// Seamless travel keeps the net driver, and the replication driver is only picked when one is created
+					if (AGameModeBase* GameMode = World->GetAuthGameMode())
+					{
+						GameMode->bUseSeamlessTravel = false;
+					}
+					bTravelForReplicationDriver = false;
+				}
+
+				UE_LOG(LogLyra, Display, TEXT("BotSoak: Traveling to %s"), *TravelURL);
+				Phase = ESoakPhase::Traveling;
+				PhaseStartTime = Now;
+				World->ServerTravel(TravelURL, /*bAbsolute=*/ true);
+			}
+			else
+			{
+				Phase = ESoakPhase::WaitingForExperience;
+				PhaseStartTime = Now;
+			}
+		}
+		break;
+
+	case ESoakPhase::Traveling:
+		// OnPostMapChange moves us on
+		break;
+
+	case ESoakPhase::WaitingForExperience:
+		if (IsExperienceReady(World))
+		{
+			UE_LOG(LogLyra, Display, TEXT("BotSoak: Experience loaded, warming up for %.1fs"), WarmupSeconds);
+			AddSimulatedClients(World);
+			Phase = ESoakPhase::WarmingUp;
+			PhaseStartTime = Now;
+		}
+		break;
+
+	case ESoakPhase::WarmingUp:
+		AdjustBotCount(World);
+		UpdateSimulatedClients(World);
+		if ((Now - PhaseStartTime) >= WarmupSeconds)
+		{
+			BeginSampling(World);
+			Phase = ESoakPhase::Sampling;
+			PhaseStartTime = Now;
+		}
+		break;
+
+	case ESoakPhase::Sampling:
+		UpdateSimulatedClients(World);
+		SampleFrame(World, TimeDelta);
+		if ((Now - PhaseStartTime) >= DurationSeconds)
+		{
+			SampledSeconds = Now - PhaseStartTime;
+			EndSampling();
+		}
+		break;
+
+	case ESoakPhase::WaitingForCsv:
+		if (!CsvFilenameFuture.IsValid() || CsvFilenameFuture.IsReady())
+		{
+			if (CsvFilenameFuture.IsValid())
+			{
+				ReadCsvScopes(CsvFilenameFuture.Get());
+			}
+			FinishTest();
+		}
+		break;
+
+	case ESoakPhase::Finished:
+		break;
+	}
+}
+
+bool ULyraTestControllerBotSoak::IsExperienceReady(UWorld* World) const
+{
+	if (AGameStateBase* GameState = World ? World->GetGameState() : nullptr)
+	{
+		if (const ULyraExperienceManagerComponent* ExperienceComponent = GameState->FindComponentByClass<ULyraExperienceManagerComponent>())
+		{
+			return ExperienceComponent->IsExperienceLoaded();
+		}
+	}
+	return false;
+}
+
+void ULyraTestControllerBotSoak::AdjustBotCount(UWorld* World) const
+{
+#if WITH_SERVER_CODE
+	if (DesiredBotCount == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (AGameStateBase* GameState = World ? World->GetGameState() : nullptr)
+	{
+		if (ULyraBotCreationComponent* BotComponent = GameState->FindComponentByClass<ULyraBotCreationComponent>())
+		{
+			// Converge on the requested count a bot per frame, so spawning doesn't land in a single hitch
+			const int32 NumBots = BotComponent->GetNumSpawnedBots();
+			if (NumBots < DesiredBotCount)
+			{
+				BotComponent->Cheat_AddBot();
+			}
+			else if (NumBots > DesiredBotCount)
+			{
+				BotComponent->Cheat_RemoveBot();
+			}
+		}
+	}
+#endif
+}
+
+void ULyraTestControllerBotSoak::AddSimulatedClients(UWorld* World)
+{
+	if (DesiredSimulatedClientCount <= 0)
+	{
+		return;
+	}
+
+	UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+	if ((NetDriver == nullptr) || !NetDriver->IsServer())
+	{
+		UE_LOG(LogLyra, Warning, TEXT("BotSoak: No server net driver to add %d simulated client(s) to, is this running as a server?"), DesiredSimulatedClientCount);
+		return;
+	}
+
+	for (int32 Index = 0; Index < DesiredSimulatedClientCount; ++Index)
+	{
+		// Absorbs and acks everything it's sent, so the server replicates to it as it would to a client that keeps up
+		USimulatedClientNetConnection* Connection = NewObject<USimulatedClientNetConnection>(GetTransientPackage());
+		Connection->InitConnection(NetDriver, USOCK_Open, World->URL, 1000000);
+		Connection->InitSendBuffer();
+		NetDriver->AddClientConnection(Connection);
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		APlayerController* PlayerController = World->SpawnActor<APlayerController>(SpawnParams);
+		PlayerController->SetReplicates(true);
+		PlayerController->SetAutonomousProxy(true);
+		PlayerController->SetPlayer(Connection);
+		Connection->OwningActor = PlayerController;
+
+		SimulatedClients.Add(PlayerController);
+	}
+
+	UE_LOG(LogLyra, Display, TEXT("BotSoak: Added %d simulated client(s) to %s"), SimulatedClients.Num(), *NetDriver->GetName());
+}
+
+void ULyraTestControllerBotSoak::UpdateSimulatedClients(UWorld* World)
+{
+	UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+	if (SimulatedClients.IsEmpty() || (NetDriver == nullptr))
+	{
+		return;
+	}
+
+	// Simulated clients never send anything, and the net driver stops replicating to connections it hasn't heard from
+	// in a while (and eventually times them out)
+	for (const TWeakObjectPtr<APlayerController>& SimulatedClient : SimulatedClients)
+	{
+		if (UNetConnection* Connection = SimulatedClient.IsValid() ? SimulatedClient->GetNetConnection() : nullptr)
+		{
+			Connection->LastReceiveTime = NetDriver->GetElapsedTime();
+			Connection->LastReceiveRealtime = FPlatformTime::Seconds();
+		}
+	}
+
+	// Park each viewer on a bot, so relevancy and spatialization see it where the action is
+	const double Now = FPlatformTime::Seconds();
+	if ((Now - LastViewerUpdateTime) < LyraBotSoak::ViewerUpdateInterval)
+	{
+		return;
+	}
+	LastViewerUpdateTime = Now;
+
+	TArray<const APawn*> Pawns;
+	for (TActorIterator<APawn> It(World); It; ++It)
+	{
+		if (It->GetController() != nullptr)
+		{
+			Pawns.Add(*It);
+		}
+	}
+
+	if (Pawns.IsEmpty())
+	{
+		return;
+	}
+
+	for (int32 Index = 0; Index < SimulatedClients.Num(); ++Index)
+	{
+		if (APlayerController* PlayerController = SimulatedClients[Index].Get())
+		{
+			const APawn* Pawn = Pawns[Index % Pawns.Num()];
+			PlayerController->SetActorLocationAndRotation(Pawn->GetActorLocation(), Pawn->GetActorRotation());
+			PlayerController->SetControlRotation(Pawn->GetActorRotation());
+		}
+	}
+}
+
+void ULyraTestControllerBotSoak::BeginSampling(UWorld* World)
+{
+	UE_LOG(LogLyra, Display, TEXT("BotSoak: Sampling for %.1fs"), DurationSeconds);
+
+	FrameTimesMS.Reset();
+	GameThreadTimesMS.Reset();
+	FrameTimesMS.Reserve(FMath::CeilToInt(DurationSeconds * 60.0));
+	GameThreadTimesMS.Reserve(FMath::CeilToInt(DurationSeconds * 60.0));
+
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	StartUsedPhysicalBytes = MemoryStats.UsedPhysical;
+	PeakUsedPhysicalBytes = MemoryStats.UsedPhysical;
+	LastMemorySampleTime = FPlatformTime::Seconds();
+
+	LyraBotSoak::GetNetDriverTotals(World, StartInBytes, StartOutBytes);
+
+	if (ULyraPerformanceStatSubsystem* PerfStats = (World && World->GetGameInstance()) ? World->GetGameInstance()->GetSubsystem<ULyraPerformanceStatSubsystem>() : nullptr)
+	{
+		PerfStats->ResetStatHistograms();
+	}
+
+	NetFlushTimesMS.Reset();
+	NetFlushTimesPerConnectionMS.Reset();
+	PeakConnectionCount = 0;
+	ReplicationDriverName = TEXT("None");
+	if (UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr)
+	{
+		UReplicationDriver* ReplicationDriver = NetDriver->GetReplicationDriver();
+		ReplicationDriverName = ReplicationDriver ? ReplicationDriver->GetClass()->GetName() : NetDriver->GetClass()->GetName();
+	}
+
+	// The net driver registered its flush before we got here and multicast delegates broadcast newest first,
+	// so these bracket the net drivers' TickFlush
+	if (World)
+	{
+		TickFlushHandle = World->OnTickFlush().AddUObject(this, &ThisClass::OnTickFlush);
+		PostTickFlushHandle = World->OnPostTickFlush().AddUObject(this, &ThisClass::OnPostTickFlush);
+	}
+
+#if WITH_SERVER_CODE
+	if (AGameStateBase* GameState = World ? World->GetGameState() : nullptr)
+	{
+		if (ULyraBotCreationComponent* BotComponent = GameState->FindComponentByClass<ULyraBotCreationComponent>())
+		{
+			SampledBotCount = BotComponent->GetNumSpawnedBots();
+		}
+	}
+#endif
+
+#if CSV_PROFILER
+	if (FCsvProfiler* CsvProfiler = FCsvProfiler::Get())
+	{
+		if (!CsvProfiler->IsCapturing())
+		{
+			CsvProfiler->BeginCapture(-1, ReportDir, GetReportName() + TEXT(".csv"));
+		}
+	}
+#endif
+}
+
+void ULyraTestControllerBotSoak::SampleFrame(UWorld* World, float TimeDelta)
+{
+	FrameTimesMS.Add(TimeDelta * 1000.0f);
+	GameThreadTimesMS.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+
+	const double Now = FPlatformTime::Seconds();
+	if ((Now - LastMemorySampleTime) >= LyraBotSoak::MemorySampleInterval)
+	{
+		LastMemorySampleTime = Now;
+		PeakUsedPhysicalBytes = FMath::Max<uint64>(PeakUsedPhysicalBytes, FPlatformMemory::GetStats().UsedPhysical);
+	}
+
+	LyraBotSoak::GetNetDriverTotals(World, EndInBytes, EndOutBytes);
+}
+
+void ULyraTestControllerBotSoak::OnTickFlush(float DeltaSeconds)
+{
+	NetFlushStartTime = FPlatformTime::Seconds();
+}
+
+void ULyraTestControllerBotSoak::OnPostTickFlush()
+{
+	if (NetFlushStartTime <= 0.0)
+	{
+		return;
+	}
+
+	const float FlushMS = static_cast<float>((FPlatformTime::Seconds() - NetFlushStartTime) * 1000.0);
+	NetFlushStartTime = 0.0;
+	NetFlushTimesMS.Add(FlushMS);
+
+	const UWorld* World = GetWorld();
+	const UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+	const int32 NumConnections = NetDriver ? NetDriver->ClientConnections.Num() : 0;
+	PeakConnectionCount = FMath::Max(PeakConnectionCount, NumConnections);
+	if (NumConnections > 0)
+	{
+		NetFlushTimesPerConnectionMS.Add(FlushMS / NumConnections);
+	}
+}
+
+void ULyraTestControllerBotSoak::EndSampling()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->OnTickFlush().Remove(TickFlushHandle);
+		World->OnPostTickFlush().Remove(PostTickFlushHandle);
+	}
+	TickFlushHandle.Reset();
+	PostTickFlushHandle.Reset();
+
+	UE_CLOG(!ReplicationDriverOverride.IsEmpty() && (PeakConnectionCount == 0), LogLyra, Warning,
+		TEXT("BotSoak: Comparing replication drivers but no client connected while sampling (pass -LyraSoak.SimulatedClients=N), the net numbers in this report don't measure replication"));
+
+	if (ULyraPerformanceStatSubsystem* PerfStats = (GetWorld() && GetWorld()->GetGameInstance()) ? GetWorld()->GetGameInstance()->GetSubsystem<ULyraPerformanceStatSubsystem>() : nullptr)
+	{
+		PerfStats->ExportStatHistograms(ReportDir / (GetReportName() + TEXT("_PerfStats")));
+	}
+
+	EndUsedPhysicalBytes = FPlatformMemory::GetStats().UsedPhysical;
+	PeakUsedPhysicalBytes = FMath::Max(PeakUsedPhysicalBytes, EndUsedPhysicalBytes);
+
+	Phase = ESoakPhase::WaitingForCsv;
+	PhaseStartTime = FPlatformTime::Seconds();
+
+#if CSV_PROFILER
+	if (FCsvProfiler* CsvProfiler = FCsvProfiler::Get())
+	{
+		if (CsvProfiler->IsCapturing())
+		{
+			CsvFilenameFuture = CsvProfiler->EndCapture();
+		}
+	}
+#endif
+}
+
+void ULyraTestControllerBotSoak::ReadCsvScopes(const FString& CsvFilename)
+{
+	TArray<FString> Lines;
+	if (CsvFilename.IsEmpty() || !FFileHelper::LoadFileToStringArray(Lines, *CsvFilename) || (Lines.Num() < 2))
+	{
+		UE_LOG(LogLyra, Warning, TEXT("BotSoak: Could not read CSV capture '%s', per-subsystem timings will be missing"), *CsvFilename);
+		return;
+	}
+
+	TArray<FString> Header;
+	Lines[0].ParseIntoArray(Header, TEXT(","), /*InCullEmpty=*/ false);
+
+	// Find the columns belonging to the tracked categories
+	TArray<int32> Columns;
+	for (int32 ColumnIndex = 0; ColumnIndex < Header.Num(); ++ColumnIndex)
+	{
+		for (const TCHAR* Category : LyraBotSoak::TrackedCsvCategories)
+		{
+			if (Header[ColumnIndex].StartsWith(FString(Category) + TEXT("/")))
+			{
+				Columns.Add(ColumnIndex);
+				break;
+			}
+		}
+	}
+
+	TArray<double> Sums;
+	TArray<double> Maxes;
+	Sums.SetNumZeroed(Columns.Num());
+	Maxes.SetNumZeroed(Columns.Num());
+	int32 NumRows = 0;
+
+	TArray<FString> Cells;
+	for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+	{
+		Lines[LineIndex].ParseIntoArray(Cells, TEXT(","), /*InCullEmpty=*/ false);
+
+		// The frame rows are followed by events/metadata rows, which don't start with a number
+		if ((Cells.Num() == 0) || !FCString::IsNumeric(*Cells[0]))
+		{
+			break;
+		}
+
+		for (int32 Index = 0; Index < Columns.Num(); ++Index)
+		{
+			const double Value = Cells.IsValidIndex(Columns[Index]) ? FCString::Atod(*Cells[Columns[Index]]) : 0.0;
+			Sums[Index] += Value;
+			Maxes[Index] = FMath::Max(Maxes[Index], Value);
+		}
+		++NumRows;
+	}
+
+	for (int32 Index = 0; Index < Columns.Num(); ++Index)
+	{
+		FScopeTiming& Timing = ScopeTimings.Add(Header[Columns[Index]]);
+		Timing.Average = (NumRows > 0) ? (Sums[Index] / NumRows) : 0.0;
+		Timing.Max = Maxes[Index];
+	}
+}
+
+TSharedRef<FJsonObject> ULyraTestControllerBotSoak::BuildReport() const
+{
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("name"), GetReportName());
+	Report->SetStringField(TEXT("map"), GetWorld() ? FPackageName::GetShortName(GetWorld()->GetMapName()) : FString());
+	Report->SetStringField(TEXT("experience"), ExperienceName);
+	Report->SetNumberField(TEXT("bots"), SampledBotCount);
+	Report->SetNumberField(TEXT("durationSeconds"), SampledSeconds);
+	Report->SetNumberField(TEXT("frames"), FrameTimesMS.Num());
+	Report->SetStringField(TEXT("replicationDriver"), ReplicationDriverName);
+	Report->SetNumberField(TEXT("simulatedClients"), SimulatedClients.Num());
+	Report->SetNumberField(TEXT("peakConnections"), PeakConnectionCount);
+
+	// Flat map of metric name to value; lower is always better, which is what the baseline comparison assumes
+	TSharedRef<FJsonObject> Metrics = MakeShared<FJsonObject>();
+	Metrics->SetNumberField(TEXT("frameTime.avgMS"), LyraBotSoak::Average(FrameTimesMS));
+	Metrics->SetNumberField(TEXT("frameTime.p50MS"), LyraBotSoak::Percentile(FrameTimesMS, 0.50));
+	Metrics->SetNumberField(TEXT("frameTime.p95MS"), LyraBotSoak::Percentile(FrameTimesMS, 0.95));
+	Metrics->SetNumberField(TEXT("frameTime.p99MS"), LyraBotSoak::Percentile(FrameTimesMS, 0.99));
+	Metrics->SetNumberField(TEXT("gameThread.avgMS"), LyraBotSoak::Average(GameThreadTimesMS));
+	Metrics->SetNumberField(TEXT("gameThread.p95MS"), LyraBotSoak::Percentile(GameThreadTimesMS, 0.95));
+	Metrics->SetNumberField(TEXT("memory.peakUsedMB"), PeakUsedPhysicalBytes / (1024.0 * 1024.0));
+	Metrics->SetNumberField(TEXT("memory.growthMB"), (static_cast<double>(EndUsedPhysicalBytes) - static_cast<double>(StartUsedPhysicalBytes)) / (1024.0 * 1024.0));
+
+	const double Seconds = FMath::Max(SampledSeconds, UE_DOUBLE_SMALL_NUMBER);
+	Metrics->SetNumberField(TEXT("net.inBytesPerSec"), (EndInBytes - FMath::Min(StartInBytes, EndInBytes)) / Seconds);
+	Metrics->SetNumberField(TEXT("net.outBytesPerSec"), (EndOutBytes - FMath::Min(StartOutBytes, EndOutBytes)) / Seconds);
+	Metrics->SetNumberField(TEXT("net.flushAvgMS"), LyraBotSoak::Average(NetFlushTimesMS));
+	Metrics->SetNumberField(TEXT("net.flushP95MS"), LyraBotSoak::Percentile(NetFlushTimesMS, 0.95));
+	if (NetFlushTimesPerConnectionMS.Num() > 0)
+	{
+		Metrics->SetNumberField(TEXT("net.flushPerConnectionMS"), LyraBotSoak::Average(NetFlushTimesPerConnectionMS));
+	}
+
+	for (const TPair<FString, FScopeTiming>& Pair : ScopeTimings)
+	{
+		// Values are per frame, in ms for timing scopes or raw counts for custom stats
+		Metrics->SetNumberField(FString::Printf(TEXT("csv.%s.avg"), *Pair.Key), Pair.Value.Average);
+		Metrics->SetNumberField(FString::Printf(TEXT("csv.%s.max"), *Pair.Key), Pair.Value.Max);
+	}
+
+	Report->SetObjectField(TEXT("metrics"), Metrics);
+	return Report;
+}
+
+int32 ULyraTestControllerBotSoak::CompareAgainstBaseline(const TSharedRef<FJsonObject>& Report, TArray<FString>& OutRegressions) const
+{
+	FString BaselineText;
+	const FString Baseline = GetBaselineFile();
+	if (!FFileHelper::LoadFileToString(BaselineText, *Baseline))
+	{
+		UE_LOG(LogLyra, Warning, TEXT("BotSoak: No baseline found at '%s', skipping comparison"), *Baseline);
+		return 0;
+	}
+
+	TSharedPtr<FJsonObject> BaselineReport;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(BaselineText);
+	if (!FJsonSerializer::Deserialize(Reader, BaselineReport) || !BaselineReport.IsValid())
+	{
+		UE_LOG(LogLyra, Error, TEXT("BotSoak: Failed to parse baseline '%s'"), *Baseline);
+		return 1;
+	}
+
+	const TSharedPtr<FJsonObject>* BaselineMetrics = nullptr;
+	if (!BaselineReport->TryGetObjectField(TEXT("metrics"), BaselineMetrics))
+	{
+		UE_LOG(LogLyra, Error, TEXT("BotSoak: Baseline '%s' has no metrics"), *Baseline);
+		return 1;
+	}
+
+	const TSharedPtr<FJsonObject> CurrentMetrics = Report->GetObjectField(TEXT("metrics"));
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*BaselineMetrics)->Values)
+	{
+		double BaselineValue = 0.0;
+		double CurrentValue = 0.0;
+		if (!Pair.Value->TryGetNumber(BaselineValue) || !CurrentMetrics->TryGetNumberField(Pair.Key, CurrentValue))
+		{
+			continue;
+		}
+
+		// Ignore noise on metrics that are near zero in the baseline
+		const double Allowed = FMath::Max(BaselineValue * (1.0 + Tolerance), BaselineValue + 0.01);
+		if (CurrentValue > Allowed)
+		{
+			OutRegressions.Add(FString::Printf(TEXT("%s: %.3f (baseline %.3f, allowed %.3f)"), *Pair.Key, CurrentValue, BaselineValue, Allowed));
+		}
+	}
+
+	return OutRegressions.Num() > 0 ? 1 : 0;
+}
+
+void ULyraTestControllerBotSoak::FinishTest()
+{
+	TSharedRef<FJsonObject> Report = BuildReport();
+	WorstExitCode = FMath::Max(WorstExitCode, WriteReport(Report));
+
+	if (bCompareReplication)
+	{
+		ReplicationPassReports.Add(Report);
+		if (ReplicationPassReports.Num() == 1)
+		{
+			UE_LOG(LogLyra, Display, TEXT("BotSoak: Replication graph pass done, running again on the default net driver"));
+			ReplicationDriverOverride = TEXT("NetDriver");
+			LyraBotSoak::ForceReplicationGraph(false);
+			bTravelForReplicationDriver = true;
+			ResetSamples();
+			Phase = ESoakPhase::WaitingForWorld;
+			PhaseStartTime = FPlatformTime::Seconds();
+			return;
+		}
+
+		WriteReplicationComparison();
+	}
+
+	Phase = ESoakPhase::Finished;
+	UE_LOG(LogLyra, Display, TEXT("BotSoak: Finished%s"), (WorstExitCode != 0) ? TEXT(" with regressions") : TEXT(""));
+	EndTest(WorstExitCode);
+}
+
+void ULyraTestControllerBotSoak::ResetSamples()
+{
+	FrameTimesMS.Reset();
+	GameThreadTimesMS.Reset();
+	PeakUsedPhysicalBytes = 0;
+	StartUsedPhysicalBytes = 0;
+	EndUsedPhysicalBytes = 0;
+	StartInBytes = 0;
+	StartOutBytes = 0;
+	EndInBytes = 0;
+	EndOutBytes = 0;
+	SampledSeconds = 0.0;
+	SampledBotCount = 0;
+	NetFlushTimesMS.Reset();
+	NetFlushTimesPerConnectionMS.Reset();
+	PeakConnectionCount = 0;
+	ScopeTimings.Reset();
+	CsvFilenameFuture = TSharedFuture<FString>();
+
+	// Their connections go away with the net driver when we travel
+	SimulatedClients.Reset();
+}
+
+int32 ULyraTestControllerBotSoak::WriteReport(const TSharedRef<FJsonObject>& Report) const
+{
+	TArray<FString> Regressions;
+	const int32 ExitCode = CompareAgainstBaseline(Report, Regressions);
+
+	TArray<TSharedPtr<FJsonValue>> RegressionValues;
+	for (const FString& Regression : Regressions)
+	{
+		UE_LOG(LogLyra, Error, TEXT("BotSoak: Regression in %s"), *Regression);
+		RegressionValues.Add(MakeShared<FJsonValueString>(Regression));
+	}
+	Report->SetArrayField(TEXT("regressions"), RegressionValues);
+	Report->SetStringField(TEXT("baseline"), GetBaselineFile());
+
+	FString ReportText;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ReportText);
+	FJsonSerializer::Serialize(Report, Writer);
+
+	const FString ReportFile = ReportDir / (GetReportName() + TEXT(".json"));
+	if (FFileHelper::SaveStringToFile(ReportText, *ReportFile))
+	{
+		UE_LOG(LogLyra, Display, TEXT("BotSoak: Wrote report to %s"), *FPaths::ConvertRelativePathToFull(ReportFile));
+	}
+	else
+	{
+		UE_LOG(LogLyra, Error, TEXT("BotSoak: Failed to write report to %s"), *ReportFile);
+	}
+
+	if (bWriteBaseline)
+	{
+		const FString Baseline = GetBaselineFile();
+		IFileManager::Get().MakeDirectory(*FPaths::GetPath(Baseline), /*Tree=*/ true);
+		FFileHelper::SaveStringToFile(ReportText, *Baseline);
+		UE_LOG(LogLyra, Display, TEXT("BotSoak: Updated baseline %s"), *Baseline);
+	}
+
+	UE_LOG(LogLyra, Display, TEXT("BotSoak: %s finished with %d regression(s)"), *GetReportName(), Regressions.Num());
+	return bWriteBaseline ? 0 : ExitCode;
+}
+
+void ULyraTestControllerBotSoak::WriteReplicationComparison() const
+{
+	check(ReplicationPassReports.Num() == 2);
+	const TSharedPtr<FJsonObject> GraphMetrics = ReplicationPassReports[0]->GetObjectField(TEXT("metrics"));
+	const TSharedPtr<FJsonObject> NetDriverMetrics = ReplicationPassReports[1]->GetObjectField(TEXT("metrics"));
+
+	// Metric name to both values and their ratio; below 1 means the graph is cheaper. Metrics only one pass has
+	// (e.g., the LyraReplicationGraph CSV scopes) are left out
+	TSharedRef<FJsonObject> SideBySide = MakeShared<FJsonObject>();
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : GraphMetrics->Values)
+	{
+		double GraphValue = 0.0;
+		double NetDriverValue = 0.0;
+		if (!Pair.Value->TryGetNumber(GraphValue) || !NetDriverMetrics->TryGetNumberField(Pair.Key, NetDriverValue))
+		{
+			continue;
+		}
+
+		TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+		Entry->SetNumberField(TEXT("repGraph"), GraphValue);
+		Entry->SetNumberField(TEXT("netDriver"), NetDriverValue);
+		if (NetDriverValue > 0.0)
+		{
+			Entry->SetNumberField(TEXT("ratio"), GraphValue / NetDriverValue);
+		}
+		SideBySide->SetObjectField(Pair.Key, Entry);
+
+		if (Pair.Key.StartsWith(TEXT("net.")) || Pair.Key.StartsWith(TEXT("frameTime.avg")))
+		{
+			UE_LOG(LogLyra, Display, TEXT("BotSoak: %-28s RepGraph %10.3f  NetDriver %10.3f"), *Pair.Key, GraphValue, NetDriverValue);
+		}
+	}
+
+	const FString ComparisonName = GetReportBaseName() + TEXT("_RepGraphVsNetDriver");
+	TSharedRef<FJsonObject> Comparison = MakeShared<FJsonObject>();
+	Comparison->SetStringField(TEXT("name"), ComparisonName);
+	Comparison->SetObjectField(TEXT("metrics"), SideBySide);
+	Comparison->SetObjectField(TEXT("repGraph"), ReplicationPassReports[0]);
+	Comparison->SetObjectField(TEXT("netDriver"), ReplicationPassReports[1]);
+
+	FString ComparisonText;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ComparisonText);
+	FJsonSerializer::Serialize(Comparison, Writer);
+
+	const FString ComparisonFile = ReportDir / (ComparisonName + TEXT(".json"));
+	if (FFileHelper::SaveStringToFile(ComparisonText, *ComparisonFile))
+	{
+		UE_LOG(LogLyra, Display, TEXT("BotSoak: Wrote replication comparison to %s"), *FPaths::ConvertRelativePathToFull(ComparisonFile));
+	}
+	else
+	{
+		UE_LOG(LogLyra, Error, TEXT("BotSoak: Failed to write replication comparison to %s"), *ComparisonFile);
+	}
+}
+
+FString ULyraTestControllerBotSoak::GetReportBaseName() const
+{
+	const FString MapPart = TravelMap.IsEmpty() ? TEXT("CurrentMap") : FPackageName::GetShortName(TravelMap);
+	const FString ExperiencePart = ExperienceName.IsEmpty() ? TEXT("DefaultExperience") : ExperienceName;
+	const FString ClientPart = (DesiredSimulatedClientCount > 0) ? FString::Printf(TEXT("_%dClients"), DesiredSimulatedClientCount) : FString();
+	return FString::Printf(TEXT("BotSoak_%s_%s_%dBots%s"), *MapPart, *ExperiencePart, FMath::Max(DesiredBotCount, 0), *ClientPart);
+}
+
+FString ULyraTestControllerBotSoak::GetReportName() const
+{
+	const FString DriverPart = ReplicationDriverOverride.IsEmpty() ? FString() : (TEXT("_") + ReplicationDriverOverride);
+	return GetReportBaseName() + DriverPart;
+}
+
+FString ULyraTestControllerBotSoak::GetBaselineFile() const
+{
+	return BaselineFile.IsEmpty() ? (FPaths::ProjectDir() / TEXT("Build/Soak") / (GetReportName() + TEXT(".json"))) : BaselineFile;
+}
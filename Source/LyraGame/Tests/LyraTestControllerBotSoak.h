@@ -0,0 +1,163 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GauntletTestController.h"
+#include "Async/Future.h"
+
+#include "LyraTestControllerBotSoak.generated.h"
+
+class APlayerController;
+class FJsonObject;
+class UWorld;
+
+/**
+ * Headless bot soak test.
+ *
+ * Runs a dedicated server with a fixed number of bots on a chosen experience for a fixed duration, samples
+ * frame time, memory, network bytes, net driver flush time and the per-subsystem CSV timing scopes (replication
+ * graph, abilities, weapons, SmoothSync, gameplay messages), then writes a JSON report and compares it against a
+ * stored baseline. The performance stat histograms (see ULyraPerformanceStatSubsystem) for the sampled window are
+ * written next to the report as <ReportName>_PerfStats.csv/.json.
+ *
+ * Bots don't have net connections, so on their own they replicate to nobody and the net numbers say nothing about
+ * replication. -LyraSoak.SimulatedClients=N adds N simulated client connections, which absorb and ack everything sent
+ * to them, each owned by a bare player controller that follows one of the bots around. The server then gathers,
+ * prioritizes and serializes for N viewers without any client processes, and net.flushPerConnectionMS (net driver
+ * flush time divided by the connection count) is the number to compare.
+ *
+ * -LyraSoak.CompareReplication runs the soak twice in one session, first with the replication graph and then with the
+ * default net driver (traveling to the map again in between, since the replication driver is only picked when the net
+ * driver is created). Each pass writes its own report and is compared against its own baseline, and
+ * <ReportName>_RepGraphVsNetDriver.json holds both sets of metrics side by side with the graph / net driver ratio.
+ *
+ * Intended to be run with -nullrhi and no clients, e.g.:
+ *   LyraServer L_Expanse -gauntlet=LyraTestControllerBotSoak -nullrhi -unattended
+ *     -LyraSoak.Experience=B_ShooterGame_Elimination -LyraSoak.Bots=32 -LyraSoak.Duration=300
+ *     -LyraSoak.SimulatedClients=16 -LyraSoak.CompareReplication
+ *
+ * Supported arguments (all optional):
+ *   -LyraSoak.Map=<MapName>             Travel to this map before starting (otherwise the current map is used)
+ *   -LyraSoak.Experience=<ExperienceId> Experience to use when traveling
+ *   -LyraSoak.Bots=<N>                  Number of bots to keep in the match (via ULyraBotCreationComponent)
+ *   -LyraSoak.Warmup=<Seconds>          Time to wait after the experience has loaded before sampling
+ *   -LyraSoak.Duration=<Seconds>        Time to sample for
+ *   -LyraSoak.ReportDir=<Dir>           Where to write the report (defaults to Saved/Soak)
+ *   -LyraSoak.Baseline=<File>           Baseline to compare against (defaults to Build/Soak/<ReportName>.json)
+ *   -LyraSoak.Tolerance=<Fraction>      Allowed regression relative to the baseline (defaults to 0.1)
+ *   -LyraSoak.WriteBaseline             Overwrite the baseline with this run's results
+ *   -LyraSoak.SimulatedClients=<N>      Number of simulated client connections to replicate to
+ *   -LyraSoak.CompareReplication        Run once with the replication graph and once without, and compare the two
+ *   -LyraRepGraph=<0|1>                 Force the replication graph off or on (also appended to the report name)
+ */
+UCLASS()
+class ULyraTestControllerBotSoak : public UGauntletTestController
+{
+	GENERATED_BODY()
+
+protected:
+	//~UGauntletTestController interface
+	virtual void OnInit() override;
+	virtual void OnPostMapChange(UWorld* World) override;
+	virtual void OnTick(float TimeDelta) override;
+	//~End of UGauntletTestController interface
+
+private:
+	enum class ESoakPhase : uint8
+	{
+		WaitingForWorld,
+		Traveling,
+		WaitingForExperience,
+		WarmingUp,
+		Sampling,
+		WaitingForCsv,
+		Finished
+	};
+
+	bool IsExperienceReady(UWorld* World) const;
+	void AdjustBotCount(UWorld* World) const;
+	void AddSimulatedClients(UWorld* World);
+	void UpdateSimulatedClients(UWorld* World);
+
+	void BeginSampling(UWorld* World);
+	void SampleFrame(UWorld* World, float TimeDelta);
+	void EndSampling();
+	void FinishTest();
+	void ResetSamples();
+
+	TSharedRef<FJsonObject> BuildReport() const;
+	void ReadCsvScopes(const FString& CsvFilename);
+	int32 CompareAgainstBaseline(const TSharedRef<FJsonObject>& Report, TArray<FString>& OutRegressions) const;
+	int32 WriteReport(const TSharedRef<FJsonObject>& Report) const;
+	void WriteReplicationComparison() const;
+
+	FString GetReportBaseName() const;
+	FString GetReportName() const;
+	FString GetBaselineFile() const;
+
+	void OnTickFlush(float DeltaSeconds);
+	void OnPostTickFlush();
+
+private:
+	// Configuration
+	FString TravelMap;
+	FString ExperienceName;
+	int32 DesiredBotCount = INDEX_NONE;
+	double WarmupSeconds = 15.0;
+	double DurationSeconds = 120.0;
+	double Tolerance = 0.1;
+	FString ReportDir;
+	FString BaselineFile; // Empty uses Build/Soak/<ReportName>.json
+	bool bWriteBaseline = false;
+	FString ReplicationDriverOverride;
+	int32 DesiredSimulatedClientCount = 0;
+	bool bCompareReplication = false;
+
+	// Progress
+	ESoakPhase Phase = ESoakPhase::WaitingForWorld;
+	double PhaseStartTime = 0.0;
+	double LastMemorySampleTime = 0.0;
+	double LastViewerUpdateTime = 0.0;
+
+	// Set when the next travel has to recreate the net driver, so it picks up the replication driver for this pass
+	bool bTravelForReplicationDriver = false;
+
+	// Reports of the finished passes when comparing, replication graph first
+	TArray<TSharedRef<FJsonObject>> ReplicationPassReports;
+	int32 WorstExitCode = 0;
+
+	// Samples
+	TArray<float> FrameTimesMS;
+	TArray<float> GameThreadTimesMS;
+	uint64 PeakUsedPhysicalBytes = 0;
+	uint64 StartUsedPhysicalBytes = 0;
+	uint64 EndUsedPhysicalBytes = 0;
+	uint64 StartInBytes = 0;
+	uint64 StartOutBytes = 0;
+	uint64 EndInBytes = 0;
+	uint64 EndOutBytes = 0;
+	double SampledSeconds = 0.0;
+	int32 SampledBotCount = 0;
+
+	// Net driver flush (replication) time, measured between the world's TickFlush and PostTickFlush events
+	TArray<float> NetFlushTimesMS;
+	TArray<float> NetFlushTimesPerConnectionMS;
+	double NetFlushStartTime = 0.0;
+	int32 PeakConnectionCount = 0;
+	FString ReplicationDriverName;
+	FDelegateHandle TickFlushHandle;
+	FDelegateHandle PostTickFlushHandle;
+
+	// Owners of the simulated client connections
+	TArray<TWeakObjectPtr<APlayerController>> SimulatedClients;
+
+	// Per-frame CSV stats for the tracked categories (timings in ms, custom stats as counts), keyed by "Category/Stat"
+	struct FScopeTiming
+	{
+		double Average = 0.0;
+		double Max = 0.0;
+	};
+	TMap<FString, FScopeTiming> ScopeTimings;
+
+	TSharedFuture<FString> CsvFilenameFuture;
+};
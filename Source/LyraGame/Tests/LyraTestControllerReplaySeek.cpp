@@ -0,0 +1,301 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Tests/LyraTestControllerReplaySeek.h"
+
+#include "Dom/JsonObject.h"
+#include "Engine/DemoNetDriver.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameModes/LyraExperienceManagerComponent.h"
+#include "HAL/FileManager.h"
+#include "LyraLogChannels.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Replays/LyraReplaySubsystem.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestControllerReplaySeek)
+
+namespace LyraReplaySeekTest
+{
+	// Give up on a phase that should have finished long ago (loading, or a seek that never completes)
+	static const double PhaseTimeoutSeconds = 300.0;
+
+	// The replay index and the seek code assume local files
+	static const TCHAR* StreamerOverride = TEXT("ReplayStreamerOverride=LocalFileNetworkReplayStreaming");
+
+	static double Percentile(const TArray<double>& SortedValues, double Fraction)
+	{
+		if (SortedValues.Num() == 0)
+		{
+			return 0.0;
+		}
+
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(Fraction * SortedValues.Num()) - 1, 0, SortedValues.Num() - 1);
+		return SortedValues[Index];
+	}
+}
+
+void ULyraTestControllerReplaySeek::OnInit()
+{
+	Super::OnInit();
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	FParse::Value(CommandLine, TEXT("LyraReplaySeek.Map="), TravelMap);
+	FParse::Value(CommandLine, TEXT("LyraReplaySeek.Experience="), ExperienceName);
+	FParse::Value(CommandLine, TEXT("LyraReplaySeek.Bots="), BotCount);
+	FParse::Value(CommandLine, TEXT("LyraReplaySeek.RecordSeconds="), RecordSeconds);
+	FParse::Value(CommandLine, TEXT("LyraReplaySeek.Seeks="), NumSeeks);
+	FParse::Value(CommandLine, TEXT("LyraReplaySeek.MaxP95MS="), MaxP95MS);
+	NumSeeks = FMath::Max(NumSeeks, 1);
+
+	if (!FParse::Value(CommandLine, TEXT("LyraReplaySeek.ReportDir="), ReportDir))
+	{
+		ReportDir = FPaths::ProjectSavedDir() / TEXT("ReplaySeek");
+	}
+
+	ReplayName = FString::Printf(TEXT("LyraReplaySeekTest_%s"), *FDateTime::UtcNow().ToString());
+
+	UE_LOG(LogLyra, Display, TEXT("ReplaySeek: Map=%s Experience=%s Bots=%d Record=%.1fs Seeks=%d"),
+		TravelMap.IsEmpty() ? TEXT("<current>") : *TravelMap,
+		ExperienceName.IsEmpty() ? TEXT("<default>") : *ExperienceName,
+		BotCount, RecordSeconds, NumSeeks);
+
+	SetPhase(ESeekTestPhase::WaitingForWorld);
+}
+
+void ULyraTestControllerReplaySeek::OnPostMapChange(UWorld* World)
+{
+	Super::OnPostMapChange(World);
+
+	if ((Phase == ESeekTestPhase::Traveling) || (Phase == ESeekTestPhase::WaitingForWorld))
+	{
+		SetPhase(ESeekTestPhase::WaitingForExperience);
+	}
+}
+
+void ULyraTestControllerReplaySeek::OnTick(float TimeDelta)
+{
+	Super::OnTick(TimeDelta);
+
+	UWorld* World = GetWorld();
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	ULyraReplaySubsystem* ReplaySubsystem = GameInstance ? GameInstance->GetSubsystem<ULyraReplaySubsystem>() : nullptr;
+	const double Now = FPlatformTime::Seconds();
+
+	if ((Phase != ESeekTestPhase::Finished) && (Phase != ESeekTestPhase::Recording) && ((Now - PhaseStartTime) > LyraReplaySeekTest::PhaseTimeoutSeconds))
+	{
+		FinishTest(FString::Printf(TEXT("Timed out in phase %d"), (int32)Phase));
+		return;
+	}
+
+	if (((Phase == ESeekTestPhase::Recording) && !GameInstance) ||
+		(((Phase == ESeekTestPhase::MeasuringFullSeeks) || (Phase == ESeekTestPhase::MeasuringPreviewSeeks)) && !ReplaySubsystem))
+	{
+		FinishTest(TEXT("Lost the game instance"));
+		return;
+	}
+
+	switch (Phase)
+	{
+	case ESeekTestPhase::WaitingForWorld:
+		if ((World != nullptr) && (World->GetGameState() != nullptr))
+		{
+			if (!TravelMap.IsEmpty() && (FPackageName::GetShortName(World->GetMapName()) != FPackageName::GetShortName(TravelMap)))
+			{
+				FString TravelURL = TravelMap;
+				if (!ExperienceName.IsEmpty())
+				{
+					TravelURL += FString::Printf(TEXT("?Experience=%s"), *ExperienceName);
+				}
+				TravelURL += FString::Printf(TEXT("?NumBots=%d"), BotCount);
+
+				UE_LOG(LogLyra, Display, TEXT("ReplaySeek: Traveling to %s"), *TravelURL);
+				SetPhase(ESeekTestPhase::Traveling);
+				World->ServerTravel(TravelURL, /*bAbsolute=*/ true);
+			}
+			else
+			{
+				SetPhase(ESeekTestPhase::WaitingForExperience);
+			}
+		}
+		break;
+
+	case ESeekTestPhase::Traveling:
+		// OnPostMapChange moves us on
+		break;
+
+	case ESeekTestPhase::WaitingForExperience:
+		if (IsExperienceReady(World) && GameInstance)
+		{
+			UE_LOG(LogLyra, Display, TEXT("ReplaySeek: Recording %s for %.1fs"), *ReplayName, RecordSeconds);
+			GameInstance->StartRecordingReplay(ReplayName, ReplayName, { LyraReplaySeekTest::StreamerOverride });
+			SetPhase(ESeekTestPhase::Recording);
+		}
+		break;
+
+	case ESeekTestPhase::Recording:
+		if ((Now - PhaseStartTime) >= RecordSeconds)
+		{
+			GameInstance->StopRecordingReplay();
+
+			UE_LOG(LogLyra, Display, TEXT("ReplaySeek: Playing back %s"), *ReplayName);
+			if (!GameInstance->PlayReplay(ReplayName, nullptr, { LyraReplaySeekTest::StreamerOverride }))
+			{
+				FinishTest(FString::Printf(TEXT("Could not play back %s"), *ReplayName));
+				return;
+			}
+			SetPhase(ESeekTestPhase::WaitingForPlayback);
+		}
+		break;
+
+	case ESeekTestPhase::WaitingForPlayback:
+		if (IsReplayPlaying(World) && ReplaySubsystem)
+		{
+			ReplayLengthSeconds = ReplaySubsystem->GetReplayLengthInSeconds();
+			NumCheckpoints = ReplaySubsystem->GetActiveReplayCheckpointTimes().Num();
+
+			UE_LOG(LogLyra, Display, TEXT("ReplaySeek: Replay is %.1fs long with %d indexed checkpoints, timing %d full seeks"), ReplayLengthSeconds, NumCheckpoints, NumSeeks);
+#if UE_BUILD_SHIPPING
+			FinishTest(TEXT("Seek measurement isn't compiled into shipping builds"));
+			return;
+#else
+			if (!ReplaySubsystem->StartSeekLatencyMeasurement(NumSeeks, /*bPreviewSeeks=*/ false))
+			{
+				FinishTest(TEXT("Could not start the full seek measurement"));
+				return;
+			}
+			SetPhase(ESeekTestPhase::MeasuringFullSeeks);
+#endif
+		}
+		break;
+
+#if !UE_BUILD_SHIPPING
+	case ESeekTestPhase::MeasuringFullSeeks:
+		if (!ReplaySubsystem->IsMeasuringSeekLatency())
+		{
+			FullSeekLatenciesMS = ReplaySubsystem->GetMeasuredSeekLatenciesMS();
+
+			UE_LOG(LogLyra, Display, TEXT("ReplaySeek: Timing %d preview seeks"), NumSeeks);
+			if (!ReplaySubsystem->StartSeekLatencyMeasurement(NumSeeks, /*bPreviewSeeks=*/ true))
+			{
+				FinishTest(TEXT("Could not start the preview seek measurement"));
+				return;
+			}
+			SetPhase(ESeekTestPhase::MeasuringPreviewSeeks);
+		}
+		break;
+
+	case ESeekTestPhase::MeasuringPreviewSeeks:
+		if (!ReplaySubsystem->IsMeasuringSeekLatency())
+		{
+			PreviewSeekLatenciesMS = ReplaySubsystem->GetMeasuredSeekLatenciesMS();
+			FinishTest(FString());
+		}
+		break;
+#endif
+
+	default:
+		break;
+	}
+}
+
+bool ULyraTestControllerReplaySeek::IsExperienceReady(UWorld* World) const
+{
+	if (AGameStateBase* GameState = World ? World->GetGameState() : nullptr)
+	{
+		if (const ULyraExperienceManagerComponent* ExperienceComponent = GameState->FindComponentByClass<ULyraExperienceManagerComponent>())
+		{
+			return ExperienceComponent->IsExperienceLoaded();
+		}
+	}
+	return false;
+}
+
+bool ULyraTestControllerReplaySeek::IsReplayPlaying(UWorld* World) const
+{
+	// Wait for the experience too, so the first seek isn't timing the map load
+	UDemoNetDriver* DemoDriver = World ? World->GetDemoNetDriver() : nullptr;
+	return DemoDriver && DemoDriver->IsPlaying() && !DemoDriver->IsFastForwarding() && (DemoDriver->GetDemoTotalTime() > 0.0f) && IsExperienceReady(World);
+}
+
+void ULyraTestControllerReplaySeek::SetPhase(ESeekTestPhase NewPhase)
+{
+	Phase = NewPhase;
+	PhaseStartTime = FPlatformTime::Seconds();
+}
+
+void ULyraTestControllerReplaySeek::AddLatencyStats(const TSharedRef<FJsonObject>& Report, const TCHAR* FieldName, const TArray<double>& LatenciesMS) const
+{
+	TArray<double> SortedLatenciesMS = LatenciesMS;
+	SortedLatenciesMS.Sort();
+
+	double TotalMS = 0.0;
+	for (double LatencyMS : SortedLatenciesMS)
+	{
+		TotalMS += LatencyMS;
+	}
+
+	TSharedRef<FJsonObject> Stats = MakeShared<FJsonObject>();
+	Stats->SetNumberField(TEXT("count"), SortedLatenciesMS.Num());
+	Stats->SetNumberField(TEXT("avgMS"), (SortedLatenciesMS.Num() > 0) ? (TotalMS / SortedLatenciesMS.Num()) : 0.0);
+	Stats->SetNumberField(TEXT("p50MS"), LyraReplaySeekTest::Percentile(SortedLatenciesMS, 0.5));
+	Stats->SetNumberField(TEXT("p95MS"), LyraReplaySeekTest::Percentile(SortedLatenciesMS, 0.95));
+	Stats->SetNumberField(TEXT("maxMS"), (SortedLatenciesMS.Num() > 0) ? SortedLatenciesMS.Last() : 0.0);
+	Report->SetObjectField(FieldName, Stats);
+}
+
+void ULyraTestControllerReplaySeek::FinishTest(const FString& Error)
+{
+	SetPhase(ESeekTestPhase::Finished);
+
+	FString FailureReason = Error;
+	if (FailureReason.IsEmpty() && (MaxP95MS > 0.0))
+	{
+		TArray<double> SortedLatenciesMS = FullSeekLatenciesMS;
+		SortedLatenciesMS.Sort();
+		const double P95MS = LyraReplaySeekTest::Percentile(SortedLatenciesMS, 0.95);
+		if (P95MS > MaxP95MS)
+		{
+			FailureReason = FString::Printf(TEXT("Full seek p95 of %.1fms is over the %.1fms limit"), P95MS, MaxP95MS);
+		}
+	}
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("replay"), ReplayName);
+	Report->SetNumberField(TEXT("lengthSeconds"), ReplayLengthSeconds);
+	Report->SetNumberField(TEXT("indexedCheckpoints"), NumCheckpoints);
+	AddLatencyStats(Report, TEXT("fullSeeks"), FullSeekLatenciesMS);
+	AddLatencyStats(Report, TEXT("previewSeeks"), PreviewSeekLatenciesMS);
+	Report->SetStringField(TEXT("error"), FailureReason);
+
+	FString ReportText;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ReportText);
+	FJsonSerializer::Serialize(Report, Writer);
+
+	IFileManager::Get().MakeDirectory(*ReportDir, /*Tree=*/ true);
+	const FString ReportFile = ReportDir / TEXT("ReplaySeek.json");
+	if (FFileHelper::SaveStringToFile(ReportText, *ReportFile))
+	{
+		UE_LOG(LogLyra, Display, TEXT("ReplaySeek: Wrote report to %s"), *FPaths::ConvertRelativePathToFull(ReportFile));
+	}
+	else
+	{
+		UE_LOG(LogLyra, Error, TEXT("ReplaySeek: Failed to write report to %s"), *ReportFile);
+	}
+
+	if (!FailureReason.IsEmpty())
+	{
+		UE_LOG(LogLyra, Error, TEXT("ReplaySeek: %s"), *FailureReason);
+		EndTest(1);
+		return;
+	}
+
+	UE_LOG(LogLyra, Display, TEXT("ReplaySeek: Finished"));
+	EndTest(0);
+}
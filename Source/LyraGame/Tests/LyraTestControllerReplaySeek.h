@@ -0,0 +1,85 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GauntletTestController.h"
+
+#include "LyraTestControllerReplaySeek.generated.h"
+
+class FJsonObject;
+class UWorld;
+
+/**
+ * Headless replay seek test.
+ *
+ * Records a replay of a bot match to the local file streamer, plays it back and times a number of full seeks and
+ * checkpoint-only scrub preview seeks to random times (see ULyraReplaySubsystem::StartSeekLatencyMeasurement), then
+ * writes the latency percentiles to a JSON report. Fails if the recording or playback doesn't work, or if the p95 of
+ * the full seeks is over the optional limit.
+ *
+ * Intended to be run as a standalone game with -nullrhi, e.g.:
+ *   LyraGame L_Expanse -gauntlet=LyraTestControllerReplaySeek -nullrhi -unattended -game
+ *     -LyraReplaySeek.Experience=B_ShooterGame_Elimination -LyraReplaySeek.Bots=8 -LyraReplaySeek.RecordSeconds=120
+ *
+ * Supported arguments (all optional):
+ *   -LyraReplaySeek.Map=<MapName>             Travel to this map before recording (otherwise the current map is used)
+ *   -LyraReplaySeek.Experience=<ExperienceId> Experience to use when traveling
+ *   -LyraReplaySeek.Bots=<N>                  Number of bots in the recorded match
+ *   -LyraReplaySeek.RecordSeconds=<Seconds>   How long to record for, needs to be several times demo.CheckpointUploadDelayInSeconds
+ *   -LyraReplaySeek.Seeks=<N>                 Number of seeks of each kind to time
+ *   -LyraReplaySeek.MaxP95MS=<MS>             Fail if the p95 of the full seeks is over this
+ *   -LyraReplaySeek.ReportDir=<Dir>           Where to write the report (defaults to Saved/ReplaySeek)
+ */
+UCLASS()
+class ULyraTestControllerReplaySeek : public UGauntletTestController
+{
+	GENERATED_BODY()
+
+protected:
+	//~UGauntletTestController interface
+	virtual void OnInit() override;
+	virtual void OnPostMapChange(UWorld* World) override;
+	virtual void OnTick(float TimeDelta) override;
+	//~End of UGauntletTestController interface
+
+private:
+	enum class ESeekTestPhase : uint8
+	{
+		WaitingForWorld,
+		Traveling,
+		WaitingForExperience,
+		Recording,
+		WaitingForPlayback,
+		MeasuringFullSeeks,
+		MeasuringPreviewSeeks,
+		Finished
+	};
+
+	bool IsExperienceReady(UWorld* World) const;
+	bool IsReplayPlaying(UWorld* World) const;
+	void SetPhase(ESeekTestPhase NewPhase);
+	void FinishTest(const FString& Error);
+
+	void AddLatencyStats(const TSharedRef<FJsonObject>& Report, const TCHAR* FieldName, const TArray<double>& LatenciesMS) const;
+
+private:
+	// Configuration
+	FString TravelMap;
+	FString ExperienceName;
+	int32 BotCount = 8;
+	double RecordSeconds = 120.0;
+	int32 NumSeeks = 20;
+	double MaxP95MS = 0.0;
+	FString ReportDir;
+	FString ReplayName;
+
+	// Progress
+	ESeekTestPhase Phase = ESeekTestPhase::WaitingForWorld;
+	double PhaseStartTime = 0.0;
+
+	// Results
+	TArray<double> FullSeekLatenciesMS;
+	TArray<double> PreviewSeekLatenciesMS;
+	int32 NumCheckpoints = 0;
+	float ReplayLengthSeconds = 0.0f;
+};
@@ -0,0 +1,611 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Tests/LyraTestControllerWeaponSpawnerBench.h"
+
+#include "Dom/JsonObject.h"
+#include "Engine/NetDriver.h"
+#include "Engine/SimulatedClientNetConnection.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
+#include "GameModes/LyraExperienceManagerComponent.h"
+#include "HAL/FileManager.h"
+#include "LyraLogChannels.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Net/NetworkObjectList.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Weapons/LyraWeaponSpawner.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestControllerWeaponSpawnerBench)
+
+namespace LyraWeaponSpawnerBench
+{
+	// Spawners and their components are counted this often rather than every frame, so iterating them doesn't show
+	// up in the game thread time being measured
+	static const double CountSampleInterval = 1.0;
+
+	// Spacing of the spawner grid, far enough apart that a pawn only ever overlaps one
+	static const double GridSpacing = 400.0;
+
+	static double Average(const TArray<float>& Values)
+	{
+		double Sum = 0.0;
+		for (float Value : Values)
+		{
+			Sum += Value;
+		}
+		return (Values.Num() > 0) ? (Sum / Values.Num()) : 0.0;
+	}
+
+	static double Percentile(TArray<float> Values, double Fraction)
+	{
+		if (Values.Num() == 0)
+		{
+			return 0.0;
+		}
+
+		Values.Sort();
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(Fraction * Values.Num()) - 1, 0, Values.Num() - 1);
+		return Values[Index];
+	}
+}
+
+TSharedRef<FJsonObject> ULyraTestControllerWeaponSpawnerBench::FPhaseSamples::ToJson() const
+{
+	const double NumCounts = FMath::Max(NumCountSamples, 1);
+
+	TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+	Json->SetNumberField(TEXT("frames"), GameThreadTimesMS.Num());
+	Json->SetNumberField(TEXT("gameThread.avgMS"), LyraWeaponSpawnerBench::Average(GameThreadTimesMS));
+	Json->SetNumberField(TEXT("gameThread.p95MS"), LyraWeaponSpawnerBench::Percentile(GameThreadTimesMS, 0.95));
+	Json->SetNumberField(TEXT("net.flushAvgMS"), LyraWeaponSpawnerBench::Average(NetFlushTimesMS));
+	Json->SetNumberField(TEXT("net.flushP95MS"), LyraWeaponSpawnerBench::Percentile(NetFlushTimesMS, 0.95));
+	Json->SetNumberField(TEXT("net.peakConnections"), PeakConnectionCount);
+	Json->SetNumberField(TEXT("tickingSpawners"), TickingSpawners / NumCounts);
+	Json->SetNumberField(TEXT("tickingComponents"), TickingComponents / NumCounts);
+	Json->SetNumberField(TEXT("awakeSpawners"), AwakeSpawners / NumCounts);
+	Json->SetNumberField(TEXT("activeNetObjects"), ActiveNetObjects / NumCounts);
+	return Json;
+}
+
+void ULyraTestControllerWeaponSpawnerBench::OnInit()
+{
+	Super::OnInit();
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	FParse::Value(CommandLine, TEXT("LyraSpawnerBench.Map="), TravelMap);
+	FParse::Value(CommandLine, TEXT("LyraSpawnerBench.Experience="), ExperienceName);
+	FParse::Value(CommandLine, TEXT("LyraSpawnerBench.SpawnerClass="), SpawnerClassPath);
+	FParse::Value(CommandLine, TEXT("LyraSpawnerBench.Spawners="), NumSpawners);
+	FParse::Value(CommandLine, TEXT("LyraSpawnerBench.Warmup="), WarmupSeconds);
+	FParse::Value(CommandLine, TEXT("LyraSpawnerBench.Duration="), DurationSeconds);
+	FParse::Value(CommandLine, TEXT("LyraSpawnerBench.SimulatedClients="), DesiredSimulatedClientCount);
+	FParse::Value(CommandLine, TEXT("LyraSpawnerBench.ViewerDistance="), ViewerDistance);
+	FParse::Value(CommandLine, TEXT("LyraSpawnerBench.Tolerance="), Tolerance);
+	bWriteBaseline = FParse::Param(CommandLine, TEXT("LyraSpawnerBench.WriteBaseline"));
+	NumSpawners = FMath::Max(NumSpawners, 1);
+
+	if (!FParse::Value(CommandLine, TEXT("LyraSpawnerBench.ReportDir="), ReportDir))
+	{
+		ReportDir = FPaths::ProjectSavedDir() / TEXT("Soak");
+	}
+
+	FParse::Value(CommandLine, TEXT("LyraSpawnerBench.Baseline="), BaselineFile);
+
+	UE_LOG(LogLyra, Display, TEXT("WeaponSpawnerBench: Map=%s Experience=%s Spawners=%d SimulatedClients=%d ViewerDistance=%.0f Warmup=%.1fs Duration=%.1fs Baseline=%s"),
+		TravelMap.IsEmpty() ? TEXT("<current>") : *TravelMap,
+		ExperienceName.IsEmpty() ? TEXT("<default>") : *ExperienceName,
+		NumSpawners, DesiredSimulatedClientCount, ViewerDistance, WarmupSeconds, DurationSeconds, *GetBaselineFile());
+
+	SetPhase(EBenchPhase::WaitingForWorld);
+}
+
+void ULyraTestControllerWeaponSpawnerBench::OnPostMapChange(UWorld* World)
+{
+	Super::OnPostMapChange(World);
+
+	if ((Phase == EBenchPhase::Traveling) || (Phase == EBenchPhase::WaitingForWorld))
+	{
+		SetPhase(EBenchPhase::WaitingForExperience);
+	}
+}
+
+void ULyraTestControllerWeaponSpawnerBench::OnTick(float TimeDelta)
+{
+	Super::OnTick(TimeDelta);
+
+	UWorld* World = GetWorld();
+	const double Now = FPlatformTime::Seconds();
+
+	switch (Phase)
+	{
+	case EBenchPhase::WaitingForWorld:
+		if ((World != nullptr) && (World->GetGameState() != nullptr))
+		{
+			if (!TravelMap.IsEmpty() && (FPackageName::GetShortName(World->GetMapName()) != FPackageName::GetShortName(TravelMap)))
+			{
+				FString TravelURL = TravelMap;
+				if (!ExperienceName.IsEmpty())
+				{
+					TravelURL += FString::Printf(TEXT("?Experience=%s"), *ExperienceName);
+				}
+
+				UE_LOG(LogLyra, Display, TEXT("WeaponSpawnerBench: Traveling to %s"), *TravelURL);
+				SetPhase(EBenchPhase::Traveling);
+				World->ServerTravel(TravelURL, /*bAbsolute=*/ true);
+			}
+			else
+			{
+				SetPhase(EBenchPhase::WaitingForExperience);
+			}
+		}
+		break;
+
+	case EBenchPhase::Traveling:
+		// OnPostMapChange moves us on
+		break;
+
+	case EBenchPhase::WaitingForExperience:
+		if (IsExperienceReady(World))
+		{
+			if (World->GetNetMode() == NM_Client)
+			{
+				FinishTest(TEXT("The benchmark has to run on the server"));
+				return;
+			}
+
+			if (ALyraWeaponSpawner* Template = FindTemplateSpawner(World))
+			{
+				GridCenter = Template->GetActorLocation();
+			}
+			else if (SpawnerClassPath.IsEmpty())
+			{
+				FinishTest(TEXT("No weapon spawner in the map to copy, pass -LyraSpawnerBench.SpawnerClass=<ClassPath>"));
+				return;
+			}
+
+			UE_LOG(LogLyra, Display, TEXT("WeaponSpawnerBench: Experience loaded, warming up for %.1fs"), WarmupSeconds);
+			AddSimulatedClients(World);
+			SetPhase(EBenchPhase::WarmingUp);
+		}
+		break;
+
+	case EBenchPhase::WarmingUp:
+		UpdateSimulatedClients(World);
+		if ((Now - PhaseStartTime) >= WarmupSeconds)
+		{
+			UE_LOG(LogLyra, Display, TEXT("WeaponSpawnerBench: Sampling the baseline for %.1fs"), DurationSeconds);
+			StartTimingNetFlush(World);
+			SetPhase(EBenchPhase::SamplingBaseline);
+		}
+		break;
+
+	case EBenchPhase::SamplingBaseline:
+		UpdateSimulatedClients(World);
+		SampleFrame(World);
+		if ((Now - PhaseStartTime) >= DurationSeconds)
+		{
+			SpawnSpawners(World);
+			if (SpawnedSpawners.IsEmpty())
+			{
+				FinishTest(TEXT("Could not spawn any weapon spawners"));
+				return;
+			}
+
+			// Let the new spawners replicate to everyone and go dormant before sampling them
+			UE_LOG(LogLyra, Display, TEXT("WeaponSpawnerBench: Spawned %d %s, settling for %.1fs"), SpawnedSpawners.Num(), *SpawnedClassName, WarmupSeconds);
+			SetPhase(EBenchPhase::SettlingSpawners);
+		}
+		break;
+
+	case EBenchPhase::SettlingSpawners:
+		UpdateSimulatedClients(World);
+		if ((Now - PhaseStartTime) >= WarmupSeconds)
+		{
+			UE_LOG(LogLyra, Display, TEXT("WeaponSpawnerBench: Sampling the spawners for %.1fs"), DurationSeconds);
+			SetPhase(EBenchPhase::SamplingSpawners);
+		}
+		break;
+
+	case EBenchPhase::SamplingSpawners:
+		UpdateSimulatedClients(World);
+		SampleFrame(World);
+		if ((Now - PhaseStartTime) >= DurationSeconds)
+		{
+			FinishTest(FString());
+		}
+		break;
+
+	case EBenchPhase::Finished:
+		break;
+	}
+}
+
+bool ULyraTestControllerWeaponSpawnerBench::IsExperienceReady(UWorld* World) const
+{
+	if (AGameStateBase* GameState = World ? World->GetGameState() : nullptr)
+	{
+		if (const ULyraExperienceManagerComponent* ExperienceComponent = GameState->FindComponentByClass<ULyraExperienceManagerComponent>())
+		{
+			return ExperienceComponent->IsExperienceLoaded();
+		}
+	}
+	return false;
+}
+
+void ULyraTestControllerWeaponSpawnerBench::SetPhase(EBenchPhase NewPhase)
+{
+	Phase = NewPhase;
+	PhaseStartTime = FPlatformTime::Seconds();
+	LastCountSampleTime = 0.0;
+}
+
+void ULyraTestControllerWeaponSpawnerBench::FinishTest(const FString& Error)
+{
+	StopTimingNetFlush();
+	DestroySpawners();
+	Phase = EBenchPhase::Finished;
+
+	if (!Error.IsEmpty())
+	{
+		UE_LOG(LogLyra, Error, TEXT("WeaponSpawnerBench: %s"), *Error);
+		EndTest(1);
+		return;
+	}
+
+	const int32 ExitCode = WriteReport(BuildReport());
+	UE_LOG(LogLyra, Display, TEXT("WeaponSpawnerBench: Finished%s"), (ExitCode != 0) ? TEXT(" with regressions") : TEXT(""));
+	EndTest(ExitCode);
+}
+
+void ULyraTestControllerWeaponSpawnerBench::AddSimulatedClients(UWorld* World)
+{
+	if (DesiredSimulatedClientCount <= 0)
+	{
+		UE_LOG(LogLyra, Warning, TEXT("WeaponSpawnerBench: No simulated clients, the net flush times won't include any replication (pass -LyraSpawnerBench.SimulatedClients=N)"));
+		return;
+	}
+
+	UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+	if ((NetDriver == nullptr) || !NetDriver->IsServer())
+	{
+		UE_LOG(LogLyra, Warning, TEXT("WeaponSpawnerBench: No server net driver to add %d simulated client(s) to, is this running as a server?"), DesiredSimulatedClientCount);
+		return;
+	}
+
+	for (int32 Index = 0; Index < DesiredSimulatedClientCount; ++Index)
+	{
+		// Absorbs and acks everything it's sent, so the server replicates to it as it would to a client that keeps up
+		USimulatedClientNetConnection* Connection = NewObject<USimulatedClientNetConnection>(GetTransientPackage());
+		Connection->InitConnection(NetDriver, USOCK_Open, World->URL, 1000000);
+		Connection->InitSendBuffer();
+		NetDriver->AddClientConnection(Connection);
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		APlayerController* PlayerController = World->SpawnActor<APlayerController>(SpawnParams);
+		PlayerController->SetReplicates(true);
+		PlayerController->SetAutonomousProxy(true);
+		PlayerController->SetPlayer(Connection);
+		Connection->OwningActor = PlayerController;
+
+		SimulatedClients.Add(PlayerController);
+	}
+
+	UE_LOG(LogLyra, Display, TEXT("WeaponSpawnerBench: Added %d simulated client(s) to %s"), SimulatedClients.Num(), *NetDriver->GetName());
+}
+
+void ULyraTestControllerWeaponSpawnerBench::UpdateSimulatedClients(UWorld* World)
+{
+	UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+	if (SimulatedClients.IsEmpty() || (NetDriver == nullptr))
+	{
+		return;
+	}
+
+	// Simulated clients never send anything, keep the net driver from treating them as gone. They all watch the
+	// spawner grid from the same spot, so relevancy is the same in both phases
+	const FVector ViewLocation = GridCenter + FVector(ViewerDistance, 0.0, 0.0);
+	for (const TWeakObjectPtr<APlayerController>& SimulatedClient : SimulatedClients)
+	{
+		if (APlayerController* PlayerController = SimulatedClient.Get())
+		{
+			if (UNetConnection* Connection = PlayerController->GetNetConnection())
+			{
+				Connection->LastReceiveTime = NetDriver->GetElapsedTime();
+				Connection->LastReceiveRealtime = FPlatformTime::Seconds();
+			}
+			PlayerController->SetActorLocation(ViewLocation);
+		}
+	}
+}
+
+ALyraWeaponSpawner* ULyraTestControllerWeaponSpawnerBench::FindTemplateSpawner(UWorld* World) const
+{
+	TActorIterator<ALyraWeaponSpawner> It(World);
+	return It ? *It : nullptr;
+}
+
+void ULyraTestControllerWeaponSpawnerBench::SpawnSpawners(UWorld* World)
+{
+	ALyraWeaponSpawner* Template = FindTemplateSpawner(World);
+
+	UClass* SpawnerClass = nullptr;
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	if (!SpawnerClassPath.IsEmpty())
+	{
+		SpawnerClass = LoadClass<ALyraWeaponSpawner>(nullptr, *SpawnerClassPath);
+		UE_CLOG(SpawnerClass == nullptr, LogLyra, Error, TEXT("WeaponSpawnerBench: Could not load spawner class %s"), *SpawnerClassPath);
+	}
+	else if (Template != nullptr)
+	{
+		// Copies keep the weapon definition and anything else set on the placed spawner
+		SpawnerClass = Template->GetClass();
+		SpawnParams.Template = Template;
+	}
+
+	if ((World == nullptr) || (SpawnerClass == nullptr))
+	{
+		return;
+	}
+
+	SpawnedClassName = SpawnerClass->GetName();
+
+	// Lay them out in a grid next to the template so overlaps only happen if a player walks over
+	const FRotator Rotation = Template ? Template->GetActorRotation() : FRotator::ZeroRotator;
+	const int32 GridSize = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt((float)NumSpawners)));
+	for (int32 Index = 0; Index < NumSpawners; ++Index)
+	{
+		const FVector Offset((Index % GridSize + 1) * LyraWeaponSpawnerBench::GridSpacing, (Index / GridSize) * LyraWeaponSpawnerBench::GridSpacing, 0.0);
+		if (ALyraWeaponSpawner* Spawner = World->SpawnActor<ALyraWeaponSpawner>(SpawnerClass, FTransform(Rotation, GridCenter + Offset), SpawnParams))
+		{
+			SpawnedSpawners.Add(Spawner);
+		}
+	}
+
+	// Viewers look at the middle of the grid from now on
+	GridCenter += FVector((GridSize + 1) * 0.5 * LyraWeaponSpawnerBench::GridSpacing, (GridSize - 1) * 0.5 * LyraWeaponSpawnerBench::GridSpacing, 0.0);
+}
+
+void ULyraTestControllerWeaponSpawnerBench::DestroySpawners()
+{
+	for (const TWeakObjectPtr<ALyraWeaponSpawner>& Spawner : SpawnedSpawners)
+	{
+		if (Spawner.IsValid())
+		{
+			Spawner->Destroy();
+		}
+	}
+	SpawnedSpawners.Reset();
+}
+
+void ULyraTestControllerWeaponSpawnerBench::StartTimingNetFlush(UWorld* World)
+{
+	// The net driver registered its flush when the world was set up and multicast delegates broadcast newest first,
+	// so these bracket the net driver's TickFlush
+	if (World)
+	{
+		TickFlushHandle = World->OnTickFlush().AddUObject(this, &ThisClass::OnTickFlush);
+		PostTickFlushHandle = World->OnPostTickFlush().AddUObject(this, &ThisClass::OnPostTickFlush);
+	}
+}
+
+void ULyraTestControllerWeaponSpawnerBench::StopTimingNetFlush()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->OnTickFlush().Remove(TickFlushHandle);
+		World->OnPostTickFlush().Remove(PostTickFlushHandle);
+	}
+	TickFlushHandle.Reset();
+	PostTickFlushHandle.Reset();
+}
+
+void ULyraTestControllerWeaponSpawnerBench::OnTickFlush(float DeltaSeconds)
+{
+	NetFlushStartTime = FPlatformTime::Seconds();
+}
+
+void ULyraTestControllerWeaponSpawnerBench::OnPostTickFlush()
+{
+	const bool bSampling = (Phase == EBenchPhase::SamplingBaseline) || (Phase == EBenchPhase::SamplingSpawners);
+	if ((NetFlushStartTime <= 0.0) || !bSampling)
+	{
+		NetFlushStartTime = 0.0;
+		return;
+	}
+
+	FPhaseSamples& Samples = GetCurrentSamples();
+	Samples.NetFlushTimesMS.Add(static_cast<float>((FPlatformTime::Seconds() - NetFlushStartTime) * 1000.0));
+	NetFlushStartTime = 0.0;
+
+	const UWorld* World = GetWorld();
+	const UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+	Samples.PeakConnectionCount = FMath::Max(Samples.PeakConnectionCount, NetDriver ? NetDriver->ClientConnections.Num() : 0);
+}
+
+ULyraTestControllerWeaponSpawnerBench::FPhaseSamples& ULyraTestControllerWeaponSpawnerBench::GetCurrentSamples()
+{
+	return (Phase == EBenchPhase::SamplingSpawners) ? SpawnerSamples : BaselineSamples;
+}
+
+void ULyraTestControllerWeaponSpawnerBench::SampleFrame(UWorld* World)
+{
+	FPhaseSamples& Samples = GetCurrentSamples();
+	Samples.GameThreadTimesMS.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+
+	const double Now = FPlatformTime::Seconds();
+	if ((World == nullptr) || ((Now - LastCountSampleTime) < LyraWeaponSpawnerBench::CountSampleInterval))
+	{
+		return;
+	}
+	LastCountSampleTime = Now;
+
+	++Samples.NumCountSamples;
+	for (TActorIterator<ALyraWeaponSpawner> It(World); It; ++It)
+	{
+		ALyraWeaponSpawner* Spawner = *It;
+		Samples.TickingSpawners += Spawner->IsActorTickEnabled() ? 1 : 0;
+		Samples.AwakeSpawners += (Spawner->NetDormancy <= DORM_Awake) ? 1 : 0;
+
+		for (UActorComponent* Component : Spawner->GetComponents())
+		{
+			Samples.TickingComponents += (Component && Component->IsRegistered() && Component->IsComponentTickEnabled()) ? 1 : 0;
+		}
+	}
+
+	if (UNetDriver* NetDriver = World->GetNetDriver())
+	{
+		Samples.ActiveNetObjects += NetDriver->GetNetworkObjectList().GetActiveObjects().Num();
+	}
+}
+
+TSharedRef<FJsonObject> ULyraTestControllerWeaponSpawnerBench::BuildReport() const
+{
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("name"), GetReportName());
+	Report->SetStringField(TEXT("map"), GetWorld() ? FPackageName::GetShortName(GetWorld()->GetMapName()) : FString());
+	Report->SetStringField(TEXT("experience"), ExperienceName);
+	Report->SetStringField(TEXT("spawnerClass"), SpawnedClassName);
+	Report->SetNumberField(TEXT("spawners"), NumSpawners);
+	Report->SetNumberField(TEXT("simulatedClients"), SimulatedClients.Num());
+	Report->SetNumberField(TEXT("viewerDistance"), ViewerDistance);
+	Report->SetNumberField(TEXT("durationSeconds"), DurationSeconds);
+
+	const TSharedRef<FJsonObject> Baseline = BaselineSamples.ToJson();
+	const TSharedRef<FJsonObject> WithSpawners = SpawnerSamples.ToJson();
+
+	TSharedRef<FJsonObject> Phases = MakeShared<FJsonObject>();
+	Phases->SetObjectField(TEXT("baseline"), Baseline);
+	Phases->SetObjectField(TEXT("spawners"), WithSpawners);
+	Report->SetObjectField(TEXT("phases"), Phases);
+
+	// Flat map of metric name to value; lower is always better, which is what the baseline comparison assumes
+	TSharedRef<FJsonObject> Metrics = MakeShared<FJsonObject>();
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : WithSpawners->Values)
+	{
+		if (Pair.Key != TEXT("frames") && Pair.Key != TEXT("net.peakConnections"))
+		{
+			Metrics->SetField(FString::Printf(TEXT("spawners.%s"), *Pair.Key), Pair.Value);
+		}
+	}
+
+	// What each added spawner costs on top of the map
+	const double GameThreadDeltaMS = LyraWeaponSpawnerBench::Average(SpawnerSamples.GameThreadTimesMS) - LyraWeaponSpawnerBench::Average(BaselineSamples.GameThreadTimesMS);
+	const double NetFlushDeltaMS = LyraWeaponSpawnerBench::Average(SpawnerSamples.NetFlushTimesMS) - LyraWeaponSpawnerBench::Average(BaselineSamples.NetFlushTimesMS);
+	const int32 NumSpawned = FMath::Max(NumSpawners, 1);
+	Metrics->SetNumberField(TEXT("perSpawner.gameThreadUS"), GameThreadDeltaMS * 1000.0 / NumSpawned);
+	if (SpawnerSamples.PeakConnectionCount > 0)
+	{
+		Metrics->SetNumberField(TEXT("perSpawner.netFlushUS"), NetFlushDeltaMS * 1000.0 / NumSpawned);
+		Metrics->SetNumberField(TEXT("perSpawner.netFlushPerConnectionUS"), NetFlushDeltaMS * 1000.0 / NumSpawned / SpawnerSamples.PeakConnectionCount);
+	}
+
+	Report->SetObjectField(TEXT("metrics"), Metrics);
+
+	UE_LOG(LogLyra, Display, TEXT("WeaponSpawnerBench: %d spawners, %d connection(s): %.3fus game thread and %.3fus net flush per spawner, %.1f ticking, %.1f awake"),
+		NumSpawners, SpawnerSamples.PeakConnectionCount, GameThreadDeltaMS * 1000.0 / NumSpawned, NetFlushDeltaMS * 1000.0 / NumSpawned,
+		WithSpawners->GetNumberField(TEXT("tickingSpawners")), WithSpawners->GetNumberField(TEXT("awakeSpawners")));
+
+	return Report;
+}
+
+int32 ULyraTestControllerWeaponSpawnerBench::CompareAgainstBaseline(const TSharedRef<FJsonObject>& Report, TArray<FString>& OutRegressions) const
+{
+	FString BaselineText;
+	const FString Baseline = GetBaselineFile();
+	if (!FFileHelper::LoadFileToString(BaselineText, *Baseline))
+	{
+		UE_LOG(LogLyra, Warning, TEXT("WeaponSpawnerBench: No baseline found at '%s', skipping comparison"), *Baseline);
+		return 0;
+	}
+
+	TSharedPtr<FJsonObject> BaselineReport;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(BaselineText);
+	const TSharedPtr<FJsonObject>* BaselineMetrics = nullptr;
+	if (!FJsonSerializer::Deserialize(Reader, BaselineReport) || !BaselineReport.IsValid() || !BaselineReport->TryGetObjectField(TEXT("metrics"), BaselineMetrics))
+	{
+		UE_LOG(LogLyra, Error, TEXT("WeaponSpawnerBench: Failed to parse baseline '%s'"), *Baseline);
+		return 1;
+	}
+
+	const TSharedPtr<FJsonObject> CurrentMetrics = Report->GetObjectField(TEXT("metrics"));
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*BaselineMetrics)->Values)
+	{
+		double BaselineValue = 0.0;
+		double CurrentValue = 0.0;
+		if (!Pair.Value->TryGetNumber(BaselineValue) || !CurrentMetrics->TryGetNumberField(Pair.Key, CurrentValue))
+		{
+			continue;
+		}
+
+		// Ignore noise on metrics that are near zero in the baseline
+		const double Allowed = FMath::Max(BaselineValue * (1.0 + Tolerance), BaselineValue + 0.01);
+		if (CurrentValue > Allowed)
+		{
+			OutRegressions.Add(FString::Printf(TEXT("%s: %.3f (baseline %.3f, allowed %.3f)"), *Pair.Key, CurrentValue, BaselineValue, Allowed));
+		}
+	}
+
+	return OutRegressions.Num() > 0 ? 1 : 0;
+}
+
+int32 ULyraTestControllerWeaponSpawnerBench::WriteReport(const TSharedRef<FJsonObject>& Report) const
+{
+	TArray<FString> Regressions;
+	const int32 ExitCode = CompareAgainstBaseline(Report, Regressions);
+
+	TArray<TSharedPtr<FJsonValue>> RegressionValues;
+	for (const FString& Regression : Regressions)
+	{
+		UE_LOG(LogLyra, Error, TEXT("WeaponSpawnerBench: Regression in %s"), *Regression);
+		RegressionValues.Add(MakeShared<FJsonValueString>(Regression));
+	}
+	Report->SetArrayField(TEXT("regressions"), RegressionValues);
+	Report->SetStringField(TEXT("baseline"), GetBaselineFile());
+
+	FString ReportText;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ReportText);
+	FJsonSerializer::Serialize(Report, Writer);
+
+	const FString ReportFile = ReportDir / (GetReportName() + TEXT(".json"));
+	if (FFileHelper::SaveStringToFile(ReportText, *ReportFile))
+	{
+		UE_LOG(LogLyra, Display, TEXT("WeaponSpawnerBench: Wrote report to %s"), *FPaths::ConvertRelativePathToFull(ReportFile));
+	}
+	else
+	{
+		UE_LOG(LogLyra, Error, TEXT("WeaponSpawnerBench: Failed to write report to %s"), *ReportFile);
+	}
+
+	if (bWriteBaseline)
+	{
+		const FString Baseline = GetBaselineFile();
+		IFileManager::Get().MakeDirectory(*FPaths::GetPath(Baseline), /*Tree=*/ true);
+		FFileHelper::SaveStringToFile(ReportText, *Baseline);
+		UE_LOG(LogLyra, Display, TEXT("WeaponSpawnerBench: Updated baseline %s"), *Baseline);
+	}
+
+	return bWriteBaseline ? 0 : ExitCode;
+}
+
+FString ULyraTestControllerWeaponSpawnerBench::GetReportName() const
+{
+	const FString MapPart = TravelMap.IsEmpty() ? TEXT("CurrentMap") : FPackageName::GetShortName(TravelMap);
+	const FString ClientPart = (DesiredSimulatedClientCount > 0) ? FString::Printf(TEXT("_%dClients"), DesiredSimulatedClientCount) : FString();
+	const FString DistancePart = (ViewerDistance > 0.0) ? FString::Printf(TEXT("_%.0fAway"), ViewerDistance) : FString();
+	return FString::Printf(TEXT("WeaponSpawnerBench_%s_%dSpawners%s%s"), *MapPart, NumSpawners, *ClientPart, *DistancePart);
+}
+
+FString ULyraTestControllerWeaponSpawnerBench::GetBaselineFile() const
+{
+	return BaselineFile.IsEmpty() ? (FPaths::ProjectDir() / TEXT("Build/Soak") / (GetReportName() + TEXT(".json"))) : BaselineFile;
+}
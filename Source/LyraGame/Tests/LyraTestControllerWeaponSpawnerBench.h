@@ -0,0 +1,148 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GauntletTestController.h"
+
+#include "LyraTestControllerWeaponSpawnerBench.generated.h"
+
+class ALyraWeaponSpawner;
+class APlayerController;
+class FJsonObject;
+class UWorld;
+
+/**
+ * Headless weapon spawner benchmark.
+ *
+ * Measures what weapon spawners cost a server: samples a baseline of the loaded map, then spawns a number of copies of
+ * a weapon spawner in a grid and samples again. Both phases record game thread time, net driver flush (replication)
+ * time, and how many spawners and spawner components tick and how many spawners are awake (not net dormant). The
+ * results and the extra cost per spawner are written to a JSON report, which is compared against a stored baseline
+ * like the bot soak (see ULyraTestControllerBotSoak).
+ *
+ * Without connections the net driver replicates to nobody, so -LyraSpawnerBench.SimulatedClients=N adds N simulated
+ * client connections, each owned by a bare player controller. -LyraSpawnerBench.ViewerDistance places them that far
+ * from the spawner grid: 0 (the default) parks them in the middle of it, a large distance measures what spawners cost
+ * when nobody is near them.
+ *
+ * Intended to be run as a dedicated server with -nullrhi, e.g.:
+ *   LyraServer L_Expanse -gauntlet=LyraTestControllerWeaponSpawnerBench -nullrhi -unattended
+ *     -LyraSpawnerBench.Experience=B_ShooterGame_Elimination -LyraSpawnerBench.Spawners=100 -LyraSpawnerBench.SimulatedClients=8
+ *
+ * Supported arguments (all optional):
+ *   -LyraSpawnerBench.Map=<MapName>             Travel to this map before starting (otherwise the current map is used)
+ *   -LyraSpawnerBench.Experience=<ExperienceId> Experience to use when traveling
+ *   -LyraSpawnerBench.SpawnerClass=<ClassPath>  Spawner class to spawn (otherwise the first weapon spawner in the map is copied)
+ *   -LyraSpawnerBench.Spawners=<N>              Number of spawners to add (defaults to 100)
+ *   -LyraSpawnerBench.Warmup=<Seconds>          Time to wait after the experience has loaded, and again after spawning, before sampling
+ *   -LyraSpawnerBench.Duration=<Seconds>        Time to sample each phase for
+ *   -LyraSpawnerBench.SimulatedClients=<N>      Number of simulated client connections to replicate to
+ *   -LyraSpawnerBench.ViewerDistance=<Units>    How far from the spawner grid the simulated clients are
+ *   -LyraSpawnerBench.ReportDir=<Dir>           Where to write the report (defaults to Saved/Soak)
+ *   -LyraSpawnerBench.Baseline=<File>           Baseline to compare against (defaults to Build/Soak/<ReportName>.json)
+ *   -LyraSpawnerBench.Tolerance=<Fraction>      Allowed regression relative to the baseline (defaults to 0.1)
+ *   -LyraSpawnerBench.WriteBaseline             Overwrite the baseline with this run's results
+ */
+UCLASS()
+class ULyraTestControllerWeaponSpawnerBench : public UGauntletTestController
+{
+	GENERATED_BODY()
+
+protected:
+	//~UGauntletTestController interface
+	virtual void OnInit() override;
+	virtual void OnPostMapChange(UWorld* World) override;
+	virtual void OnTick(float TimeDelta) override;
+	//~End of UGauntletTestController interface
+
+private:
+	enum class EBenchPhase : uint8
+	{
+		WaitingForWorld,
+		Traveling,
+		WaitingForExperience,
+		WarmingUp,
+		SamplingBaseline,
+		SettlingSpawners,
+		SamplingSpawners,
+		Finished
+	};
+
+	// Samples of one phase, averaged per frame in the report
+	struct FPhaseSamples
+	{
+		TArray<float> GameThreadTimesMS;
+		TArray<float> NetFlushTimesMS;
+		int32 NumCountSamples = 0;
+		int64 TickingSpawners = 0;
+		int64 TickingComponents = 0;
+		int64 AwakeSpawners = 0;
+		int64 ActiveNetObjects = 0;
+		int32 PeakConnectionCount = 0;
+
+		TSharedRef<FJsonObject> ToJson() const;
+	};
+
+	bool IsExperienceReady(UWorld* World) const;
+	void SetPhase(EBenchPhase NewPhase);
+	void FinishTest(const FString& Error);
+
+	void AddSimulatedClients(UWorld* World);
+	void UpdateSimulatedClients(UWorld* World);
+
+	ALyraWeaponSpawner* FindTemplateSpawner(UWorld* World) const;
+	void SpawnSpawners(UWorld* World);
+	void DestroySpawners();
+
+	void StartTimingNetFlush(UWorld* World);
+	void StopTimingNetFlush();
+	void OnTickFlush(float DeltaSeconds);
+	void OnPostTickFlush();
+
+	void SampleFrame(UWorld* World);
+	FPhaseSamples& GetCurrentSamples();
+
+	TSharedRef<FJsonObject> BuildReport() const;
+	int32 CompareAgainstBaseline(const TSharedRef<FJsonObject>& Report, TArray<FString>& OutRegressions) const;
+	int32 WriteReport(const TSharedRef<FJsonObject>& Report) const;
+
+	FString GetReportName() const;
+	FString GetBaselineFile() const;
+
+private:
+	// Configuration
+	FString TravelMap;
+	FString ExperienceName;
+	FString SpawnerClassPath;
+	int32 NumSpawners = 100;
+	double WarmupSeconds = 10.0;
+	double DurationSeconds = 30.0;
+	int32 DesiredSimulatedClientCount = 0;
+	double ViewerDistance = 0.0;
+	double Tolerance = 0.1;
+	FString ReportDir;
+	FString BaselineFile; // Empty uses Build/Soak/<ReportName>.json
+	bool bWriteBaseline = false;
+
+	// Progress
+	EBenchPhase Phase = EBenchPhase::WaitingForWorld;
+	double PhaseStartTime = 0.0;
+	double LastCountSampleTime = 0.0;
+
+	// Spawners added for the second phase, and where the simulated clients look at them from
+	TArray<TWeakObjectPtr<ALyraWeaponSpawner>> SpawnedSpawners;
+	FString SpawnedClassName;
+	FVector GridCenter = FVector::ZeroVector;
+
+	// Owners of the simulated client connections
+	TArray<TWeakObjectPtr<APlayerController>> SimulatedClients;
+
+	// Samples
+	FPhaseSamples BaselineSamples;
+	FPhaseSamples SpawnerSamples;
+
+	// Net driver flush (replication) time, measured between the world's TickFlush and PostTickFlush events
+	double NetFlushStartTime = 0.0;
+	FDelegateHandle TickFlushHandle;
+	FDelegateHandle PostTickFlushHandle;
+};
@@ -0,0 +1,94 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Weapons/LyraWeaponSpawner.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Equipment/LyraPickupDefinition.h"
+#include "GameFramework/WorldSettings.h"
+#include "Inventory/LyraInventoryItemDefinition.h"
+#include "Misc/AutomationTest.h"
+#include "TimerManager.h"
+#include "UObject/Package.h"
+#include "Weapons/LyraWeaponSpawnerSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraWeaponSpawnerTickTest, "Lyra.Weapons.WeaponSpawner.Tick", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLyraWeaponSpawnerTickTest::RunTest(const FString& Parameters)
+{
+	// A standalone world that has begun play, so spawned actors get BeginPlay
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->AddToRoot();
+	GameInstance->InitializeStandalone();
+	UWorld* World = GameInstance->GetWorld();
+	World->InitializeActorsForPlay(FURL());
+	World->GetWorldSettings()->NotifyBeginPlay();
+
+	ULyraWeaponSpawnerSubsystem* SpawnerSubsystem = World->GetSubsystem<ULyraWeaponSpawnerSubsystem>();
+	if (!TestNotNull(TEXT("Weapon spawner subsystem"), SpawnerSubsystem))
+	{
+		return false;
+	}
+
+	ULyraWeaponPickupDefinition* WeaponDefinition = NewObject<ULyraWeaponPickupDefinition>(GetTransientPackage());
+	WeaponDefinition->InventoryItemDefinition = ULyraInventoryItemDefinition::StaticClass();
+	WeaponDefinition->SpawnCoolDownSeconds = 10;
+
+	ALyraWeaponSpawner* Spawner = World->SpawnActorDeferred<ALyraWeaponSpawner>(ALyraWeaponSpawner::StaticClass(), FTransform::Identity);
+	Spawner->WeaponDefinition = WeaponDefinition;
+	Spawner->FinishSpawning(FTransform::Identity);
+
+	TestFalse(TEXT("Native spawners don't tick while the weapon is available"), Spawner->IsActorTickEnabled());
+	TestFalse(TEXT("Native spawners don't tick for blueprints"), Spawner->bTickForBlueprint);
+	TestTrue(TEXT("The visible weapon mesh spins"), SpawnerSubsystem->IsMeshSpinning(Spawner));
+	TestTrue(TEXT("The subsystem ticks while a mesh spins"), SpawnerSubsystem->IsTickable());
+
+	// Nothing is rendered in this world, so spin regardless
+	const FQuat StartRotation = Spawner->WeaponMesh->GetRelativeRotation().Quaternion();
+	SpawnerSubsystem->UpdateSpinningMeshes(0.5f, /*bOnlyIfRendered=*/ false);
+	const float ExpectedYaw = 0.5f * Spawner->WeaponMeshRotationSpeed;
+	TestEqual(TEXT("Yaw after half a second"), (float)FMath::RadiansToDegrees(StartRotation.AngularDistance(Spawner->WeaponMesh->GetRelativeRotation().Quaternion())), ExpectedYaw, 0.01f);
+
+	const FRotator RenderedOnlyRotation = Spawner->WeaponMesh->GetRelativeRotation();
+	SpawnerSubsystem->UpdateSpinningMeshes(0.5f, /*bOnlyIfRendered=*/ true);
+	TestTrue(TEXT("Meshes that weren't rendered don't move"), Spawner->WeaponMesh->GetRelativeRotation().Equals(RenderedOnlyRotation));
+
+	// What AttemptPickUpWeapon does once the weapon is given
+	Spawner->bIsWeaponAvailable = false;
+	Spawner->CoolDownStartTime = World->GetTimeSeconds();
+	Spawner->SetWeaponPickupVisibility(false);
+	Spawner->StartCoolDown();
+
+	TestFalse(TEXT("The hidden weapon mesh doesn't spin"), SpawnerSubsystem->IsMeshSpinning(Spawner));
+	TestFalse(TEXT("The subsystem doesn't tick with nothing to spin"), SpawnerSubsystem->IsTickable());
+	TestTrue(TEXT("The spawner ticks while cooling down outside dedicated servers"), Spawner->IsActorTickEnabled());
+	TestTrue(TEXT("The respawn is timed by the server"), World->GetTimerManager().IsTimerActive(Spawner->CoolDownTimerHandle));
+
+	Spawner->ResetCoolDown();
+
+	TestTrue(TEXT("The weapon is available again"), Spawner->bIsWeaponAvailable);
+	TestFalse(TEXT("The spawner stops ticking once the weapon is back"), Spawner->IsActorTickEnabled());
+	TestTrue(TEXT("The weapon mesh spins again"), SpawnerSubsystem->IsMeshSpinning(Spawner));
+
+	Spawner->WeaponMeshRotationSpeed = 0.0f;
+	Spawner->SetWeaponPickupVisibility(true);
+	TestFalse(TEXT("A rotation speed of 0 leaves the spin to the material"), SpawnerSubsystem->IsMeshSpinning(Spawner));
+
+	Spawner->WeaponMeshRotationSpeed = 40.0f;
+	Spawner->SetWeaponPickupVisibility(true);
+	Spawner->Destroy();
+	TestFalse(TEXT("Destroyed spawners stop spinning"), SpawnerSubsystem->IsMeshSpinning(Spawner));
+
+	GameInstance->Shutdown();
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	GameInstance->RemoveFromRoot();
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
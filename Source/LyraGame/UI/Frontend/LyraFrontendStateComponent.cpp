@@ -3,6 +3,7 @@
 #include "LyraFrontendStateComponent.h"
 
 #include "CommonGameInstance.h"
+#include "CommonLocalPlayer.h"
 #include "CommonSessionSubsystem.h"
 #include "CommonUserSubsystem.h"
 #include "ControlFlowManager.h"
@@ -40,6 +41,8 @@ void ULyraFrontendStateComponent::BeginPlay()
 
 void ULyraFrontendStateComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	StopWaitingForPrimaryLayout();
+
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -137,7 +140,7 @@ void ULyraFrontendStateComponent::FlowStep_TryShowPressStartScreen(FControlFlowN
 	}
 
 	// Add the Press Start screen, move to the next flow when it deactivates.
-	if (UPrimaryGameLayout* RootLayout = UPrimaryGameLayout::GetPrimaryGameLayoutForPrimaryPlayer(this))
+	CallOrWaitForPrimaryLayout(SubFlow, [this, SubFlow](UPrimaryGameLayout* RootLayout)
 	{
 		constexpr bool bSuspendInputUntilComplete = true;
 		RootLayout->PushWidgetToLayerStackAsync<UCommonActivatableWidget>(FrontendTags::TAG_UI_LAYER_MENU, bSuspendInputUntilComplete, PressStartScreenClass,
@@ -156,7 +159,7 @@ void ULyraFrontendStateComponent::FlowStep_TryShowPressStartScreen(FControlFlowN
 				return;
 			}
 		});
-	}
+	});
 }
 
 void ULyraFrontendStateComponent::OnUserInitialized(const UCommonUserInfo* UserInfo, bool bSuccess, FText Error, ECommonUserPrivilege RequestedPrivilege, ECommonUserOnlineContext OnlineContext)
@@ -221,7 +224,7 @@ void ULyraFrontendStateComponent::FlowStep_TryJoinRequestedSession(FControlFlowN
 
 void ULyraFrontendStateComponent::FlowStep_TryShowMainScreen(FControlFlowNodeRef SubFlow)
 {
-	if (UPrimaryGameLayout* RootLayout = UPrimaryGameLayout::GetPrimaryGameLayoutForPrimaryPlayer(this))
+	CallOrWaitForPrimaryLayout(SubFlow, [this, SubFlow](UPrimaryGameLayout* RootLayout)
 	{
 		constexpr bool bSuspendInputUntilComplete = true;
 		RootLayout->PushWidgetToLayerStackAsync<UCommonActivatableWidget>(FrontendTags::TAG_UI_LAYER_MENU, bSuspendInputUntilComplete, MainScreenClass,
@@ -238,6 +241,46 @@ void ULyraFrontendStateComponent::FlowStep_TryShowMainScreen(FControlFlowNodeRef
 				return;
 			}
 		});
+	});
+}
+
+void ULyraFrontendStateComponent::CallOrWaitForPrimaryLayout(FControlFlowNodeRef SubFlow, TFunction<void(UPrimaryGameLayout*)>&& OnReady)
+{
+	UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(this);
+	UCommonLocalPlayer* LocalPlayer = GameInstance ? Cast<UCommonLocalPlayer>(GameInstance->GetFirstGamePlayer()) : nullptr;
+	if (LocalPlayer == nullptr)
+	{
+		// Nobody to show the screen to
+		SubFlow->ContinueFlow();
+		return;
+	}
+
+	if (UPrimaryGameLayout* RootLayout = LocalPlayer->GetRootUILayout())
+	{
+		OnReady(RootLayout);
+		return;
+	}
+
+	// The UI policy and its layout class load asynchronously, so on boot the layout can arrive after the experience
+	StopWaitingForPrimaryLayout();
+	PrimaryLayoutPlayer = LocalPlayer;
+	PrimaryLayoutSetHandle = LocalPlayer->OnRootLayoutSet.AddWeakLambda(this, [this, OnReady = MoveTemp(OnReady)](UCommonLocalPlayer* InLocalPlayer, UPrimaryGameLayout* RootLayout) mutable
+	{
+		// Removing the binding destroys this lambda, so take what it holds first
+		ULyraFrontendStateComponent* Self = this;
+		TFunction<void(UPrimaryGameLayout*)> ReadyCallback = MoveTemp(OnReady);
+		Self->StopWaitingForPrimaryLayout();
+		ReadyCallback(RootLayout);
+	});
+}
+
+void ULyraFrontendStateComponent::StopWaitingForPrimaryLayout()
+{
+	if (UCommonLocalPlayer* LocalPlayer = PrimaryLayoutPlayer.Get())
+	{
+		LocalPlayer->OnRootLayoutSet.Remove(PrimaryLayoutSetHandle);
 	}
+	PrimaryLayoutPlayer.Reset();
+	PrimaryLayoutSetHandle.Reset();
 }
 
@@ -17,7 +17,9 @@ struct FFrame;
 enum class ECommonUserOnlineContext : uint8;
 enum class ECommonUserPrivilege : uint8;
 class UCommonActivatableWidget;
+class UCommonLocalPlayer;
 class UCommonUserInfo;
+class UPrimaryGameLayout;
 class ULyraExperienceDefinition;
 
 UCLASS(Abstract)
@@ -49,6 +51,10 @@ private:
 	void FlowStep_TryJoinRequestedSession(FControlFlowNodeRef SubFlow);
 	void FlowStep_TryShowMainScreen(FControlFlowNodeRef SubFlow);
 
+	// Calls OnReady with the primary player's root layout once the UI policy has created it, or skips the step if there is no primary player
+	void CallOrWaitForPrimaryLayout(FControlFlowNodeRef SubFlow, TFunction<void(UPrimaryGameLayout*)>&& OnReady);
+	void StopWaitingForPrimaryLayout();
+
 	bool bShouldShowLoadingScreen = true;
 
 	UPROPERTY(EditAnywhere, Category = UI)
@@ -63,4 +69,7 @@ private:
 	FControlFlowNodePtr InProgressPressStartScreen;
 
 	FDelegateHandle OnJoinSessionCompleteEventHandle;
+
+	TWeakObjectPtr<UCommonLocalPlayer> PrimaryLayoutPlayer;
+	FDelegateHandle PrimaryLayoutSetHandle;
 };
@@ -2,10 +2,13 @@
 
 #include "LyraUIMessaging.h"
 
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "Messaging/CommonGameDialog.h"
 #include "NativeGameplayTags.h"
 #include "Player/LyraLocalPlayer.h"
 #include "PrimaryGameLayout.h"
+#include "UObject/StrongObjectPtr.h"
 #include "Widgets/CommonActivatableWidgetContainer.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraUIMessaging)
@@ -18,32 +21,62 @@ void ULyraUIMessaging::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
-	ConfirmationDialogClassPtr = ConfirmationDialogClass.LoadSynchronous();
-	ErrorDialogClassPtr = ErrorDialogClass.LoadSynchronous();
+	// Warm the dialog classes in the background, showing a dialog before this finishes just waits on the same load
+	TArray<FSoftObjectPath> DialogClassPaths;
+	for (const TSoftClassPtr<UCommonGameDialog>& DialogClass : { ConfirmationDialogClass, ErrorDialogClass })
+	{
+		if (!DialogClass.IsNull())
+		{
+			DialogClassPaths.Add(DialogClass.ToSoftObjectPath());
+		}
+	}
+
+	if (DialogClassPaths.Num() > 0)
+	{
+		DialogClassesLoadHandle = UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(DialogClassPaths);
+	}
 }
 
-void ULyraUIMessaging::ShowConfirmation(UCommonGameDialogDescriptor* DialogDescriptor, FCommonMessagingResultDelegate ResultCallback)
+void ULyraUIMessaging::Deinitialize()
 {
-	if (ULyraLocalPlayer* LocalPlayer = GetLocalPlayer<ULyraLocalPlayer>())
+	if (DialogClassesLoadHandle.IsValid())
 	{
-		if (UPrimaryGameLayout* RootLayout = LocalPlayer->GetRootUILayout())
-		{
-			RootLayout->PushWidgetToLayerStack<UCommonGameDialog>(TAG_UI_LAYER_MODAL, ConfirmationDialogClassPtr, [DialogDescriptor, ResultCallback](UCommonGameDialog& Dialog) {
-				Dialog.SetupDialog(DialogDescriptor, ResultCallback);
-			});
-		}
+		DialogClassesLoadHandle->CancelHandle();
+		DialogClassesLoadHandle.Reset();
 	}
+
+	Super::Deinitialize();
+}
+
+void ULyraUIMessaging::ShowConfirmation(UCommonGameDialogDescriptor* DialogDescriptor, FCommonMessagingResultDelegate ResultCallback)
+{
+	ShowDialog(ConfirmationDialogClass, DialogDescriptor, ResultCallback);
 }
 
 void ULyraUIMessaging::ShowError(UCommonGameDialogDescriptor* DialogDescriptor, FCommonMessagingResultDelegate ResultCallback)
+{
+	ShowDialog(ErrorDialogClass, DialogDescriptor, ResultCallback);
+}
+
+void ULyraUIMessaging::ShowDialog(const TSoftClassPtr<UCommonGameDialog>& DialogClass, UCommonGameDialogDescriptor* DialogDescriptor, FCommonMessagingResultDelegate ResultCallback)
 {
 	if (ULyraLocalPlayer* LocalPlayer = GetLocalPlayer<ULyraLocalPlayer>())
 	{
 		if (UPrimaryGameLayout* RootLayout = LocalPlayer->GetRootUILayout())
 		{
-			RootLayout->PushWidgetToLayerStack<UCommonGameDialog>(TAG_UI_LAYER_MODAL, ErrorDialogClassPtr, [DialogDescriptor, ResultCallback](UCommonGameDialog& Dialog) {
-				Dialog.SetupDialog(DialogDescriptor, ResultCallback);
-			});
+			TStrongObjectPtr<UCommonGameDialogDescriptor> DescriptorRef(DialogDescriptor);
+			RootLayout->PushWidgetToLayerStackAsync<UCommonGameDialog>(TAG_UI_LAYER_MODAL, true, DialogClass,
+				[DescriptorRef, ResultCallback](EAsyncWidgetLayerState State, UCommonGameDialog* Dialog) {
+					if (State == EAsyncWidgetLayerState::Initialize)
+					{
+						Dialog->SetupDialog(DescriptorRef.Get(), ResultCallback);
+					}
+					else if (State == EAsyncWidgetLayerState::Canceled)
+					{
+						// The dialog is never going to show, so let the caller know instead of waiting forever
+						ResultCallback.ExecuteIfBound(ECommonMessagingResult::Killed);
+					}
+				});
 		}
 	}
 }
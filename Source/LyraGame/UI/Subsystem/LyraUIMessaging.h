@@ -12,6 +12,7 @@ class FSubsystemCollectionBase;
 class UCommonGameDialog;
 class UCommonGameDialogDescriptor;
 class UObject;
+struct FStreamableHandle;
 
 /**
  * 
@@ -25,16 +26,17 @@ public:
 	ULyraUIMessaging() { }
 
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
 
 	virtual void ShowConfirmation(UCommonGameDialogDescriptor* DialogDescriptor, FCommonMessagingResultDelegate ResultCallback = FCommonMessagingResultDelegate()) override;
 	virtual void ShowError(UCommonGameDialogDescriptor* DialogDescriptor, FCommonMessagingResultDelegate ResultCallback = FCommonMessagingResultDelegate()) override;
 
 private:
-	UPROPERTY()
-	TSubclassOf<UCommonGameDialog> ConfirmationDialogClassPtr;
+	void ShowDialog(const TSoftClassPtr<UCommonGameDialog>& DialogClass, UCommonGameDialogDescriptor* DialogDescriptor, FCommonMessagingResultDelegate ResultCallback);
 
-	UPROPERTY()
-	TSubclassOf<UCommonGameDialog> ErrorDialogClassPtr;
+private:
+	// Keeps both dialog classes loaded once the background preload finishes
+	TSharedPtr<FStreamableHandle> DialogClassesLoadHandle;
 
 	UPROPERTY(config)
 	TSoftClassPtr<UCommonGameDialog> ConfirmationDialogClass;
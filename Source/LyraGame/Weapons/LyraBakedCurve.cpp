@@ -0,0 +1,172 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraBakedCurve.h"
+
+//////////////////////////////////////////////////////////////////////
+// FLyraBakedCurve
+
+void FLyraBakedCurve::Reset()
+{
+	SourceCurve = nullptr;
+	bUseSourceCurve = false;
+	KeyTimes.Reset();
+	KeyValues.Reset();
+	InterpModes.Reset();
+	CubicSampleOffsets.Reset();
+	CubicSamples.Reset();
+	BucketToSegment.Reset();
+	MinTime = 0.0f;
+	MaxTime = 0.0f;
+	InvBucketSize = 0.0f;
+}
+
+void FLyraBakedCurve::Bake(const FRichCurve* InSourceCurve)
+{
+	Reset();
+
+	SourceCurve = InSourceCurve;
+	if (SourceCurve == nullptr)
+	{
+		return;
+	}
+
+	const TArray<FRichCurveKey>& Keys = SourceCurve->GetConstRefOfKeys();
+	const int32 NumKeys = Keys.Num();
+
+	// Empty curves return their default value, and non-constant extrapolation needs the full evaluator
+	const bool bConstantExtrapolation =
+		((SourceCurve->PreInfinityExtrap == RCCE_Constant) || (SourceCurve->PreInfinityExtrap == RCCE_None)) &&
+		((SourceCurve->PostInfinityExtrap == RCCE_Constant) || (SourceCurve->PostInfinityExtrap == RCCE_None));
+
+	if ((NumKeys == 0) || !bConstantExtrapolation)
+	{
+		bUseSourceCurve = true;
+		return;
+	}
+
+	KeyTimes.Reserve(NumKeys);
+	KeyValues.Reserve(NumKeys);
+	InterpModes.Reserve(NumKeys);
+	for (const FRichCurveKey& Key : Keys)
+	{
+		if ((Key.InterpMode == RCIM_Cubic) && (Key.TangentWeightMode != RCTWM_WeightedNone))
+		{
+			// Weighted tangents use an iterative solve in FRichCurve::Eval, keep it authoritative
+			bUseSourceCurve = true;
+		}
+
+		KeyTimes.Add(Key.Time);
+		KeyValues.Add(Key.Value);
+		InterpModes.Add(Key.InterpMode);
+	}
+
+	MinTime = KeyTimes[0];
+	MaxTime = KeyTimes.Last();
+
+	if (bUseSourceCurve)
+	{
+		return;
+	}
+
+	// Resample the cubic segments, pinning the end points to the key values
+	const int32 NumSegments = NumKeys - 1;
+	CubicSampleOffsets.Init(INDEX_NONE, FMath::Max(NumSegments, 0));
+	for (int32 SegmentIndex = 0; SegmentIndex < NumSegments; ++SegmentIndex)
+	{
+		const float SegmentStart = KeyTimes[SegmentIndex];
+		const float SegmentEnd = KeyTimes[SegmentIndex + 1];
+		if ((InterpModes[SegmentIndex] == RCIM_Cubic) && (SegmentEnd > SegmentStart))
+		{
+			CubicSampleOffsets[SegmentIndex] = CubicSamples.Num();
+			CubicSamples.Add(KeyValues[SegmentIndex]);
+			for (int32 SampleIndex = 1; SampleIndex < SamplesPerCubicSegment - 1; ++SampleIndex)
+			{
+				const float Alpha = (float)SampleIndex / (float)(SamplesPerCubicSegment - 1);
+				CubicSamples.Add(SourceCurve->Eval(FMath::Lerp(SegmentStart, SegmentEnd, Alpha)));
+			}
+			CubicSamples.Add(SourceCurve->Eval(SegmentEnd));
+		}
+	}
+
+	// Build the bucket grid used to find the segment without searching the keys
+	if ((NumSegments > 0) && (MaxTime > MinTime))
+	{
+		const int32 NumBuckets = NumSegments * 4;
+		InvBucketSize = NumBuckets / (MaxTime - MinTime);
+		BucketToSegment.SetNumUninitialized(NumBuckets);
+
+		int32 SegmentIndex = 0;
+		for (int32 BucketIndex = 0; BucketIndex < NumBuckets; ++BucketIndex)
+		{
+			const float BucketStart = MinTime + (BucketIndex / InvBucketSize);
+			while ((SegmentIndex < NumSegments - 1) && (KeyTimes[SegmentIndex + 1] <= BucketStart))
+			{
+				++SegmentIndex;
+			}
+			BucketToSegment[BucketIndex] = SegmentIndex;
+		}
+	}
+}
+
+int32 FLyraBakedCurve::FindSegment(float InTime) const
+{
+	const int32 NumSegments = KeyTimes.Num() - 1;
+	const int32 BucketIndex = FMath::Clamp(FMath::FloorToInt32((InTime - MinTime) * InvBucketSize), 0, BucketToSegment.Num() - 1);
+
+	// A bucket can straddle a few keys, walk forward to the one containing InTime
+	int32 SegmentIndex = BucketToSegment[BucketIndex];
+	while ((SegmentIndex < NumSegments - 1) && (KeyTimes[SegmentIndex + 1] <= InTime))
+	{
+		++SegmentIndex;
+	}
+	return SegmentIndex;
+}
+
+float FLyraBakedCurve::Eval(float InTime) const
+{
+	check(IsBaked());
+
+	if (bUseSourceCurve)
+	{
+		return SourceCurve->Eval(InTime);
+	}
+
+	// Constant extrapolation outside of the key range
+	if ((KeyTimes.Num() == 1) || (InTime <= MinTime))
+	{
+		return KeyValues[0];
+	}
+	if (InTime >= MaxTime)
+	{
+		return KeyValues.Last();
+	}
+
+	const int32 SegmentIndex = FindSegment(InTime);
+	const float SegmentStart = KeyTimes[SegmentIndex];
+	const float SegmentLength = KeyTimes[SegmentIndex + 1] - SegmentStart;
+	if (SegmentLength <= 0.0f)
+	{
+		return KeyValues[SegmentIndex];
+	}
+
+	const float Alpha = (InTime - SegmentStart) / SegmentLength;
+
+	switch (InterpModes[SegmentIndex])
+	{
+	case RCIM_Linear:
+		return FMath::Lerp(KeyValues[SegmentIndex], KeyValues[SegmentIndex + 1], Alpha);
+
+	case RCIM_Cubic:
+		{
+			const float SamplePosition = Alpha * (SamplesPerCubicSegment - 1);
+			const int32 SampleIndex = FMath::Min(FMath::FloorToInt32(SamplePosition), SamplesPerCubicSegment - 2);
+			const float* Samples = &CubicSamples[CubicSampleOffsets[SegmentIndex]];
+			return FMath::Lerp(Samples[SampleIndex], Samples[SampleIndex + 1], SamplePosition - SampleIndex);
+		}
+
+	case RCIM_Constant:
+	case RCIM_None:
+	default:
+		return KeyValues[SegmentIndex];
+	}
+}
@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Curves/RichCurve.h"
+
+/**
+ * FLyraBakedCurve
+ *
+ * A FRichCurve flattened into uniform lookup tables so it can be sampled every frame without a key search.
+ * Linear and constant segments are evaluated exactly from their keys; cubic segments are resampled into a
+ * fixed number of points per segment whose end points are the keys themselves, so results are always exact at
+ * key times. Curves that can't be represented (weighted tangents, non-constant extrapolation) keep using the
+ * source curve.
+ *
+ * Baking allocates, sampling never does.
+ */
+struct FLyraBakedCurve
+{
+public:
+	/** Bakes the given curve, replacing any previously baked data */
+	void Bake(const FRichCurve* InSourceCurve);
+
+	/** Clears the baked data */
+	void Reset();
+
+	/** Returns true if Bake has been called with a curve */
+	bool IsBaked() const { return SourceCurve != nullptr; }
+
+	/** Evaluates the curve at the specified time; must be baked first */
+	float Eval(float InTime) const;
+
+private:
+	int32 FindSegment(float InTime) const;
+
+private:
+	// Number of samples stored for each cubic segment (including both end points)
+	static constexpr int32 SamplesPerCubicSegment = 16;
+
+	// Curve this was baked from, used as a fallback when bUseSourceCurve is set
+	const FRichCurve* SourceCurve = nullptr;
+	bool bUseSourceCurve = false;
+
+	TArray<float> KeyTimes;
+	TArray<float> KeyValues;
+	TArray<TEnumAsByte<ERichCurveInterpMode>> InterpModes;
+
+	// Offset into CubicSamples for each segment, or INDEX_NONE for non-cubic segments
+	TArray<int32> CubicSampleOffsets;
+	TArray<float> CubicSamples;
+
+	// Uniform grid over the key range mapping a bucket to the first segment that overlaps it
+	TArray<int32> BucketToSegment;
+	float MinTime = 0.0f;
+	float MaxTime = 0.0f;
+	float InvBucketSize = 0.0f;
+};
@@ -14,14 +14,17 @@ UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Lyra_Damage_Message);
 ULyraDamageLogDebuggerComponent::ULyraDamageLogDebuggerComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	// Only ticks while there is damage waiting to be logged
 	PrimaryComponentTick.bCanEverTick = true;
-	PrimaryComponentTick.SetTickFunctionEnable(true);
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 }
 
 void ULyraDamageLogDebuggerComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+	DamageLog.SetNum(FMath::Max(MaxLoggedFrames, 1));
+
 	UGameplayMessageSubsystem& MessageSubsystem = UGameplayMessageSubsystem::Get(this);
 	ListenerHandle = MessageSubsystem.RegisterListener(TAG_Lyra_Damage_Message, this, &ThisClass::OnDamageMessage);
 }
@@ -37,63 +40,135 @@ void ULyraDamageLogDebuggerComponent::EndPlay(const EEndPlayReason::Type EndPlay
 void ULyraDamageLogDebuggerComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	const double TimeSinceDamage = GetWorld()->GetTimeSeconds() - LastDamageEntryTime;
-	if ((TimeSinceDamage >= SecondsBetweenDamageBeforeLogging) && (DamageLog.Num() > 0))
+	if (TimeSinceDamage >= SecondsBetweenDamageBeforeLogging)
 	{
-		TArray<FFrameDamageEntry> Entries;
-		DamageLog.GenerateValueArray(/*out*/ Entries);
-		DamageLog.Reset();
+		LogPendingDamage();
+		SetComponentTickEnabled(false);
+	}
+}
 
-		Entries.Sort([](const FFrameDamageEntry& A, const FFrameDamageEntry& B) { return A.TimeOfFirstHit < B.TimeOfFirstHit; });
+void ULyraDamageLogDebuggerComponent::LogPendingDamage()
+{
+	if (NumUnloggedEntries == 0)
+	{
+		return;
+	}
 
-		double TotalDamage = 0.0;
-		int32 NumImpacts = 0;
-		int32 NumFrames = Entries.Num();
-		double MinInterval = TNumericLimits<double>::Max();
-		double MaxInterval = -TNumericLimits<double>::Max();
-		double TotalInterval = 0.0;
+	double TotalDamage = 0.0;
+	int32 NumImpacts = 0;
+	const int32 NumFrames = NumUnloggedEntries;
+	double MinInterval = TNumericLimits<double>::Max();
+	double MaxInterval = -TNumericLimits<double>::Max();
+	double TotalInterval = 0.0;
 
-		for (int32 i = 0; i < Entries.Num(); ++i)
-		{
-			FFrameDamageEntry& EntryA = Entries[i];
-			NumImpacts += EntryA.NumImpacts;
-			TotalDamage += EntryA.SumDamage;
+	// The log is already in the order the hits came in
+	const int32 FirstIndex = DamageLogNum - NumUnloggedEntries;
+	for (int32 i = FirstIndex; i < DamageLogNum; ++i)
+	{
+		const FFrameDamageEntry& EntryA = GetEntry(i);
+		NumImpacts += EntryA.NumImpacts;
+		TotalDamage += EntryA.SumDamage;
 
-			if (i + 1 < Entries.Num())
-			{
-				FFrameDamageEntry& EntryB = Entries[i+1];
+		if (i + 1 < DamageLogNum)
+		{
+			const FFrameDamageEntry& EntryB = GetEntry(i + 1);
 
-				const double TimeGap = EntryB.TimeOfFirstHit - EntryA.TimeOfFirstHit;
-				MinInterval = FMath::Min(MinInterval, TimeGap);
-				MaxInterval = FMath::Max(MaxInterval, TimeGap);
-				TotalInterval += TimeGap;
-			}
+			const double TimeGap = EntryB.TimeOfFirstHit - EntryA.TimeOfFirstHit;
+			MinInterval = FMath::Min(MinInterval, TimeGap);
+			MaxInterval = FMath::Max(MaxInterval, TimeGap);
+			TotalInterval += TimeGap;
 		}
+	}
+
+	UE_LOG(LogLyra, Warning, TEXT("%d impacts in %d distinct frames over %.2f seconds did %.2f damage"),
+		NumImpacts, NumFrames, TotalInterval, TotalDamage);
+	if (TotalInterval > 0.0)
+	{
+		UE_LOG(LogLyra, Warning, TEXT("Interval ranged from %.1f ms to %.1f ms (avg %.1f ms)"),
+			MinInterval * 1000.0, MaxInterval * 1000.0, TotalInterval / (NumFrames - 1) * 1000.0);
+		UE_LOG(LogLyra, Warning, TEXT("DPS %.2f"), TotalDamage / TotalInterval);
+	}
+	if (NumDroppedEntries > 0)
+	{
+		UE_LOG(LogLyra, Warning, TEXT("%d earlier frames were dropped, raise MaxLoggedFrames to keep them"), NumDroppedEntries);
+	}
+	UE_LOG(LogLyra, Warning, TEXT("\n"));
 
-		UE_LOG(LogLyra, Warning, TEXT("%d impacts in %d distinct frames over %.2f seconds did %.2f damage"),
-			NumImpacts, NumFrames, TotalInterval, TotalDamage);
-		if (TotalInterval > 0.0)
+	NumUnloggedEntries = 0;
+	NumDroppedEntries = 0;
+}
+
+double ULyraDamageLogDebuggerComponent::GetDamagePerSecond(double WindowSeconds) const
+{
+	double TotalDamage = 0.0;
+	int32 NumImpacts = 0;
+	GetDamageInWindow(WindowSeconds, /*out*/ TotalDamage, /*out*/ NumImpacts);
+
+	return (WindowSeconds > 0.0) ? (TotalDamage / WindowSeconds) : 0.0;
+}
+
+void ULyraDamageLogDebuggerComponent::GetDamageInWindow(double WindowSeconds, double& OutTotalDamage, int32& OutNumImpacts) const
+{
+	OutTotalDamage = 0.0;
+	OutNumImpacts = 0;
+
+	const UWorld* World = GetWorld();
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	// Walk back from the newest entry until we leave the window
+	const double WindowStart = World->GetTimeSeconds() - WindowSeconds;
+	for (int32 i = DamageLogNum - 1; i >= 0; --i)
+	{
+		const FFrameDamageEntry& Entry = GetEntry(i);
+		if (Entry.TimeOfFirstHit < WindowStart)
 		{
-			UE_LOG(LogLyra, Warning, TEXT("Interval ranged from %.1f ms to %.1f ms (avg %.1f ms)"),
-				MinInterval * 1000.0, MaxInterval * 1000.0, (MaxInterval + MinInterval) / 2.0 * 1000.0);
-			UE_LOG(LogLyra, Warning, TEXT("DPS %.2f"), TotalDamage / TotalInterval);
+			break;
 		}
-		UE_LOG(LogLyra, Warning, TEXT("\n"));
+
+		OutTotalDamage += Entry.SumDamage;
+		OutNumImpacts += Entry.NumImpacts;
 	}
 }
 
 void ULyraDamageLogDebuggerComponent::OnDamageMessage(FGameplayTag Channel, const FLyraVerbMessage& Payload)
 {
-	if (Payload.Target == GetOwner())
+	if (Payload.Target == GetOwner() && (DamageLog.Num() > 0))
 	{
-		FFrameDamageEntry& LogEntry = DamageLog.FindOrAdd(GFrameCounter);
-		
-		if (LogEntry.TimeOfFirstHit == 0.0)
+		// Hits in the same frame are merged into the newest entry, otherwise start a new one (overwriting the oldest when full)
+		if ((DamageLogNum == 0) || (GetEntry(DamageLogNum - 1).FrameNumber != GFrameCounter))
 		{
-			LogEntry.TimeOfFirstHit = GetWorld()->GetTimeSeconds();
-			LastDamageEntryTime = LogEntry.TimeOfFirstHit;
+			if (DamageLogNum < DamageLog.Num())
+			{
+				++DamageLogNum;
+			}
+			else
+			{
+				DamageLogStart = (DamageLogStart + 1) % DamageLog.Num();
+			}
+
+			if (NumUnloggedEntries < DamageLog.Num())
+			{
+				++NumUnloggedEntries;
+			}
+			else
+			{
+				++NumDroppedEntries;
+			}
+
+			FFrameDamageEntry& NewEntry = GetEntry(DamageLogNum - 1);
+			NewEntry = FFrameDamageEntry();
+			NewEntry.FrameNumber = GFrameCounter;
+			NewEntry.TimeOfFirstHit = GetWorld()->GetTimeSeconds();
+			LastDamageEntryTime = NewEntry.TimeOfFirstHit;
 		}
+
+		FFrameDamageEntry& LogEntry = GetEntry(DamageLogNum - 1);
 		LogEntry.NumImpacts++;
 		LogEntry.SumDamage += -Payload.Magnitude;
+
+		SetComponentTickEnabled(true);
 	}
 }
-
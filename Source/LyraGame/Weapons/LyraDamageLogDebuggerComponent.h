@@ -15,6 +15,7 @@ struct FLyraVerbMessage;
 
 struct FFrameDamageEntry
 {
+	uint64 FrameNumber = 0;
 	int32 NumImpacts = 0;
 	double SumDamage = 0.0;
 	double TimeOfFirstHit = 0.0;
@@ -36,12 +37,37 @@ public:
 	UPROPERTY(EditAnywhere)
 	double SecondsBetweenDamageBeforeLogging = 1.0;
 
+	// How many distinct frames of damage are remembered, older frames are overwritten
+	UPROPERTY(EditAnywhere, meta=(ClampMin=1))
+	int32 MaxLoggedFrames = 512;
+
+	// Damage per second over the last WindowSeconds, for on-screen display
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="Lyra|Debug")
+	double GetDamagePerSecond(double WindowSeconds = 5.0) const;
+
+	// Total damage and impacts over the last WindowSeconds
+	UFUNCTION(BlueprintCallable, Category="Lyra|Debug")
+	void GetDamageInWindow(double WindowSeconds, double& OutTotalDamage, int32& OutNumImpacts) const;
+
 private:
 	FGameplayMessageListenerHandle ListenerHandle;
 
 	double LastDamageEntryTime = 0.0;
-	TMap<int64, FFrameDamageEntry> DamageLog;
+
+	// Ring buffer of per-frame damage, oldest entry at DamageLogStart
+	TArray<FFrameDamageEntry> DamageLog;
+	int32 DamageLogStart = 0;
+	int32 DamageLogNum = 0;
+
+	// How many of the newest entries haven't been logged yet, and how many were overwritten before they could be
+	int32 NumUnloggedEntries = 0;
+	int32 NumDroppedEntries = 0;
 
 private:
 	void OnDamageMessage(FGameplayTag Channel, const FLyraVerbMessage& Payload);
+	void LogPendingDamage();
+
+	// Index 0 is the oldest entry in the log
+	const FFrameDamageEntry& GetEntry(int32 Index) const { return DamageLog[(DamageLogStart + Index) % DamageLog.Num()]; }
+	FFrameDamageEntry& GetEntry(int32 Index) { return DamageLog[(DamageLogStart + Index) % DamageLog.Num()]; }
 };
@@ -574,7 +574,9 @@ void ULyraGameplayAbility_RangedWeapon::StartRangedWeaponTargeting()
 
 	if (FoundHits.Num() > 0)
 	{
-		const int32 CartridgeID = FMath::Rand();
+		// Counting up keeps the values small (and the target data compact) for a long time before they would ever wrap
+		const int32 CartridgeID = NextCartridgeID;
+		NextCartridgeID = (NextCartridgeID < MAX_int32) ? (NextCartridgeID + 1) : 0;
 
 		for (const FHitResult& FoundHit : FoundHits)
 		{
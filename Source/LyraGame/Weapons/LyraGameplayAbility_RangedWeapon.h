@@ -120,4 +120,7 @@ protected:
 
 private:
 	FDelegateHandle OnTargetDataReadyCallbackDelegateHandle;
+
+	// Cartridge ID for the next shot (see FLyraGameplayAbilityTargetData_SingleTargetHit::CartridgeID)
+	int32 NextCartridgeID = 0;
 };
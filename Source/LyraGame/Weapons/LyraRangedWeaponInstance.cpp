@@ -2,16 +2,35 @@
 
 #include "LyraRangedWeaponInstance.h"
 #include "NativeGameplayTags.h"
-#include "GameFramework/Pawn.h"
+#include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/Controller.h"
 #include "Camera/LyraCameraComponent.h"
 #include "Physics/PhysicalMaterialWithTags.h"
 #include "Weapons/LyraWeaponInstance.h"
+#include "Weapons/LyraWeaponStateComponent.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraRangedWeaponInstance)
 
 UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Lyra_Weapon_SteadyAimingCamera, "Lyra.Weapon.SteadyAimingCamera");
 
+CSV_DEFINE_CATEGORY(LyraWeapons, true);
+
+namespace LyraRangedWeapon
+{
+	// Camera mode changes and similar wake events can land a frame before the state they react to is visible,
+	// so a woken weapon keeps ticking for at least this many ticks before it may go dormant again
+	static const int32 WakeGraceTicks = 2;
+
+	static int32 EnableDormancy = 1;
+	static FAutoConsoleVariableRef CVarEnableDormancy(
+		TEXT("Lyra.Weapon.EnableDormancy"),
+		EnableDormancy,
+		TEXT("Should ranged weapons stop ticking once their spread and multipliers have settled?"),
+		ECVF_Default);
+}
+
 ULyraRangedWeaponInstance::ULyraRangedWeaponInstance(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -33,6 +52,11 @@ void ULyraRangedWeaponInstance::PostEditChangeProperty(struct FPropertyChangedEv
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
 	UpdateDebugVisualization();
+
+	if (BakedHeatToSpreadCurve.IsBaked())
+	{
+		BakeCurves();
+	}
 }
 
 void ULyraRangedWeaponInstance::UpdateDebugVisualization()
@@ -49,42 +73,155 @@ void ULyraRangedWeaponInstance::OnEquipped()
 {
 	Super::OnEquipped();
 
+	BakeCurves();
+
 	// Start heat in the middle
-	float MinHeatRange;
-	float MaxHeatRange;
-	ComputeHeatRange(/*out*/ MinHeatRange, /*out*/ MaxHeatRange);
-	CurrentHeat = (MinHeatRange + MaxHeatRange) * 0.5f;
+	CurrentHeat = (CachedMinHeat + CachedMaxHeat) * 0.5f;
 
 	// Derive spread
-	CurrentSpreadAngle = HeatToSpreadCurve.GetRichCurveConst()->Eval(CurrentHeat);
+	CurrentSpreadAngle = BakedHeatToSpreadCurve.Eval(CurrentHeat);
 
 	// Default the multipliers to 1x
 	CurrentSpreadAngleMultiplier = 1.0f;
 	StandingStillMultiplier = 1.0f;
 	JumpFallMultiplier = 1.0f;
 	CrouchingMultiplier = 1.0f;
+
+	BindToPawnMovement();
+	WakeFromDormancy();
 }
 
 void ULyraRangedWeaponInstance::OnUnequipped()
 {
+	UnbindFromPawnMovement();
+
 	Super::OnUnequipped();
 }
 
 void ULyraRangedWeaponInstance::Tick(float DeltaSeconds)
 {
+	CSV_SCOPED_TIMING_STAT(LyraWeapons, RangedWeaponTick);
+	CSV_CUSTOM_STAT(LyraWeapons, RangedWeaponTicks, 1, ECsvCustomStatOp::Accumulate);
+
 	APawn* Pawn = GetPawn();
 	check(Pawn != nullptr);
-	
-	const bool bMinSpread = UpdateSpread(DeltaSeconds);
-	const bool bMinMultipliers = UpdateMultipliers(DeltaSeconds);
+
+	if (!BakedHeatToSpreadCurve.IsBaked())
+	{
+		BakeCurves();
+	}
+
+	bool bSpreadSettled = false;
+	bool bMultipliersSettled = false;
+	const bool bMinSpread = UpdateSpread(DeltaSeconds, /*out*/ bSpreadSettled);
+	const bool bMinMultipliers = UpdateMultipliers(DeltaSeconds, /*out*/ bMultipliersSettled);
 
 	bHasFirstShotAccuracy = bAllowFirstShotAccuracy && bMinMultipliers && bMinSpread;
 
+	// Once another tick would produce the same result, stop ticking until something changes our inputs
+	if (WakeGraceTicks > 0)
+	{
+		--WakeGraceTicks;
+	}
+	else if (bSpreadSettled && bMultipliersSettled && (LyraRangedWeapon::EnableDormancy != 0))
+	{
+		SetDormant(true);
+	}
+
 #if WITH_EDITOR
 	UpdateDebugVisualization();
 #endif
 }
 
+void ULyraRangedWeaponInstance::BakeCurves()
+{
+	BakedHeatToSpreadCurve.Bake(HeatToSpreadCurve.GetRichCurveConst());
+	BakedHeatToHeatPerShotCurve.Bake(HeatToHeatPerShotCurve.GetRichCurveConst());
+	BakedHeatToCoolDownPerSecondCurve.Bake(HeatToCoolDownPerSecondCurve.GetRichCurveConst());
+
+	ComputeHeatRange(/*out*/ CachedMinHeat, /*out*/ CachedMaxHeat);
+	ComputeSpreadRange(/*out*/ CachedMinSpread, /*out*/ CachedMaxSpread);
+}
+
+void ULyraRangedWeaponInstance::WakeFromDormancy()
+{
+	WakeGraceTicks = LyraRangedWeapon::WakeGraceTicks;
+	SetDormant(false);
+}
+
+void ULyraRangedWeaponInstance::SetDormant(bool bNewDormant)
+{
+	// Going dormant twice is a no-op, but waking always has to reach the state component: its tick is shared by every
+	// weapon the controller equips, so a previous weapon may have turned it off while this one was never dormant
+	if (bNewDormant && bDormant)
+	{
+		return;
+	}
+
+	bDormant = bNewDormant;
+
+	// The weapon is ticked by the controller's weapon state component, which only needs to tick while we do
+	if (APawn* Pawn = GetPawn())
+	{
+		if (AController* Controller = Pawn->GetController())
+		{
+			if (ULyraWeaponStateComponent* WeaponStateComponent = Controller->FindComponentByClass<ULyraWeaponStateComponent>())
+			{
+				WeaponStateComponent->SetComponentTickEnabled(!bDormant);
+			}
+		}
+	}
+}
+
+void ULyraRangedWeaponInstance::BindToPawnMovement()
+{
+	UnbindFromPawnMovement();
+
+	if (APawn* Pawn = GetPawn())
+	{
+		if (USceneComponent* RootComponent = Pawn->GetRootComponent())
+		{
+			PawnTransformUpdatedHandle = RootComponent->TransformUpdated.AddUObject(this, &ThisClass::OnPawnTransformUpdated);
+		}
+
+		if (ACharacter* Character = Cast<ACharacter>(Pawn))
+		{
+			Character->MovementModeChangedDelegate.AddDynamic(this, &ThisClass::OnPawnMovementModeChanged);
+		}
+	}
+}
+
+void ULyraRangedWeaponInstance::UnbindFromPawnMovement()
+{
+	if (APawn* Pawn = GetPawn())
+	{
+		if (USceneComponent* RootComponent = Pawn->GetRootComponent())
+		{
+			RootComponent->TransformUpdated.Remove(PawnTransformUpdatedHandle);
+		}
+
+		if (ACharacter* Character = Cast<ACharacter>(Pawn))
+		{
+			Character->MovementModeChangedDelegate.RemoveDynamic(this, &ThisClass::OnPawnMovementModeChanged);
+		}
+	}
+
+	PawnTransformUpdatedHandle.Reset();
+}
+
+void ULyraRangedWeaponInstance::OnPawnTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	if (bDormant)
+	{
+		WakeFromDormancy();
+	}
+}
+
+void ULyraRangedWeaponInstance::OnPawnMovementModeChanged(ACharacter* Character, EMovementMode PrevMovementMode, uint8 PreviousCustomMode)
+{
+	WakeFromDormancy();
+}
+
 void ULyraRangedWeaponInstance::ComputeHeatRange(float& MinHeat, float& MaxHeat)
 {
 	float Min1;
@@ -110,12 +247,20 @@ void ULyraRangedWeaponInstance::ComputeSpreadRange(float& MinSpread, float& MaxS
 
 void ULyraRangedWeaponInstance::AddSpread()
 {
+	if (!BakedHeatToSpreadCurve.IsBaked())
+	{
+		BakeCurves();
+	}
+
 	// Sample the heat up curve
-	const float HeatPerShot = HeatToHeatPerShotCurve.GetRichCurveConst()->Eval(CurrentHeat);
+	const float HeatPerShot = BakedHeatToHeatPerShotCurve.Eval(CurrentHeat);
 	CurrentHeat = ClampHeat(CurrentHeat + HeatPerShot);
 
 	// Map the heat to the spread angle
-	CurrentSpreadAngle = HeatToSpreadCurve.GetRichCurveConst()->Eval(CurrentHeat);
+	CurrentSpreadAngle = BakedHeatToSpreadCurve.Eval(CurrentHeat);
+
+	// Firing changes the heat, so we need to tick again to recover from it
+	WakeFromDormancy();
 
 #if WITH_EDITOR
 	UpdateDebugVisualization();
@@ -145,25 +290,28 @@ float ULyraRangedWeaponInstance::GetPhysicalMaterialAttenuation(const UPhysicalM
 	return CombinedMultiplier;
 }
 
-bool ULyraRangedWeaponInstance::UpdateSpread(float DeltaSeconds)
+bool ULyraRangedWeaponInstance::UpdateSpread(float DeltaSeconds, bool& bOutSettled)
 {
 	const float TimeSinceFired = GetWorld()->TimeSince(LastFireTime);
 
+	// Before the recovery delay has elapsed the heat is held, but will start changing without any event
+	bOutSettled = false;
+
 	if (TimeSinceFired > SpreadRecoveryCooldownDelay)
 	{
-		const float CooldownRate = HeatToCoolDownPerSecondCurve.GetRichCurveConst()->Eval(CurrentHeat);
+		const float PreviousHeat = CurrentHeat;
+		const float CooldownRate = BakedHeatToCoolDownPerSecondCurve.Eval(CurrentHeat);
 		CurrentHeat = ClampHeat(CurrentHeat - (CooldownRate * DeltaSeconds));
-		CurrentSpreadAngle = HeatToSpreadCurve.GetRichCurveConst()->Eval(CurrentHeat);
+		CurrentSpreadAngle = BakedHeatToSpreadCurve.Eval(CurrentHeat);
+
+		// Heat only depends on itself, so once it stops changing (clamped or no cooldown) it stays put
+		bOutSettled = (CurrentHeat == PreviousHeat);
 	}
-	
-	float MinSpread;
-	float MaxSpread;
-	ComputeSpreadRange(/*out*/ MinSpread, /*out*/ MaxSpread);
 
-	return FMath::IsNearlyEqual(CurrentSpreadAngle, MinSpread, KINDA_SMALL_NUMBER);
+	return FMath::IsNearlyEqual(CurrentSpreadAngle, CachedMinSpread, KINDA_SMALL_NUMBER);
 }
 
-bool ULyraRangedWeaponInstance::UpdateMultipliers(float DeltaSeconds)
+bool ULyraRangedWeaponInstance::UpdateMultipliers(float DeltaSeconds, bool& bOutSettled)
 {
 	const float MultiplierNearlyEqualThreshold = 0.05f;
 
@@ -194,6 +342,7 @@ bool ULyraRangedWeaponInstance::UpdateMultipliers(float DeltaSeconds)
 
 	// Determine if we are aiming down sights, and apply the bonus based on how far into the camera transition we are
 	float AimingAlpha = 0.0f;
+	bool bCameraBlendSettled = true;
 	if (const ULyraCameraComponent* CameraComponent = ULyraCameraComponent::FindCameraComponent(Pawn))
 	{
 		float TopCameraWeight;
@@ -201,6 +350,7 @@ bool ULyraRangedWeaponInstance::UpdateMultipliers(float DeltaSeconds)
 		CameraComponent->GetBlendInfo(/*out*/ TopCameraWeight, /*out*/ TopCameraTag);
 
 		AimingAlpha = (TopCameraTag == TAG_Lyra_Weapon_SteadyAimingCamera) ? TopCameraWeight : 0.0f;
+		bCameraBlendSettled = (TopCameraWeight >= 1.0f);
 	}
 	const float AimingMultiplier = FMath::GetMappedRangeValueClamped(
 		/*InputRange=*/ FVector2D(0.0f, 1.0f),
@@ -212,6 +362,12 @@ bool ULyraRangedWeaponInstance::UpdateMultipliers(float DeltaSeconds)
 	const float CombinedMultiplier = AimingMultiplier * StandingStillMultiplier * CrouchingMultiplier * JumpFallMultiplier;
 	CurrentSpreadAngleMultiplier = CombinedMultiplier;
 
+	// FInterpTo snaps to the target once close enough, so exact equality means these are done moving
+	bOutSettled = bCameraBlendSettled &&
+		(StandingStillMultiplier == MovementTargetValue) &&
+		(CrouchingMultiplier == CrouchingTargetValue) &&
+		(JumpFallMultiplier == JumpFallTargetValue);
+
 	// need to handle these spread multipliers indicating we are not at min spread
 	return bStandingStillMultiplierAtMin && bCrouchingMultiplierAtTarget && bJumpFallMultiplerIs1 && bAimingMultiplierAtTarget;
 }
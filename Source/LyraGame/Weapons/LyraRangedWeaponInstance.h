@@ -3,13 +3,17 @@
 #pragma once
 
 #include "Curves/CurveFloat.h"
+#include "Engine/EngineTypes.h"
 
 #include "LyraWeaponInstance.h"
+#include "LyraBakedCurve.h"
 #include "AbilitySystem/LyraAbilitySourceInterface.h"
 
 #include "LyraRangedWeaponInstance.generated.h"
 
+class ACharacter;
 class UPhysicalMaterial;
+class USceneComponent;
 
 /**
  * ULyraRangedWeaponInstance
@@ -214,9 +218,37 @@ private:
 	// The current crouching multiplier
 	float CrouchingMultiplier = 1.0f;
 
+	// Heat curves baked when equipped, so ticking and firing don't search the curve keys
+	FLyraBakedCurve BakedHeatToSpreadCurve;
+	FLyraBakedCurve BakedHeatToHeatPerShotCurve;
+	FLyraBakedCurve BakedHeatToCoolDownPerSecondCurve;
+
+	// Heat and spread ranges cached alongside the baked curves
+	float CachedMinHeat = 0.0f;
+	float CachedMaxHeat = 0.0f;
+	float CachedMinSpread = 0.0f;
+	float CachedMaxSpread = 0.0f;
+
+	// Is the spread/multiplier state settled so that ticking would not change it?
+	bool bDormant = false;
+
+	// Ticks to run after being woken before we are allowed to go dormant again
+	int32 WakeGraceTicks = 0;
+
+	FDelegateHandle PawnTransformUpdatedHandle;
+
 public:
 	void Tick(float DeltaSeconds);
 
+	// Returns true if the weapon has settled and doesn't need to tick until something wakes it
+	bool IsDormant() const
+	{
+		return bDormant;
+	}
+
+	// Resumes ticking after the weapon has gone dormant (firing, owner movement, camera mode changes)
+	void WakeFromDormancy();
+
 	//~ULyraEquipmentInstance interface
 	virtual void OnEquipped();
 	virtual void OnUnequipped();
@@ -233,18 +265,29 @@ private:
 	void ComputeSpreadRange(float& MinSpread, float& MaxSpread);
 	void ComputeHeatRange(float& MinHeat, float& MaxHeat);
 
+	// Bakes the heat curves and caches their ranges
+	void BakeCurves();
+
 	inline float ClampHeat(float NewHeat)
 	{
-		float MinHeat;
-		float MaxHeat;
-		ComputeHeatRange(/*out*/ MinHeat, /*out*/ MaxHeat);
-
-		return FMath::Clamp(NewHeat, MinHeat, MaxHeat);
+		return FMath::Clamp(NewHeat, CachedMinHeat, CachedMaxHeat);
 	}
 
 	// Updates the spread and returns true if the spread is at minimum
-	bool UpdateSpread(float DeltaSeconds);
+	// bOutSettled is set if another update would not change the spread
+	bool UpdateSpread(float DeltaSeconds, bool& bOutSettled);
 
 	// Updates the multipliers and returns true if they are at minimum
-	bool UpdateMultipliers(float DeltaSeconds);
+	// bOutSettled is set if another update would not change the multipliers
+	bool UpdateMultipliers(float DeltaSeconds, bool& bOutSettled);
+
+	void SetDormant(bool bNewDormant);
+
+	void BindToPawnMovement();
+	void UnbindFromPawnMovement();
+
+	void OnPawnTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	UFUNCTION()
+	void OnPawnMovementModeChanged(ACharacter* Character, EMovementMode PrevMovementMode, uint8 PreviousCustomMode);
 };
@@ -8,6 +8,7 @@
 #include "Components/StaticMeshComponent.h"
 #include "Engine/World.h"
 #include "Equipment/LyraPickupDefinition.h"
+#include "GameFramework/GameStateBase.h"
 #include "GameFramework/Pawn.h"
 #include "Inventory/InventoryFragment_SetStats.h"
 #include "Kismet/GameplayStatics.h"
@@ -16,6 +17,7 @@
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraSystem.h"
 #include "TimerManager.h"
+#include "Weapons/LyraWeaponSpawnerSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraWeaponSpawner)
 
@@ -27,8 +29,9 @@ struct FHitResult;
 // Sets default values
 ALyraWeaponSpawner::ALyraWeaponSpawner()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+	// Ticking is only turned on by clients while cooling down, or by blueprints implementing Event Tick, see BeginPlay
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	RootComponent = CollisionVolume = CreateDefaultSubobject<UCapsuleComponent>(TEXT("CollisionVolume"));
 	CollisionVolume->InitCapsuleSize(80.f, 80.f);
@@ -43,8 +46,13 @@ ALyraWeaponSpawner::ALyraWeaponSpawner()
 	WeaponMeshRotationSpeed = 40.0f;
 	CoolDownTime = 30.0f;
 	CheckExistingOverlapDelay = 0.25f;
+	CoolDownIndicatorUpdateInterval = 0.1f;
+	CoolDownStartTime = 0.0;
 	bIsWeaponAvailable = true;
 	bReplicates = true;
+
+	// Nothing changes between pickups, so only wake up to replicate the pickup and the respawn
+	NetDormancy = DORM_Initial;
 }
 
 // Called when the game starts or when spawned
@@ -63,6 +71,19 @@ void ALyraWeaponSpawner::BeginPlay()
 			UE_LOG(LogLyra, Error, TEXT("'%s' does not have a valid weapon definition! Make sure to set this data on the instance!"), *GetNameSafe(this));	
 		}
 	}
+
+	// Not starting with tick enabled would otherwise silently switch off Event Tick in blueprint subclasses
+	bTickForBlueprint = GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(ALyraWeaponSpawner, ReceiveTick));
+	if (bTickForBlueprint)
+	{
+		SetActorTickEnabled(true);
+	}
+	else
+	{
+		SetActorTickInterval(CoolDownIndicatorUpdateInterval);
+	}
+
+	UpdateWeaponMeshRotation();
 }
 
 void ALyraWeaponSpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -71,24 +92,22 @@ void ALyraWeaponSpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	{
 		World->GetTimerManager().ClearTimer(CoolDownTimerHandle);
 		World->GetTimerManager().ClearTimer(CheckOverlapsDelayTimerHandle);
+
+		if (ULyraWeaponSpawnerSubsystem* SpawnerSubsystem = World->GetSubsystem<ULyraWeaponSpawnerSubsystem>())
+		{
+			SpawnerSubsystem->UnregisterSpinningMesh(this);
+		}
 	}
 	
 	Super::EndPlay(EndPlayReason);
 }
 
-// Called every frame
 void ALyraWeaponSpawner::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
 	//Update the CoolDownPercentage property to drive respawn time indicators
-	UWorld* World = GetWorld();
-	if (World->GetTimerManager().IsTimerActive(CoolDownTimerHandle))
-	{
-		CoolDownPercentage = 1.0f - World->GetTimerManager().GetTimerRemaining(CoolDownTimerHandle)/CoolDownTime;
-	}
-
-	WeaponMesh->AddRelativeRotation(FRotator(0.0f, World->GetDeltaSeconds() * WeaponMeshRotationSpeed, 0.0f));
+	CoolDownPercentage = GetCoolDownPercentage();
 }
 
 void ALyraWeaponSpawner::OnConstruction(const FTransform& Transform)
@@ -132,7 +151,9 @@ void ALyraWeaponSpawner::AttemptPickUpWeapon_Implementation(APawn* Pawn)
 			if (GiveWeapon(WeaponItemDefinition, Pawn))
 			{
 				//Weapon picked up by pawn
+				FlushNetDormancy();
 				bIsWeaponAvailable = false;
+				CoolDownStartTime = GetServerWorldTimeSeconds();
 				SetWeaponPickupVisibility(false);
 				PlayPickupEffects();
 				StartCoolDown();
@@ -143,10 +164,17 @@ void ALyraWeaponSpawner::AttemptPickUpWeapon_Implementation(APawn* Pawn)
 
 void ALyraWeaponSpawner::StartCoolDown()
 {
-	if (UWorld* World = GetWorld())
+	// Only the server times the respawn, clients find out through OnRep_WeaponAvailability
+	if (GetLocalRole() == ROLE_Authority)
 	{
-		World->GetTimerManager().SetTimer(CoolDownTimerHandle, this, &ALyraWeaponSpawner::OnCoolDownTimerComplete, CoolDownTime);
+		if (UWorld* World = GetWorld())
+		{
+			const float TimeRemaining = FMath::Max(CoolDownTime * (1.0f - GetCoolDownPercentage()), KINDA_SMALL_NUMBER);
+			World->GetTimerManager().SetTimer(CoolDownTimerHandle, this, &ALyraWeaponSpawner::OnCoolDownTimerComplete, TimeRemaining);
+		}
 	}
+
+	UpdateCoolDownIndicator(true);
 }
 
 void ALyraWeaponSpawner::ResetCoolDown()
@@ -160,6 +188,7 @@ void ALyraWeaponSpawner::ResetCoolDown()
 
 	if (GetLocalRole() == ROLE_Authority)
 	{
+		FlushNetDormancy();
 		bIsWeaponAvailable = true;
 		PlayRespawnEffects();
 		SetWeaponPickupVisibility(true);
@@ -170,7 +199,7 @@ void ALyraWeaponSpawner::ResetCoolDown()
 		}
 	}
 
-	CoolDownPercentage = 0.0f;
+	UpdateCoolDownIndicator(false);
 }
 
 void ALyraWeaponSpawner::OnCoolDownTimerComplete()
@@ -178,9 +207,61 @@ void ALyraWeaponSpawner::OnCoolDownTimerComplete()
 	ResetCoolDown();
 }
 
+float ALyraWeaponSpawner::GetCoolDownPercentage() const
+{
+	if (bIsWeaponAvailable || CoolDownTime <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	const double TimeSinceCoolDownStarted = GetServerWorldTimeSeconds() - CoolDownStartTime;
+	return FMath::Clamp((float)(TimeSinceCoolDownStarted / CoolDownTime), 0.0f, 1.0f);
+}
+
+double ALyraWeaponSpawner::GetServerWorldTimeSeconds() const
+{
+	if (const UWorld* World = GetWorld())
+	{
+		if (const AGameStateBase* GameState = World->GetGameState())
+		{
+			return GameState->GetServerWorldTimeSeconds();
+		}
+		return World->GetTimeSeconds();
+	}
+	return 0.0;
+}
+
+void ALyraWeaponSpawner::UpdateCoolDownIndicator(bool bCoolingDown)
+{
+	// Dedicated servers have nothing to show
+	const bool bShouldTick = bTickForBlueprint || (bCoolingDown && !IsNetMode(NM_DedicatedServer));
+	SetActorTickEnabled(bShouldTick);
+	CoolDownPercentage = bCoolingDown ? GetCoolDownPercentage() : 0.0f;
+}
+
+void ALyraWeaponSpawner::UpdateWeaponMeshRotation()
+{
+	ULyraWeaponSpawnerSubsystem* SpawnerSubsystem = UWorld::GetSubsystem<ULyraWeaponSpawnerSubsystem>(GetWorld());
+	if (SpawnerSubsystem == nullptr)
+	{
+		return;
+	}
+
+	const bool bShouldRotate = (WeaponMeshRotationSpeed != 0.0f) && WeaponMesh->IsVisible() && !IsNetMode(NM_DedicatedServer);
+	if (bShouldRotate)
+	{
+		SpawnerSubsystem->RegisterSpinningMesh(this, WeaponMesh, WeaponMeshRotationSpeed);
+	}
+	else
+	{
+		SpawnerSubsystem->UnregisterSpinningMesh(this);
+	}
+}
+
 void ALyraWeaponSpawner::SetWeaponPickupVisibility(bool bShouldBeVisible)
 {
 	WeaponMesh->SetVisibility(bShouldBeVisible, true);
+	UpdateWeaponMeshRotation();
 }
 
 void ALyraWeaponSpawner::PlayPickupEffects_Implementation()
@@ -225,6 +306,7 @@ void ALyraWeaponSpawner::OnRep_WeaponAvailability()
 	{
 		PlayRespawnEffects();
 		SetWeaponPickupVisibility(true);
+		UpdateCoolDownIndicator(false);
 	}
 	else
 	{
@@ -234,11 +316,20 @@ void ALyraWeaponSpawner::OnRep_WeaponAvailability()
 	}	
 }
 
+void ALyraWeaponSpawner::OnRep_CoolDownStartTime()
+{
+	if (!bIsWeaponAvailable)
+	{
+		CoolDownPercentage = GetCoolDownPercentage();
+	}
+}
+
 void ALyraWeaponSpawner::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
 	DOREPLIFETIME(ALyraWeaponSpawner, bIsWeaponAvailable);
+	DOREPLIFETIME(ALyraWeaponSpawner, CoolDownStartTime);
 }
 
 int32 ALyraWeaponSpawner::GetDefaultStatFromItemDef(const TSubclassOf<ULyraInventoryItemDefinition> WeaponItemClass, FGameplayTag StatTag)
@@ -19,6 +19,13 @@ struct FFrame;
 struct FGameplayTag;
 struct FHitResult;
 
+/**
+ * Weapon pickup pad. Spawners don't tick: the display mesh is spun by ULyraWeaponSpawnerSubsystem and the cool down
+ * progress is worked out on demand from a replicated start time. Clients only tick while cooling down, to keep
+ * CoolDownPercentage current for respawn indicators.
+ *
+ * Blueprint subclasses that implement Event Tick keep ticking all the time, at their own tick interval.
+ */
 UCLASS(Blueprintable,BlueprintType)
 class LYRAGAME_API ALyraWeaponSpawner : public AActor
 {
@@ -34,7 +41,7 @@ protected:
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:	
-	// Called every frame
+	// Only enabled on clients while cooling down, or always when a blueprint subclass implements Event Tick
 	virtual void Tick(float DeltaTime) override;
 
 	void OnConstruction(const FTransform& Transform) override;
@@ -55,10 +62,18 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Lyra|WeaponPickup")
 	float CheckExistingOverlapDelay;
 
-	//Used to drive weapon respawn time indicators 0-1
+	//Used to drive weapon respawn time indicators 0-1. Prefer GetCoolDownPercentage, which doesn't need the spawner to tick
 	UPROPERTY(BlueprintReadOnly, Transient, Category = "Lyra|WeaponPickup")
 	float CoolDownPercentage;
 
+	//Server world time the current cool down started at, replicated so clients can work out the progress themselves
+	UPROPERTY(Transient, ReplicatedUsing = OnRep_CoolDownStartTime)
+	double CoolDownStartTime;
+
+	//How often the indicator tick runs on clients while cooling down, 0 means every frame
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Lyra|WeaponPickup")
+	float CoolDownIndicatorUpdateInterval;
+
 public:
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Lyra|WeaponPickup")
@@ -70,6 +85,7 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Lyra|WeaponPickup")
 	TObjectPtr<UStaticMeshComponent> WeaponMesh;
 
+	//Yaw speed of the display mesh in degrees per second, picked up whenever the weapon is shown. Set to 0 when the display material spins the mesh itself (e.g. with world position offset)
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Lyra|WeaponPickup")
 	float WeaponMeshRotationSpeed;
 
@@ -97,6 +113,10 @@ public:
 	UFUNCTION()
 	void OnCoolDownTimerComplete();
 
+	//Progress of the current cool down from 0 to 1, worked out from the replicated start time. 0 while the weapon is available
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Lyra|WeaponPickup")
+	float GetCoolDownPercentage() const;
+
 	void SetWeaponPickupVisibility(bool bShouldBeVisible);
 
 	UFUNCTION(BlueprintNativeEvent, Category = "Lyra|WeaponPickup")
@@ -108,6 +128,23 @@ public:
 	UFUNCTION()
 	void OnRep_WeaponAvailability();
 
+	UFUNCTION()
+	void OnRep_CoolDownStartTime();
+
+private:
+	double GetServerWorldTimeSeconds() const;
+	void UpdateCoolDownIndicator(bool bCoolingDown);
+	void UpdateWeaponMeshRotation();
+
+	// Set in BeginPlay when a blueprint subclass implements Event Tick, so the actor tick is never turned off
+	bool bTickForBlueprint = false;
+
+#if WITH_DEV_AUTOMATION_TESTS
+	friend class FLyraWeaponSpawnerTickTest;
+#endif
+
+public:
+
 	/** Searches an item definition type for a matching stat and returns the value, or 0 if not found */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Lyra|WeaponPickup")
 	static int32 GetDefaultStatFromItemDef(const TSubclassOf<ULyraInventoryItemDefinition> WeaponItemClass, FGameplayTag StatTag);
@@ -0,0 +1,81 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Weapons/LyraWeaponSpawnerSubsystem.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Weapons/LyraWeaponSpawner.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraWeaponSpawnerSubsystem)
+
+namespace LyraWeaponSpawnerSubsystem
+{
+	// How long since a mesh was last rendered before it stops spinning
+	static const float RecentlyRenderedTolerance = 0.2f;
+}
+
+void ULyraWeaponSpawnerSubsystem::Tick(float DeltaTime)
+{
+	UpdateSpinningMeshes(DeltaTime, /*bOnlyIfRendered=*/ true);
+}
+
+bool ULyraWeaponSpawnerSubsystem::IsTickable() const
+{
+	return !SpinningMeshes.IsEmpty();
+}
+
+TStatId ULyraWeaponSpawnerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULyraWeaponSpawnerSubsystem, STATGROUP_Tickables);
+}
+
+void ULyraWeaponSpawnerSubsystem::RegisterSpinningMesh(ALyraWeaponSpawner* Spawner, UStaticMeshComponent* Mesh, float RotationSpeed)
+{
+	check(Spawner && Mesh);
+
+	FSpinningMesh* Entry = SpinningMeshes.FindByPredicate([Spawner](const FSpinningMesh& Existing) { return Existing.Spawner == Spawner; });
+	if (Entry == nullptr)
+	{
+		Entry = &SpinningMeshes.AddDefaulted_GetRef();
+		Entry->Spawner = Spawner;
+	}
+
+	Entry->Mesh = Mesh;
+	Entry->BaseRotation = Mesh->GetRelativeRotation();
+	Entry->RotationSpeed = RotationSpeed;
+	Entry->SpinStartTime = SpinTime;
+}
+
+void ULyraWeaponSpawnerSubsystem::UnregisterSpinningMesh(ALyraWeaponSpawner* Spawner)
+{
+	SpinningMeshes.RemoveAllSwap([Spawner](const FSpinningMesh& Existing) { return Existing.Spawner == Spawner; });
+}
+
+bool ULyraWeaponSpawnerSubsystem::IsMeshSpinning(const ALyraWeaponSpawner* Spawner) const
+{
+	return SpinningMeshes.ContainsByPredicate([Spawner](const FSpinningMesh& Existing) { return Existing.Spawner == Spawner; });
+}
+
+void ULyraWeaponSpawnerSubsystem::UpdateSpinningMeshes(float DeltaTime, bool bOnlyIfRendered)
+{
+	SpinTime += DeltaTime;
+
+	for (int32 Index = SpinningMeshes.Num() - 1; Index >= 0; --Index)
+	{
+		const FSpinningMesh& Entry = SpinningMeshes[Index];
+		UStaticMeshComponent* Mesh = Entry.Mesh.Get();
+		if (Mesh == nullptr || !Entry.Spawner.IsValid())
+		{
+			SpinningMeshes.RemoveAtSwap(Index);
+			continue;
+		}
+
+		if (bOnlyIfRendered && !Mesh->WasRecentlyRendered(LyraWeaponSpawnerSubsystem::RecentlyRenderedTolerance))
+		{
+			continue;
+		}
+
+		const double Yaw = FMath::Fmod((SpinTime - Entry.SpinStartTime) * Entry.RotationSpeed, 360.0);
+		const FQuat Spin(FVector::UpVector, FMath::DegreesToRadians(Yaw));
+		Mesh->SetRelativeRotation(Entry.BaseRotation.Quaternion() * Spin);
+	}
+}
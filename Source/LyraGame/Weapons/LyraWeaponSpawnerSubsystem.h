@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+
+#include "LyraWeaponSpawnerSubsystem.generated.h"
+
+class ALyraWeaponSpawner;
+class UStaticMeshComponent;
+
+/**
+ * Spins the display meshes of all weapon spawners in the world from a single tick, instead of giving every spawner
+ * its own ticking movement component. Spawners register while their weapon is visible (never on dedicated servers),
+ * and meshes that haven't been rendered recently are skipped, so spawners nobody is looking at cost nothing.
+ */
+UCLASS()
+class LYRAGAME_API ULyraWeaponSpawnerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~End of FTickableGameObject interface
+
+	// Starts spinning the mesh at RotationSpeed degrees per second around its current relative rotation
+	void RegisterSpinningMesh(ALyraWeaponSpawner* Spawner, UStaticMeshComponent* Mesh, float RotationSpeed);
+
+	// Stops spinning the spawner's mesh, leaving it where it is
+	void UnregisterSpinningMesh(ALyraWeaponSpawner* Spawner);
+
+	bool IsMeshSpinning(const ALyraWeaponSpawner* Spawner) const;
+
+private:
+	void UpdateSpinningMeshes(float DeltaTime, bool bOnlyIfRendered);
+
+	struct FSpinningMesh
+	{
+		TWeakObjectPtr<ALyraWeaponSpawner> Spawner;
+		TWeakObjectPtr<UStaticMeshComponent> Mesh;
+		FRotator BaseRotation;
+		float RotationSpeed = 0.0f;
+		double SpinStartTime = 0.0;
+	};
+
+	TArray<FSpinningMesh> SpinningMeshes;
+
+	// Accumulated tick time, the yaw of every mesh is worked out from it so skipped frames don't need catching up
+	double SpinTime = 0.0;
+
+#if WITH_DEV_AUTOMATION_TESTS
+	friend class FLyraWeaponSpawnerTickTest;
+#endif
+};
@@ -4,6 +4,7 @@
 
 #include "Abilities/GameplayAbilityTargetTypes.h"
 #include "Equipment/LyraEquipmentManagerComponent.h"
+#include "GameFramework/Controller.h"
 #include "GameFramework/Pawn.h"
 #include "GameplayEffectTypes.h"
 #include "Kismet/GameplayStatics.h"
@@ -25,6 +26,32 @@ ULyraWeaponStateComponent::ULyraWeaponStateComponent(const FObjectInitializer& O
 	PrimaryComponentTick.bCanEverTick = true;
 }
 
+void ULyraWeaponStateComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (AController* Controller = GetController<AController>())
+	{
+		Controller->OnPossessedPawnChanged.AddDynamic(this, &ThisClass::HandlePossessedPawnChanged);
+	}
+}
+
+void ULyraWeaponStateComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (AController* Controller = GetController<AController>())
+	{
+		Controller->OnPossessedPawnChanged.RemoveDynamic(this, &ThisClass::HandlePossessedPawnChanged);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ULyraWeaponStateComponent::HandlePossessedPawnChanged(APawn* OldPawn, APawn* NewPawn)
+{
+	// Let the new pawn's weapon decide on its first tick whether it can go dormant
+	SetComponentTickEnabled(NewPawn != nullptr);
+}
+
 void ULyraWeaponStateComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
@@ -35,7 +62,16 @@ void ULyraWeaponStateComponent::TickComponent(float DeltaTime, enum ELevelTick T
 		{
 			if (ULyraRangedWeaponInstance* CurrentWeapon = Cast<ULyraRangedWeaponInstance>(EquipmentManager->GetFirstInstanceOfType(ULyraRangedWeaponInstance::StaticClass())))
 			{
-				CurrentWeapon->Tick(DeltaTime);
+				// Dormant weapons re-enable our tick when they wake up (see ULyraRangedWeaponInstance::WakeFromDormancy)
+				if (!CurrentWeapon->IsDormant())
+				{
+					CurrentWeapon->Tick(DeltaTime);
+				}
+
+				if (CurrentWeapon->IsDormant())
+				{
+					SetComponentTickEnabled(false);
+				}
 			}
 		}
 	}